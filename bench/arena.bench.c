@@ -0,0 +1,120 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * State of the arena benchmarks.
+ */
+typedef struct
+{
+  point_arena_t *arena;
+  point_t **points;
+  size_t count;
+  uint32_t threads;
+} bench_arena_t;
+
+/**
+ * Creates and destroys every point with the allocator currently installed.
+ */
+static void
+bench_arena_create_destroy (void *context)
+{
+  bench_arena_t *bench_arena = context;
+  for (size_t i = 0; i < bench_arena->count; ++i)
+    {
+      bench_arena->points[i] = point_create ((uint32_t)i, (uint32_t)(i * 7U));
+    }
+  for (size_t i = 0; i < bench_arena->count; ++i)
+    {
+      (void)point_destroy (bench_arena->points[i]);
+    }
+}
+
+/**
+ * Creates every point in the arena, released at once by resetting it.
+ */
+static void
+bench_arena_create_reset (void *context)
+{
+  bench_arena_t *bench_arena = context;
+  (void)point_set_allocator (point_arena_alloc, point_arena_free, bench_arena->arena);
+  for (size_t i = 0; i < bench_arena->count; ++i)
+    {
+      bench_arena->points[i] = point_create ((uint32_t)i, (uint32_t)(i * 7U));
+    }
+  (void)point_arena_reset (bench_arena->arena);
+  (void)bench_install_allocator ();
+}
+
+/**
+ * Computes the bounding box of the points.
+ */
+static void
+bench_arena_bbox (void *context)
+{
+  const bench_arena_t *bench_arena = context;
+  point_bbox_t bbox;
+  (void)point_bbox_compute (bench_arena->points, bench_arena->count, &bbox, bench_arena->threads);
+}
+
+/**
+ * Creates a prefaulted arena for every point and destroys it.
+ */
+static void
+bench_arena_prefault (void *context)
+{
+  const bench_arena_t *bench_arena = context;
+  point_arena_options_t options = { .capacity = bench_arena->count * 8U, .is_huge = true, .numa_node = -1, .is_prefaulted = true };
+  options.threads = bench_arena->threads;
+  (void)point_arena_destroy (point_arena_create (&options));
+}
+
+/**
+ * Benchmarks creating points and reading them back from an arena, against the
+ * default allocator.
+ *
+ * @param bench The benchmark session; bench->count points are created per sample.
+ */
+void
+bench_arena (bench_t *bench)
+{
+  size_t count = bench->count;
+  point_arena_options_t options = { .capacity = count * 8U, .is_huge = true, .numa_node = -1, .is_prefaulted = true };
+  bench_arena_t bench_arena = { point_arena_create (&options), malloc (count * sizeof (point_t *)), count, 1U };
+
+  if ((bench_arena.arena != NULL) && (bench_arena.points != NULL) && (count > 0U))
+    {
+      bench_run (bench, "arena/create_malloc/threads=1", bench_arena_create_destroy, &bench_arena, count);
+      bench_run (bench, "arena/create_arena/threads=1", bench_arena_create_reset, &bench_arena, count);
+
+      /* Read back points left in place by the allocators */
+      for (size_t i = 0; i < count; ++i)
+        {
+          bench_arena.points[i] = point_create ((uint32_t)i, (uint32_t)(i * 7U));
+        }
+      bench_run (bench, "arena/bbox_malloc/threads=1", bench_arena_bbox, &bench_arena, count);
+      for (size_t i = 0; i < count; ++i)
+        {
+          (void)point_destroy (bench_arena.points[i]);
+        }
+      (void)point_set_allocator (point_arena_alloc, point_arena_free, bench_arena.arena);
+      for (size_t i = 0; i < count; ++i)
+        {
+          bench_arena.points[i] = point_create ((uint32_t)i, (uint32_t)(i * 7U));
+        }
+      (void)bench_install_allocator ();
+      bench_run (bench, "arena/bbox_arena/threads=1", bench_arena_bbox, &bench_arena, count);
+      (void)point_arena_reset (bench_arena.arena);
+
+      bench_run (bench, "arena/prefault/threads=1", bench_arena_prefault, &bench_arena, count);
+      bench_arena.threads = 0U;
+      bench_run (bench, "arena/prefault/threads=all", bench_arena_prefault, &bench_arena, count);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the arena benchmark.\n", count);
+    }
+
+  (void)point_arena_destroy (bench_arena.arena);
+  free (bench_arena.points);
+}
@@ -0,0 +1,91 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Upper bound on the number of individually allocated points of the array benchmarks. */
+#define BENCH_BBOX_ARRAY_MAX 1048576U
+
+/**
+ * State of the bounding-box benchmarks.
+ */
+typedef struct
+{
+  point_t **points;
+  size_t point_count;
+  point_batch_t batch;
+  uint32_t threads;
+} bench_bbox_t;
+
+/**
+ * Computes the bounding box of the point array.
+ */
+static void
+bench_bbox_array (void *context)
+{
+  const bench_bbox_t *bench_bbox = context;
+  point_bbox_t bbox;
+  (void)point_bbox_compute (bench_bbox->points, bench_bbox->point_count, &bbox, bench_bbox->threads);
+}
+
+/**
+ * Computes the bounding box of the batch.
+ */
+static void
+bench_bbox_batch (void *context)
+{
+  const bench_bbox_t *bench_bbox = context;
+  point_bbox_t bbox;
+  (void)point_batch_bbox_compute (&bench_bbox->batch, &bbox, bench_bbox->threads);
+}
+
+/**
+ * Benchmarks the bounding-box kernels on an array of points and on a batch.
+ *
+ * @param bench The benchmark session; the batch holds bench->count points and the
+ * array at most BENCH_BBOX_ARRAY_MAX of them.
+ */
+void
+bench_bbox (bench_t *bench)
+{
+  size_t count = bench->count;
+  size_t point_count = (count < BENCH_BBOX_ARRAY_MAX) ? count : BENCH_BBOX_ARRAY_MAX;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  point_t **points = calloc (point_count, sizeof (point_t *));
+
+  if ((x != NULL) && (y != NULL) && (points != NULL) && (count > 0U))
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < count; ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          x[i] = state;
+          state = (state * 1664525U) + 1013904223U;
+          y[i] = state;
+        }
+      for (size_t i = 0; i < point_count; ++i)
+        {
+          points[i] = point_create (x[i], y[i]);
+        }
+
+      bench_bbox_t bench_bbox = { points, point_count, { x, y, count }, 1U };
+      bench_run (bench, "bbox/array/threads=1", bench_bbox_array, &bench_bbox, point_count);
+      bench_run (bench, "bbox/batch/threads=1", bench_bbox_batch, &bench_bbox, count);
+      bench_bbox.threads = 0U;
+      bench_run (bench, "bbox/array/threads=all", bench_bbox_array, &bench_bbox, point_count);
+      bench_run (bench, "bbox/batch/threads=all", bench_bbox_batch, &bench_bbox, count);
+
+      for (size_t i = 0; i < point_count; ++i)
+        {
+          (void)point_destroy (points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the bounding-box benchmark.\n", count);
+    }
+
+  free (x);
+  free (y);
+  free (points);
+}
@@ -0,0 +1,74 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Number of timed samples per benchmark, preceded by one untimed warm-up sample. */
+#define BENCH_SAMPLES 21U
+
+/* Maximum number of baseline results that can be compared against. */
+#define BENCH_MAX_BASELINE 256U
+
+/* Runs one sample of a benchmark, performing the number of operations it was registered with. */
+typedef void (*bench_fn) (void *context);
+
+/**
+ * A result read from a baseline file.
+ */
+typedef struct
+{
+  char name[64];
+  double p50_ns;
+} bench_baseline_t;
+
+/**
+ * The configuration and state of a benchmark session.
+ */
+typedef struct
+{
+  size_t count;
+  const char *filter;
+  bool perf;
+  double tolerance;
+  FILE *output;
+  bench_baseline_t baseline[BENCH_MAX_BASELINE];
+  size_t baseline_count;
+  size_t regressions;
+} bench_t;
+
+/**
+ * Returns the current value of the monotonic clock in nanoseconds.
+ */
+static inline uint64_t
+bench_now_ns (void)
+{
+  struct timespec now = { 0 };
+  (void)clock_gettime (CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+/* Harness */
+bool bench_install_allocator (void);
+bool bench_load_baseline (bench_t *bench, const char *path);
+void bench_run (bench_t *bench, const char *name, bench_fn function, void *context, size_t operations);
+
+/* Benchmarks */
+void bench_point (bench_t *bench);
+void bench_bbox (bench_t *bench);
+void bench_histogram (bench_t *bench);
+void bench_transform (bench_t *bench);
+void bench_distance (bench_t *bench);
+void bench_pool (bench_t *bench);
+void bench_polygon (bench_t *bench);
+void bench_dbscan (bench_t *bench);
+void bench_join (bench_t *bench);
+void bench_compact (bench_t *bench);
+void bench_types (bench_t *bench);
+void bench_arena (bench_t *bench);
+void bench_inspection (bench_t *bench);
+
+#endif
@@ -0,0 +1,134 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of consecutive points generated in the same tile, as many as a compact block holds. */
+#define BENCH_COMPACT_TILE_POINTS 4096U
+
+/* Side of the tiles the points are generated in. */
+#define BENCH_COMPACT_TILE_SIDE 65536U
+
+/* Number of tiles per row of the tiled extent. */
+#define BENCH_COMPACT_TILES_PER_ROW 1024U
+
+/**
+ * State of the compact point benchmarks.
+ */
+typedef struct
+{
+  point_batch_t batch;
+  point_batch_t output;
+  point_compact_t *compact;
+  point_bbox_t range;
+  uint32_t *ids;
+  size_t found;
+  uint32_t threads;
+} bench_compact_t;
+
+/**
+ * Compacts the batch.
+ */
+static void
+bench_compact_create (void *context)
+{
+  const bench_compact_t *bench_compact = context;
+  (void)point_compact_destroy (point_compact_create (&bench_compact->batch, bench_compact->threads));
+}
+
+/**
+ * Widens the compact points back into a batch.
+ */
+static void
+bench_compact_export (void *context)
+{
+  const bench_compact_t *bench_compact = context;
+  (void)point_compact_export (bench_compact->compact, &bench_compact->output, bench_compact->threads);
+}
+
+/**
+ * Finds the points of the full-width batch inside the range with a scan, as callers
+ * did before compact points.
+ */
+static void
+bench_compact_query_naive (void *context)
+{
+  bench_compact_t *bench_compact = context;
+  const point_bbox_t range = bench_compact->range;
+  const uint32_t *x = bench_compact->batch.x;
+  const uint32_t *y = bench_compact->batch.y;
+  size_t found = 0;
+
+  for (size_t i = 0; i < bench_compact->batch.count; ++i)
+    {
+      bench_compact->ids[found] = (uint32_t)i;
+      found += (x[i] >= range.min_x) & (x[i] <= range.max_x) & (y[i] >= range.min_y) & (y[i] <= range.max_y);
+    }
+  bench_compact->found = found;
+}
+
+/**
+ * Finds the compact points inside the range.
+ */
+static void
+bench_compact_query_range (void *context)
+{
+  bench_compact_t *bench_compact = context;
+  bench_compact->found = point_compact_query_range (bench_compact->compact, &bench_compact->range, bench_compact->ids, bench_compact->batch.count);
+}
+
+/**
+ * Benchmarks the conversions between full-width and compact points, and range
+ * queries over both.
+ *
+ * Every run of BENCH_COMPACT_TILE_POINTS points lies in its own tile, as the points
+ * of a tiled data set do, and the range covers parts of a few tiles.
+ *
+ * @param bench The benchmark session; bench->count points are generated.
+ */
+void
+bench_compact (bench_t *bench)
+{
+  bench_compact_t bench_compact = { 0 };
+  size_t count = bench->count;
+  uint32_t *coordinates = malloc (count * 4U * sizeof (uint32_t));
+  bench_compact.ids = malloc ((count + 1U) * sizeof (uint32_t));
+
+  if ((coordinates != NULL) && (bench_compact.ids != NULL) && (count > 0U))
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < count; ++i)
+        {
+          uint32_t tile = (uint32_t)(i / BENCH_COMPACT_TILE_POINTS);
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = ((tile % BENCH_COMPACT_TILES_PER_ROW) * BENCH_COMPACT_TILE_SIDE) + (state >> 16U);
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[count + i] = ((tile / BENCH_COMPACT_TILES_PER_ROW) * BENCH_COMPACT_TILE_SIDE) + (state >> 16U);
+        }
+
+      bench_compact.batch = (point_batch_t){ coordinates, &coordinates[count], count };
+      bench_compact.output = (point_batch_t){ &coordinates[count * 2U], &coordinates[count * 3U], count };
+      bench_compact.range = (point_bbox_t){ BENCH_COMPACT_TILE_SIDE / 2U, BENCH_COMPACT_TILE_SIDE / 2U, (BENCH_COMPACT_TILE_SIDE * 9U) / 2U,
+                                            (BENCH_COMPACT_TILE_SIDE * 3U) / 2U };
+      bench_compact.threads = 1U;
+
+      bench_run (bench, "compact/create/threads=1", bench_compact_create, &bench_compact, count);
+      bench_compact.compact = point_compact_create (&bench_compact.batch, 1U);
+      if (bench_compact.compact != NULL)
+        {
+          bench_run (bench, "compact/export/threads=1", bench_compact_export, &bench_compact, count);
+          bench_run (bench, "compact/query_naive/threads=1", bench_compact_query_naive, &bench_compact, count);
+          bench_run (bench, "compact/query_range/threads=1", bench_compact_query_range, &bench_compact, count);
+          bench_compact.threads = 0U;
+          bench_run (bench, "compact/create/threads=all", bench_compact_create, &bench_compact, count);
+          bench_run (bench, "compact/export/threads=all", bench_compact_export, &bench_compact, count);
+          (void)point_compact_destroy (bench_compact.compact);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the compact point benchmark.\n", count);
+    }
+
+  free (coordinates);
+  free (bench_compact.ids);
+}
@@ -0,0 +1,181 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of points clustered by the quadratic baseline, and by the grid on the same points. */
+#define BENCH_DBSCAN_NAIVE_POINTS 4096U
+
+/* Neighborhood radius of the clustering benchmarks. */
+#define BENCH_DBSCAN_EPSILON 48U
+
+/* Number of neighbors making a core point in the clustering benchmarks. */
+#define BENCH_DBSCAN_MIN_POINTS 8U
+
+/**
+ * State of the clustering benchmarks.
+ */
+typedef struct
+{
+  point_t **points;
+  point_batch_t batch;
+  uint32_t *labels;
+  uint32_t *queue;
+  size_t count;
+  uint32_t threads;
+} bench_dbscan_t;
+
+/**
+ * Tests whether two points of the array are within the radius through the point accessors.
+ */
+static bool
+bench_dbscan_is_within (point_t *const *points, size_t a, size_t b)
+{
+  int64_t dx = (int64_t)point_get_x (points[a]) - point_get_x (points[b]);
+  int64_t dy = (int64_t)point_get_y (points[a]) - point_get_y (points[b]);
+  return ((dx * dx) + (dy * dy)) <= ((int64_t)BENCH_DBSCAN_EPSILON * BENCH_DBSCAN_EPSILON);
+}
+
+/**
+ * Clusters the points with a textbook DBSCAN scanning every point for neighbors, as
+ * callers did before the grid.
+ */
+static void
+bench_dbscan_naive (void *context)
+{
+  bench_dbscan_t *bench_dbscan = context;
+  point_t *const *points = bench_dbscan->points;
+  uint32_t *labels = bench_dbscan->labels;
+  uint32_t cluster = 0;
+
+  for (size_t i = 0; i < bench_dbscan->count; ++i)
+    {
+      labels[i] = UINT32_MAX - 1U;
+    }
+
+  for (size_t i = 0; i < bench_dbscan->count; ++i)
+    {
+      if (labels[i] != (UINT32_MAX - 1U))
+        {
+          continue;
+        }
+
+      size_t neighbors = 0;
+      for (size_t j = 0; j < bench_dbscan->count; ++j)
+        {
+          neighbors += bench_dbscan_is_within (points, i, j) ? 1U : 0U;
+        }
+      if (neighbors < BENCH_DBSCAN_MIN_POINTS)
+        {
+          labels[i] = UINT32_MAX;
+          continue;
+        }
+
+      /* Expand the new cluster breadth-first from its first core point */
+      size_t head = 0;
+      size_t tail = 0;
+      labels[i] = cluster;
+      bench_dbscan->queue[tail++] = (uint32_t)i;
+      while (head < tail)
+        {
+          uint32_t current = bench_dbscan->queue[head++];
+          size_t found = 0;
+          for (size_t j = 0; j < bench_dbscan->count; ++j)
+            {
+              found += bench_dbscan_is_within (points, current, j) ? 1U : 0U;
+            }
+          for (size_t j = 0; (found >= BENCH_DBSCAN_MIN_POINTS) && (j < bench_dbscan->count); ++j)
+            {
+              if (((labels[j] == (UINT32_MAX - 1U)) || (labels[j] == UINT32_MAX)) && bench_dbscan_is_within (points, current, j))
+                {
+                  bench_dbscan->queue[tail] = (uint32_t)j;
+                  tail += (labels[j] == (UINT32_MAX - 1U)) ? 1U : 0U;
+                  labels[j] = cluster;
+                }
+            }
+        }
+      ++cluster;
+    }
+}
+
+/**
+ * Clusters the points of the array with the grid.
+ */
+static void
+bench_dbscan_compute (void *context)
+{
+  const bench_dbscan_t *bench_dbscan = context;
+  (void)point_dbscan_compute (bench_dbscan->points, bench_dbscan->count, BENCH_DBSCAN_EPSILON, BENCH_DBSCAN_MIN_POINTS, bench_dbscan->labels, NULL,
+                              bench_dbscan->threads);
+}
+
+/**
+ * Clusters the points of the batch with the grid.
+ */
+static void
+bench_dbscan_batch_compute (void *context)
+{
+  const bench_dbscan_t *bench_dbscan = context;
+  point_batch_t batch = { bench_dbscan->batch.x, bench_dbscan->batch.y, bench_dbscan->count };
+  (void)point_batch_dbscan_compute (&batch, BENCH_DBSCAN_EPSILON, BENCH_DBSCAN_MIN_POINTS, bench_dbscan->labels, NULL, bench_dbscan->threads);
+}
+
+/**
+ * Benchmarks the grid clustering against a quadratic DBSCAN, and on the full point set.
+ *
+ * @param bench The benchmark session; bench->count points are clustered, of which the
+ * first BENCH_DBSCAN_NAIVE_POINTS by the quadratic baseline.
+ */
+void
+bench_dbscan (bench_t *bench)
+{
+  bench_dbscan_t bench_dbscan = { 0 };
+  size_t count = bench->count;
+  uint32_t *coordinates = malloc (count * 2U * sizeof (uint32_t));
+  bench_dbscan.points = calloc (count, sizeof (point_t *));
+  bench_dbscan.labels = malloc (count * sizeof (uint32_t));
+  bench_dbscan.queue = malloc (BENCH_DBSCAN_NAIVE_POINTS * sizeof (uint32_t));
+
+  if ((coordinates != NULL) && (bench_dbscan.points != NULL) && (bench_dbscan.labels != NULL) && (bench_dbscan.queue != NULL) && (count > 0U))
+    {
+      /* Blobs of about 24000 points, generated one after the other so the baseline clusters a dense blob */
+      uint32_t blob_side = 2048U;
+      uint32_t blobs = (uint32_t)((count / 24000U) + 1U);
+      uint32_t state = 1U;
+      for (size_t i = 0; i < count; ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          uint32_t blob = (uint32_t)((i * blobs) / count);
+          bool is_noise = ((state >> 4U) % 10U) == 0U;
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = is_noise ? (state >> 8U) : (((blob % 1024U) * 2U * blob_side) + ((state >> 8U) % blob_side));
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[count + i] = is_noise ? (state >> 8U) : (((blob / 1024U) * 2U * blob_side) + ((state >> 8U) % blob_side));
+          bench_dbscan.points[i] = point_create (coordinates[i], coordinates[count + i]);
+        }
+
+      bench_dbscan.batch = (point_batch_t){ coordinates, &coordinates[count], count };
+      bench_dbscan.threads = 1U;
+      bench_dbscan.count = (count < BENCH_DBSCAN_NAIVE_POINTS) ? count : BENCH_DBSCAN_NAIVE_POINTS;
+      bench_run (bench, "dbscan/naive_4096/threads=1", bench_dbscan_naive, &bench_dbscan, bench_dbscan.count);
+      bench_run (bench, "dbscan/batch_4096/threads=1", bench_dbscan_batch_compute, &bench_dbscan, bench_dbscan.count);
+      bench_dbscan.count = count;
+      bench_run (bench, "dbscan/compute/threads=1", bench_dbscan_compute, &bench_dbscan, count);
+      bench_run (bench, "dbscan/batch/threads=1", bench_dbscan_batch_compute, &bench_dbscan, count);
+      bench_dbscan.threads = 0U;
+      bench_run (bench, "dbscan/batch/threads=all", bench_dbscan_batch_compute, &bench_dbscan, count);
+
+      for (size_t i = 0; i < count; ++i)
+        {
+          (void)point_destroy (bench_dbscan.points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the clustering benchmark.\n", count);
+    }
+
+  free (coordinates);
+  free (bench_dbscan.points);
+  free (bench_dbscan.labels);
+  free (bench_dbscan.queue);
+}
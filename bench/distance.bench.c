@@ -0,0 +1,141 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of row points, such as depots, of the distance benchmarks. */
+#define BENCH_DISTANCE_ROWS 256U
+
+/* Upper bound on the number of column points, such as customers, of the distance benchmarks. */
+#define BENCH_DISTANCE_COLUMNS_MAX 16384U
+
+/* Number of closest columns selected per row by the top-k benchmark. */
+#define BENCH_DISTANCE_K 8U
+
+/**
+ * State of the distance benchmarks.
+ */
+typedef struct
+{
+  point_t **rows;
+  point_t **columns;
+  point_batch_t row_batch;
+  point_batch_t column_batch;
+  size_t column_count;
+  uint64_t *matrix;
+  uint32_t *indices;
+  uint32_t threads;
+} bench_distance_t;
+
+/**
+ * Fills the matrix with nested loops over the point accessors, as callers did before the kernel.
+ */
+static void
+bench_distance_naive (void *context)
+{
+  const bench_distance_t *bench_distance = context;
+  for (size_t i = 0; i < BENCH_DISTANCE_ROWS; ++i)
+    {
+      uint32_t x = point_get_x (bench_distance->rows[i]);
+      uint32_t y = point_get_y (bench_distance->rows[i]);
+      for (size_t j = 0; j < bench_distance->column_count; ++j)
+        {
+          int64_t dx = (int64_t)point_get_x (bench_distance->columns[j]) - x;
+          int64_t dy = (int64_t)point_get_y (bench_distance->columns[j]) - y;
+          bench_distance->matrix[(i * bench_distance->column_count) + j] = (uint64_t)(dx * dx) + (uint64_t)(dy * dy);
+        }
+    }
+}
+
+/**
+ * Fills the matrix from the point arrays with the tiled kernel.
+ */
+static void
+bench_distance_matrix (void *context)
+{
+  const bench_distance_t *bench_distance = context;
+  (void)point_distance_matrix_compute (bench_distance->rows, BENCH_DISTANCE_ROWS, bench_distance->columns, bench_distance->column_count,
+                                       bench_distance->matrix, bench_distance->threads);
+}
+
+/**
+ * Fills the matrix from the batches with the tiled kernel.
+ */
+static void
+bench_distance_batch_matrix (void *context)
+{
+  const bench_distance_t *bench_distance = context;
+  (void)point_batch_distance_matrix_compute (&bench_distance->row_batch, &bench_distance->column_batch, bench_distance->matrix,
+                                             bench_distance->threads);
+}
+
+/**
+ * Selects the closest columns of every row from the batches without a matrix.
+ */
+static void
+bench_distance_batch_top_k (void *context)
+{
+  const bench_distance_t *bench_distance = context;
+  (void)point_batch_distance_top_k_compute (&bench_distance->row_batch, &bench_distance->column_batch, BENCH_DISTANCE_K,
+                                            bench_distance->indices, NULL, bench_distance->threads);
+}
+
+/**
+ * Benchmarks the distance matrix and top-k kernels against nested accessor loops.
+ *
+ * @param bench The benchmark session; the columns are at most BENCH_DISTANCE_COLUMNS_MAX
+ * of bench->count points.
+ */
+void
+bench_distance (bench_t *bench)
+{
+  bench_distance_t bench_distance = { 0 };
+  size_t column_count = (bench->count < BENCH_DISTANCE_COLUMNS_MAX) ? bench->count : BENCH_DISTANCE_COLUMNS_MAX;
+  size_t total = BENCH_DISTANCE_ROWS + column_count;
+  uint32_t *coordinates = malloc (total * 2U * sizeof (uint32_t));
+  point_t **points = calloc (total, sizeof (point_t *));
+  bench_distance.matrix = malloc (BENCH_DISTANCE_ROWS * column_count * sizeof (uint64_t));
+  bench_distance.indices = malloc (BENCH_DISTANCE_ROWS * BENCH_DISTANCE_K * sizeof (uint32_t));
+
+  if ((coordinates != NULL) && (points != NULL) && (bench_distance.matrix != NULL) && (bench_distance.indices != NULL) && (column_count > 0U))
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < total; ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = state >> 8U;
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[total + i] = state >> 8U;
+          points[i] = point_create (coordinates[i], coordinates[total + i]);
+        }
+
+      bench_distance.rows = points;
+      bench_distance.columns = &points[BENCH_DISTANCE_ROWS];
+      bench_distance.row_batch = (point_batch_t){ coordinates, &coordinates[total], BENCH_DISTANCE_ROWS };
+      bench_distance.column_batch = (point_batch_t){ &coordinates[BENCH_DISTANCE_ROWS], &coordinates[total + BENCH_DISTANCE_ROWS], column_count };
+      bench_distance.column_count = column_count;
+
+      size_t pairs = BENCH_DISTANCE_ROWS * column_count;
+      bench_distance.threads = 1U;
+      bench_run (bench, "distance/naive/threads=1", bench_distance_naive, &bench_distance, pairs);
+      bench_run (bench, "distance/matrix/threads=1", bench_distance_matrix, &bench_distance, pairs);
+      bench_run (bench, "distance/batch_matrix/threads=1", bench_distance_batch_matrix, &bench_distance, pairs);
+      bench_run (bench, "distance/batch_top_k/threads=1", bench_distance_batch_top_k, &bench_distance, pairs);
+      bench_distance.threads = 0U;
+      bench_run (bench, "distance/batch_matrix/threads=all", bench_distance_batch_matrix, &bench_distance, pairs);
+      bench_run (bench, "distance/batch_top_k/threads=all", bench_distance_batch_top_k, &bench_distance, pairs);
+
+      for (size_t i = 0; i < total; ++i)
+        {
+          (void)point_destroy (points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the distance benchmark.\n", total);
+    }
+
+  free (coordinates);
+  free (points);
+  free (bench_distance.matrix);
+  free (bench_distance.indices);
+}
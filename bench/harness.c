@@ -0,0 +1,294 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_COUNTER_CYCLES PERF_COUNT_HW_CPU_CYCLES
+#define BENCH_COUNTER_CACHE_MISSES PERF_COUNT_HW_CACHE_MISSES
+#else
+#define BENCH_COUNTER_CYCLES 0U
+#define BENCH_COUNTER_CACHE_MISSES 1U
+#endif
+
+/* Number of point allocations made since the allocator was installed. */
+static size_t g_bench_allocations = 0U;
+
+/**
+ * Allocates a point with malloc and counts the allocation.
+ */
+static void *
+bench_alloc (size_t size, void *user_data)
+{
+  (void)user_data;
+  ++g_bench_allocations;
+  return malloc (size);
+}
+
+/**
+ * Releases a point allocated by bench_alloc.
+ */
+static void
+bench_free (void *memory, size_t size, void *user_data)
+{
+  (void)size;
+  (void)user_data;
+  free (memory);
+}
+
+/**
+ * Routes point allocations through the counting allocator of the harness.
+ *
+ * The counter is not synchronized, as points are only created on the benchmark
+ * thread; allocations made internally by the bulk kernels are not counted.
+ *
+ * @return true if the allocator was installed, false otherwise.
+ */
+bool
+bench_install_allocator (void)
+{
+  return point_set_allocator (bench_alloc, bench_free, NULL);
+}
+
+/**
+ * Compares two per-operation sample times for qsort.
+ */
+static int
+bench_compare_samples (const void *a, const void *b)
+{
+  double lhs = *(const double *)a;
+  double rhs = *(const double *)b;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * Returns the nearest-rank percentile of sorted samples.
+ *
+ * @param samples The samples in ascending order.
+ * @param count The number of samples.
+ * @param percentile The percentile, between 0 and 100.
+ */
+static double
+bench_percentile (const double *samples, size_t count, uint32_t percentile)
+{
+  size_t rank = ((count * percentile) + 99U) / 100U;
+  return samples[(rank > 0U) ? (rank - 1U) : 0U];
+}
+
+/**
+ * Opens a hardware counter of the calling thread and the threads it creates.
+ *
+ * @param config The PERF_COUNT_HW_* event to count.
+ *
+ * @return The counter file descriptor, or -1 if counters are unavailable.
+ */
+static int
+bench_counter_open (uint64_t config)
+{
+  int result = -1;
+#ifdef __linux__
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof (attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof (attr);
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  result = (int)syscall (SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+  (void)config;
+#endif
+  return result;
+}
+
+/**
+ * Starts or stops a hardware counter, ignoring unavailable counters.
+ */
+static void
+bench_counter_enable (int counter, bool enable)
+{
+#ifdef __linux__
+  if (counter >= 0)
+    {
+      (void)ioctl (counter, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+    }
+#else
+  (void)counter;
+  (void)enable;
+#endif
+}
+
+/**
+ * Reads and closes a hardware counter.
+ *
+ * @return The counted events, or 0 if the counter is unavailable.
+ */
+static uint64_t
+bench_counter_close (int counter)
+{
+  uint64_t result = 0U;
+#ifdef __linux__
+  if (counter >= 0)
+    {
+      if (read (counter, &result, sizeof (result)) != (ssize_t)sizeof (result))
+        {
+          result = 0U;
+        }
+      (void)close (counter);
+    }
+#else
+  (void)counter;
+#endif
+  return result;
+}
+
+/**
+ * Prints a line to the standard output and to the output file of the session, if any.
+ */
+static void
+bench_emit (const bench_t *bench, const char *line)
+{
+  (void)fputs (line, stdout);
+  if (bench->output != NULL)
+    {
+      (void)fputs (line, bench->output);
+    }
+}
+
+/**
+ * Compares a result against the baseline of the session and counts regressions.
+ *
+ * @param bench The benchmark session.
+ * @param name The name of the benchmark.
+ * @param p50_ns The median time per operation of the current run.
+ */
+static void
+bench_compare (bench_t *bench, const char *name, double p50_ns)
+{
+  for (size_t i = 0; i < bench->baseline_count; ++i)
+    {
+      if (strcmp (bench->baseline[i].name, name) == 0)
+        {
+          double change = ((p50_ns / bench->baseline[i].p50_ns) - 1.0) * 100.0;
+          bool regressed = (change > bench->tolerance);
+          bench->regressions += regressed ? 1U : 0U;
+
+          (void)printf ("compare bench=%s baseline_p50_ns=%.3f p50_ns=%.3f change_pct=%+.2f status=%s\n", name, bench->baseline[i].p50_ns,
+                        p50_ns, change, regressed ? "regressed" : "ok");
+          break;
+        }
+    }
+}
+
+/**
+ * Reads the results of a previous run, as written by the --output option.
+ *
+ * Lines other than result lines are ignored, so the standard output of a previous
+ * run can be used as a baseline as well.
+ *
+ * @param bench The benchmark session receiving the baseline.
+ * @param path The path of the baseline file.
+ *
+ * @return true if the file was read, false if it cannot be opened.
+ */
+bool
+bench_load_baseline (bench_t *bench, const char *path)
+{
+  FILE *file = fopen (path, "r");
+  if (file != NULL)
+    {
+      char line[512];
+      while ((bench->baseline_count < BENCH_MAX_BASELINE) && (fgets (line, sizeof (line), file) != NULL))
+        {
+          bench_baseline_t *entry = &bench->baseline[bench->baseline_count];
+          const char *p50 = strstr (line, " p50_ns=");
+          if ((strncmp (line, "bench=", 6U) == 0) && (p50 != NULL) && (sscanf (line + 6U, "%63s", entry->name) == 1))
+            {
+              entry->p50_ns = strtod (p50 + 8U, NULL);
+              bench->baseline_count += (entry->p50_ns > 0.0) ? 1U : 0U;
+            }
+        }
+      (void)fclose (file);
+    }
+
+  return file != NULL;
+}
+
+/**
+ * Times a benchmark and prints its result line.
+ *
+ * Every sample performs the given number of operations, so the percentiles are
+ * taken over the mean operation time of each sample rather than over single
+ * operations, which would be dominated by the cost of reading the clock.
+ * Allocations are counted through the allocator installed by the session, and
+ * cycles and cache misses are read from the kernel when requested and available.
+ *
+ * @param bench The benchmark session.
+ * @param name The name of the benchmark, without spaces.
+ * @param function The function running one sample.
+ * @param context The context passed to the function.
+ * @param operations The number of operations performed by one sample, at least 1;
+ * benchmarks without operations are reported and skipped, as they have no time per operation.
+ */
+void
+bench_run (bench_t *bench, const char *name, bench_fn function, void *context, size_t operations)
+{
+  if (operations == 0U)
+    {
+      (void)fprintf (stderr, "Error: Benchmark %s performs no operations and is skipped.\n", name);
+    }
+  else if ((bench->filter == NULL) || (strstr (name, bench->filter) != NULL))
+    {
+      double samples[BENCH_SAMPLES];
+      uint64_t total_ns = 0U;
+      int cycles = bench->perf ? bench_counter_open (BENCH_COUNTER_CYCLES) : -1;
+      int cache_misses = bench->perf ? bench_counter_open (BENCH_COUNTER_CACHE_MISSES) : -1;
+
+      function (context);
+      size_t allocations = g_bench_allocations;
+
+      for (uint32_t i = 0; i < BENCH_SAMPLES; ++i)
+        {
+          bench_counter_enable (cycles, true);
+          bench_counter_enable (cache_misses, true);
+          uint64_t start = bench_now_ns ();
+          function (context);
+          uint64_t elapsed = bench_now_ns () - start;
+          bench_counter_enable (cycles, false);
+          bench_counter_enable (cache_misses, false);
+
+          samples[i] = (double)elapsed / (double)operations;
+          total_ns += elapsed;
+        }
+
+      allocations = g_bench_allocations - allocations;
+      qsort (samples, BENCH_SAMPLES, sizeof (double), bench_compare_samples);
+
+      double total_operations = (double)operations * BENCH_SAMPLES;
+      double p50_ns = bench_percentile (samples, BENCH_SAMPLES, 50U);
+      char line[512];
+      int length = snprintf (line, sizeof (line), "bench=%s ops=%zu ns_per_op=%.3f p50_ns=%.3f p90_ns=%.3f p99_ns=%.3f allocs_per_op=%.3f", name,
+                             operations, (double)total_ns / total_operations, p50_ns, bench_percentile (samples, BENCH_SAMPLES, 90U),
+                             bench_percentile (samples, BENCH_SAMPLES, 99U), (double)allocations / total_operations);
+
+      if ((cycles >= 0) && (cache_misses >= 0))
+        {
+          length += snprintf (&line[length], sizeof (line) - (size_t)length, " cycles_per_op=%.2f cache_misses_per_op=%.4f",
+                              (double)bench_counter_close (cycles) / total_operations, (double)bench_counter_close (cache_misses) / total_operations);
+        }
+      else
+        {
+          (void)bench_counter_close (cycles);
+          (void)bench_counter_close (cache_misses);
+        }
+      (void)snprintf (&line[length], sizeof (line) - (size_t)length, "\n");
+
+      bench_emit (bench, line);
+      bench_compare (bench, name, p50_ns);
+    }
+}
@@ -0,0 +1,73 @@
+#include "bench.h"
+#include "library.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Grid layout used by the histogram benchmark: 1024x1024 cells covering the generated points. */
+#define BENCH_HISTOGRAM_SIZE 1024U
+#define BENCH_HISTOGRAM_CELL 977U
+
+/**
+ * State of the histogram benchmark.
+ */
+typedef struct
+{
+  point_batch_t batch;
+  point_grid_t grid;
+  uint32_t *cells;
+  uint32_t threads;
+} bench_histogram_t;
+
+/**
+ * Clears the counters and bins the batch into them.
+ */
+static void
+bench_histogram_batch (void *context)
+{
+  const bench_histogram_t *bench_histogram = context;
+  memset (bench_histogram->cells, 0, (size_t)BENCH_HISTOGRAM_SIZE * BENCH_HISTOGRAM_SIZE * sizeof (uint32_t));
+  (void)point_batch_histogram_compute (&bench_histogram->batch, &bench_histogram->grid, bench_histogram->cells, bench_histogram->threads);
+}
+
+/**
+ * Benchmarks binning uniformly distributed points into a 1024x1024 histogram.
+ *
+ * @param bench The benchmark session; bench->count points are binned.
+ */
+void
+bench_histogram (bench_t *bench)
+{
+  size_t count = bench->count;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  uint32_t *cells = malloc ((size_t)BENCH_HISTOGRAM_SIZE * BENCH_HISTOGRAM_SIZE * sizeof (uint32_t));
+
+  if ((x != NULL) && (y != NULL) && (cells != NULL))
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < count; ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          x[i] = state % (BENCH_HISTOGRAM_SIZE * BENCH_HISTOGRAM_CELL);
+          state = (state * 1664525U) + 1013904223U;
+          y[i] = state % (BENCH_HISTOGRAM_SIZE * BENCH_HISTOGRAM_CELL);
+        }
+
+      bench_histogram_t bench_histogram = {
+        { x, y, count }, { 0U, 0U, BENCH_HISTOGRAM_CELL, BENCH_HISTOGRAM_CELL, BENCH_HISTOGRAM_SIZE, BENCH_HISTOGRAM_SIZE }, cells, 1U
+      };
+
+      bench_run (bench, "histogram/batch/threads=1", bench_histogram_batch, &bench_histogram, count);
+      bench_histogram.threads = 0U;
+      bench_run (bench, "histogram/batch/threads=all", bench_histogram_batch, &bench_histogram, count);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the histogram benchmark.\n", count);
+    }
+
+  free (x);
+  free (y);
+  free (cells);
+}
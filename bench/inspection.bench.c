@@ -0,0 +1,155 @@
+#include "bench.h"
+#include "inspection.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Number of API functions of the generated library, within the limits of the inspection. */
+#define BENCH_INSPECTION_FUNCTIONS 256U
+
+/* Maximum length of the paths of the generated library. */
+#define BENCH_INSPECTION_LENGTH_PATH 256U
+
+/**
+ * State of the inspection benchmark.
+ */
+typedef struct
+{
+  char root[BENCH_INSPECTION_LENGTH_PATH];
+  inspection_t *inspection;
+} bench_inspection_t;
+
+/**
+ * The files of the generated library, relative to its root.
+ */
+static const char *const g_bench_inspection_files[] = { "include/library.h", "src/library.c", "test/library.test.c" };
+
+/**
+ * Writes one file of the generated library, formatted like the sources of this
+ * repository: documented functions with numbers, strings and directives.
+ *
+ * @return The number of bytes written, or 0 if the file could not be written.
+ */
+static size_t
+bench_inspection_write (const char *root, uint32_t file_index)
+{
+  size_t result = 0;
+  char path[BENCH_INSPECTION_LENGTH_PATH * 2U];
+  (void)snprintf (path, sizeof (path), "%s/%s", root, g_bench_inspection_files[file_index]);
+
+  FILE *file = fopen (path, "w");
+  if (file != NULL)
+    {
+      int length = fprintf (file, (file_index == 0U) ? "#define API\n#include <stddef.h>\n#include <stdint.h>\n\n" : "#include \"library.h\"\n\n");
+      result += (length > 0) ? (size_t)length : 0U;
+
+      for (uint32_t i = 0; i < BENCH_INSPECTION_FUNCTIONS; ++i)
+        {
+          if (file_index == 0U)
+            {
+              length = fprintf (file, "API uint32_t bench_function_%u (const uint32_t *values, size_t count, uint32_t seed);\n", i);
+            }
+          else if (file_index == 1U)
+            {
+              length = fprintf (file,
+                                "/**\n * @brief Fold the values with the multiplier %u.\n *\n * @param values The values to fold.\n"
+                                " * @param count The number of values.\n * @param seed The initial state.\n *\n"
+                                " * @return The folded state, or the seed if the values are NULL.\n */\n"
+                                "uint32_t\nbench_function_%u (const uint32_t *values, size_t count, uint32_t seed)\n{\n"
+                                "  uint32_t result = seed;\n  for (size_t i = 0; (values != NULL) && (i < count); ++i)\n    {\n"
+                                "      /* Mix the value into the state */\n      result = (result * %uU) + values[i] + 0x9E3779B9U;\n"
+                                "    }\n\n#ifdef BENCH_TRACE\n  (void)printf (\"bench_function_%u: %%u\\n\", result);\n#endif\n\n"
+                                "  return result;\n}\n\n",
+                                i, i, (i * 2U) + 1U, i);
+            }
+          else
+            {
+              length = fprintf (file,
+                                "CLOVE_TEST (bench_function_%u)\n{\n  uint32_t values[3] = { 1U, 2U, %uU };\n"
+                                "  CLOVE_UINT_EQ (%uU, bench_function_%u (values, 3U, 0U));\n"
+                                "  CLOVE_UINT_EQ (7U, bench_function_%u (NULL, 3U, 7U));\n}\n\n",
+                                i, i, i, i, i);
+            }
+          result += (length > 0) ? (size_t)length : 0U;
+        }
+
+      result = (fclose (file) == 0) ? result : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * Removes the generated library.
+ */
+static void
+bench_inspection_remove (const char *root)
+{
+  char path[BENCH_INSPECTION_LENGTH_PATH * 2U];
+  for (uint32_t i = 0; i < (sizeof (g_bench_inspection_files) / sizeof (g_bench_inspection_files[0])); ++i)
+    {
+      (void)snprintf (path, sizeof (path), "%s/%s", root, g_bench_inspection_files[i]);
+      (void)unlink (path);
+      *strrchr (path, '/') = '\0';
+      (void)rmdir (path);
+    }
+  (void)rmdir (root);
+}
+
+/**
+ * Loads every file of the library, as the checks of a full inspection do.
+ */
+static void
+bench_inspection_load (void *context)
+{
+  bench_inspection_t *bench_inspection = context;
+  (void)inspection_load (bench_inspection->inspection);
+  for (uint32_t report = 0; report < INSPECTION_REPORT_COUNT; ++report)
+    {
+      (void)inspection_prepare (bench_inspection->inspection, (inspection_report_t)report);
+    }
+}
+
+/**
+ * Benchmarks the inspection of a generated library of BENCH_INSPECTION_FUNCTIONS
+ * documented and tested functions, per byte of its files. Lexing, with the interning
+ * of identifiers and punctuators, is the largest part of the inspection, so this
+ * tracks the throughput of the lexer.
+ *
+ * @param bench The benchmark session.
+ */
+void
+bench_inspection (bench_t *bench)
+{
+  bench_inspection_t bench_inspection = { "/tmp/LibraryBenchInspectionXXXXXX", NULL };
+  size_t size = 0;
+
+  if (mkdtemp (bench_inspection.root) != NULL)
+    {
+      for (uint32_t i = 0; i < (sizeof (g_bench_inspection_files) / sizeof (g_bench_inspection_files[0])); ++i)
+        {
+          char directory[BENCH_INSPECTION_LENGTH_PATH * 2U];
+          (void)snprintf (directory, sizeof (directory), "%s/%s", bench_inspection.root, g_bench_inspection_files[i]);
+          *strrchr (directory, '/') = '\0';
+          (void)mkdir (directory, 0700);
+          size = (size > 0U) || (i == 0U) ? (size + bench_inspection_write (bench_inspection.root, i)) : 0U;
+        }
+
+      inspection_config_t config = { 0 };
+      inspection_config_init (&config, bench_inspection.root);
+      bench_inspection.inspection = inspection_create (&config);
+    }
+
+  if ((bench_inspection.inspection != NULL) && (size > 0U))
+    {
+      bench_run (bench, "inspection/load", bench_inspection_load, &bench_inspection, size);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to generate a library for the inspection benchmark.\n");
+    }
+
+  inspection_destroy (bench_inspection.inspection);
+  bench_inspection_remove (bench_inspection.root);
+}
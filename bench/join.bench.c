@@ -0,0 +1,168 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Upper bound on the number of points of each side of the join benchmarks. */
+#define BENCH_JOIN_POINTS_MAX 1048576U
+
+/* Number of points of each side joined by the quadratic baseline, and by the grid on the same points. */
+#define BENCH_JOIN_NAIVE_POINTS 4096U
+
+/* Side of the square the points are scattered over. */
+#define BENCH_JOIN_EXTENT (1U << 20U)
+
+/**
+ * State of the join benchmarks.
+ */
+typedef struct
+{
+  point_t **left;
+  point_t **right;
+  point_batch_t left_batch;
+  point_batch_t right_batch;
+  size_t count;
+  uint32_t distance;
+  size_t matches;
+  uint32_t threads;
+} bench_join_t;
+
+/**
+ * Counts the delivered matches.
+ */
+static bool
+bench_join_count (void *context, const uint32_t *left, const uint32_t *right, size_t count)
+{
+  (void)left;
+  (void)right;
+  bench_join_t *bench_join = context;
+  bench_join->matches += count;
+  return true;
+}
+
+/**
+ * Returns the distance giving about two matches per left point among count right points,
+ * which needs pi * distance^2 * count / extent^2 = 2.
+ */
+static uint32_t
+bench_join_distance (size_t count)
+{
+  size_t root = 1U;
+  while ((root * root) < count)
+    {
+      ++root;
+    }
+
+  return (uint32_t)((BENCH_JOIN_EXTENT / 5U) * 4U / root);
+}
+
+/**
+ * Joins the points with nested loops over the point accessors, as callers did before the grid.
+ */
+static void
+bench_join_naive (void *context)
+{
+  bench_join_t *bench_join = context;
+  uint32_t left[1];
+  uint32_t right[1];
+  uint64_t distance_squared = (uint64_t)bench_join->distance * bench_join->distance;
+
+  for (size_t i = 0; i < bench_join->count; ++i)
+    {
+      for (size_t j = 0; j < bench_join->count; ++j)
+        {
+          int64_t dx = (int64_t)point_get_x (bench_join->left[i]) - point_get_x (bench_join->right[j]);
+          int64_t dy = (int64_t)point_get_y (bench_join->left[i]) - point_get_y (bench_join->right[j]);
+          if ((uint64_t)((dx * dx) + (dy * dy)) <= distance_squared)
+            {
+              left[0] = (uint32_t)i;
+              right[0] = (uint32_t)j;
+              (void)bench_join_count (bench_join, left, right, 1U);
+            }
+        }
+    }
+}
+
+/**
+ * Joins the point arrays with the grid.
+ */
+static void
+bench_join_compute (void *context)
+{
+  bench_join_t *bench_join = context;
+  (void)point_join_compute (bench_join->left, bench_join->count, bench_join->right, bench_join->count, bench_join->distance, bench_join_count,
+                            bench_join, bench_join->threads);
+}
+
+/**
+ * Joins the batches with the grid.
+ */
+static void
+bench_join_batch_compute (void *context)
+{
+  bench_join_t *bench_join = context;
+  point_batch_t left = { bench_join->left_batch.x, bench_join->left_batch.y, bench_join->count };
+  point_batch_t right = { bench_join->right_batch.x, bench_join->right_batch.y, bench_join->count };
+  (void)point_batch_join_compute (&left, &right, bench_join->distance, bench_join_count, bench_join, bench_join->threads);
+}
+
+/**
+ * Benchmarks the spatial join against nested accessor loops, and at full scale.
+ *
+ * The distance keeps about two matches per left point at every size, as when joining
+ * pickups with the drop-offs near them. The naive baseline joins the first points of
+ * the full sets, which are spread over the same extent, so the distance grows with it.
+ *
+ * @param bench The benchmark session; each side holds at most BENCH_JOIN_POINTS_MAX of
+ * bench->count points, of which the first BENCH_JOIN_NAIVE_POINTS are joined by the baseline.
+ */
+void
+bench_join (bench_t *bench)
+{
+  bench_join_t bench_join = { 0 };
+  size_t count = (bench->count < BENCH_JOIN_POINTS_MAX) ? bench->count : BENCH_JOIN_POINTS_MAX;
+  uint32_t *coordinates = malloc (count * 4U * sizeof (uint32_t));
+  point_t **points = calloc (count * 2U, sizeof (point_t *));
+
+  if ((coordinates != NULL) && (points != NULL) && (count > 0U))
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < (count * 2U); ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = (state >> 8U) % BENCH_JOIN_EXTENT;
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[(count * 2U) + i] = (state >> 8U) % BENCH_JOIN_EXTENT;
+          points[i] = point_create (coordinates[i], coordinates[(count * 2U) + i]);
+        }
+
+      bench_join.left = points;
+      bench_join.right = &points[count];
+      bench_join.left_batch = (point_batch_t){ coordinates, &coordinates[count * 2U], count };
+      bench_join.right_batch = (point_batch_t){ &coordinates[count], &coordinates[count * 3U], count };
+      bench_join.threads = 1U;
+
+      bench_join.count = (count < BENCH_JOIN_NAIVE_POINTS) ? count : BENCH_JOIN_NAIVE_POINTS;
+      bench_join.distance = bench_join_distance (bench_join.count);
+      bench_run (bench, "join/naive_4096/threads=1", bench_join_naive, &bench_join, bench_join.count);
+      bench_run (bench, "join/batch_4096/threads=1", bench_join_batch_compute, &bench_join, bench_join.count);
+
+      bench_join.count = count;
+      bench_join.distance = bench_join_distance (count);
+      bench_run (bench, "join/compute/threads=1", bench_join_compute, &bench_join, count);
+      bench_run (bench, "join/batch/threads=1", bench_join_batch_compute, &bench_join, count);
+      bench_join.threads = 0U;
+      bench_run (bench, "join/batch/threads=all", bench_join_batch_compute, &bench_join, count);
+
+      for (size_t i = 0; i < (count * 2U); ++i)
+        {
+          (void)point_destroy (points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the join benchmark.\n", count * 2U);
+    }
+
+  free (coordinates);
+  free (points);
+}
@@ -0,0 +1,114 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Default number of points processed by the bulk benchmarks. */
+#define BENCH_DEFAULT_COUNT 10000000U
+
+/* Default slowdown of the median, in percent, tolerated against a baseline. */
+#define BENCH_DEFAULT_TOLERANCE 10.0
+
+/**
+ * Prints the command line usage.
+ */
+static void
+bench_usage (const char *program)
+{
+  (void)fprintf (stderr,
+                 "Usage: %s [count] [--count N] [--filter TEXT] [--perf] [--output FILE] [--baseline FILE] [--tolerance PERCENT]\n"
+                 "  --filter     Run only the benchmarks whose name contains TEXT.\n"
+                 "  --perf       Report cycles and cache misses per operation where the kernel allows it.\n"
+                 "  --output     Also write the result lines to FILE, for use as a later baseline.\n"
+                 "  --baseline   Compare the median time per operation against a previous output.\n"
+                 "  --tolerance  Slowdown in percent reported as a regression (default %.0f).\n"
+                 "The exit status is 1 if a benchmark regressed against the baseline.\n",
+                 program, BENCH_DEFAULT_TOLERANCE);
+}
+
+int
+main (int argc, char *argv[])
+{
+  int result = 0;
+  bench_t *bench = calloc (1U, sizeof (bench_t));
+  if (bench == NULL)
+    {
+      return 2;
+    }
+
+  bench->count = BENCH_DEFAULT_COUNT;
+  bench->tolerance = BENCH_DEFAULT_TOLERANCE;
+
+  for (int i = 1; (i < argc) && (result == 0); ++i)
+    {
+      bool has_value = (i + 1) < argc;
+      if ((strcmp (argv[i], "--count") == 0) && has_value)
+        {
+          bench->count = (size_t)strtoull (argv[++i], NULL, 10);
+        }
+      else if ((strcmp (argv[i], "--filter") == 0) && has_value)
+        {
+          bench->filter = argv[++i];
+        }
+      else if (strcmp (argv[i], "--perf") == 0)
+        {
+          bench->perf = true;
+        }
+      else if ((strcmp (argv[i], "--output") == 0) && has_value)
+        {
+          bench->output = fopen (argv[++i], "w");
+          result = (bench->output != NULL) ? 0 : 2;
+        }
+      else if ((strcmp (argv[i], "--baseline") == 0) && has_value)
+        {
+          result = bench_load_baseline (bench, argv[++i]) ? 0 : 2;
+        }
+      else if ((strcmp (argv[i], "--tolerance") == 0) && has_value)
+        {
+          bench->tolerance = strtod (argv[++i], NULL);
+        }
+      else if ((argv[i][0] >= '0') && (argv[i][0] <= '9'))
+        {
+          bench->count = (size_t)strtoull (argv[i], NULL, 10);
+        }
+      else
+        {
+          result = 2;
+        }
+    }
+
+  if (result == 0)
+    {
+      if (!bench_install_allocator ())
+        {
+          (void)fprintf (stderr, "Warning: Point allocations are not counted.\n");
+        }
+
+      bench_point (bench);
+      bench_bbox (bench);
+      bench_histogram (bench);
+      bench_transform (bench);
+      bench_distance (bench);
+      bench_pool (bench);
+      bench_polygon (bench);
+      bench_dbscan (bench);
+      bench_join (bench);
+      bench_compact (bench);
+      bench_types (bench);
+      bench_arena (bench);
+      bench_inspection (bench);
+
+      result = (bench->regressions > 0U) ? 1 : 0;
+    }
+  else
+    {
+      bench_usage (argv[0]);
+    }
+
+  if (bench->output != NULL)
+    {
+      (void)fclose (bench->output);
+    }
+  free (bench);
+
+  return result;
+}
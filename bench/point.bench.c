@@ -0,0 +1,123 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of operations per sample of the point benchmarks; the points stay cache resident. */
+#define BENCH_POINT_OPERATIONS 4096U
+
+/**
+ * State of the point benchmarks.
+ */
+typedef struct
+{
+  point_t *points[BENCH_POINT_OPERATIONS];
+  point_value_t values[BENCH_POINT_OPERATIONS];
+  uint64_t sink;
+} bench_point_t;
+
+/**
+ * Creates and immediately destroys one point per operation.
+ */
+static void
+bench_point_create_destroy (void *context)
+{
+  (void)context;
+  for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+    {
+      (void)point_destroy (point_create (i, i));
+    }
+}
+
+/**
+ * Creates all points of a sample before destroying them, so many points are live at once.
+ */
+static void
+bench_point_create_bulk (void *context)
+{
+  bench_point_t *bench_point = context;
+  for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+    {
+      bench_point->points[i] = point_create (i, i);
+    }
+  for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+    {
+      (void)point_destroy (bench_point->points[i]);
+    }
+}
+
+/**
+ * Reads both coordinates of every point.
+ */
+static void
+bench_point_get (void *context)
+{
+  bench_point_t *bench_point = context;
+  uint64_t sum = 0U;
+  for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+    {
+      sum += point_get_x (bench_point->points[i]) + point_get_y (bench_point->points[i]);
+    }
+  bench_point->sink += sum;
+}
+
+/**
+ * Makes one point value per operation, the by-value counterpart of creating a point.
+ */
+static void
+bench_point_value_make (void *context)
+{
+  bench_point_t *bench_point = context;
+  for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+    {
+      bench_point->values[i] = point_value_make (i, i);
+    }
+}
+
+/**
+ * Reads both coordinates of every point value.
+ */
+static void
+bench_point_value_get (void *context)
+{
+  bench_point_t *bench_point = context;
+  uint64_t sum = 0U;
+  for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+    {
+      sum += point_value_get_x (bench_point->values[i]) + point_value_get_y (bench_point->values[i]);
+    }
+  bench_point->sink += sum;
+}
+
+/**
+ * Benchmarks the lifetime and accessor functions of single points and point values.
+ *
+ * @param bench The benchmark session.
+ */
+void
+bench_point (bench_t *bench)
+{
+  bench_point_t *bench_point = calloc (1U, sizeof (bench_point_t));
+  if (bench_point != NULL)
+    {
+      bench_run (bench, "point/create_destroy", bench_point_create_destroy, bench_point, BENCH_POINT_OPERATIONS);
+      bench_run (bench, "point/create_bulk", bench_point_create_bulk, bench_point, BENCH_POINT_OPERATIONS);
+
+      for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+        {
+          bench_point->points[i] = point_create (i, BENCH_POINT_OPERATIONS - i);
+        }
+      bench_run (bench, "point/get_xy", bench_point_get, bench_point, BENCH_POINT_OPERATIONS);
+      bench_run (bench, "point/value_make", bench_point_value_make, bench_point, BENCH_POINT_OPERATIONS);
+      bench_run (bench, "point/value_get_xy", bench_point_value_get, bench_point, BENCH_POINT_OPERATIONS);
+      for (uint32_t i = 0; i < BENCH_POINT_OPERATIONS; ++i)
+        {
+          (void)point_destroy (bench_point->points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate the point benchmark state.\n");
+    }
+
+  free (bench_point);
+}
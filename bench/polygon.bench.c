@@ -0,0 +1,190 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Upper bound on the number of points tested by the polygon benchmarks. */
+#define BENCH_POLYGON_POINTS_MAX 1048576U
+
+/* Number of vertices of the tested polygons. */
+#define BENCH_POLYGON_VERTICES 256U
+
+/* Number of polygons, on a square grid, among which the points are located. */
+#define BENCH_POLYGON_FENCES 1024U
+
+/**
+ * State of the polygon benchmarks.
+ */
+typedef struct
+{
+  point_value_t vertices[BENCH_POLYGON_VERTICES];
+  point_polygon_t *polygon;
+  point_polygon_t *fences[BENCH_POLYGON_FENCES];
+  point_t **points;
+  point_batch_t batch;
+  uint64_t *bitmap;
+  uint32_t *indices;
+  size_t count;
+  uint32_t threads;
+} bench_polygon_t;
+
+/**
+ * Fills a ring with a circle-like polygon of the given center and radius, with every
+ * other vertex pulled inwards.
+ */
+static void
+bench_polygon_fill (point_value_t *vertices, uint32_t center_x, uint32_t center_y, uint32_t radius)
+{
+  /* The vertices walk a square ring, which keeps the coordinates integral without libm */
+  for (uint32_t i = 0; i < BENCH_POLYGON_VERTICES; ++i)
+    {
+      uint32_t length = ((i % 2U) == 0U) ? radius : ((radius * 15U) / 16U);
+      uint32_t side = (i * 4U) / BENCH_POLYGON_VERTICES;
+      int64_t step = (int64_t)(((i * 4U) % BENCH_POLYGON_VERTICES) * 2U * (uint64_t)length / BENCH_POLYGON_VERTICES) - length;
+      int64_t x = (side == 0U) ? length : ((side == 1U) ? -step : ((side == 2U) ? -(int64_t)length : step));
+      int64_t y = (side == 0U) ? step : ((side == 1U) ? length : ((side == 2U) ? -step : -(int64_t)length));
+      vertices[i] = (point_value_t){ (uint32_t)(center_x + x), (uint32_t)(center_y + y) };
+    }
+}
+
+/**
+ * Tests the points with a crossing-number loop over all vertices through the point accessors,
+ * as callers did before prepared polygons.
+ */
+static void
+bench_polygon_naive (void *context)
+{
+  bench_polygon_t *bench_polygon = context;
+  const point_value_t *vertices = bench_polygon->vertices;
+  for (size_t i = 0; i < bench_polygon->count; ++i)
+    {
+      double px = (double)point_get_x (bench_polygon->points[i]);
+      double py = (double)point_get_y (bench_polygon->points[i]);
+      bool is_inside = false;
+      for (size_t v = 0, u = BENCH_POLYGON_VERTICES - 1U; v < BENCH_POLYGON_VERTICES; u = v++)
+        {
+          double vx = vertices[v].x;
+          double vy = vertices[v].y;
+          double ux = vertices[u].x;
+          double uy = vertices[u].y;
+          if (((vy > py) != (uy > py)) && (px < (((ux - vx) * (py - vy)) / (uy - vy)) + vx))
+            {
+              is_inside = !is_inside;
+            }
+        }
+      bench_polygon->bitmap[i / 64U] = (bench_polygon->bitmap[i / 64U] & ~((uint64_t)1U << (i % 64U))) | ((uint64_t)is_inside << (i % 64U));
+    }
+}
+
+/**
+ * Tests the points of the array against the prepared polygon.
+ */
+static void
+bench_polygon_test (void *context)
+{
+  const bench_polygon_t *bench_polygon = context;
+  (void)point_polygon_test (bench_polygon->polygon, bench_polygon->points, bench_polygon->count, bench_polygon->bitmap, bench_polygon->threads);
+}
+
+/**
+ * Tests the points of the batch against the prepared polygon.
+ */
+static void
+bench_polygon_batch_test (void *context)
+{
+  const bench_polygon_t *bench_polygon = context;
+  (void)point_batch_polygon_test (bench_polygon->polygon, &bench_polygon->batch, bench_polygon->bitmap, bench_polygon->threads);
+}
+
+/**
+ * Locates the points of the batch among the fences.
+ */
+static void
+bench_polygon_batch_locate (void *context)
+{
+  const bench_polygon_t *bench_polygon = context;
+  (void)point_batch_polygon_locate (bench_polygon->fences, BENCH_POLYGON_FENCES, &bench_polygon->batch, bench_polygon->indices,
+                                    bench_polygon->threads);
+}
+
+/**
+ * Benchmarks prepared polygons against a naive crossing-number loop, and locating
+ * points among many polygons.
+ *
+ * @param bench The benchmark session; at most BENCH_POLYGON_POINTS_MAX of bench->count points are tested.
+ */
+void
+bench_polygon (bench_t *bench)
+{
+  bench_polygon_t *bench_polygon = calloc (1U, sizeof (bench_polygon_t));
+  size_t count = (bench->count < BENCH_POLYGON_POINTS_MAX) ? bench->count : BENCH_POLYGON_POINTS_MAX;
+  uint32_t *coordinates = malloc (count * 2U * sizeof (uint32_t));
+
+  bool is_valid = (bench_polygon != NULL) && (coordinates != NULL) && (count > 0U);
+  if (is_valid)
+    {
+      bench_polygon->points = calloc (count, sizeof (point_t *));
+      bench_polygon->bitmap = calloc ((count + 63U) / 64U, sizeof (uint64_t));
+      bench_polygon->indices = malloc (count * sizeof (uint32_t));
+      bench_polygon_fill (bench_polygon->vertices, 1U << 23U, 1U << 23U, 1U << 22U);
+      bench_polygon->polygon = point_polygon_create (bench_polygon->vertices, BENCH_POLYGON_VERTICES);
+      is_valid = (bench_polygon->points != NULL) && (bench_polygon->bitmap != NULL) && (bench_polygon->indices != NULL)
+                 && (bench_polygon->polygon != NULL);
+
+      /* The fences tile the plane of the points, 32 by 32, touching at their long vertices */
+      for (uint32_t i = 0; is_valid && (i < BENCH_POLYGON_FENCES); ++i)
+        {
+          point_value_t vertices[BENCH_POLYGON_VERTICES];
+          bench_polygon_fill (vertices, ((i % 32U) * (1U << 19U)) + (1U << 18U), ((i / 32U) * (1U << 19U)) + (1U << 18U), 1U << 18U);
+          bench_polygon->fences[i] = point_polygon_create (vertices, BENCH_POLYGON_VERTICES);
+          is_valid = (bench_polygon->fences[i] != NULL);
+        }
+    }
+
+  if (is_valid)
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < (count * 2U); ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = state >> 8U;
+        }
+      for (size_t i = 0; i < count; ++i)
+        {
+          bench_polygon->points[i] = point_create (coordinates[i], coordinates[count + i]);
+        }
+
+      bench_polygon->batch = (point_batch_t){ coordinates, &coordinates[count], count };
+      bench_polygon->count = count;
+      bench_polygon->threads = 1U;
+      bench_run (bench, "polygon/naive/threads=1", bench_polygon_naive, bench_polygon, count);
+      bench_run (bench, "polygon/test/threads=1", bench_polygon_test, bench_polygon, count);
+      bench_run (bench, "polygon/batch_test/threads=1", bench_polygon_batch_test, bench_polygon, count);
+      bench_run (bench, "polygon/batch_locate_1024/threads=1", bench_polygon_batch_locate, bench_polygon, count);
+      bench_polygon->threads = 0U;
+      bench_run (bench, "polygon/batch_test/threads=all", bench_polygon_batch_test, bench_polygon, count);
+      bench_run (bench, "polygon/batch_locate_1024/threads=all", bench_polygon_batch_locate, bench_polygon, count);
+
+      for (size_t i = 0; i < count; ++i)
+        {
+          (void)point_destroy (bench_polygon->points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the polygon benchmark.\n", count);
+    }
+
+  if (bench_polygon != NULL)
+    {
+      (void)point_polygon_destroy (bench_polygon->polygon);
+      for (uint32_t i = 0; i < BENCH_POLYGON_FENCES; ++i)
+        {
+          (void)point_polygon_destroy (bench_polygon->fences[i]);
+        }
+      free (bench_polygon->points);
+      free (bench_polygon->bitmap);
+      free (bench_polygon->indices);
+    }
+  free (bench_polygon);
+  free (coordinates);
+}
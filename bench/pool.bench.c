@@ -0,0 +1,183 @@
+#include "bench.h"
+#include "library.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/* Number of dispatches timed per sample of the dispatch benchmarks. */
+#define BENCH_POOL_ROUNDS 1000U
+
+/* Number of elements of every dispatched loop, small enough for dispatch to dominate. */
+#define BENCH_POOL_LOOP 4096U
+
+/* Number of threads of both the pool and the spawning baseline. */
+#define BENCH_POOL_THREADS 4U
+
+/**
+ * State of the thread pool benchmarks.
+ */
+typedef struct
+{
+  uint32_t *values;
+  size_t count;
+  uint32_t threads;
+} bench_pool_t;
+
+/**
+ * Slice of a loop run by a thread of the spawning baseline.
+ */
+typedef struct
+{
+  uint32_t *values;
+  size_t begin;
+  size_t end;
+} bench_pool_slice_t;
+
+/**
+ * Increments every element of a chunk.
+ */
+static void
+bench_pool_body (void *context, size_t begin, size_t end)
+{
+  uint32_t *values = context;
+  for (size_t i = begin; i < end; ++i)
+    {
+      values[i] += 1U;
+    }
+}
+
+/**
+ * Performs work proportional to the index of every element of a chunk.
+ */
+static void
+bench_pool_skewed_body (void *context, size_t begin, size_t end)
+{
+  uint32_t *values = context;
+  for (size_t i = begin; i < end; ++i)
+    {
+      uint32_t state = values[i];
+      for (size_t j = 0; j < (i / 64U); ++j)
+        {
+          state = (state * 1664525U) + 1013904223U;
+        }
+      values[i] = state;
+    }
+}
+
+/**
+ * Task doing nothing, so that submitting and waiting dominate.
+ */
+static void
+bench_pool_noop (void *context)
+{
+  (void)context;
+}
+
+/**
+ * Entry point of a thread of the spawning baseline.
+ */
+static void *
+bench_pool_thread_main (void *argument)
+{
+  const bench_pool_slice_t *slice = argument;
+  bench_pool_body (slice->values, slice->begin, slice->end);
+  return NULL;
+}
+
+/**
+ * Runs small loops on threads started for every loop, as parallel kernels did before the pool.
+ */
+static void
+bench_pool_spawn (void *context)
+{
+  const bench_pool_t *bench_pool = context;
+  pthread_t threads[BENCH_POOL_THREADS];
+  bench_pool_slice_t slices[BENCH_POOL_THREADS];
+  uint32_t count = bench_pool->threads;
+
+  for (uint32_t round = 0; round < BENCH_POOL_ROUNDS; ++round)
+    {
+      for (uint32_t i = 0; i < count; ++i)
+        {
+          slices[i] = (bench_pool_slice_t){ bench_pool->values, (BENCH_POOL_LOOP * i) / count, (BENCH_POOL_LOOP * (i + 1U)) / count };
+          if ((i > 0U) && (pthread_create (&threads[i], NULL, bench_pool_thread_main, &slices[i]) != 0))
+            {
+              slices[i].end = slices[i].begin;
+            }
+        }
+      bench_pool_body (bench_pool->values, slices[0].begin, slices[0].end);
+      for (uint32_t i = 1; i < count; ++i)
+        {
+          if (slices[i].end > slices[i].begin)
+            {
+              (void)pthread_join (threads[i], NULL);
+            }
+        }
+    }
+}
+
+/**
+ * Runs small loops on the thread pool.
+ */
+static void
+bench_pool_dispatch (void *context)
+{
+  const bench_pool_t *bench_pool = context;
+  for (uint32_t round = 0; round < BENCH_POOL_ROUNDS; ++round)
+    {
+      (void)point_parallel_for (BENCH_POOL_LOOP, 0U, bench_pool_body, bench_pool->values);
+    }
+}
+
+/**
+ * Submits empty tasks and waits for every one of them.
+ */
+static void
+bench_pool_task (void *context)
+{
+  (void)context;
+  for (uint32_t round = 0; round < BENCH_POOL_ROUNDS; ++round)
+    {
+      (void)point_future_wait (point_task_submit (bench_pool_noop, NULL));
+    }
+}
+
+/**
+ * Runs a loop whose cost grows with the index, so that work stealing must balance it.
+ */
+static void
+bench_pool_skewed (void *context)
+{
+  const bench_pool_t *bench_pool = context;
+  (void)point_parallel_for (bench_pool->count, 1024U, bench_pool_skewed_body, bench_pool->values);
+}
+
+/**
+ * Benchmarks the dispatch overhead and the load balancing of the thread pool.
+ *
+ * @param bench The benchmark session; the skewed loop covers bench->count / 64 elements.
+ */
+void
+bench_pool (bench_t *bench)
+{
+  bench_pool_t bench_pool = { 0 };
+  (void)point_pool_configure (BENCH_POOL_THREADS, false);
+  bench_pool.count = bench->count / 64U;
+  bench_pool.count = (bench_pool.count > BENCH_POOL_LOOP) ? bench_pool.count : BENCH_POOL_LOOP;
+  bench_pool.values = calloc (bench_pool.count, sizeof (uint32_t));
+  bench_pool.threads = BENCH_POOL_THREADS;
+
+  if (bench_pool.values != NULL)
+    {
+      bench_run (bench, "pool/spawn_loop", bench_pool_spawn, &bench_pool, BENCH_POOL_ROUNDS);
+      bench_run (bench, "pool/parallel_for_loop", bench_pool_dispatch, &bench_pool, BENCH_POOL_ROUNDS);
+      bench_run (bench, "pool/task_roundtrip", bench_pool_task, &bench_pool, BENCH_POOL_ROUNDS);
+      bench_run (bench, "pool/parallel_for_skewed", bench_pool_skewed, &bench_pool, bench_pool.count);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu elements for the pool benchmark.\n", bench_pool.count);
+    }
+
+  (void)point_pool_configure (0U, false);
+  free (bench_pool.values);
+}
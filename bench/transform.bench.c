@@ -0,0 +1,149 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Upper bound on the number of individually allocated points of the array benchmark. */
+#define BENCH_TRANSFORM_ARRAY_MAX 1048576U
+
+/* Number of operations of the benchmarked chain: translate, scale, clamp and quantize. */
+#define BENCH_TRANSFORM_STEPS 4U
+
+/**
+ * State of the transform benchmarks.
+ */
+typedef struct
+{
+  point_transform_t *chain;
+  point_transform_t *steps[BENCH_TRANSFORM_STEPS];
+  point_batch_t batch;
+  point_batch_t output;
+  point_t **points;
+  point_value_t *values;
+  size_t point_count;
+  uint32_t threads;
+} bench_transform_t;
+
+/**
+ * Applies the whole chain to the batch in one fused pass.
+ */
+static void
+bench_transform_batch_fused (void *context)
+{
+  const bench_transform_t *bench_transform = context;
+  (void)point_batch_transform_apply (bench_transform->chain, &bench_transform->batch, &bench_transform->output, bench_transform->threads);
+}
+
+/**
+ * Applies the operations of the chain to the batch one pass at a time, as separate transforms.
+ */
+static void
+bench_transform_batch_stepwise (void *context)
+{
+  const bench_transform_t *bench_transform = context;
+  (void)point_batch_transform_apply (bench_transform->steps[0], &bench_transform->batch, &bench_transform->output, bench_transform->threads);
+  for (uint32_t i = 1; i < BENCH_TRANSFORM_STEPS; ++i)
+    {
+      (void)point_batch_transform_apply (bench_transform->steps[i], &bench_transform->output, &bench_transform->output, bench_transform->threads);
+    }
+}
+
+/**
+ * Applies the whole chain to the point array, writing point values.
+ */
+static void
+bench_transform_array (void *context)
+{
+  const bench_transform_t *bench_transform = context;
+  (void)point_transform_apply (bench_transform->chain, bench_transform->points, bench_transform->point_count, bench_transform->values,
+                               bench_transform->threads);
+}
+
+/**
+ * Records the benchmarked chain, either into one transform or into one transform per operation.
+ *
+ * @param transforms The transforms to record into, of which only the first is used if is_fused.
+ * @param is_fused Whether all operations are recorded into the first transform.
+ * @return true if every operation was recorded, false otherwise.
+ */
+static bool
+bench_transform_record (point_transform_t **transforms, bool is_fused)
+{
+  const point_bbox_t bounds = { 1000U, 1000U, 1000000000U, 1000000000U };
+  bool result = true;
+
+  result = point_transform_translate (transforms[0], -1000.0, 2500.0) && result;
+  result = point_transform_scale (transforms[is_fused ? 0U : 1U], 0.75, 0.5) && result;
+  result = point_transform_clamp (transforms[is_fused ? 0U : 2U], &bounds) && result;
+  result = point_transform_quantize (transforms[is_fused ? 0U : 3U], 16U, 16U) && result;
+
+  return result;
+}
+
+/**
+ * Benchmarks a translate, scale, clamp and quantize chain over a batch and an array of points.
+ *
+ * @param bench The benchmark session; the batch holds bench->count points and the
+ * array at most BENCH_TRANSFORM_ARRAY_MAX of them.
+ */
+void
+bench_transform (bench_t *bench)
+{
+  size_t count = bench->count;
+  size_t point_count = (count < BENCH_TRANSFORM_ARRAY_MAX) ? count : BENCH_TRANSFORM_ARRAY_MAX;
+  bench_transform_t bench_transform = { 0 };
+  uint32_t *coordinates = malloc (count * 4U * sizeof (uint32_t));
+  bench_transform.points = calloc (point_count, sizeof (point_t *));
+  bench_transform.values = malloc (point_count * sizeof (point_value_t));
+  bench_transform.chain = point_transform_create ();
+
+  bool is_valid = (coordinates != NULL) && (bench_transform.points != NULL) && (bench_transform.values != NULL) && (count > 0U);
+  for (uint32_t i = 0; i < BENCH_TRANSFORM_STEPS; ++i)
+    {
+      bench_transform.steps[i] = point_transform_create ();
+      is_valid = is_valid && (bench_transform.steps[i] != NULL);
+    }
+  is_valid = is_valid && (bench_transform.chain != NULL) && bench_transform_record (&bench_transform.chain, true)
+             && bench_transform_record (bench_transform.steps, false);
+
+  if (is_valid)
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < (count * 2U); ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = state;
+        }
+      for (size_t i = 0; i < point_count; ++i)
+        {
+          bench_transform.points[i] = point_create (coordinates[i], coordinates[count + i]);
+        }
+
+      bench_transform.batch = (point_batch_t){ coordinates, &coordinates[count], count };
+      bench_transform.output = (point_batch_t){ &coordinates[count * 2U], &coordinates[count * 3U], count };
+      bench_transform.point_count = point_count;
+      bench_transform.threads = 1U;
+      bench_run (bench, "transform/batch_fused/threads=1", bench_transform_batch_fused, &bench_transform, count);
+      bench_run (bench, "transform/batch_stepwise/threads=1", bench_transform_batch_stepwise, &bench_transform, count);
+      bench_run (bench, "transform/array/threads=1", bench_transform_array, &bench_transform, point_count);
+      bench_transform.threads = 0U;
+      bench_run (bench, "transform/batch_fused/threads=all", bench_transform_batch_fused, &bench_transform, count);
+
+      for (size_t i = 0; i < point_count; ++i)
+        {
+          (void)point_destroy (bench_transform.points[i]);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the transform benchmark.\n", count);
+    }
+
+  (void)point_transform_destroy (bench_transform.chain);
+  for (uint32_t i = 0; i < BENCH_TRANSFORM_STEPS; ++i)
+    {
+      (void)point_transform_destroy (bench_transform.steps[i]);
+    }
+  free (coordinates);
+  free (bench_transform.points);
+  free (bench_transform.values);
+}
@@ -0,0 +1,120 @@
+#include "bench.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * State of the specialized point type benchmarks.
+ */
+typedef struct
+{
+  point_u16_batch_t u16;
+  point3_f32_batch_t f32;
+  uint32_t *wide_x;
+  uint32_t *wide_y;
+  uint32_t threads;
+} bench_types_t;
+
+/**
+ * Widens the 16-bit batch to full-width coordinates to reuse the 32-bit bounding box,
+ * as callers did before the specialized types.
+ */
+static void
+bench_types_convert_bbox (void *context)
+{
+  const bench_types_t *bench_types = context;
+  for (size_t i = 0; i < bench_types->u16.count; ++i)
+    {
+      bench_types->wide_x[i] = bench_types->u16.x[i];
+      bench_types->wide_y[i] = bench_types->u16.y[i];
+    }
+
+  point_batch_t batch = { bench_types->wide_x, bench_types->wide_y, bench_types->u16.count };
+  point_bbox_t bbox;
+  (void)point_batch_bbox_compute (&batch, &bbox, bench_types->threads);
+}
+
+/**
+ * Computes the bounding box of the 16-bit batch directly.
+ */
+static void
+bench_types_u16_bbox (void *context)
+{
+  const bench_types_t *bench_types = context;
+  point_u16_bbox_t bbox;
+  (void)point_u16_batch_bbox_compute (&bench_types->u16, &bbox, bench_types->threads);
+}
+
+/**
+ * Computes the bounding box of the planar single-precision batch.
+ */
+static void
+bench_types_f32_bbox (void *context)
+{
+  const bench_types_t *bench_types = context;
+  point_f32_batch_t batch = { bench_types->f32.x, bench_types->f32.y, bench_types->f32.count };
+  point_f32_bbox_t bbox;
+  (void)point_f32_batch_bbox_compute (&batch, &bbox, bench_types->threads);
+}
+
+/**
+ * Computes the bounding box of the spatial single-precision batch.
+ */
+static void
+bench_types_f32_3d_bbox (void *context)
+{
+  const bench_types_t *bench_types = context;
+  point3_f32_bbox_t bbox;
+  (void)point3_f32_batch_bbox_compute (&bench_types->f32, &bbox, bench_types->threads);
+}
+
+/**
+ * Benchmarks the bounding boxes of the specialized point types, against widening
+ * 16-bit coordinates to reuse the full-width kernel.
+ *
+ * @param bench The benchmark session; bench->count points of every type are reduced.
+ */
+void
+bench_types (bench_t *bench)
+{
+  bench_types_t bench_types = { 0 };
+  size_t count = bench->count;
+  uint16_t *narrow = malloc (count * 2U * sizeof (uint16_t));
+  float *coordinates = malloc (count * 3U * sizeof (float));
+  bench_types.wide_x = malloc (count * sizeof (uint32_t));
+  bench_types.wide_y = malloc (count * sizeof (uint32_t));
+
+  if ((narrow != NULL) && (coordinates != NULL) && (bench_types.wide_x != NULL) && (bench_types.wide_y != NULL) && (count > 0U))
+    {
+      uint32_t state = 1U;
+      for (size_t i = 0; i < (count * 3U); ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          coordinates[i] = (float)(state >> 8U) * 0.001F;
+          if (i < (count * 2U))
+            {
+              narrow[i] = (uint16_t)(state >> 16U);
+            }
+        }
+
+      bench_types.u16 = (point_u16_batch_t){ narrow, &narrow[count], count };
+      bench_types.f32 = (point3_f32_batch_t){ coordinates, &coordinates[count], &coordinates[count * 2U], count };
+      bench_types.threads = 1U;
+
+      bench_run (bench, "types/u16_convert_bbox/threads=1", bench_types_convert_bbox, &bench_types, count);
+      bench_run (bench, "types/u16_bbox/threads=1", bench_types_u16_bbox, &bench_types, count);
+      bench_run (bench, "types/f32_bbox/threads=1", bench_types_f32_bbox, &bench_types, count);
+      bench_run (bench, "types/f32_3d_bbox/threads=1", bench_types_f32_3d_bbox, &bench_types, count);
+      bench_types.threads = 0U;
+      bench_run (bench, "types/u16_bbox/threads=all", bench_types_u16_bbox, &bench_types, count);
+      bench_run (bench, "types/f32_3d_bbox/threads=all", bench_types_f32_3d_bbox, &bench_types, count);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate %zu points for the point type benchmark.\n", count);
+    }
+
+  free (narrow);
+  free (coordinates);
+  free (bench_types.wide_x);
+  free (bench_types.wide_y);
+}
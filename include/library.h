@@ -18,14 +18,307 @@
 #endif
 #endif
 
+#ifdef _MSC_VER
+#define API_INLINE static __inline
+#else
+#define API_INLINE static inline
+#endif
+
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct point point_t;
+typedef struct point_quadtree point_quadtree_t;
+typedef struct point_transform point_transform_t;
+typedef struct point_future point_future_t;
+typedef struct point_polygon point_polygon_t;
+typedef struct point_compact point_compact_t;
+typedef struct point_arena point_arena_t;
+typedef struct point_u16 point_u16_t;
+typedef struct point_i64 point_i64_t;
+typedef struct point_f32 point_f32_t;
+typedef struct point3_f32 point3_f32_t;
+
+typedef void *(*point_alloc_fn) (size_t size, void *user_data);
+typedef void (*point_free_fn) (void *memory, size_t size, void *user_data);
+typedef void (*point_range_fn) (void *context, size_t begin, size_t end);
+typedef void (*point_task_fn) (void *context);
+typedef bool (*point_join_fn) (void *context, const uint32_t *left, const uint32_t *right, size_t count);
+
+typedef struct
+{
+  uint32_t x;
+  uint32_t y;
+} point_value_t;
+
+typedef struct
+{
+  uint64_t creates;
+  uint64_t destroys;
+  uint64_t live;
+  uint64_t peak_live;
+  uint64_t bytes_allocated;
+  uint64_t bytes_live;
+  uint64_t alloc_ns;
+} point_stats_t;
+
+typedef struct
+{
+  uint32_t *x;
+  uint32_t *y;
+  size_t count;
+} point_batch_t;
+
+typedef struct
+{
+  uint32_t min_x;
+  uint32_t min_y;
+  uint32_t max_x;
+  uint32_t max_y;
+} point_bbox_t;
+
+typedef struct
+{
+  uint32_t origin_x;
+  uint32_t origin_y;
+  uint32_t cell_width;
+  uint32_t cell_height;
+  uint32_t columns;
+  uint32_t rows;
+} point_grid_t;
+
+typedef struct
+{
+  size_t capacity;
+  bool is_huge;
+  int32_t numa_node;
+  bool is_prefaulted;
+  uint32_t threads;
+} point_arena_options_t;
+
+typedef struct
+{
+  size_t capacity;
+  size_t used;
+  bool is_huge_explicit;
+  bool is_huge_transparent;
+  bool is_numa_bound;
+} point_arena_info_t;
+
+typedef struct
+{
+  uint16_t *x;
+  uint16_t *y;
+  size_t count;
+} point_u16_batch_t;
+
+typedef struct
+{
+  uint16_t min_x;
+  uint16_t min_y;
+  uint16_t max_x;
+  uint16_t max_y;
+} point_u16_bbox_t;
+
+typedef struct
+{
+  int64_t *x;
+  int64_t *y;
+  size_t count;
+} point_i64_batch_t;
+
+typedef struct
+{
+  int64_t min_x;
+  int64_t min_y;
+  int64_t max_x;
+  int64_t max_y;
+} point_i64_bbox_t;
+
+typedef struct
+{
+  float *x;
+  float *y;
+  size_t count;
+} point_f32_batch_t;
+
+typedef struct
+{
+  float min_x;
+  float min_y;
+  float max_x;
+  float max_y;
+} point_f32_bbox_t;
+
+typedef struct
+{
+  float *x;
+  float *y;
+  float *z;
+  size_t count;
+} point3_f32_batch_t;
+
+typedef struct
+{
+  float min_x;
+  float min_y;
+  float min_z;
+  float max_x;
+  float max_y;
+  float max_z;
+} point3_f32_bbox_t;
 
 API point_t *point_create (uint32_t x, uint32_t y);
 API bool point_destroy (point_t *point);
 API uint32_t point_get_x (const point_t *point);
 API uint32_t point_get_y (const point_t *point);
 
+API point_value_t point_value_from_point (const point_t *point);
+API point_t *point_value_to_point (point_value_t value);
+
+/**
+ * @brief Make a point value with the specified coordinates.
+ *
+ * Point values are plain 8-byte structures that are passed and returned in
+ * registers, so they need neither an allocation nor a pointer dereference. They
+ * complement the opaque point_t, whose layout can change without breaking the ABI.
+ * The value functions are defined inline, so that they compile to plain register
+ * moves instead of calls into the library.
+ *
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ *
+ * @return The point value.
+ */
+API_INLINE point_value_t
+point_value_make (uint32_t x, uint32_t y)
+{
+  point_value_t result = { x, y };
+  return result;
+}
+
+/**
+ * @brief Get the x-coordinate of a point value.
+ *
+ * @param value The point value.
+ *
+ * @return The x-coordinate of the point value.
+ */
+API_INLINE uint32_t
+point_value_get_x (point_value_t value)
+{
+  return value.x;
+}
+
+/**
+ * @brief Get the y-coordinate of a point value.
+ *
+ * @param value The point value.
+ *
+ * @return The y-coordinate of the point value.
+ */
+API_INLINE uint32_t
+point_value_get_y (point_value_t value)
+{
+  return value.y;
+}
+
+API bool point_set_allocator (point_alloc_fn alloc, point_free_fn release, void *user_data);
+API bool point_stats_get (point_stats_t *stats);
+API bool point_stats_reset (void);
+
+API bool point_bbox_compute (point_t *const *points, size_t count, point_bbox_t *bbox, uint32_t threads);
+API bool point_batch_bbox_compute (const point_batch_t *batch, point_bbox_t *bbox, uint32_t threads);
+
+API size_t point_hull_compute (point_t *const *points, size_t count, uint32_t *indices, uint32_t threads);
+API size_t point_batch_hull_compute (const point_batch_t *batch, uint32_t *indices, uint32_t threads);
+
+API bool point_histogram_compute (point_t *const *points, size_t count, const point_grid_t *grid, uint32_t *cells, uint32_t threads);
+API bool point_batch_histogram_compute (const point_batch_t *batch, const point_grid_t *grid, uint32_t *cells, uint32_t threads);
+
+API point_quadtree_t *point_quadtree_create (const point_bbox_t *bounds, uint32_t leaf_capacity);
+API bool point_quadtree_destroy (point_quadtree_t *tree);
+API bool point_quadtree_insert (point_quadtree_t *tree, uint32_t x, uint32_t y, uint32_t *id);
+API bool point_quadtree_remove (point_quadtree_t *tree, uint32_t id);
+API bool point_quadtree_move (point_quadtree_t *tree, uint32_t id, uint32_t x, uint32_t y);
+API bool point_quadtree_rebalance (point_quadtree_t *tree);
+API size_t point_quadtree_get_count (const point_quadtree_t *tree);
+API size_t point_quadtree_query_range (const point_quadtree_t *tree, const point_bbox_t *range, uint32_t *ids, size_t capacity);
+API bool point_quadtree_query_nearest (const point_quadtree_t *tree, uint32_t x, uint32_t y, uint32_t *id);
+
+API point_transform_t *point_transform_create (void);
+API bool point_transform_destroy (point_transform_t *transform);
+API bool point_transform_translate (point_transform_t *transform, double dx, double dy);
+API bool point_transform_scale (point_transform_t *transform, double sx, double sy);
+API bool point_transform_affine (point_transform_t *transform, const double *matrix);
+API bool point_transform_clamp (point_transform_t *transform, const point_bbox_t *bounds);
+API bool point_transform_quantize (point_transform_t *transform, uint32_t step_x, uint32_t step_y);
+API bool point_transform_apply (const point_transform_t *transform, point_t *const *points, size_t count, point_value_t *output, uint32_t threads);
+API bool point_batch_transform_apply (const point_transform_t *transform, const point_batch_t *batch, const point_batch_t *output, uint32_t threads);
+
+API bool point_distance_matrix_compute (point_t *const *rows, size_t row_count, point_t *const *columns, size_t column_count, uint64_t *matrix,
+                                        uint32_t threads);
+API bool point_batch_distance_matrix_compute (const point_batch_t *rows, const point_batch_t *columns, uint64_t *matrix, uint32_t threads);
+API bool point_distance_top_k_compute (point_t *const *rows, size_t row_count, point_t *const *columns, size_t column_count, uint32_t k,
+                                       uint32_t *indices, uint64_t *distances, uint32_t threads);
+API bool point_batch_distance_top_k_compute (const point_batch_t *rows, const point_batch_t *columns, uint32_t k, uint32_t *indices,
+                                             uint64_t *distances, uint32_t threads);
+
+API point_polygon_t *point_polygon_create (const point_value_t *vertices, size_t count);
+API bool point_polygon_destroy (point_polygon_t *polygon);
+API bool point_polygon_contains (const point_polygon_t *polygon, uint32_t x, uint32_t y);
+API bool point_polygon_test (const point_polygon_t *polygon, point_t *const *points, size_t count, uint64_t *bitmap, uint32_t threads);
+API bool point_batch_polygon_test (const point_polygon_t *polygon, const point_batch_t *batch, uint64_t *bitmap, uint32_t threads);
+API bool point_polygon_locate (point_polygon_t *const *polygons, size_t polygon_count, point_t *const *points, size_t count, uint32_t *indices,
+                               uint32_t threads);
+API bool point_batch_polygon_locate (point_polygon_t *const *polygons, size_t polygon_count, const point_batch_t *batch, uint32_t *indices,
+                                     uint32_t threads);
+
+API bool point_dbscan_compute (point_t *const *points, size_t count, uint32_t epsilon, uint32_t min_points, uint32_t *labels, size_t *cluster_count,
+                              uint32_t threads);
+API bool point_batch_dbscan_compute (const point_batch_t *batch, uint32_t epsilon, uint32_t min_points, uint32_t *labels, size_t *cluster_count,
+                                    uint32_t threads);
+
+API bool point_join_compute (point_t *const *left, size_t left_count, point_t *const *right, size_t right_count, uint32_t distance,
+                            point_join_fn callback, void *context, uint32_t threads);
+API bool point_batch_join_compute (const point_batch_t *left, const point_batch_t *right, uint32_t distance, point_join_fn callback, void *context,
+                                  uint32_t threads);
+
+API point_compact_t *point_compact_create (const point_batch_t *batch, uint32_t threads);
+API bool point_compact_destroy (point_compact_t *compact);
+API size_t point_compact_get_count (const point_compact_t *compact);
+API bool point_compact_get (const point_compact_t *compact, size_t index, point_value_t *value);
+API bool point_compact_export (const point_compact_t *compact, const point_batch_t *output, uint32_t threads);
+API bool point_compact_bbox_compute (const point_compact_t *compact, point_bbox_t *bbox);
+API size_t point_compact_query_range (const point_compact_t *compact, const point_bbox_t *range, uint32_t *ids, size_t capacity);
+
+/* Declare the API functions of a point type, whose creation takes the parenthesized parameters. */
+#define POINT_TYPE_DECLARE(name, type, parameters)                                                                                                   \
+  API name##_t *name##_create parameters;                                                                                                            \
+  API bool name##_destroy (name##_t *point);                                                                                                         \
+  API type name##_get_x (const name##_t *point);                                                                                                     \
+  API type name##_get_y (const name##_t *point);                                                                                                     \
+  API bool name##_batch_bbox_compute (const name##_batch_t *batch, name##_bbox_t *bbox, uint32_t threads);                                           \
+  API size_t name##_batch_query_range (const name##_batch_t *batch, const name##_bbox_t *range, uint32_t *ids, size_t capacity);
+
+POINT_TYPE_DECLARE (point_u16, uint16_t, (uint16_t x, uint16_t y))
+POINT_TYPE_DECLARE (point_i64, int64_t, (int64_t x, int64_t y))
+POINT_TYPE_DECLARE (point_f32, float, (float x, float y))
+POINT_TYPE_DECLARE (point3_f32, float, (float x, float y, float z))
+API float point3_f32_get_z (const point3_f32_t *point);
+
+API point_arena_t *point_arena_create (const point_arena_options_t *options);
+API bool point_arena_destroy (point_arena_t *arena);
+API void *point_arena_alloc (size_t size, void *arena);
+API void point_arena_free (void *memory, size_t size, void *arena);
+API bool point_arena_reset (point_arena_t *arena);
+API bool point_arena_get_info (const point_arena_t *arena, point_arena_info_t *info);
+
+API bool point_pool_configure (uint32_t threads, bool is_pinned);
+API uint32_t point_pool_get_threads (void);
+API bool point_parallel_for (size_t count, size_t grain, point_range_fn body, void *context);
+API point_future_t *point_task_submit (point_task_fn task, void *context);
+API bool point_future_wait (point_future_t *future);
+
 #endif
@@ -0,0 +1,77 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * @brief The allocator used for points, malloc and free when both callbacks are NULL.
+ */
+typedef struct
+{
+  point_alloc_fn alloc;
+  point_free_fn release;
+  void *user_data;
+} allocator_t;
+
+static allocator_t g_allocator = { NULL, NULL, NULL };
+
+/**
+ * @brief Allocate memory for a point with the installed allocator.
+ *
+ * @param size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if allocation fails.
+ */
+void *
+allocator_alloc (size_t size)
+{
+  return (g_allocator.alloc != NULL) ? g_allocator.alloc (size, g_allocator.user_data) : malloc (size);
+}
+
+/**
+ * @brief Release memory obtained from allocator_alloc.
+ *
+ * @param memory A pointer to the memory to release.
+ * @param size The number of bytes that were requested for the memory.
+ */
+void
+allocator_free (void *memory, size_t size)
+{
+  if (g_allocator.release != NULL)
+    {
+      g_allocator.release (memory, size, g_allocator.user_data);
+    }
+  else
+    {
+      free (memory);
+    }
+}
+
+/**
+ * @brief Install the allocator used by point_create and point_destroy.
+ *
+ * Every point is released through the allocator that was installed when it was
+ * created, so the allocator should be replaced only while no points exist. The
+ * function is not synchronized with point creation on other threads. Passing NULL
+ * for both callbacks restores malloc and free.
+ *
+ * @param alloc The callback allocating memory, receiving the size and user data.
+ * @param release The callback releasing memory, receiving the pointer, the size that
+ * was requested for it and the user data.
+ * @param user_data An opaque pointer handed to both callbacks.
+ *
+ * @return true if the allocator was installed, false if only one callback is NULL.
+ */
+bool
+point_set_allocator (point_alloc_fn alloc, point_free_fn release, void *user_data)
+{
+  bool result = false;
+  if ((alloc == NULL) == (release == NULL))
+    {
+      g_allocator.alloc = alloc;
+      g_allocator.release = release;
+      g_allocator.user_data = (alloc != NULL) ? user_data : NULL;
+      result = true;
+    }
+
+  return result;
+}
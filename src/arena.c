@@ -0,0 +1,350 @@
+#ifdef __linux__
+/* MAP_HUGETLB, MAP_NORESERVE and MADV_HUGEPAGE are Linux extensions */
+#define _GNU_SOURCE
+#endif
+
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+/* Size of the huge pages the arena is aligned to and requests. */
+#define ARENA_HUGE_PAGE (2U * 1024U * 1024U)
+
+/* Size of the pages touched one by one by the first-touch initialization. */
+#define ARENA_PAGE 4096U
+
+/* Minimum number of pages touched by a worker before the initialization is split across threads. */
+#define ARENA_MIN_CHUNK_PAGES 512U
+
+/* Memory policy placing the pages of a range on the node of a mask while it has free memory, from the mbind interface. */
+#define ARENA_MPOL_PREFERRED 1
+
+/* Number of NUMA nodes the node mask passed to mbind can hold. */
+#define ARENA_MAX_NODES 1024U
+
+/**
+ * @brief A range of reserved memory serving allocations by bumping an offset.
+ *
+ * The range is mapped once, aligned to huge pages, and never grows. Allocations
+ * advance the offset atomically, so points and batches created together are
+ * contiguous in memory and share the TLB entries of their huge pages.
+ */
+struct point_arena
+{
+  uint8_t *base;
+  size_t capacity;
+  atomic_size_t offset;
+  bool is_huge_explicit;
+  bool is_huge_transparent;
+  bool is_numa_bound;
+};
+
+/**
+ * @brief Parallel task writing to every page of a range of an arena.
+ *
+ * @param context A pointer to the point_arena_t to initialize.
+ * @param worker The index of the worker, unused.
+ * @param begin The first page of the range.
+ * @param end One past the last page of the range.
+ */
+static void
+arena_touch_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const point_arena_t *arena = context;
+  volatile uint8_t *base = arena->base;
+  for (size_t page = begin; page < end; ++page)
+    {
+      base[page * ARENA_PAGE] = 0U;
+    }
+}
+
+/**
+ * @brief Map the memory of an arena, with huge pages where requested and available.
+ *
+ * Explicit huge pages from the reserved pool are tried first. Otherwise ordinary
+ * pages are mapped with room to align the range to a huge page, the excess is
+ * unmapped, and transparent huge pages are requested for the range.
+ *
+ * @param arena A pointer to the arena, whose capacity is a multiple of ARENA_HUGE_PAGE.
+ * @param is_huge Whether huge pages are requested.
+ *
+ * @return true if the memory was mapped, false otherwise.
+ */
+static bool
+arena_map (point_arena_t *arena, bool is_huge)
+{
+  uint8_t *mapping = MAP_FAILED;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef __linux__
+  /* Huge pages are taken from the pool up front, so that a short pool fails here rather than on first touch */
+  if (is_huge)
+    {
+      mapping = mmap (NULL, arena->capacity, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+      arena->is_huge_explicit = (mapping != MAP_FAILED);
+    }
+
+  /* The reservation of ordinary pages may exceed the memory available now, which is only committed on use */
+  flags |= MAP_NORESERVE;
+#endif
+
+  if (mapping == MAP_FAILED)
+    {
+      mapping = mmap (NULL, arena->capacity + ARENA_HUGE_PAGE, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if (mapping != MAP_FAILED)
+        {
+          /* Keep the part aligned to a huge page only */
+          size_t head = (ARENA_HUGE_PAGE - ((uintptr_t)mapping % ARENA_HUGE_PAGE)) % ARENA_HUGE_PAGE;
+          if (head > 0U)
+            {
+              (void)munmap (mapping, head);
+            }
+          (void)munmap (&mapping[head + arena->capacity], ARENA_HUGE_PAGE - head);
+          mapping = &mapping[head];
+
+#ifdef __linux__
+          arena->is_huge_transparent = is_huge && (madvise (mapping, arena->capacity, MADV_HUGEPAGE) == 0);
+#endif
+        }
+    }
+
+  arena->base = (mapping != MAP_FAILED) ? mapping : NULL;
+  return arena->base != NULL;
+}
+
+/**
+ * @brief Bind the memory of an arena to a NUMA node.
+ *
+ * The node is preferred rather than required, so that the pages spill over to other
+ * nodes when it is full instead of failing. The system call is issued directly, so
+ * that no NUMA library is needed. It fails without effect on kernels or machines
+ * without NUMA support, or for nodes that do not exist.
+ *
+ * @param arena A pointer to the mapped arena, none of whose pages were touched yet.
+ * @param node The node to bind the memory to.
+ *
+ * @return true if the memory was bound, false otherwise.
+ */
+static bool
+arena_bind (const point_arena_t *arena, uint32_t node)
+{
+  bool result = false;
+#if defined(__linux__) && defined(SYS_mbind)
+  unsigned long mask[ARENA_MAX_NODES / (8U * sizeof (unsigned long))] = { 0U };
+  if (node < (ARENA_MAX_NODES - 1U))
+    {
+      mask[node / (8U * sizeof (unsigned long))] = 1UL << (node % (8U * sizeof (unsigned long)));
+      result = (syscall (SYS_mbind, arena->base, arena->capacity, ARENA_MPOL_PREFERRED, mask, (unsigned long)ARENA_MAX_NODES, 0U) == 0);
+    }
+#else
+  (void)arena;
+  (void)node;
+#endif
+
+  return result;
+}
+
+/**
+ * @brief Create an arena for bulk point storage.
+ *
+ * The arena reserves its whole capacity at once, aligned to 2 MiB huge pages, and
+ * serves allocations from it contiguously until it is destroyed. Huge pages and the
+ * NUMA binding are best effort: when the system does not provide them, the arena uses
+ * ordinary pages with the default placement, which point_arena_get_info reports.
+ *
+ * @param options A pointer to the options of the arena:
+ * capacity is the number of bytes to reserve, at least 1 and rounded up to 2 MiB;
+ * is_huge requests explicit huge pages from the pool reserved by the system, falling
+ * back to transparent huge pages;
+ * numa_node is the node the memory is placed on while it has free memory, or negative
+ * for the default policy;
+ * is_prefaulted touches every page at creation, split across threads as configured by
+ * threads (0 for all available processors), so that page faults are not taken by the
+ * first allocations and, without a binding, pages are placed on the nodes of the workers.
+ *
+ * @return A pointer to the arena, or NULL if the options are NULL, the capacity is 0
+ * or too large, or the memory cannot be reserved.
+ */
+point_arena_t *
+point_arena_create (const point_arena_options_t *options)
+{
+  point_arena_t *result = NULL;
+  if ((options != NULL) && (options->capacity > 0U) && (options->capacity <= (SIZE_MAX / 2U)))
+    {
+      result = calloc (1U, sizeof (point_arena_t));
+      if (result != NULL)
+        {
+          result->capacity = ((options->capacity + ARENA_HUGE_PAGE - 1U) / ARENA_HUGE_PAGE) * ARENA_HUGE_PAGE;
+          atomic_init (&result->offset, 0U);
+
+          if (arena_map (result, options->is_huge))
+            {
+              result->is_numa_bound = (options->numa_node >= 0) && arena_bind (result, (uint32_t)options->numa_node);
+
+              if (options->is_prefaulted)
+                {
+                  size_t pages = result->capacity / ARENA_PAGE;
+                  parallel_run (parallel_plan (options->threads, pages, ARENA_MIN_CHUNK_PAGES), pages, arena_touch_task, result);
+                }
+            }
+          else
+            {
+              free (result);
+              result = NULL;
+            }
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Destroy an arena and release all of its memory.
+ *
+ * Every allocation from the arena becomes invalid, including points created while it
+ * was installed with point_set_allocator, which must be uninstalled first.
+ *
+ * @param arena A pointer to the arena.
+ *
+ * @return true if the arena was destroyed, false if it is NULL.
+ */
+bool
+point_arena_destroy (point_arena_t *arena)
+{
+  bool result = false;
+  if (arena != NULL)
+    {
+      (void)munmap (arena->base, arena->capacity);
+      free (arena);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Allocate memory from an arena.
+ *
+ * Allocations are thread-safe and lock-free. Allocations of at least 64 bytes, such
+ * as the coordinate arrays of batches, are aligned to cache lines, and smaller ones
+ * to 8 or 16 bytes, so that points are packed without gaps. The signature matches
+ * point_alloc_fn, so that the arena can be installed with point_set_allocator.
+ *
+ * @param size The number of bytes to allocate.
+ * @param arena A pointer to the arena.
+ *
+ * @return A pointer to the memory, or NULL if the arena is NULL or full, or size is 0.
+ */
+void *
+point_arena_alloc (size_t size, void *arena)
+{
+  void *result = NULL;
+  point_arena_t *point_arena = arena;
+  if ((point_arena != NULL) && (size > 0U) && (size <= point_arena->capacity))
+    {
+      size_t alignment = (size >= 64U) ? 64U : ((size > 8U) ? 16U : 8U);
+      size_t offset = atomic_load_explicit (&point_arena->offset, memory_order_relaxed);
+      size_t begin = 0U;
+      bool is_full = false;
+      do
+        {
+          begin = (offset + alignment - 1U) & ~(alignment - 1U);
+          is_full = (begin > (point_arena->capacity - size));
+        }
+      while (!is_full
+             && !atomic_compare_exchange_weak_explicit (&point_arena->offset, &offset, begin + size, memory_order_relaxed, memory_order_relaxed));
+
+      result = is_full ? NULL : &point_arena->base[begin];
+    }
+
+  return result;
+}
+
+/**
+ * @brief Release memory allocated from an arena.
+ *
+ * Memory is only reused when it is the latest allocation of the arena, as for a
+ * temporary batch, and otherwise stays allocated until the arena is reset or
+ * destroyed. The signature matches point_free_fn, so that the arena can be installed
+ * with point_set_allocator.
+ *
+ * Memory outside the arena, such as points created with another allocator before the
+ * arena was installed, is ignored rather than released: the arena cannot tell which
+ * allocator owns it, so such points leak unless they are destroyed before installing
+ * the arena.
+ *
+ * @param memory A pointer to memory allocated from the arena, or NULL.
+ * @param size The number of bytes that were requested for the memory.
+ * @param arena A pointer to the arena.
+ */
+void
+point_arena_free (void *memory, size_t size, void *arena)
+{
+  point_arena_t *point_arena = arena;
+  uintptr_t address = (uintptr_t)memory;
+  uintptr_t base = (point_arena != NULL) ? (uintptr_t)point_arena->base : 0U;
+
+  /* Compare addresses as integers, as pointer arithmetic across objects is undefined */
+  if ((point_arena != NULL) && (memory != NULL) && (address >= base) && ((address - base) < point_arena->capacity))
+    {
+      size_t begin = (size_t)(address - base);
+      size_t end = begin + size;
+      (void)atomic_compare_exchange_strong_explicit (&point_arena->offset, &end, begin, memory_order_relaxed, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Release every allocation of an arena at once, keeping its memory mapped.
+ *
+ * The pages stay resident, so refilling the arena takes no page faults. The arena must
+ * not be used by other threads during the reset.
+ *
+ * @param arena A pointer to the arena.
+ *
+ * @return true if the arena was reset, false if it is NULL.
+ */
+bool
+point_arena_reset (point_arena_t *arena)
+{
+  bool result = false;
+  if (arena != NULL)
+    {
+      atomic_store_explicit (&arena->offset, 0U, memory_order_relaxed);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Get the capacity, usage and backing of an arena.
+ *
+ * @param arena A pointer to the arena.
+ * @param info A pointer receiving the capacity in bytes, the bytes allocated so far,
+ * whether explicit or transparent huge pages back the arena, and whether its memory is
+ * bound to the requested NUMA node. Transparent huge pages are only requested, and the
+ * system may still use ordinary pages for parts of the arena.
+ *
+ * @return true if the information was read, false if an argument is NULL.
+ */
+bool
+point_arena_get_info (const point_arena_t *arena, point_arena_info_t *info)
+{
+  bool result = false;
+  if ((arena != NULL) && (info != NULL))
+    {
+      info->capacity = arena->capacity;
+      info->used = atomic_load_explicit (&arena->offset, memory_order_relaxed);
+      info->is_huge_explicit = arena->is_huge_explicit;
+      info->is_huge_transparent = arena->is_huge_transparent;
+      info->is_numa_bound = arena->is_numa_bound;
+      result = true;
+    }
+
+  return result;
+}
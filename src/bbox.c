@@ -0,0 +1,314 @@
+#include "internal.h"
+#include "library.h"
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Shared state of a parallel bounding-box reduction.
+ */
+typedef struct
+{
+  point_t *const *points;
+  const point_batch_t *batch;
+  point_bbox_t partial[PARALLEL_MAX_WORKERS];
+} bbox_context_t;
+
+/**
+ * @brief Initialize a bounding box to the empty state.
+ *
+ * The empty state has its minimum above its maximum, so that merging any point
+ * into it yields the bounding box of that point alone.
+ *
+ * @param bbox A pointer to the bounding box to initialize.
+ */
+static void
+bbox_reset (point_bbox_t *bbox)
+{
+  bbox->min_x = UINT32_MAX;
+  bbox->min_y = UINT32_MAX;
+  bbox->max_x = 0U;
+  bbox->max_y = 0U;
+}
+
+/**
+ * @brief Merge a bounding box into another one.
+ *
+ * @param bbox A pointer to the bounding box to extend.
+ * @param other A pointer to the bounding box to merge.
+ */
+static void
+bbox_merge (point_bbox_t *bbox, const point_bbox_t *other)
+{
+  bbox->min_x = (other->min_x < bbox->min_x) ? other->min_x : bbox->min_x;
+  bbox->min_y = (other->min_y < bbox->min_y) ? other->min_y : bbox->min_y;
+  bbox->max_x = (other->max_x > bbox->max_x) ? other->max_x : bbox->max_x;
+  bbox->max_y = (other->max_y > bbox->max_y) ? other->max_y : bbox->max_y;
+}
+
+/**
+ * @brief Reduce a range of structure-of-arrays coordinates into a bounding box.
+ *
+ * The bulk of the range is processed with AVX2 or SSE4.1 minimum and maximum
+ * instructions when available, keeping one running extreme per vector lane. SSE2,
+ * which every x86-64 build has, lacks unsigned minimum and maximum, so there the
+ * coordinates are biased into the signed range, compared and selected by masks.
+ * The lanes and the remaining tail are then reduced with scalar code.
+ *
+ * @param x The x-coordinates to reduce.
+ * @param y The y-coordinates to reduce.
+ * @param count The number of coordinates.
+ * @param bbox A pointer to the bounding box to extend.
+ */
+static void
+bbox_reduce_batch (const uint32_t *x, const uint32_t *y, size_t count, point_bbox_t *bbox)
+{
+  size_t i = 0;
+  point_bbox_t result = *bbox;
+
+#if defined(__AVX2__)
+  if (count >= 8U)
+    {
+      __m256i min_x = _mm256_set1_epi32 (-1);
+      __m256i min_y = _mm256_set1_epi32 (-1);
+      __m256i max_x = _mm256_setzero_si256 ();
+      __m256i max_y = _mm256_setzero_si256 ();
+
+      for (; (i + 8U) <= count; i += 8U)
+        {
+          __m256i vx = _mm256_loadu_si256 ((const __m256i *)&x[i]);
+          __m256i vy = _mm256_loadu_si256 ((const __m256i *)&y[i]);
+          min_x = _mm256_min_epu32 (min_x, vx);
+          min_y = _mm256_min_epu32 (min_y, vy);
+          max_x = _mm256_max_epu32 (max_x, vx);
+          max_y = _mm256_max_epu32 (max_y, vy);
+        }
+
+      uint32_t lanes[4][8];
+      _mm256_storeu_si256 ((__m256i *)lanes[0], min_x);
+      _mm256_storeu_si256 ((__m256i *)lanes[1], min_y);
+      _mm256_storeu_si256 ((__m256i *)lanes[2], max_x);
+      _mm256_storeu_si256 ((__m256i *)lanes[3], max_y);
+
+      for (uint32_t lane = 0; lane < 8U; ++lane)
+        {
+          point_bbox_t lane_bbox = { lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane] };
+          bbox_merge (&result, &lane_bbox);
+        }
+    }
+#elif defined(__SSE4_1__)
+  if (count >= 4U)
+    {
+      __m128i min_x = _mm_set1_epi32 (-1);
+      __m128i min_y = _mm_set1_epi32 (-1);
+      __m128i max_x = _mm_setzero_si128 ();
+      __m128i max_y = _mm_setzero_si128 ();
+
+      for (; (i + 4U) <= count; i += 4U)
+        {
+          __m128i vx = _mm_loadu_si128 ((const __m128i *)&x[i]);
+          __m128i vy = _mm_loadu_si128 ((const __m128i *)&y[i]);
+          min_x = _mm_min_epu32 (min_x, vx);
+          min_y = _mm_min_epu32 (min_y, vy);
+          max_x = _mm_max_epu32 (max_x, vx);
+          max_y = _mm_max_epu32 (max_y, vy);
+        }
+
+      uint32_t lanes[4][4];
+      _mm_storeu_si128 ((__m128i *)lanes[0], min_x);
+      _mm_storeu_si128 ((__m128i *)lanes[1], min_y);
+      _mm_storeu_si128 ((__m128i *)lanes[2], max_x);
+      _mm_storeu_si128 ((__m128i *)lanes[3], max_y);
+
+      for (uint32_t lane = 0; lane < 4U; ++lane)
+        {
+          point_bbox_t lane_bbox = { lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane] };
+          bbox_merge (&result, &lane_bbox);
+        }
+    }
+#elif defined(__SSE2__)
+  if (count >= 4U)
+    {
+      /* Flipping the sign bit maps unsigned order onto signed order */
+      const __m128i bias = _mm_set1_epi32 (INT32_MIN);
+      __m128i min_x = _mm_set1_epi32 (INT32_MAX);
+      __m128i min_y = _mm_set1_epi32 (INT32_MAX);
+      __m128i max_x = bias;
+      __m128i max_y = bias;
+
+      for (; (i + 4U) <= count; i += 4U)
+        {
+          __m128i vx = _mm_xor_si128 (_mm_loadu_si128 ((const __m128i *)&x[i]), bias);
+          __m128i vy = _mm_xor_si128 (_mm_loadu_si128 ((const __m128i *)&y[i]), bias);
+          __m128i is_below_x = _mm_cmplt_epi32 (vx, min_x);
+          __m128i is_below_y = _mm_cmplt_epi32 (vy, min_y);
+          __m128i is_above_x = _mm_cmpgt_epi32 (vx, max_x);
+          __m128i is_above_y = _mm_cmpgt_epi32 (vy, max_y);
+          min_x = _mm_or_si128 (_mm_and_si128 (is_below_x, vx), _mm_andnot_si128 (is_below_x, min_x));
+          min_y = _mm_or_si128 (_mm_and_si128 (is_below_y, vy), _mm_andnot_si128 (is_below_y, min_y));
+          max_x = _mm_or_si128 (_mm_and_si128 (is_above_x, vx), _mm_andnot_si128 (is_above_x, max_x));
+          max_y = _mm_or_si128 (_mm_and_si128 (is_above_y, vy), _mm_andnot_si128 (is_above_y, max_y));
+        }
+
+      uint32_t lanes[4][4];
+      _mm_storeu_si128 ((__m128i *)lanes[0], _mm_xor_si128 (min_x, bias));
+      _mm_storeu_si128 ((__m128i *)lanes[1], _mm_xor_si128 (min_y, bias));
+      _mm_storeu_si128 ((__m128i *)lanes[2], _mm_xor_si128 (max_x, bias));
+      _mm_storeu_si128 ((__m128i *)lanes[3], _mm_xor_si128 (max_y, bias));
+
+      for (uint32_t lane = 0; lane < 4U; ++lane)
+        {
+          point_bbox_t lane_bbox = { lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane] };
+          bbox_merge (&result, &lane_bbox);
+        }
+    }
+#endif
+
+  for (; i < count; ++i)
+    {
+      result.min_x = (x[i] < result.min_x) ? x[i] : result.min_x;
+      result.min_y = (y[i] < result.min_y) ? y[i] : result.min_y;
+      result.max_x = (x[i] > result.max_x) ? x[i] : result.max_x;
+      result.max_y = (y[i] > result.max_y) ? y[i] : result.max_y;
+    }
+
+  *bbox = result;
+}
+
+/**
+ * @brief Reduce a range of a point array into a bounding box, skipping NULL entries.
+ *
+ * @param points The points to reduce.
+ * @param count The number of points.
+ * @param bbox A pointer to the bounding box to extend.
+ */
+static void
+bbox_reduce_points (point_t *const *points, size_t count, point_bbox_t *bbox)
+{
+  point_bbox_t result = *bbox;
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      const point_t *point = points[i];
+      if (point != NULL)
+        {
+          result.min_x = (point->x < result.min_x) ? point->x : result.min_x;
+          result.min_y = (point->y < result.min_y) ? point->y : result.min_y;
+          result.max_x = (point->x > result.max_x) ? point->x : result.max_x;
+          result.max_y = (point->y > result.max_y) ? point->y : result.max_y;
+        }
+    }
+
+  *bbox = result;
+}
+
+/**
+ * @brief Parallel task reducing one slice of the input into its partial bounding box.
+ *
+ * @param context A pointer to the bbox_context_t of the reduction.
+ * @param worker The index of the worker, selecting its partial bounding box.
+ * @param begin The first index of the slice.
+ * @param end One past the last index of the slice.
+ */
+static void
+bbox_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  bbox_context_t *bbox_context = context;
+  point_bbox_t *partial = &bbox_context->partial[worker];
+  bbox_reset (partial);
+
+  if (bbox_context->batch != NULL)
+    {
+      bbox_reduce_batch (&bbox_context->batch->x[begin], &bbox_context->batch->y[begin], end - begin, partial);
+    }
+  else
+    {
+      bbox_reduce_points (&bbox_context->points[begin], end - begin, partial);
+    }
+}
+
+/**
+ * @brief Run a bounding-box reduction and combine the partial results.
+ *
+ * @param bbox_context A pointer to the prepared reduction state.
+ * @param count The number of input elements.
+ * @param bbox A pointer receiving the bounding box.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if at least one point contributed to the bounding box, false otherwise.
+ */
+static bool
+bbox_compute (bbox_context_t *bbox_context, size_t count, point_bbox_t *bbox, uint32_t threads)
+{
+  uint32_t workers = parallel_plan (threads, count, PARALLEL_MIN_CHUNK);
+  parallel_run (workers, count, bbox_task, bbox_context);
+
+  point_bbox_t result;
+  bbox_reset (&result);
+  for (uint32_t i = 0; i < workers; ++i)
+    {
+      bbox_merge (&result, &bbox_context->partial[i]);
+    }
+
+  bool found = (result.min_x <= result.max_x);
+  if (found)
+    {
+      *bbox = result;
+    }
+
+  return found;
+}
+
+/**
+ * @brief Compute the axis-aligned bounding box of an array of points.
+ *
+ * NULL entries in the array are skipped. Large arrays are split across threads,
+ * each of which reduces its slice into a private bounding box before the partial
+ * results are merged.
+ *
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the array.
+ * @param bbox A pointer receiving the bounding box.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the bounding box was computed, false if an argument is NULL or the
+ * array holds no points.
+ */
+bool
+point_bbox_compute (point_t *const *points, size_t count, point_bbox_t *bbox, uint32_t threads)
+{
+  bool result = false;
+  if ((points != NULL) && (bbox != NULL) && (count > 0U))
+    {
+      bbox_context_t bbox_context = { .points = points, .batch = NULL };
+      result = bbox_compute (&bbox_context, count, bbox, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Compute the axis-aligned bounding box of a batch of points.
+ *
+ * The coordinates are reduced with SIMD minimum and maximum instructions where
+ * available, and large batches are additionally split across threads.
+ *
+ * @param batch A pointer to the batch of points.
+ * @param bbox A pointer receiving the bounding box.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the bounding box was computed, false if an argument is NULL or the
+ * batch is empty.
+ */
+bool
+point_batch_bbox_compute (const point_batch_t *batch, point_bbox_t *bbox, uint32_t threads)
+{
+  bool result = false;
+  if ((batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (bbox != NULL) && (batch->count > 0U))
+    {
+      bbox_context_t bbox_context = { .points = NULL, .batch = batch };
+      result = bbox_compute (&bbox_context, batch->count, bbox, threads);
+    }
+
+  return result;
+}
@@ -0,0 +1,447 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+/* Number of consecutive points sharing the origin of a compact block. */
+#define COMPACT_BLOCK 4096U
+
+/* Largest span of the coordinates of a compact block, the range of their 16-bit offsets. */
+#define COMPACT_MAX_SPAN UINT16_MAX
+
+/**
+ * @brief Points stored as 16-bit offsets from the origin of their block.
+ *
+ * The points are split into blocks of COMPACT_BLOCK consecutive points. Each block
+ * keeps its bounding box, whose minimum is the origin the offsets of its points are
+ * relative to, so the coordinates take 4 bytes per point instead of 8 while the
+ * bounding boxes let range queries skip or accept whole blocks at once.
+ */
+struct point_compact
+{
+  size_t count;
+  size_t blocks;
+  point_bbox_t *bounds;
+  uint16_t *x;
+  uint16_t *y;
+};
+
+/**
+ * @brief Shared state of a parallel conversion between full-width and compact points.
+ */
+typedef struct
+{
+  const point_compact_t *compact;
+  const point_batch_t *batch;
+  atomic_bool is_out_of_range;
+} compact_context_t;
+
+/**
+ * @brief Narrow a range of coordinates to 16-bit offsets from an origin.
+ *
+ * The offsets are packed with AVX2 or SSE4.1 unsigned saturating packs when
+ * available, which are exact since every offset fits in 16 bits.
+ *
+ * @param values The coordinates, none below origin nor above origin + COMPACT_MAX_SPAN.
+ * @param count The number of coordinates.
+ * @param origin The origin of the offsets.
+ * @param offsets Receives one offset per coordinate.
+ */
+static void
+compact_narrow (const uint32_t *values, size_t count, uint32_t origin, uint16_t *offsets)
+{
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  __m256i origins = _mm256_set1_epi32 ((int32_t)origin);
+  for (; (i + 16U) <= count; i += 16U)
+    {
+      __m256i low = _mm256_sub_epi32 (_mm256_loadu_si256 ((const __m256i *)&values[i]), origins);
+      __m256i high = _mm256_sub_epi32 (_mm256_loadu_si256 ((const __m256i *)&values[i + 8U]), origins);
+
+      /* The pack works within 128-bit lanes, so the 64-bit quarters are put back in order */
+      __m256i packed = _mm256_permute4x64_epi64 (_mm256_packus_epi32 (low, high), 0xD8);
+      _mm256_storeu_si256 ((__m256i *)&offsets[i], packed);
+    }
+#elif defined(__SSE4_1__)
+  __m128i origins = _mm_set1_epi32 ((int32_t)origin);
+  for (; (i + 8U) <= count; i += 8U)
+    {
+      __m128i low = _mm_sub_epi32 (_mm_loadu_si128 ((const __m128i *)&values[i]), origins);
+      __m128i high = _mm_sub_epi32 (_mm_loadu_si128 ((const __m128i *)&values[i + 4U]), origins);
+      _mm_storeu_si128 ((__m128i *)&offsets[i], _mm_packus_epi32 (low, high));
+    }
+#endif
+
+  for (; i < count; ++i)
+    {
+      offsets[i] = (uint16_t)(values[i] - origin);
+    }
+}
+
+/**
+ * @brief Widen a range of 16-bit offsets back to full-width coordinates.
+ *
+ * The offsets are zero-extended and added to the origin with AVX2 or SSE4.1 when
+ * available.
+ *
+ * @param offsets The offsets.
+ * @param count The number of offsets.
+ * @param origin The origin of the offsets.
+ * @param values Receives one coordinate per offset.
+ */
+static void
+compact_widen (const uint16_t *offsets, size_t count, uint32_t origin, uint32_t *values)
+{
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  __m256i origins = _mm256_set1_epi32 ((int32_t)origin);
+  for (; (i + 8U) <= count; i += 8U)
+    {
+      __m256i wide = _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *)&offsets[i]));
+      _mm256_storeu_si256 ((__m256i *)&values[i], _mm256_add_epi32 (wide, origins));
+    }
+#elif defined(__SSE4_1__)
+  __m128i origins = _mm_set1_epi32 ((int32_t)origin);
+  for (; (i + 4U) <= count; i += 4U)
+    {
+      __m128i wide = _mm_cvtepu16_epi32 (_mm_loadl_epi64 ((const __m128i *)&offsets[i]));
+      _mm_storeu_si128 ((__m128i *)&values[i], _mm_add_epi32 (wide, origins));
+    }
+#endif
+
+  for (; i < count; ++i)
+    {
+      values[i] = origin + offsets[i];
+    }
+}
+
+/**
+ * @brief Parallel task compacting a range of blocks of a batch.
+ *
+ * A block whose coordinates span more than COMPACT_MAX_SPAN flags the conversion
+ * as out of range instead of being narrowed.
+ *
+ * @param context A pointer to the compact_context_t of the conversion.
+ * @param worker The index of the worker, unused.
+ * @param begin The first block of the range.
+ * @param end One past the last block of the range.
+ */
+static void
+compact_create_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  compact_context_t *compact_context = context;
+  const point_compact_t *compact = compact_context->compact;
+  const point_batch_t *batch = compact_context->batch;
+
+  for (size_t block = begin; block < end; ++block)
+    {
+      size_t first = block * COMPACT_BLOCK;
+      size_t count = ((compact->count - first) < COMPACT_BLOCK) ? (compact->count - first) : COMPACT_BLOCK;
+      const uint32_t *x = &batch->x[first];
+      const uint32_t *y = &batch->y[first];
+
+      point_bbox_t bounds = { UINT32_MAX, UINT32_MAX, 0U, 0U };
+      for (size_t i = 0; i < count; ++i)
+        {
+          bounds.min_x = (x[i] < bounds.min_x) ? x[i] : bounds.min_x;
+          bounds.min_y = (y[i] < bounds.min_y) ? y[i] : bounds.min_y;
+          bounds.max_x = (x[i] > bounds.max_x) ? x[i] : bounds.max_x;
+          bounds.max_y = (y[i] > bounds.max_y) ? y[i] : bounds.max_y;
+        }
+      compact->bounds[block] = bounds;
+
+      if (((bounds.max_x - bounds.min_x) > COMPACT_MAX_SPAN) || ((bounds.max_y - bounds.min_y) > COMPACT_MAX_SPAN))
+        {
+          atomic_store_explicit (&compact_context->is_out_of_range, true, memory_order_relaxed);
+        }
+      else
+        {
+          compact_narrow (x, count, bounds.min_x, &compact->x[first]);
+          compact_narrow (y, count, bounds.min_y, &compact->y[first]);
+        }
+    }
+}
+
+/**
+ * @brief Parallel task widening a range of blocks into a batch.
+ *
+ * @param context A pointer to the compact_context_t of the conversion.
+ * @param worker The index of the worker, unused.
+ * @param begin The first block of the range.
+ * @param end One past the last block of the range.
+ */
+static void
+compact_export_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  compact_context_t *compact_context = context;
+  const point_compact_t *compact = compact_context->compact;
+  const point_batch_t *batch = compact_context->batch;
+
+  for (size_t block = begin; block < end; ++block)
+    {
+      size_t first = block * COMPACT_BLOCK;
+      size_t count = ((compact->count - first) < COMPACT_BLOCK) ? (compact->count - first) : COMPACT_BLOCK;
+      compact_widen (&compact->x[first], count, compact->bounds[block].min_x, &batch->x[first]);
+      compact_widen (&compact->y[first], count, compact->bounds[block].min_y, &batch->y[first]);
+    }
+}
+
+/**
+ * @brief Create compact points from a batch of points.
+ *
+ * Every block of COMPACT_BLOCK consecutive points stores its coordinates as 16-bit
+ * offsets from the minimum of the block, which halves the memory of the batch and
+ * round-trips exactly. Points that are spatially grouped, such as the points of a
+ * tile or the points sorted along a curve, are therefore required: the coordinates
+ * of each block must not span more than 65535 on either axis. Large batches are
+ * converted by several threads.
+ *
+ * @param batch A pointer to the batch of points, of at most UINT32_MAX points.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return A pointer to the compact points, or NULL if the batch is NULL or too large,
+ * a block spans more than 65535 on either axis, or memory allocation fails.
+ */
+point_compact_t *
+point_compact_create (const point_batch_t *batch, uint32_t threads)
+{
+  point_compact_t *result = NULL;
+  if ((batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (batch->count <= UINT32_MAX))
+    {
+      /* A single block holds the compact points, the bounds of their blocks and their offsets */
+      size_t blocks = (batch->count + COMPACT_BLOCK - 1U) / COMPACT_BLOCK;
+      size_t size = sizeof (point_compact_t) + (blocks * sizeof (point_bbox_t)) + (batch->count * 2U * sizeof (uint16_t));
+      result = malloc (size);
+      if (result != NULL)
+        {
+          result->count = batch->count;
+          result->blocks = blocks;
+          result->bounds = (point_bbox_t *)&result[1];
+          result->x = (uint16_t *)&result->bounds[blocks];
+          result->y = &result->x[batch->count];
+
+          compact_context_t compact_context = { .compact = result, .batch = batch, .is_out_of_range = false };
+          parallel_run (parallel_plan (threads, blocks, PARALLEL_MIN_CHUNK / COMPACT_BLOCK), blocks, compact_create_task, &compact_context);
+          if (atomic_load_explicit (&compact_context.is_out_of_range, memory_order_relaxed))
+            {
+              free (result);
+              result = NULL;
+            }
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Destroy compact points.
+ *
+ * @param compact A pointer to the compact points.
+ *
+ * @return true if the compact points were destroyed, false if the pointer is NULL.
+ */
+bool
+point_compact_destroy (point_compact_t *compact)
+{
+  bool result = false;
+  if (compact != NULL)
+    {
+      free (compact);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Get the number of compact points.
+ *
+ * @param compact A pointer to the compact points.
+ *
+ * @return The number of points, or 0 if the pointer is NULL.
+ */
+size_t
+point_compact_get_count (const point_compact_t *compact)
+{
+  size_t result = 0U;
+  if (compact != NULL)
+    {
+      result = compact->count;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Get the full-width coordinates of one compact point.
+ *
+ * @param compact A pointer to the compact points.
+ * @param index The index of the point in the batch the compact points were created from.
+ * @param value A pointer receiving the coordinates.
+ *
+ * @return true if the coordinates were read, false if an argument is NULL or the index
+ * is out of bounds.
+ */
+bool
+point_compact_get (const point_compact_t *compact, size_t index, point_value_t *value)
+{
+  bool result = false;
+  if ((compact != NULL) && (value != NULL) && (index < compact->count))
+    {
+      const point_bbox_t *bounds = &compact->bounds[index / COMPACT_BLOCK];
+      value->x = bounds->min_x + compact->x[index];
+      value->y = bounds->min_y + compact->y[index];
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Widen compact points back into a batch of full-width points.
+ *
+ * The offsets are widened with SIMD instructions where available, and large sets
+ * are additionally split across threads.
+ *
+ * @param compact A pointer to the compact points.
+ * @param output A pointer to a batch of at least as many points receiving the coordinates.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were widened, false if an argument is NULL or the output
+ * is smaller than the compact points.
+ */
+bool
+point_compact_export (const point_compact_t *compact, const point_batch_t *output, uint32_t threads)
+{
+  bool result = false;
+  if ((compact != NULL) && (output != NULL) && (output->x != NULL) && (output->y != NULL) && (output->count >= compact->count))
+    {
+      compact_context_t compact_context = { .compact = compact, .batch = output, .is_out_of_range = false };
+      parallel_run (parallel_plan (threads, compact->blocks, PARALLEL_MIN_CHUNK / COMPACT_BLOCK), compact->blocks, compact_export_task,
+                    &compact_context);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Compute the axis-aligned bounding box of compact points.
+ *
+ * Only the bounding boxes kept for the blocks are merged, so no coordinate is read.
+ *
+ * @param compact A pointer to the compact points.
+ * @param bbox A pointer receiving the bounding box.
+ *
+ * @return true if the bounding box was computed, false if an argument is NULL or there
+ * are no points.
+ */
+bool
+point_compact_bbox_compute (const point_compact_t *compact, point_bbox_t *bbox)
+{
+  bool result = false;
+  if ((compact != NULL) && (bbox != NULL) && (compact->count > 0U))
+    {
+      point_bbox_t merged = compact->bounds[0];
+      for (size_t block = 1U; block < compact->blocks; ++block)
+        {
+          const point_bbox_t *bounds = &compact->bounds[block];
+          merged.min_x = (bounds->min_x < merged.min_x) ? bounds->min_x : merged.min_x;
+          merged.min_y = (bounds->min_y < merged.min_y) ? bounds->min_y : merged.min_y;
+          merged.max_x = (bounds->max_x > merged.max_x) ? bounds->max_x : merged.max_x;
+          merged.max_y = (bounds->max_y > merged.max_y) ? bounds->max_y : merged.max_y;
+        }
+      *bbox = merged;
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find all compact points inside a rectangular range.
+ *
+ * Blocks outside the range are skipped and blocks inside it are reported whole. In
+ * the other blocks the range is translated to the origin of the block once, and the
+ * offsets are compared in 16 bits.
+ *
+ * @param compact A pointer to the compact points.
+ * @param range A pointer to the range, with inclusive limits.
+ * @param ids A buffer receiving the indices of the points found, in increasing order;
+ * may be NULL if capacity is 0.
+ * @param capacity The number of indices the buffer can hold.
+ *
+ * @return The number of points inside the range. If it exceeds capacity, only the
+ * first capacity indices were written.
+ */
+size_t
+point_compact_query_range (const point_compact_t *compact, const point_bbox_t *range, uint32_t *ids, size_t capacity)
+{
+  size_t result = 0U;
+
+  if ((compact != NULL) && (range != NULL) && ((ids != NULL) || (capacity == 0U)))
+    {
+      for (size_t block = 0; block < compact->blocks; ++block)
+        {
+          const point_bbox_t *bounds = &compact->bounds[block];
+          size_t first = block * COMPACT_BLOCK;
+          size_t count = ((compact->count - first) < COMPACT_BLOCK) ? (compact->count - first) : COMPACT_BLOCK;
+
+          if ((bounds->min_x > range->max_x) || (bounds->max_x < range->min_x) || (bounds->min_y > range->max_y) || (bounds->max_y < range->min_y))
+            {
+              continue;
+            }
+
+          if ((bounds->min_x >= range->min_x) && (bounds->max_x <= range->max_x) && (bounds->min_y >= range->min_y)
+              && (bounds->max_y <= range->max_y))
+            {
+              for (size_t i = 0; (i < count) && ((result + i) < capacity); ++i)
+                {
+                  ids[result + i] = (uint32_t)(first + i);
+                }
+              result += count;
+              continue;
+            }
+
+          /* The range clipped to the block, as offsets and widths from its origin */
+          uint16_t low_x = (uint16_t)((range->min_x > bounds->min_x) ? (range->min_x - bounds->min_x) : 0U);
+          uint16_t low_y = (uint16_t)((range->min_y > bounds->min_y) ? (range->min_y - bounds->min_y) : 0U);
+          uint16_t width = (uint16_t)(((range->max_x < bounds->max_x) ? (range->max_x - bounds->min_x) : (bounds->max_x - bounds->min_x)) - low_x);
+          uint16_t height = (uint16_t)(((range->max_y < bounds->max_y) ? (range->max_y - bounds->min_y) : (bounds->max_y - bounds->min_y)) - low_y);
+          const uint16_t *x = &compact->x[first];
+          const uint16_t *y = &compact->y[first];
+
+          if ((result + count) <= capacity)
+            {
+              /* Every index is written and kept only if inside, which avoids a branch per point */
+              for (size_t i = 0; i < count; ++i)
+                {
+                  ids[result] = (uint32_t)(first + i);
+                  result += ((uint16_t)(x[i] - low_x) <= width) & ((uint16_t)(y[i] - low_y) <= height);
+                }
+            }
+          else
+            {
+              for (size_t i = 0; i < count; ++i)
+                {
+                  if (((uint16_t)(x[i] - low_x) <= width) && ((uint16_t)(y[i] - low_y) <= height))
+                    {
+                      if (result < capacity)
+                        {
+                          ids[result] = (uint32_t)(first + i);
+                        }
+                      ++result;
+                    }
+                }
+            }
+        }
+    }
+
+  return result;
+}
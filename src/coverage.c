@@ -0,0 +1,339 @@
+#ifdef LIB_COVERAGE
+/* dladdr is a GNU extension */
+#define _GNU_SOURCE
+#endif
+
+#include "internal.h"
+
+#ifdef LIB_COVERAGE
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Environment variable naming the file the executed API functions are appended to. */
+#define COVERAGE_ENVIRONMENT "LIBRARY_COVERAGE"
+
+/* Upper bound on the number of distinct API functions that are recorded. */
+#define COVERAGE_MAX_FUNCTIONS 1024U
+
+/* Number of 64-bit words of a bitmap holding one bit per API function. */
+#define COVERAGE_WORDS (COVERAGE_MAX_FUNCTIONS / 64U)
+
+/* Number of entries of the per-thread cache resolving function addresses, a power of two. */
+#define COVERAGE_CACHE_SIZE 256U
+
+/* Number of entries of the shared table resolving function addresses, a power of two. */
+#define COVERAGE_TABLE_SIZE 4096U
+
+/* Identifier of instrumented functions that are not part of the API. */
+#define COVERAGE_NOT_API (-1)
+
+/**
+ * @brief The resolution of an instrumented function address to an API function.
+ */
+typedef struct
+{
+  const void *function;
+  int32_t id;
+} coverage_entry_t;
+
+/**
+ * @brief The coverage of one thread.
+ *
+ * The bitmap holds one bit per API function that the thread entered, and the cache
+ * maps recently entered addresses to their API function identifiers, so that the
+ * hot path neither locks nor calls into the dynamic linker. Only the thread writes
+ * its bitmap, but coverage_write reads it concurrently, hence the atomic words.
+ */
+typedef struct coverage_slot
+{
+  _Atomic uint64_t bits[COVERAGE_WORDS];
+  coverage_entry_t cache[COVERAGE_CACHE_SIZE];
+  struct coverage_slot *previous;
+  struct coverage_slot *next;
+} coverage_slot_t;
+
+static pthread_mutex_t g_coverage_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t g_coverage_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_coverage_key;
+static coverage_slot_t *g_coverage_slots = NULL;
+static uint64_t g_coverage_retired[COVERAGE_WORDS];
+static coverage_entry_t g_coverage_table[COVERAGE_TABLE_SIZE];
+/* Slot of threads whose slot was retired; its empty cache sends every entry to the slow path */
+static coverage_slot_t g_coverage_retired_slot;
+static const char *g_coverage_names[COVERAGE_MAX_FUNCTIONS];
+static uint32_t g_coverage_count = 0U;
+static uint32_t g_coverage_table_count = 0U;
+/* The initial-exec model reads the slot without calling __tls_get_addr on the hot path */
+static _Thread_local coverage_slot_t *t_coverage_slot __attribute__ ((tls_model ("initial-exec"))) = NULL;
+
+void __cyg_profile_func_enter (void *function, void *call_site) __attribute__ ((no_instrument_function));
+void __cyg_profile_func_exit (void *function, void *call_site) __attribute__ ((no_instrument_function));
+static void coverage_retire (void *slot) __attribute__ ((no_instrument_function));
+static void coverage_initialize (void) __attribute__ ((no_instrument_function));
+static int32_t coverage_resolve (const void *function) __attribute__ ((no_instrument_function));
+static void coverage_enter_slow (const void *function) __attribute__ ((no_instrument_function, noinline));
+static void coverage_write (void) __attribute__ ((no_instrument_function, destructor));
+
+/**
+ * @brief Merge the bitmap of an exiting thread into the retired bitmap and release its slot.
+ *
+ * @param slot A pointer to the coverage_slot_t of the thread.
+ */
+static void
+coverage_retire (void *slot)
+{
+  coverage_slot_t *coverage_slot = slot;
+
+  (void)pthread_mutex_lock (&g_coverage_lock);
+  for (uint32_t i = 0; i < COVERAGE_WORDS; ++i)
+    {
+      g_coverage_retired[i] |= atomic_load_explicit (&coverage_slot->bits[i], memory_order_relaxed);
+    }
+
+  if (coverage_slot->previous != NULL)
+    {
+      coverage_slot->previous->next = coverage_slot->next;
+    }
+  else
+    {
+      g_coverage_slots = coverage_slot->next;
+    }
+  if (coverage_slot->next != NULL)
+    {
+      coverage_slot->next->previous = coverage_slot->previous;
+    }
+  (void)pthread_mutex_unlock (&g_coverage_lock);
+
+  /* Functions entered by later destructors of the thread are recorded as retired */
+  t_coverage_slot = &g_coverage_retired_slot;
+  free (coverage_slot);
+}
+
+/**
+ * @brief Create the thread-specific key retiring the slots of exiting threads.
+ */
+static void
+coverage_initialize (void)
+{
+  (void)pthread_key_create (&g_coverage_key, coverage_retire);
+}
+
+/**
+ * @brief Resolve a function address to the identifier of its API function.
+ *
+ * An address is part of the API if it is the exact address of an exported symbol;
+ * static and hidden functions resolve to the nearest exported symbol at best.
+ * Identifiers are assigned in the order in which API functions are first entered.
+ * Must be called with g_coverage_lock held.
+ *
+ * @param function The address of the entered function.
+ *
+ * @return The identifier, or COVERAGE_NOT_API.
+ */
+static int32_t
+coverage_resolve (const void *function)
+{
+  uint32_t index = (uint32_t)(((uintptr_t)function >> 4U) & (COVERAGE_TABLE_SIZE - 1U));
+  while ((g_coverage_table[index].function != NULL) && (g_coverage_table[index].function != function))
+    {
+      index = (index + 1U) & (COVERAGE_TABLE_SIZE - 1U);
+    }
+
+  coverage_entry_t *entry = &g_coverage_table[index];
+  if (entry->function == NULL)
+    {
+      Dl_info info;
+      bool is_api = (dladdr (function, &info) != 0) && (info.dli_saddr == function) && (info.dli_sname != NULL);
+
+      /* Keep one entry free so that lookups of unknown addresses terminate */
+      if (g_coverage_table_count < (COVERAGE_TABLE_SIZE - 1U))
+        {
+          entry->function = function;
+          ++g_coverage_table_count;
+        }
+
+      entry->id = COVERAGE_NOT_API;
+      if (is_api && (entry->function != NULL) && (g_coverage_count < COVERAGE_MAX_FUNCTIONS))
+        {
+          g_coverage_names[g_coverage_count] = info.dli_sname;
+          entry->id = (int32_t)g_coverage_count++;
+        }
+    }
+
+  return entry->id;
+}
+
+/**
+ * @brief Record the entry of a function whose address is not in the thread's cache.
+ *
+ * A thread whose slot was already retired records into the retired bitmap, so that
+ * destructors running after coverage_retire neither lose coverage nor leak a slot.
+ *
+ * @param function The address of the entered function.
+ */
+static void
+coverage_enter_slow (const void *function)
+{
+  coverage_slot_t *slot = t_coverage_slot;
+  if (slot == &g_coverage_retired_slot)
+    {
+      (void)pthread_mutex_lock (&g_coverage_lock);
+      int32_t id = coverage_resolve (function);
+      if (id != COVERAGE_NOT_API)
+        {
+          g_coverage_retired[(uint32_t)id / 64U] |= (uint64_t)1U << ((uint32_t)id % 64U);
+        }
+      (void)pthread_mutex_unlock (&g_coverage_lock);
+      return;
+    }
+
+  if (slot == NULL)
+    {
+      (void)pthread_once (&g_coverage_once, coverage_initialize);
+      slot = calloc (1U, sizeof (coverage_slot_t));
+      if (slot == NULL)
+        {
+          return;
+        }
+
+      (void)pthread_mutex_lock (&g_coverage_lock);
+      slot->next = g_coverage_slots;
+      if (g_coverage_slots != NULL)
+        {
+          g_coverage_slots->previous = slot;
+        }
+      g_coverage_slots = slot;
+      (void)pthread_mutex_unlock (&g_coverage_lock);
+
+      (void)pthread_setspecific (g_coverage_key, slot);
+      t_coverage_slot = slot;
+    }
+
+  (void)pthread_mutex_lock (&g_coverage_lock);
+  int32_t id = coverage_resolve (function);
+  (void)pthread_mutex_unlock (&g_coverage_lock);
+
+  coverage_entry_t *entry = &slot->cache[((uintptr_t)function >> 4U) & (COVERAGE_CACHE_SIZE - 1U)];
+  entry->function = function;
+  entry->id = id;
+  if (id != COVERAGE_NOT_API)
+    {
+      _Atomic uint64_t *word = &slot->bits[(uint32_t)id / 64U];
+      uint64_t bit = (uint64_t)1U << ((uint32_t)id % 64U);
+      atomic_store_explicit (word, atomic_load_explicit (word, memory_order_relaxed) | bit, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Instrumentation hook called on the entry of every function of the library.
+ *
+ * The hot path is a thread-local cache lookup and a bit test, and the bitmap is only
+ * written the first time a thread enters an API function.
+ *
+ * @param function The address of the entered function.
+ * @param call_site The address of the call, unused.
+ */
+void
+__cyg_profile_func_enter (void *function, void *call_site)
+{
+  (void)call_site;
+  coverage_slot_t *slot = t_coverage_slot;
+  const coverage_entry_t *entry = (slot != NULL) ? &slot->cache[((uintptr_t)function >> 4U) & (COVERAGE_CACHE_SIZE - 1U)] : NULL;
+
+  if ((entry != NULL) && (entry->function == function))
+    {
+      if (entry->id != COVERAGE_NOT_API)
+        {
+          /* Relaxed accesses suffice, as the thread is the only writer of its bitmap */
+          _Atomic uint64_t *word = &slot->bits[(uint32_t)entry->id / 64U];
+          uint64_t bit = (uint64_t)1U << ((uint32_t)entry->id % 64U);
+          uint64_t value = atomic_load_explicit (word, memory_order_relaxed);
+          if ((value & bit) == 0U)
+            {
+              atomic_store_explicit (word, value | bit, memory_order_relaxed);
+            }
+        }
+    }
+  else
+    {
+      coverage_enter_slow (function);
+    }
+}
+
+/**
+ * @brief Instrumentation hook called on the exit of every function of the library, unused.
+ *
+ * @param function The address of the exited function.
+ * @param call_site The address of the call.
+ */
+void
+__cyg_profile_func_exit (void *function, void *call_site)
+{
+  (void)function;
+  (void)call_site;
+}
+
+/**
+ * @brief Append the names of the executed API functions to the coverage file.
+ *
+ * Runs when the library is unloaded, typically at process exit. The bitmaps of the
+ * remaining threads and of the exited ones are merged, and one line per executed
+ * API function is appended with a single write, so that several processes, such as
+ * parallel test workers, can share a coverage file.
+ */
+static void
+coverage_write (void)
+{
+  const char *path = getenv (COVERAGE_ENVIRONMENT);
+  if (path == NULL)
+    {
+      return;
+    }
+
+  (void)pthread_mutex_lock (&g_coverage_lock);
+  uint64_t bits[COVERAGE_WORDS];
+  memcpy (bits, g_coverage_retired, sizeof (bits));
+  for (const coverage_slot_t *slot = g_coverage_slots; slot != NULL; slot = slot->next)
+    {
+      for (uint32_t i = 0; i < COVERAGE_WORDS; ++i)
+        {
+          bits[i] |= atomic_load_explicit (&slot->bits[i], memory_order_relaxed);
+        }
+    }
+
+  size_t size = 0;
+  for (uint32_t i = 0; i < g_coverage_count; ++i)
+    {
+      size += ((bits[i / 64U] >> (i % 64U)) & 1U) ? (strlen (g_coverage_names[i]) + 1U) : 0U;
+    }
+
+  char *buffer = malloc (size + 1U);
+  if (buffer != NULL)
+    {
+      size_t length = 0;
+      for (uint32_t i = 0; i < g_coverage_count; ++i)
+        {
+          if ((bits[i / 64U] >> (i % 64U)) & 1U)
+            {
+              size_t name_length = strlen (g_coverage_names[i]);
+              memcpy (&buffer[length], g_coverage_names[i], name_length);
+              length += name_length;
+              buffer[length++] = '\n';
+            }
+        }
+
+      int descriptor = open (path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+      if (descriptor >= 0)
+        {
+          (void)write (descriptor, buffer, length);
+          (void)close (descriptor);
+        }
+      free (buffer);
+    }
+  (void)pthread_mutex_unlock (&g_coverage_lock);
+}
+#endif
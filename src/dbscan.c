@@ -0,0 +1,689 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Label of the points that belong to no cluster. */
+#define DBSCAN_NOISE UINT32_MAX
+
+/* Upper bound on the number of cells, along each axis, between a cell and the farthest cell within reach. */
+#define DBSCAN_MAX_REACH 2U
+
+/* Upper bound on the number of grid cells within reach of a cell, including itself. */
+#define DBSCAN_MAX_NEIGHBORS (((2U * DBSCAN_MAX_REACH) + 1U) * ((2U * DBSCAN_MAX_REACH) + 1U))
+
+/* Minimum number of points handled by a worker; every point scans a whole neighborhood. */
+#define DBSCAN_MIN_CHUNK 4096U
+
+/**
+ * @brief Shared state of a clustering run.
+ *
+ * The points are bucketed into square grid cells whose diagonal is at most epsilon,
+ * so the points of a cell are all neighbors of each other, and the neighbors of a
+ * point lie in the few cells within reach of its own. Cells are identified by a key
+ * holding their row above their column, and the points are sorted by key so every
+ * cell is a contiguous run of coordinates. Clusters are merged per cell with a
+ * lock-free union-find whose roots are always the lowest cell of their set.
+ */
+typedef struct
+{
+  point_t *const *points;
+  const point_batch_t *batch;
+  size_t count;
+  uint32_t epsilon;
+  uint64_t epsilon_squared;
+  uint32_t min_points;
+  uint32_t side;
+  uint32_t reach;
+  uint32_t *labels;
+  size_t present;
+  size_t cell_count;
+  uint64_t *keys;
+  uint32_t *values;
+  uint32_t *x;
+  uint32_t *y;
+  uint32_t *cell_start;
+  uint8_t *is_core;
+  _Atomic uint32_t *parents;
+  uint32_t *clusters;
+} dbscan_context_t;
+
+/**
+ * @brief The cells near the cell visited by a task, tracked with a cursor per grid row.
+ *
+ * Tasks visit cells in ascending key order, so along a row the first candidate cell
+ * of every nearby row only moves forward, and it is only searched again when the
+ * visit moves on to another row.
+ */
+typedef struct
+{
+  bool is_set;
+  uint64_t row;
+  size_t cursors[(2U * DBSCAN_MAX_REACH) + 1U];
+} dbscan_window_t;
+
+/**
+ * @brief Read a point of the batch or the array of a context.
+ *
+ * @param dbscan_context A pointer to the context.
+ * @param index The index of the point.
+ * @param x A pointer receiving the x-coordinate.
+ * @param y A pointer receiving the y-coordinate.
+ *
+ * @return true if the point exists, false if the array entry is NULL.
+ */
+static bool
+dbscan_read (const dbscan_context_t *dbscan_context, size_t index, uint32_t *x, uint32_t *y)
+{
+  bool result = true;
+  if (dbscan_context->batch != NULL)
+    {
+      *x = dbscan_context->batch->x[index];
+      *y = dbscan_context->batch->y[index];
+    }
+  else
+    {
+      const point_t *point = dbscan_context->points[index];
+      result = (point != NULL);
+      *x = result ? point->x : 0U;
+      *y = result ? point->y : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Determine the side of the grid cells for a neighborhood radius.
+ *
+ * Coordinates within a cell differ by at most side - 1 on each axis, so the side is
+ * one more than the largest s with 2 * s * s <= epsilon * epsilon.
+ *
+ * @param epsilon The neighborhood radius.
+ *
+ * @return The side of the cells, at least 1.
+ */
+static uint32_t
+dbscan_side (uint32_t epsilon)
+{
+  uint64_t half = ((uint64_t)epsilon * epsilon) / 2U;
+  uint64_t low = 0;
+  uint64_t high = (uint64_t)UINT32_MAX + 1U;
+
+  /* Binary search for the integer square root, without relying on libm rounding */
+  while ((high - low) > 1U)
+    {
+      uint64_t middle = low + ((high - low) / 2U);
+      low = ((middle * middle) <= half) ? middle : low;
+      high = ((middle * middle) <= half) ? high : middle;
+    }
+
+  return (uint32_t)low + 1U;
+}
+
+/**
+ * @brief Test whether two points are within a radius without overflowing.
+ *
+ * @param dx The distance between the points along x.
+ * @param dy The distance between the points along y.
+ * @param epsilon The radius.
+ * @param epsilon_squared The square of the radius.
+ *
+ * @return true if the Euclidean distance is at most the radius.
+ */
+static inline bool
+dbscan_is_within (uint64_t dx, uint64_t dy, uint64_t epsilon, uint64_t epsilon_squared)
+{
+  /* The subtraction may wrap when dy exceeds epsilon, but the result is then masked out */
+  return (dx <= epsilon) & (dy <= epsilon) & ((dx * dx) <= (epsilon_squared - (dy * dy)));
+}
+
+/**
+ * @brief Find the first cell whose key is not below a key.
+ *
+ * @param dbscan_context A pointer to the context with its cell keys set.
+ * @param key The key to search.
+ *
+ * @return The index of the cell, or the number of cells if every key is below.
+ */
+static size_t
+dbscan_search_key (const dbscan_context_t *dbscan_context, uint64_t key)
+{
+  size_t low = 0;
+  size_t high = dbscan_context->cell_count;
+  while (low < high)
+    {
+      size_t middle = low + ((high - low) / 2U);
+      low = (dbscan_context->keys[middle] < key) ? (middle + 1U) : low;
+      high = (dbscan_context->keys[middle] < key) ? high : middle;
+    }
+
+  return low;
+}
+
+/**
+ * @brief Find the first cell starting at or after a sorted position.
+ *
+ * @param dbscan_context A pointer to the context with its cells set.
+ * @param position The sorted position.
+ *
+ * @return The index of the cell, or the number of cells if every cell starts before.
+ */
+static size_t
+dbscan_search_position (const dbscan_context_t *dbscan_context, size_t position)
+{
+  size_t low = 0;
+  size_t high = dbscan_context->cell_count;
+  while (low < high)
+    {
+      size_t middle = low + ((high - low) / 2U);
+      low = (dbscan_context->cell_start[middle] < position) ? (middle + 1U) : low;
+      high = (dbscan_context->cell_start[middle] < position) ? high : middle;
+    }
+
+  return low;
+}
+
+/**
+ * @brief List the cells that may hold neighbors of the points of a cell.
+ *
+ * A cell is listed when the closest coordinates it can hold are within epsilon of
+ * the coordinates of the given cell. The cell itself is included, and ties in the
+ * distance are listed in ascending order.
+ *
+ * @param dbscan_context A pointer to the context with its cells set.
+ * @param window A pointer to the window of the task, zeroed before its first cell.
+ * @param cell The index of the cell, above any cell the window visited before.
+ * @param neighbors A buffer of DBSCAN_MAX_NEIGHBORS elements receiving the cells, nearest first.
+ *
+ * @return The number of listed cells.
+ */
+static uint32_t
+dbscan_neighbors (const dbscan_context_t *dbscan_context, dbscan_window_t *window, size_t cell, size_t *neighbors)
+{
+  uint32_t result = 0;
+  int64_t reach = dbscan_context->reach;
+  int64_t column = (int64_t)(dbscan_context->keys[cell] & UINT32_MAX);
+  int64_t row = (int64_t)(dbscan_context->keys[cell] >> 32U);
+  bool is_same_row = window->is_set && (window->row == (uint64_t)row);
+  uint64_t gaps[DBSCAN_MAX_NEIGHBORS];
+  window->is_set = true;
+  window->row = (uint64_t)row;
+
+  for (int64_t dy = -reach; dy <= reach; ++dy)
+    {
+      if (((row + dy) < 0) || ((row + dy) > (int64_t)UINT32_MAX))
+        {
+          continue;
+        }
+
+      uint64_t base = (uint64_t)(row + dy) << 32U;
+      uint64_t first = base | (uint64_t)(((column - reach) < 0) ? 0 : (column - reach));
+      uint64_t last = base | (uint64_t)(((column + reach) > (int64_t)UINT32_MAX) ? (int64_t)UINT32_MAX : (column + reach));
+      size_t *cursor = &window->cursors[dy + reach];
+      *cursor = is_same_row ? *cursor : dbscan_search_key (dbscan_context, first);
+      while ((*cursor < dbscan_context->cell_count) && (dbscan_context->keys[*cursor] < first))
+        {
+          ++*cursor;
+        }
+
+      for (size_t n = *cursor; (n < dbscan_context->cell_count) && (dbscan_context->keys[n] <= last); ++n)
+        {
+          /* Cells one apart hold coordinates as close as 1, cells k apart as close as (k - 1) * side + 1 */
+          int64_t dx = (int64_t)(dbscan_context->keys[n] & UINT32_MAX) - column;
+          uint64_t gap_x = (dx == 0) ? 0U : ((uint64_t)(((dx < 0) ? -dx : dx) - 1) * dbscan_context->side) + 1U;
+          uint64_t gap_y = (dy == 0) ? 0U : ((uint64_t)(((dy < 0) ? -dy : dy) - 1) * dbscan_context->side) + 1U;
+          if (dbscan_is_within (gap_x, gap_y, dbscan_context->epsilon, dbscan_context->epsilon_squared))
+            {
+              /* Insert nearest first, so counts reach min_points early and merges start with likely links */
+              uint64_t gap = (gap_x * gap_x) + (gap_y * gap_y);
+              uint32_t position = result++;
+              while ((position > 0U) && (gaps[position - 1U] > gap))
+                {
+                  neighbors[position] = neighbors[position - 1U];
+                  gaps[position] = gaps[position - 1U];
+                  --position;
+                }
+              neighbors[position] = n;
+              gaps[position] = gap;
+            }
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Count the points of a sorted range within epsilon of a point.
+ *
+ * @param dbscan_context A pointer to the context with its sorted coordinates set.
+ * @param px The x-coordinate of the point.
+ * @param py The y-coordinate of the point.
+ * @param begin The first sorted position of the range.
+ * @param end One past the last sorted position of the range.
+ *
+ * @return The number of points of the range within epsilon.
+ */
+static size_t
+dbscan_count_within (const dbscan_context_t *dbscan_context, uint32_t px, uint32_t py, size_t begin, size_t end)
+{
+  size_t result = 0;
+  const uint32_t *restrict x = dbscan_context->x;
+  const uint32_t *restrict y = dbscan_context->y;
+  uint64_t epsilon = dbscan_context->epsilon;
+  uint64_t epsilon_squared = dbscan_context->epsilon_squared;
+
+  for (size_t i = begin; i < end; ++i)
+    {
+      uint64_t dx = (px > x[i]) ? (px - x[i]) : (x[i] - px);
+      uint64_t dy = (py > y[i]) ? (py - y[i]) : (y[i] - py);
+      result += dbscan_is_within (dx, dy, epsilon, epsilon_squared) ? 1U : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Test whether a cell holds a core point within epsilon of a point.
+ *
+ * @param dbscan_context A pointer to the context with its core points set.
+ * @param px The x-coordinate of the point.
+ * @param py The y-coordinate of the point.
+ * @param cell The index of the cell.
+ *
+ * @return true if a core point of the cell is within epsilon.
+ */
+static bool
+dbscan_has_core_within (const dbscan_context_t *dbscan_context, uint32_t px, uint32_t py, size_t cell)
+{
+  bool result = false;
+  for (size_t i = dbscan_context->cell_start[cell]; !result && (i < dbscan_context->cell_start[cell + 1U]); ++i)
+    {
+      uint64_t dx = (px > dbscan_context->x[i]) ? (px - dbscan_context->x[i]) : (dbscan_context->x[i] - px);
+      uint64_t dy = (py > dbscan_context->y[i]) ? (py - dbscan_context->y[i]) : (dbscan_context->y[i] - py);
+      result = (dbscan_context->is_core[i] != 0U) && dbscan_is_within (dx, dy, dbscan_context->epsilon, dbscan_context->epsilon_squared);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the root of the set of a cell, halving the path on the way.
+ *
+ * Every parent is lower than its child, so replacing a parent by the grandparent
+ * keeps the forest valid while other threads link roots concurrently.
+ *
+ * @param parents The parent of every cell.
+ * @param cell The index of the cell.
+ *
+ * @return The lowest cell of the set.
+ */
+static uint32_t
+dbscan_find (_Atomic uint32_t *parents, uint32_t cell)
+{
+  uint32_t result = cell;
+  uint32_t parent = atomic_load (&parents[result]);
+  while (parent != result)
+    {
+      uint32_t grandparent = atomic_load (&parents[parent]);
+      if (grandparent != parent)
+        {
+          (void)atomic_compare_exchange_weak (&parents[result], &parent, grandparent);
+        }
+      result = grandparent;
+      parent = atomic_load (&parents[result]);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Merge the sets of two cells without locks.
+ *
+ * The higher root is linked below the lower one with a compare-and-swap, which
+ * fails and is retried if another thread linked that root first.
+ *
+ * @param parents The parent of every cell.
+ * @param a The index of the first cell.
+ * @param b The index of the second cell.
+ */
+static void
+dbscan_union (_Atomic uint32_t *parents, uint32_t a, uint32_t b)
+{
+  bool is_linked = false;
+  while (!is_linked)
+    {
+      uint32_t root_a = dbscan_find (parents, a);
+      uint32_t root_b = dbscan_find (parents, b);
+      uint32_t low = (root_a < root_b) ? root_a : root_b;
+      uint32_t high = (root_a < root_b) ? root_b : root_a;
+      is_linked = (low == high) || atomic_compare_exchange_strong (&parents[high], &high, low);
+    }
+}
+
+/**
+ * @brief Parallel task gathering the coordinates of a slice of sorted positions.
+ *
+ * @param context A pointer to the dbscan_context_t of the run.
+ * @param worker The index of the worker, unused.
+ * @param begin The first sorted position of the slice.
+ * @param end One past the last sorted position of the slice.
+ */
+static void
+dbscan_gather_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const dbscan_context_t *dbscan_context = context;
+  for (size_t i = begin; i < end; ++i)
+    {
+      (void)dbscan_read (dbscan_context, dbscan_context->values[i], &dbscan_context->x[i], &dbscan_context->y[i]);
+    }
+}
+
+/**
+ * @brief Parallel task finding the core points of the cells starting in a slice.
+ *
+ * Cells holding at least min_points points only hold core points, and cells with
+ * fewer points within reach hold none. Otherwise each point counts its neighbors
+ * cell by cell, and stops once it has enough.
+ *
+ * @param context A pointer to the dbscan_context_t of the run.
+ * @param worker The index of the worker, unused.
+ * @param begin The first sorted position of the slice.
+ * @param end One past the last sorted position of the slice.
+ */
+static void
+dbscan_core_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const dbscan_context_t *dbscan_context = context;
+  size_t neighbors[DBSCAN_MAX_NEIGHBORS];
+  dbscan_window_t window = { 0 };
+
+  for (size_t cell = dbscan_search_position (dbscan_context, begin); (cell < dbscan_context->cell_count) && (dbscan_context->cell_start[cell] < end);
+       ++cell)
+    {
+      size_t first = dbscan_context->cell_start[cell];
+      size_t last = dbscan_context->cell_start[cell + 1U];
+      bool is_dense = ((last - first) >= dbscan_context->min_points);
+      uint32_t neighbor_count = is_dense ? 0U : dbscan_neighbors (dbscan_context, &window, cell, neighbors);
+      bool has_core = false;
+
+      /* Without enough points in reach of the cell, none of its points are counted */
+      size_t reachable = 0;
+      for (uint32_t n = 0; n < neighbor_count; ++n)
+        {
+          reachable += (size_t)dbscan_context->cell_start[neighbors[n] + 1U] - dbscan_context->cell_start[neighbors[n]];
+        }
+      neighbor_count = (reachable >= dbscan_context->min_points) ? neighbor_count : 0U;
+
+      for (size_t i = first; i < last; ++i)
+        {
+          size_t count = last - first;
+          for (uint32_t n = 0; (count < dbscan_context->min_points) && (n < neighbor_count); ++n)
+            {
+              size_t other = neighbors[n];
+              count += (other == cell) ? 0U
+                                       : dbscan_count_within (dbscan_context, dbscan_context->x[i], dbscan_context->y[i],
+                                                              dbscan_context->cell_start[other], dbscan_context->cell_start[other + 1U]);
+            }
+          dbscan_context->is_core[i] = (count >= dbscan_context->min_points) ? 1U : 0U;
+          has_core = has_core || (count >= dbscan_context->min_points);
+        }
+
+      /* Until the clusters are numbered, a cell holding a core point is marked with 0 */
+      atomic_init (&dbscan_context->parents[cell], (uint32_t)cell);
+      dbscan_context->clusters[cell] = has_core ? 0U : DBSCAN_NOISE;
+    }
+}
+
+/**
+ * @brief Parallel task merging the cells starting in a slice with their neighbor cells.
+ *
+ * Two cells holding core points join the same set when a core point of one is
+ * within epsilon of a core point of the other. Each pair is examined from its lower
+ * cell, and skipped if the cells already share a set.
+ *
+ * @param context A pointer to the dbscan_context_t of the run.
+ * @param worker The index of the worker, unused.
+ * @param begin The first sorted position of the slice.
+ * @param end One past the last sorted position of the slice.
+ */
+static void
+dbscan_merge_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const dbscan_context_t *dbscan_context = context;
+  size_t neighbors[DBSCAN_MAX_NEIGHBORS];
+  dbscan_window_t window = { 0 };
+
+  for (size_t cell = dbscan_search_position (dbscan_context, begin); (cell < dbscan_context->cell_count) && (dbscan_context->cell_start[cell] < end);
+       ++cell)
+    {
+      uint32_t neighbor_count = (dbscan_context->clusters[cell] != DBSCAN_NOISE) ? dbscan_neighbors (dbscan_context, &window, cell, neighbors) : 0U;
+      uint32_t root = (neighbor_count > 0U) ? dbscan_find (dbscan_context->parents, (uint32_t)cell) : (uint32_t)cell;
+      for (uint32_t n = 0; n < neighbor_count; ++n)
+        {
+          /* A stale root only costs an extra scan, as sets are never split */
+          size_t other = neighbors[n];
+          bool is_candidate = (other > cell) && (dbscan_context->clusters[other] != DBSCAN_NOISE)
+                              && (root != dbscan_find (dbscan_context->parents, (uint32_t)other));
+
+          bool is_linked = false;
+          for (size_t i = dbscan_context->cell_start[cell]; is_candidate && !is_linked && (i < dbscan_context->cell_start[cell + 1U]); ++i)
+            {
+              is_linked = (dbscan_context->is_core[i] != 0U)
+                          && dbscan_has_core_within (dbscan_context, dbscan_context->x[i], dbscan_context->y[i], other);
+            }
+          if (is_linked)
+            {
+              dbscan_union (dbscan_context->parents, (uint32_t)cell, (uint32_t)other);
+              root = dbscan_find (dbscan_context->parents, (uint32_t)cell);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Parallel task labeling the points of the cells starting in a slice.
+ *
+ * All points of a cell holding a core point are within epsilon of it, and take its
+ * cluster. The points of other cells take the cluster of the nearest neighbor cell
+ * holding a core point within epsilon, or are noise.
+ *
+ * @param context A pointer to the dbscan_context_t of the run.
+ * @param worker The index of the worker, unused.
+ * @param begin The first sorted position of the slice.
+ * @param end One past the last sorted position of the slice.
+ */
+static void
+dbscan_label_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const dbscan_context_t *dbscan_context = context;
+  size_t neighbors[DBSCAN_MAX_NEIGHBORS];
+  dbscan_window_t window = { 0 };
+
+  for (size_t cell = dbscan_search_position (dbscan_context, begin); (cell < dbscan_context->cell_count) && (dbscan_context->cell_start[cell] < end);
+       ++cell)
+    {
+      uint32_t cluster = dbscan_context->clusters[cell];
+      uint32_t neighbor_count = (cluster == DBSCAN_NOISE) ? dbscan_neighbors (dbscan_context, &window, cell, neighbors) : 0U;
+
+      for (size_t i = dbscan_context->cell_start[cell]; i < dbscan_context->cell_start[cell + 1U]; ++i)
+        {
+          uint32_t label = cluster;
+          for (uint32_t n = 0; (label == DBSCAN_NOISE) && (n < neighbor_count); ++n)
+            {
+              size_t other = neighbors[n];
+              bool is_border = (dbscan_context->clusters[other] != DBSCAN_NOISE)
+                               && dbscan_has_core_within (dbscan_context, dbscan_context->x[i], dbscan_context->y[i], other);
+              label = is_border ? dbscan_context->clusters[other] : DBSCAN_NOISE;
+            }
+          dbscan_context->labels[dbscan_context->values[i]] = label;
+        }
+    }
+}
+
+/**
+ * @brief Cluster the points of a context with DBSCAN.
+ *
+ * @param dbscan_context A pointer to the context with its input, parameters and labels set.
+ * @param cluster_count A pointer receiving the number of clusters, or NULL.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if the points were clustered, false on allocation failure.
+ */
+static bool
+dbscan_compute (dbscan_context_t *dbscan_context, size_t *cluster_count, uint32_t threads)
+{
+  bool result = false;
+  size_t count = dbscan_context->count;
+
+  /* A single block holds the keys, the values and their sort scratch, then the per-cell state */
+  size_t size = (count * 2U * sizeof (uint64_t)) + (((count * 4U) + 1U) * sizeof (uint32_t)) + (count * sizeof (uint8_t));
+  uint64_t *block = malloc (size);
+  if (block != NULL)
+    {
+      uint64_t *tmp_keys = &block[count];
+      uint32_t *tmp_values = (uint32_t *)&block[count * 2U];
+      dbscan_context->keys = block;
+      dbscan_context->values = &tmp_values[count + 1U];
+      dbscan_context->parents = (_Atomic uint32_t *)&dbscan_context->values[count];
+      dbscan_context->clusters = (uint32_t *)&dbscan_context->parents[count];
+      dbscan_context->is_core = (uint8_t *)&dbscan_context->clusters[count];
+      dbscan_context->side = dbscan_side (dbscan_context->epsilon);
+      dbscan_context->reach = (dbscan_context->epsilon == 0U) ? 0U : (((dbscan_context->epsilon - 1U) / dbscan_context->side) + 1U);
+      dbscan_context->epsilon_squared = (uint64_t)dbscan_context->epsilon * dbscan_context->epsilon;
+
+      size_t present = 0;
+      for (size_t i = 0; i < count; ++i)
+        {
+          uint32_t x = 0U;
+          uint32_t y = 0U;
+          if (dbscan_read (dbscan_context, i, &x, &y))
+            {
+              dbscan_context->keys[present] = ((uint64_t)(y / dbscan_context->side) << 32U) | (x / dbscan_context->side);
+              dbscan_context->values[present++] = (uint32_t)i;
+            }
+          else
+            {
+              dbscan_context->labels[i] = DBSCAN_NOISE;
+            }
+        }
+      sort_keys (dbscan_context->keys, dbscan_context->values, tmp_keys, tmp_values, present);
+
+      /* Once sorted, the scratch keys hold the coordinates and the scratch values the cell starts */
+      dbscan_context->present = present;
+      dbscan_context->x = (uint32_t *)tmp_keys;
+      dbscan_context->y = &dbscan_context->x[count];
+      dbscan_context->cell_start = tmp_values;
+      size_t cells = 0;
+      for (size_t i = 0; i < present; ++i)
+        {
+          if ((i == 0U) || (dbscan_context->keys[i] != dbscan_context->keys[cells - 1U]))
+            {
+              dbscan_context->keys[cells] = dbscan_context->keys[i];
+              dbscan_context->cell_start[cells++] = (uint32_t)i;
+            }
+        }
+      dbscan_context->cell_start[cells] = (uint32_t)present;
+      dbscan_context->cell_count = cells;
+
+      uint32_t workers = parallel_plan (threads, present, DBSCAN_MIN_CHUNK);
+      parallel_run (workers, present, dbscan_gather_task, dbscan_context);
+      parallel_run (workers, present, dbscan_core_task, dbscan_context);
+      parallel_run (workers, present, dbscan_merge_task, dbscan_context);
+
+      /* Roots are the lowest cell of their set, so they are numbered before the rest of it */
+      size_t clusters = 0;
+      for (size_t cell = 0; cell < cells; ++cell)
+        {
+          if (dbscan_context->clusters[cell] != DBSCAN_NOISE)
+            {
+              uint32_t root = dbscan_find (dbscan_context->parents, (uint32_t)cell);
+              dbscan_context->clusters[cell] = (root == cell) ? (uint32_t)clusters++ : dbscan_context->clusters[root];
+            }
+        }
+      parallel_run (workers, present, dbscan_label_task, dbscan_context);
+
+      if (cluster_count != NULL)
+        {
+          *cluster_count = clusters;
+        }
+      free (block);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Cluster an array of points with DBSCAN.
+ *
+ * A point is a core point when at least min_points points, itself included, lie
+ * within a Euclidean distance of epsilon. Core points within epsilon of each other
+ * share a cluster, and other points join the cluster of a core point within epsilon
+ * or are noise. A uniform grid limits every neighbor search to a few cells, the
+ * core points are found in parallel, and the clusters are merged with a lock-free
+ * union-find, so the cost grows with the density of the points rather than with
+ * the square of their number.
+ *
+ * Clusters are numbered from 0 in the order of their lowest grid cell, so the labels
+ * do not depend on the number of threads. A point within epsilon of the core points
+ * of several clusters joins one of them.
+ *
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the array, at most UINT32_MAX.
+ * @param epsilon The neighborhood radius.
+ * @param min_points The number of points within epsilon making a core point, at least 1.
+ * @param labels A buffer of count elements receiving the cluster of each point, or
+ * UINT32_MAX for noise and NULL entries.
+ * @param cluster_count A pointer receiving the number of clusters, or NULL.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were clustered, false if an argument is NULL or out of
+ * range, or memory allocation fails.
+ */
+bool
+point_dbscan_compute (point_t *const *points, size_t count, uint32_t epsilon, uint32_t min_points, uint32_t *labels, size_t *cluster_count,
+                      uint32_t threads)
+{
+  bool result = false;
+  if ((points != NULL) && (count <= UINT32_MAX) && (min_points > 0U) && (labels != NULL))
+    {
+      dbscan_context_t dbscan_context = { .points = points, .count = count, .epsilon = epsilon, .min_points = min_points, .labels = labels };
+      result = dbscan_compute (&dbscan_context, cluster_count, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Cluster a batch of points with DBSCAN.
+ *
+ * The coordinates are read in place, otherwise the points are clustered as by
+ * point_dbscan_compute.
+ *
+ * @param batch A pointer to the batch of points, of at most UINT32_MAX points.
+ * @param epsilon The neighborhood radius.
+ * @param min_points The number of points within epsilon making a core point, at least 1.
+ * @param labels A buffer of batch->count elements receiving the cluster of each point,
+ * or UINT32_MAX for noise.
+ * @param cluster_count A pointer receiving the number of clusters, or NULL.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were clustered, false if an argument is NULL or out of
+ * range, or memory allocation fails.
+ */
+bool
+point_batch_dbscan_compute (const point_batch_t *batch, uint32_t epsilon, uint32_t min_points, uint32_t *labels, size_t *cluster_count,
+                            uint32_t threads)
+{
+  bool result = false;
+  if ((batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (batch->count <= UINT32_MAX) && (min_points > 0U) && (labels != NULL))
+    {
+      dbscan_context_t dbscan_context = { .batch = batch, .count = batch->count, .epsilon = epsilon, .min_points = min_points, .labels = labels };
+      result = dbscan_compute (&dbscan_context, cluster_count, threads);
+    }
+
+  return result;
+}
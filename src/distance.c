@@ -0,0 +1,514 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of columns per tile; the 8 KB of coordinates of a tile stay in the L1 cache. */
+#define DISTANCE_COLUMN_TILE 1024U
+
+/* Number of rows sharing a column tile before the next tile is processed. */
+#define DISTANCE_ROW_BLOCK 64U
+
+/* Size in bytes of the top-k heaps of a row block, sized for the L2 cache. */
+#define DISTANCE_HEAP_BUDGET 262144U
+
+/* Number of tile entries whose minimum is compared against the heap root before they are scanned one by one. */
+#define DISTANCE_FILTER_CHUNK 16U
+
+/* Index reported for top-k entries that no column filled. */
+#define DISTANCE_NO_INDEX UINT32_MAX
+
+/**
+ * @brief Shared state of a pairwise distance computation.
+ *
+ * The coordinates are structure-of-arrays, either the caller's batches or copies
+ * gathered from point arrays. The missing flags mark NULL entries of point arrays
+ * and are NULL if every entry is present. A k of 0 selects the full matrix.
+ */
+typedef struct
+{
+  const uint32_t *row_x;
+  const uint32_t *row_y;
+  const uint8_t *row_missing;
+  const uint32_t *column_x;
+  const uint32_t *column_y;
+  const uint8_t *column_missing;
+  size_t column_count;
+  uint64_t *matrix;
+  uint32_t k;
+  uint32_t *indices;
+  uint64_t *distances;
+  size_t block_rows;
+  uint64_t *scratch;
+  size_t scratch_stride;
+} distance_context_t;
+
+/**
+ * @brief Compute the squared distances between one point and a tile of columns.
+ *
+ * The differences are taken in 32 bits and squared in 64 bits, and the sum saturates
+ * at UINT64_MAX instead of wrapping. The carry is derived with bitwise operations
+ * rather than a comparison, so the loop vectorizes without 64-bit compare instructions.
+ *
+ * @param px The x-coordinate of the point.
+ * @param py The y-coordinate of the point.
+ * @param x The x-coordinates of the columns.
+ * @param y The y-coordinates of the columns.
+ * @param count The number of columns.
+ * @param output A buffer of count elements receiving the squared distances.
+ */
+static void
+distance_row (uint32_t px, uint32_t py, const uint32_t *restrict x, const uint32_t *restrict y, size_t count, uint64_t *restrict output)
+{
+  for (size_t j = 0; j < count; ++j)
+    {
+      uint32_t dx = (x[j] > px) ? (x[j] - px) : (px - x[j]);
+      uint32_t dy = (y[j] > py) ? (y[j] - py) : (py - y[j]);
+      uint64_t square_x = (uint64_t)dx * dx;
+      uint64_t square_y = (uint64_t)dy * dy;
+      uint64_t sum = square_x + square_y;
+      uint64_t carry = ((square_x & square_y) | ((square_x | square_y) & ~sum)) >> 63U;
+      output[j] = sum | (0U - carry);
+    }
+}
+
+/**
+ * @brief Parallel task filling the matrix rows of one slice.
+ *
+ * Rows are processed in blocks that sweep the columns tile by tile, so a tile is
+ * loaded from memory once per block rather than once per row.
+ *
+ * @param context A pointer to the distance_context_t of the computation.
+ * @param worker The index of the worker, unused.
+ * @param begin The first row of the slice.
+ * @param end One past the last row of the slice.
+ */
+static void
+distance_matrix_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const distance_context_t *distance = context;
+  size_t column_count = distance->column_count;
+
+  for (size_t block = begin; block < end; block += DISTANCE_ROW_BLOCK)
+    {
+      size_t block_end = ((end - block) < DISTANCE_ROW_BLOCK) ? end : (block + DISTANCE_ROW_BLOCK);
+      for (size_t tile = 0; tile < column_count; tile += DISTANCE_COLUMN_TILE)
+        {
+          size_t tile_count = ((column_count - tile) < DISTANCE_COLUMN_TILE) ? (column_count - tile) : DISTANCE_COLUMN_TILE;
+          for (size_t row = block; row < block_end; ++row)
+            {
+              uint64_t *output = &distance->matrix[(row * column_count) + tile];
+              distance_row (distance->row_x[row], distance->row_y[row], &distance->column_x[tile], &distance->column_y[tile], tile_count, output);
+
+              /* NULL entries of point arrays are infinitely far from everything */
+              for (size_t j = 0; (distance->column_missing != NULL) && (j < tile_count); ++j)
+                {
+                  output[j] = distance->column_missing[tile + j] ? UINT64_MAX : output[j];
+                }
+              if ((distance->row_missing != NULL) && distance->row_missing[row])
+                {
+                  memset (output, 0xFF, tile_count * sizeof (uint64_t));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Restore the max-heap order of a top-k heap from its root downwards.
+ *
+ * Entries are ordered by distance and then by column index, so the root is the
+ * entry that the next closer column replaces.
+ *
+ * @param distances The distances of the heap.
+ * @param indices The column indices of the heap.
+ * @param count The number of entries of the heap.
+ * @param root The position of the entry to move down.
+ */
+static void
+distance_heap_sift (uint64_t *distances, uint32_t *indices, size_t count, size_t root)
+{
+  uint64_t distance = distances[root];
+  uint32_t index = indices[root];
+  size_t parent = root;
+
+  for (size_t child = (parent * 2U) + 1U; child < count; child = (parent * 2U) + 1U)
+    {
+      size_t right = child + 1U;
+      if ((right < count) && ((distances[right] > distances[child]) || ((distances[right] == distances[child]) && (indices[right] > indices[child]))))
+        {
+          child = right;
+        }
+      if ((distances[child] < distance) || ((distances[child] == distance) && (indices[child] < index)))
+        {
+          break;
+        }
+      distances[parent] = distances[child];
+      indices[parent] = indices[child];
+      parent = child;
+    }
+
+  distances[parent] = distance;
+  indices[parent] = index;
+}
+
+/**
+ * @brief Parallel task selecting the k closest columns of every row of one slice.
+ *
+ * Every row of a block keeps a max-heap of its k closest columns so far. The
+ * distances of a tile are computed into a buffer, and a column only enters the heap
+ * if it is closer than the root, which is rarely the case once the heap is filled,
+ * so chunks of the buffer whose minimum is farther than the root are skipped.
+ * The heaps are sorted in ascending order once all tiles were processed.
+ *
+ * @param context A pointer to the distance_context_t of the computation.
+ * @param worker The index of the worker, selecting its scratch memory.
+ * @param begin The first row of the slice.
+ * @param end One past the last row of the slice.
+ */
+static void
+distance_top_k_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  const distance_context_t *distance = context;
+  size_t column_count = distance->column_count;
+  size_t k = distance->k;
+  uint64_t *heaps = &distance->scratch[worker * distance->scratch_stride];
+  uint64_t *buffer = &heaps[distance->block_rows * k];
+
+  for (size_t block = begin; block < end; block += distance->block_rows)
+    {
+      size_t block_end = ((end - block) < distance->block_rows) ? end : (block + distance->block_rows);
+      for (size_t row = block; row < block_end; ++row)
+        {
+          memset (&heaps[(row - block) * k], 0xFF, k * sizeof (uint64_t));
+          memset (&distance->indices[row * k], 0xFF, k * sizeof (uint32_t));
+        }
+
+      for (size_t tile = 0; tile < column_count; tile += DISTANCE_COLUMN_TILE)
+        {
+          size_t tile_count = ((column_count - tile) < DISTANCE_COLUMN_TILE) ? (column_count - tile) : DISTANCE_COLUMN_TILE;
+          for (size_t row = block; row < block_end; ++row)
+            {
+              if ((distance->row_missing != NULL) && distance->row_missing[row])
+                {
+                  continue;
+                }
+
+              uint64_t *heap_distances = &heaps[(row - block) * k];
+              uint32_t *heap_indices = &distance->indices[row * k];
+              distance_row (distance->row_x[row], distance->row_y[row], &distance->column_x[tile], &distance->column_y[tile], tile_count, buffer);
+
+              for (size_t chunk = 0; chunk < tile_count; chunk += DISTANCE_FILTER_CHUNK)
+                {
+                  /* A chunk is scanned only while its minimum is not farther than the root */
+                  size_t chunk_end = ((tile_count - chunk) < DISTANCE_FILTER_CHUNK) ? tile_count : (chunk + DISTANCE_FILTER_CHUNK);
+                  uint64_t minimum = UINT64_MAX;
+                  for (size_t j = chunk; j < chunk_end; ++j)
+                    {
+                      minimum = (buffer[j] < minimum) ? buffer[j] : minimum;
+                    }
+
+                  for (size_t j = chunk; (minimum <= heap_distances[0]) && (j < chunk_end); ++j)
+                    {
+                      uint32_t index = (uint32_t)(tile + j);
+                      bool is_closer = (buffer[j] < heap_distances[0]) || ((buffer[j] == heap_distances[0]) && (index < heap_indices[0]));
+                      if (is_closer && ((distance->column_missing == NULL) || !distance->column_missing[index]))
+                        {
+                          heap_distances[0] = buffer[j];
+                          heap_indices[0] = index;
+                          distance_heap_sift (heap_distances, heap_indices, k, 0U);
+                        }
+                    }
+                }
+            }
+        }
+
+      for (size_t row = block; row < block_end; ++row)
+        {
+          uint64_t *heap_distances = &heaps[(row - block) * k];
+          uint32_t *heap_indices = &distance->indices[row * k];
+          for (size_t size = k; size > 1U; --size)
+            {
+              uint64_t top_distance = heap_distances[0];
+              uint32_t top_index = heap_indices[0];
+              heap_distances[0] = heap_distances[size - 1U];
+              heap_indices[0] = heap_indices[size - 1U];
+              heap_distances[size - 1U] = top_distance;
+              heap_indices[size - 1U] = top_index;
+              distance_heap_sift (heap_distances, heap_indices, size - 1U, 0U);
+            }
+          if (distance->distances != NULL)
+            {
+              memcpy (&distance->distances[row * k], heap_distances, k * sizeof (uint64_t));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Run a prepared distance computation across threads.
+ *
+ * Rows are split across threads, each of which covers at least PARALLEL_MIN_CHUNK
+ * distances. The top-k mode allocates heaps for one row block and a tile buffer per
+ * worker in a single block.
+ *
+ * @param distance A pointer to the computation state with its inputs and outputs set.
+ * @param row_count The number of rows.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if the computation ran, false on allocation failure.
+ */
+static bool
+distance_compute (distance_context_t *distance, size_t row_count, uint32_t threads)
+{
+  bool result = true;
+  size_t column_count = (distance->column_count > 0U) ? distance->column_count : 1U;
+  uint32_t workers = parallel_plan (threads, row_count, (PARALLEL_MIN_CHUNK + column_count - 1U) / column_count);
+
+  if (distance->k == 0U)
+    {
+      parallel_run (workers, row_count, distance_matrix_task, distance);
+    }
+  else
+    {
+      size_t row_bytes = (size_t)distance->k * (sizeof (uint64_t) + sizeof (uint32_t));
+      distance->block_rows = DISTANCE_HEAP_BUDGET / row_bytes;
+      distance->block_rows = (distance->block_rows > DISTANCE_ROW_BLOCK) ? DISTANCE_ROW_BLOCK : distance->block_rows;
+      distance->block_rows = (distance->block_rows > 0U) ? distance->block_rows : 1U;
+      distance->scratch_stride = (distance->block_rows * distance->k) + DISTANCE_COLUMN_TILE;
+      distance->scratch = malloc ((size_t)workers * distance->scratch_stride * sizeof (uint64_t));
+
+      result = (distance->scratch != NULL);
+      if (result)
+        {
+          parallel_run (workers, row_count, distance_top_k_task, distance);
+          free (distance->scratch);
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Run a distance computation on point arrays by gathering their coordinates.
+ *
+ * The coordinates of both arrays are copied into one block of structure-of-arrays
+ * buffers, and NULL entries are recorded in missing flags.
+ *
+ * @param distance A pointer to the computation state with its outputs set.
+ * @param rows The row points.
+ * @param row_count The number of row points.
+ * @param columns The column points.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if the computation ran, false on allocation failure.
+ */
+static bool
+distance_compute_points (distance_context_t *distance, point_t *const *rows, size_t row_count, point_t *const *columns, uint32_t threads)
+{
+  bool result = false;
+  size_t total = row_count + distance->column_count;
+
+  /* A single block holds every buffer: 4 + 4 + 1 bytes per point */
+  uint32_t *block = malloc (total * ((sizeof (uint32_t) * 2U) + 1U));
+  if (block != NULL)
+    {
+      uint32_t *x = block;
+      uint32_t *y = &block[total];
+      uint8_t *missing = (uint8_t *)&block[total * 2U];
+      bool has_missing = false;
+
+      for (size_t i = 0; i < total; ++i)
+        {
+          const point_t *point = (i < row_count) ? rows[i] : columns[i - row_count];
+          x[i] = (point != NULL) ? point->x : 0U;
+          y[i] = (point != NULL) ? point->y : 0U;
+          missing[i] = (point == NULL) ? 1U : 0U;
+          has_missing = has_missing || (point == NULL);
+        }
+
+      distance->row_x = x;
+      distance->row_y = y;
+      distance->row_missing = has_missing ? missing : NULL;
+      distance->column_x = &x[row_count];
+      distance->column_y = &y[row_count];
+      distance->column_missing = has_missing ? &missing[row_count] : NULL;
+      result = distance_compute (distance, row_count, threads);
+
+      free (block);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Check whether a matrix of row_count rows and columns columns is addressable.
+ *
+ * @param row_count The number of rows.
+ * @param columns The number of columns.
+ *
+ * @return true if the number of elements fits a size_t, false otherwise.
+ */
+static bool
+distance_fits (size_t row_count, size_t columns)
+{
+  return (columns == 0U) || (row_count <= (SIZE_MAX / columns / sizeof (uint64_t)));
+}
+
+/**
+ * @brief Check whether a batch and both of its coordinate arrays are set.
+ *
+ * @param batch A pointer to the batch, or NULL.
+ *
+ * @return true if the batch can be read, false otherwise.
+ */
+static bool
+distance_is_batch (const point_batch_t *batch)
+{
+  return (batch != NULL) && (batch->x != NULL) && (batch->y != NULL);
+}
+
+/**
+ * @brief Compute the squared distances between every pair of points of two arrays.
+ *
+ * The matrix is filled row by row, with the entry of row i and column j at
+ * i * column_count + j. Columns are processed in tiles that stay in the L1 cache
+ * while a block of rows sweeps them, the distances of a tile are computed with
+ * SIMD instructions where available, and large matrices are split across threads
+ * by rows. Distances are exact in 64 bits and saturate at UINT64_MAX, which is
+ * also the distance to NULL entries.
+ *
+ * @param rows An array of pointers to the row points.
+ * @param row_count The number of entries in the row array.
+ * @param columns An array of pointers to the column points.
+ * @param column_count The number of entries in the column array.
+ * @param matrix A buffer of row_count * column_count elements receiving the squared distances.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the matrix was computed, false if an argument is NULL, the matrix
+ * is too large to address or memory allocation fails.
+ */
+bool
+point_distance_matrix_compute (point_t *const *rows, size_t row_count, point_t *const *columns, size_t column_count, uint64_t *matrix,
+                               uint32_t threads)
+{
+  bool result = false;
+  if ((rows != NULL) && (columns != NULL) && (matrix != NULL) && distance_fits (row_count, column_count))
+    {
+      distance_context_t distance = { .column_count = column_count, .matrix = matrix, .k = 0U };
+      result = distance_compute_points (&distance, rows, row_count, columns, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Compute the squared distances between every pair of points of two batches.
+ *
+ * The coordinates are read in place, otherwise the matrix is computed as by
+ * point_distance_matrix_compute.
+ *
+ * @param rows A pointer to the batch of row points.
+ * @param columns A pointer to the batch of column points.
+ * @param matrix A buffer of rows->count * columns->count elements receiving the squared distances.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the matrix was computed, false if an argument is NULL or the
+ * matrix is too large to address.
+ */
+bool
+point_batch_distance_matrix_compute (const point_batch_t *rows, const point_batch_t *columns, uint64_t *matrix, uint32_t threads)
+{
+  bool result = false;
+  if (distance_is_batch (rows) && distance_is_batch (columns) && (matrix != NULL) && distance_fits (rows->count, columns->count))
+    {
+      distance_context_t distance = {
+        .row_x = rows->x,
+        .row_y = rows->y,
+        .column_x = columns->x,
+        .column_y = columns->y,
+        .column_count = columns->count,
+        .matrix = matrix,
+        .k = 0U,
+      };
+      result = distance_compute (&distance, rows->count, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the k closest column points of every row point of two arrays.
+ *
+ * The full matrix is never materialized: every row keeps a heap of its k closest
+ * columns while the columns are swept tile by tile. The entries of a row are sorted
+ * by ascending squared distance, ties by ascending column index. Entries beyond the
+ * number of columns, and all entries of NULL rows, have the index UINT32_MAX and the
+ * distance UINT64_MAX. NULL columns are never selected.
+ *
+ * @param rows An array of pointers to the row points.
+ * @param row_count The number of entries in the row array.
+ * @param columns An array of pointers to the column points.
+ * @param column_count The number of entries in the column array, at most UINT32_MAX.
+ * @param k The number of closest columns per row.
+ * @param indices A buffer of row_count * k elements receiving the column indices.
+ * @param distances A buffer of row_count * k elements receiving the squared distances, or NULL.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the closest columns were found, false if an argument is NULL, k is
+ * 0, a size is out of range or memory allocation fails.
+ */
+bool
+point_distance_top_k_compute (point_t *const *rows, size_t row_count, point_t *const *columns, size_t column_count, uint32_t k, uint32_t *indices,
+                              uint64_t *distances, uint32_t threads)
+{
+  bool result = false;
+  if ((rows != NULL) && (columns != NULL) && (indices != NULL) && (k > 0U) && (column_count <= UINT32_MAX) && distance_fits (row_count, k))
+    {
+      distance_context_t distance = { .column_count = column_count, .k = k, .indices = indices, .distances = distances };
+      result = distance_compute_points (&distance, rows, row_count, columns, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the k closest column points of every row point of two batches.
+ *
+ * The coordinates are read in place, otherwise the closest columns are found as by
+ * point_distance_top_k_compute.
+ *
+ * @param rows A pointer to the batch of row points.
+ * @param columns A pointer to the batch of column points, at most UINT32_MAX of them.
+ * @param k The number of closest columns per row.
+ * @param indices A buffer of rows->count * k elements receiving the column indices.
+ * @param distances A buffer of rows->count * k elements receiving the squared distances, or NULL.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the closest columns were found, false if an argument is NULL, k is
+ * 0, a size is out of range or memory allocation fails.
+ */
+bool
+point_batch_distance_top_k_compute (const point_batch_t *rows, const point_batch_t *columns, uint32_t k, uint32_t *indices, uint64_t *distances,
+                                    uint32_t threads)
+{
+  bool result = false;
+  if (distance_is_batch (rows) && distance_is_batch (columns) && (indices != NULL) && (k > 0U) && (columns->count <= UINT32_MAX)
+      && distance_fits (rows->count, k))
+    {
+      distance_context_t distance = {
+        .row_x = rows->x,
+        .row_y = rows->y,
+        .column_x = columns->x,
+        .column_y = columns->y,
+        .column_count = columns->count,
+        .k = k,
+        .indices = indices,
+        .distances = distances,
+      };
+      result = distance_compute (&distance, rows->count, threads);
+    }
+
+  return result;
+}
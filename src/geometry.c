@@ -0,0 +1,71 @@
+#include "internal.h"
+
+/**
+ * @brief Multiply two signed coordinate differences into a sign and a magnitude.
+ *
+ * Coordinate differences are bounded by 2^32 - 1 in magnitude, so their product
+ * always fits in an unsigned 64-bit magnitude even though it may not fit in a
+ * signed 64-bit integer.
+ *
+ * @param a The first difference.
+ * @param b The second difference.
+ * @param magnitude Receives the absolute value of the product.
+ *
+ * @return -1, 0 or 1 depending on the sign of the product.
+ */
+static int32_t
+geometry_multiply (int64_t a, int64_t b, uint64_t *magnitude)
+{
+  uint64_t magnitude_a = (a < 0) ? (uint64_t)(-a) : (uint64_t)a;
+  uint64_t magnitude_b = (b < 0) ? (uint64_t)(-b) : (uint64_t)b;
+  *magnitude = magnitude_a * magnitude_b;
+
+  int32_t result = 0;
+  if ((a != 0) && (b != 0))
+    {
+      result = ((a < 0) != (b < 0)) ? -1 : 1;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Determine the orientation of the triangle (origin, a, b).
+ *
+ * The points are packed keys holding the x-coordinate in the upper and the
+ * y-coordinate in the lower 32 bits. The cross product is evaluated exactly for
+ * the full uint32_t coordinate range.
+ *
+ * @param origin The packed origin of the triangle.
+ * @param a The packed second vertex.
+ * @param b The packed third vertex.
+ *
+ * @return 1 for a counter-clockwise turn, -1 for a clockwise turn and 0 if the
+ * points are collinear.
+ */
+int32_t
+geometry_orientation (uint64_t origin, uint64_t a, uint64_t b)
+{
+  int64_t ax = (int64_t)(a >> 32) - (int64_t)(origin >> 32);
+  int64_t ay = (int64_t)(a & UINT32_MAX) - (int64_t)(origin & UINT32_MAX);
+  int64_t bx = (int64_t)(b >> 32) - (int64_t)(origin >> 32);
+  int64_t by = (int64_t)(b & UINT32_MAX) - (int64_t)(origin & UINT32_MAX);
+
+  uint64_t lhs = 0U;
+  uint64_t rhs = 0U;
+  int32_t lhs_sign = geometry_multiply (ax, by, &lhs);
+  int32_t rhs_sign = geometry_multiply (ay, bx, &rhs);
+
+  int32_t result = 0;
+  if (lhs_sign != rhs_sign)
+    {
+      result = (lhs_sign > rhs_sign) ? 1 : -1;
+    }
+  else if (lhs_sign != 0)
+    {
+      result = (int32_t)(lhs > rhs) - (int32_t)(lhs < rhs);
+      result = (lhs_sign < 0) ? -result : result;
+    }
+
+  return result;
+}
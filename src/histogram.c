@@ -0,0 +1,320 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of points whose cell indices are computed together before counting. */
+#define HISTOGRAM_BLOCK 256U
+
+/* Upper bound on the memory spent on private per-thread histograms. */
+#define HISTOGRAM_MAX_PRIVATE_BYTES (64U * 1024U * 1024U)
+
+/**
+ * @brief Branch-free unsigned division by a run-time constant.
+ *
+ * The quotient n / d is computed as ((n - q) / 2 + q) >> shift with
+ * q = (n * magic) >> 32, which only needs a widening multiply and shifts and
+ * therefore vectorizes, unlike the division instruction.
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t shift;
+  bool is_identity;
+} histogram_divider_t;
+
+/**
+ * @brief Pre-computed state of a histogram computation.
+ */
+typedef struct
+{
+  point_t *const *points;
+  const point_batch_t *batch;
+  const point_grid_t *grid;
+  histogram_divider_t column_divider;
+  histogram_divider_t row_divider;
+  uint32_t total;
+  uint32_t workers;
+  uint32_t *cells;
+  uint32_t *private_cells;
+} histogram_t;
+
+/**
+ * @brief Derive the branch-free division constants for a divisor.
+ *
+ * @param divisor The divisor, at least 1.
+ *
+ * @return The divider computing quotients by divisor.
+ */
+static histogram_divider_t
+histogram_divider_create (uint32_t divisor)
+{
+  histogram_divider_t result = { 0U, 0U, divisor == 1U };
+
+  uint32_t floor_log2 = 0U;
+  for (uint32_t value = divisor; value > 1U; value >>= 1U)
+    {
+      ++floor_log2;
+    }
+
+  if ((divisor & (divisor - 1U)) == 0U)
+    {
+      /* Powers of two reduce to a plain shift with a zero multiplier */
+      result.shift = (floor_log2 > 0U) ? (floor_log2 - 1U) : 0U;
+    }
+  else
+    {
+      uint64_t numerator = (uint64_t)1U << (32U + floor_log2);
+      uint64_t proposed = numerator / divisor;
+      uint64_t remainder = numerator % divisor;
+
+      proposed += proposed;
+      if ((remainder + remainder) >= divisor)
+        {
+          ++proposed;
+        }
+
+      result.magic = (uint32_t)(proposed + 1U);
+      result.shift = floor_log2;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Compute the cell indices of a block of coordinates.
+ *
+ * Coordinates outside the grid receive the index histogram->total. The loop is free
+ * of branches and divisions so that it is vectorized by the compiler.
+ *
+ * @param histogram A pointer to the histogram state.
+ * @param x The x-coordinates of the block.
+ * @param y The y-coordinates of the block.
+ * @param count The number of coordinates, at most HISTOGRAM_BLOCK.
+ * @param indices Receives one cell index per coordinate.
+ */
+static void
+histogram_index_block (const histogram_t *histogram, const uint32_t *x, const uint32_t *y, size_t count, uint32_t *indices)
+{
+  const uint32_t origin_x = histogram->grid->origin_x;
+  const uint32_t origin_y = histogram->grid->origin_y;
+  const uint32_t columns = histogram->grid->columns;
+  const uint32_t rows = histogram->grid->rows;
+  const histogram_divider_t column_divider = histogram->column_divider;
+  const histogram_divider_t row_divider = histogram->row_divider;
+  const uint32_t total = histogram->total;
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t dx = x[i] - origin_x;
+      uint32_t dy = y[i] - origin_y;
+
+      uint32_t qx = (uint32_t)(((uint64_t)dx * column_divider.magic) >> 32);
+      uint32_t qy = (uint32_t)(((uint64_t)dy * row_divider.magic) >> 32);
+      uint32_t column = column_divider.is_identity ? dx : ((((dx - qx) >> 1) + qx) >> column_divider.shift);
+      uint32_t row = row_divider.is_identity ? dy : ((((dy - qy) >> 1) + qy) >> row_divider.shift);
+
+      bool inside = (x[i] >= origin_x) & (y[i] >= origin_y) & (column < columns) & (row < rows);
+      indices[i] = inside ? ((row * columns) + column) : total;
+    }
+}
+
+/**
+ * @brief Count a range of points into a histogram.
+ *
+ * @param histogram A pointer to the histogram state.
+ * @param cells The counters to increment.
+ * @param begin The first index of the range.
+ * @param end One past the last index of the range.
+ */
+static void
+histogram_count (const histogram_t *histogram, uint32_t *cells, size_t begin, size_t end)
+{
+  uint32_t block_x[HISTOGRAM_BLOCK];
+  uint32_t block_y[HISTOGRAM_BLOCK];
+  uint32_t indices[HISTOGRAM_BLOCK];
+  const uint32_t total = histogram->total;
+
+  for (size_t block = begin; block < end; block += HISTOGRAM_BLOCK)
+    {
+      size_t count = ((end - block) < HISTOGRAM_BLOCK) ? (end - block) : HISTOGRAM_BLOCK;
+
+      if (histogram->batch != NULL)
+        {
+          histogram_index_block (histogram, &histogram->batch->x[block], &histogram->batch->y[block], count, indices);
+        }
+      else
+        {
+          for (size_t i = 0; i < count; ++i)
+            {
+              const point_t *point = histogram->points[block + i];
+              block_x[i] = (point != NULL) ? point->x : 0U;
+              block_y[i] = (point != NULL) ? point->y : 0U;
+            }
+
+          histogram_index_block (histogram, block_x, block_y, count, indices);
+
+          for (size_t i = 0; i < count; ++i)
+            {
+              indices[i] = (histogram->points[block + i] != NULL) ? indices[i] : total;
+            }
+        }
+
+      for (size_t i = 0; i < count; ++i)
+        {
+          if (indices[i] < total)
+            {
+              ++cells[indices[i]];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Parallel task counting one slice of the input into a private histogram.
+ *
+ * @param context A pointer to the histogram_t of the computation.
+ * @param worker The index of the worker, selecting its private histogram.
+ * @param begin The first index of the slice.
+ * @param end One past the last index of the slice.
+ */
+static void
+histogram_count_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  const histogram_t *histogram = context;
+  histogram_count (histogram, &histogram->private_cells[(size_t)worker * histogram->total], begin, end);
+}
+
+/**
+ * @brief Parallel task adding a range of cells of every private histogram to the result.
+ *
+ * @param context A pointer to the histogram_t of the computation.
+ * @param worker The index of the worker.
+ * @param begin The first cell of the range.
+ * @param end One past the last cell of the range.
+ */
+static void
+histogram_merge_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  const histogram_t *histogram = context;
+  (void)worker;
+
+  for (uint32_t source = 0; source < histogram->workers; ++source)
+    {
+      const uint32_t *private_cells = &histogram->private_cells[(size_t)source * histogram->total];
+      for (size_t i = begin; i < end; ++i)
+        {
+          histogram->cells[i] += private_cells[i];
+        }
+    }
+}
+
+/**
+ * @brief Validate the grid and bin the input of a histogram computation.
+ *
+ * A single worker counts directly into the caller's cells. Multiple workers count
+ * into private histograms, which avoids atomic increments and false sharing, and
+ * the private histograms are summed into the caller's cells in parallel afterwards.
+ * When the private histograms cannot be allocated, the input is counted serially.
+ *
+ * @param histogram A pointer to the histogram state with its input set.
+ * @param count The number of input elements.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if the points were binned, false if the grid is invalid.
+ */
+static bool
+histogram_compute (histogram_t *histogram, size_t count, uint32_t threads)
+{
+  bool result = false;
+  const point_grid_t *grid = histogram->grid;
+  uint64_t total = (uint64_t)grid->columns * grid->rows;
+
+  if ((grid->cell_width > 0U) && (grid->cell_height > 0U) && (total > 0U) && (total < UINT32_MAX))
+    {
+      histogram->total = (uint32_t)total;
+      histogram->column_divider = histogram_divider_create (grid->cell_width);
+      histogram->row_divider = histogram_divider_create (grid->cell_height);
+
+      uint32_t workers = parallel_plan (threads, count, PARALLEL_MIN_CHUNK);
+      while ((workers > 1U) && (((uint64_t)workers * total * sizeof (uint32_t)) > HISTOGRAM_MAX_PRIVATE_BYTES))
+        {
+          --workers;
+        }
+
+      histogram->private_cells = (workers > 1U) ? calloc ((size_t)workers * total, sizeof (uint32_t)) : NULL;
+      if (histogram->private_cells != NULL)
+        {
+          histogram->workers = workers;
+          parallel_run (workers, count, histogram_count_task, histogram);
+          parallel_run (parallel_plan (workers, total, PARALLEL_MIN_CHUNK), total, histogram_merge_task, histogram);
+          free (histogram->private_cells);
+        }
+      else
+        {
+          /* Without memory for the private histograms, a single worker counts in place */
+          histogram_count (histogram, histogram->cells, 0U, count);
+        }
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Bin an array of points into a two-dimensional histogram.
+ *
+ * Every point increments the counter of the grid cell containing it. The cells are
+ * stored row by row, and points outside the grid as well as NULL entries in the
+ * array are ignored. Counters are incremented rather than overwritten, so several
+ * arrays can be accumulated into the same histogram.
+ *
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the array.
+ * @param grid A pointer to the grid layout; cell sizes must be non-zero.
+ * @param cells The counters of the grid, columns * rows elements.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were binned, false if an argument is invalid.
+ */
+bool
+point_histogram_compute (point_t *const *points, size_t count, const point_grid_t *grid, uint32_t *cells, uint32_t threads)
+{
+  bool result = false;
+  if ((points != NULL) && (grid != NULL) && (cells != NULL))
+    {
+      histogram_t histogram = { .points = points, .batch = NULL, .grid = grid, .cells = cells };
+      result = histogram_compute (&histogram, count, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Bin a batch of points into a two-dimensional histogram.
+ *
+ * Every point increments the counter of the grid cell containing it. The cells are
+ * stored row by row and points outside the grid are ignored. Counters are
+ * incremented rather than overwritten, so several batches can be accumulated into
+ * the same histogram. Cell indices are computed in vectorized blocks, and large
+ * batches are binned by several threads into private histograms that are merged
+ * at the end.
+ *
+ * @param batch A pointer to the batch of points.
+ * @param grid A pointer to the grid layout; cell sizes must be non-zero.
+ * @param cells The counters of the grid, columns * rows elements.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were binned, false if an argument is invalid.
+ */
+bool
+point_batch_histogram_compute (const point_batch_t *batch, const point_grid_t *grid, uint32_t *cells, uint32_t threads)
+{
+  bool result = false;
+  if ((batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (grid != NULL) && (cells != NULL))
+    {
+      histogram_t histogram = { .points = NULL, .batch = batch, .grid = grid, .cells = cells };
+      result = histogram_compute (&histogram, batch->count, threads);
+    }
+
+  return result;
+}
@@ -0,0 +1,247 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * @brief Shared state of a convex hull computation.
+ *
+ * All buffers hold one element per input point and are sliced per worker, so a
+ * hull computation performs a single allocation regardless of the input size.
+ */
+typedef struct
+{
+  point_t *const *points;
+  const point_batch_t *batch;
+  uint64_t *keys;
+  uint32_t *values;
+  uint64_t *tmp_keys;
+  uint32_t *tmp_values;
+  uint32_t *lower;
+  uint32_t *upper;
+  size_t begin[PARALLEL_MAX_WORKERS];
+  size_t size[PARALLEL_MAX_WORKERS];
+} hull_context_t;
+
+/**
+ * @brief Build the hull of sorted packed points with Andrew's monotone chain.
+ *
+ * Duplicate points and points on hull edges are dropped. The hull is written to
+ * lower as positions into keys, in counter-clockwise order starting at the
+ * lowest-leftmost point.
+ *
+ * @param keys The packed points, sorted in ascending order.
+ * @param count The number of packed points.
+ * @param lower A stack of at least count positions; receives the hull.
+ * @param upper A scratch stack of at least count positions.
+ *
+ * @return The number of hull vertices written to lower.
+ */
+static size_t
+hull_chain (const uint64_t *keys, size_t count, uint32_t *lower, uint32_t *upper)
+{
+  size_t lower_count = 0;
+  size_t upper_count = 0;
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      if ((i > 0U) && (keys[i] == keys[i - 1U]))
+        {
+          continue;
+        }
+
+      while ((lower_count >= 2U) && (geometry_orientation (keys[lower[lower_count - 2U]], keys[lower[lower_count - 1U]], keys[i]) <= 0))
+        {
+          --lower_count;
+        }
+      lower[lower_count++] = (uint32_t)i;
+    }
+
+  for (size_t i = count; i-- > 0U;)
+    {
+      if ((i > 0U) && (keys[i] == keys[i - 1U]))
+        {
+          continue;
+        }
+
+      while ((upper_count >= 2U) && (geometry_orientation (keys[upper[upper_count - 2U]], keys[upper[upper_count - 1U]], keys[i]) <= 0))
+        {
+          --upper_count;
+        }
+      upper[upper_count++] = (uint32_t)i;
+    }
+
+  /* A single distinct point is its own hull */
+  size_t result = lower_count;
+  if (lower_count > 1U)
+    {
+      /* Both chains share their end points, drop the last vertex of each */
+      result = lower_count - 1U;
+      for (size_t i = 0; (i + 1U) < upper_count; ++i)
+        {
+          lower[result++] = upper[i];
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Parallel task computing the hull of one slice of the input.
+ *
+ * @param context A pointer to the hull_context_t of the computation.
+ * @param worker The index of the worker.
+ * @param begin The first index of the slice.
+ * @param end One past the last index of the slice.
+ */
+static void
+hull_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  hull_context_t *hull = context;
+  uint64_t *keys = &hull->keys[begin];
+  uint32_t *values = &hull->values[begin];
+  size_t count = 0;
+
+  for (size_t i = begin; i < end; ++i)
+    {
+      if (hull->batch != NULL)
+        {
+          keys[count] = ((uint64_t)hull->batch->x[i] << 32) | hull->batch->y[i];
+          values[count++] = (uint32_t)i;
+        }
+      else if (hull->points[i] != NULL)
+        {
+          keys[count] = ((uint64_t)hull->points[i]->x << 32) | hull->points[i]->y;
+          values[count++] = (uint32_t)i;
+        }
+    }
+
+  sort_keys (keys, values, &hull->tmp_keys[begin], &hull->tmp_values[begin], count);
+
+  hull->begin[worker] = begin;
+  hull->size[worker] = hull_chain (keys, count, &hull->lower[begin], &hull->upper[begin]);
+}
+
+/**
+ * @brief Compute the convex hull of a point array or batch.
+ *
+ * The input is divided into one slice per worker, and the hull of every slice is
+ * computed in parallel. The hull of the input is the hull of the slice hulls, so
+ * the partial hulls are merged with a final, much smaller monotone chain pass.
+ *
+ * @param hull A pointer to the hull state with its input set.
+ * @param count The number of input elements.
+ * @param indices A buffer of at least count elements receiving the hull as input indices.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return The number of hull vertices, or 0 on allocation failure.
+ */
+static size_t
+hull_compute (hull_context_t *hull, size_t count, uint32_t *indices, uint32_t threads)
+{
+  size_t result = 0;
+
+  /* A single block holds every buffer: 8 + 4 + 8 + 4 + 4 + 4 bytes per point */
+  uint64_t *block = malloc (count * (sizeof (uint64_t) * 4U));
+  if (block != NULL)
+    {
+      hull->keys = block;
+      hull->tmp_keys = &block[count];
+      hull->values = (uint32_t *)&block[count * 2U];
+      hull->tmp_values = &hull->values[count];
+      hull->lower = &hull->tmp_values[count];
+      hull->upper = &hull->lower[count];
+
+      uint32_t workers = parallel_plan (threads, count, PARALLEL_MIN_CHUNK);
+      parallel_run (workers, count, hull_task, hull);
+
+      const uint32_t *values = hull->values;
+      result = hull->size[0];
+
+      if (workers > 1U)
+        {
+          /* Gather the vertices of every partial hull and build their hull */
+          size_t merged = 0;
+          for (uint32_t worker = 0; worker < workers; ++worker)
+            {
+              size_t begin = hull->begin[worker];
+              for (size_t i = 0; i < hull->size[worker]; ++i)
+                {
+                  hull->tmp_keys[merged] = hull->keys[begin + hull->lower[begin + i]];
+                  hull->tmp_values[merged++] = hull->values[begin + hull->lower[begin + i]];
+                }
+            }
+
+          sort_keys (hull->tmp_keys, hull->tmp_values, hull->keys, hull->values, merged);
+          result = hull_chain (hull->tmp_keys, merged, hull->lower, hull->upper);
+          values = hull->tmp_values;
+        }
+
+      for (size_t i = 0; i < result; ++i)
+        {
+          indices[i] = values[hull->lower[i]];
+        }
+
+      free (block);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Compute the convex hull of an array of points.
+ *
+ * The hull is determined with Andrew's monotone chain algorithm. Large arrays are
+ * divided across threads whose partial hulls are merged afterwards. NULL entries
+ * in the array are skipped, duplicate points are reported once and points lying on
+ * a hull edge are not reported.
+ *
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the array, at most UINT32_MAX.
+ * @param indices A buffer of at least count elements receiving the array indices of
+ * the hull vertices in counter-clockwise order, starting at the lowest-leftmost point.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return The number of hull vertices, or 0 if an argument is invalid or memory
+ * allocation fails.
+ */
+size_t
+point_hull_compute (point_t *const *points, size_t count, uint32_t *indices, uint32_t threads)
+{
+  size_t result = 0;
+  if ((points != NULL) && (indices != NULL) && (count > 0U) && (count <= UINT32_MAX))
+    {
+      hull_context_t hull = { .points = points, .batch = NULL };
+      result = hull_compute (&hull, count, indices, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Compute the convex hull of a batch of points.
+ *
+ * The hull is determined with Andrew's monotone chain algorithm. Large batches are
+ * divided across threads whose partial hulls are merged afterwards. Duplicate points
+ * are reported once and points lying on a hull edge are not reported.
+ *
+ * @param batch A pointer to the batch of points, holding at most UINT32_MAX points.
+ * @param indices A buffer of at least batch->count elements receiving the batch
+ * indices of the hull vertices in counter-clockwise order, starting at the
+ * lowest-leftmost point.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return The number of hull vertices, or 0 if an argument is invalid or memory
+ * allocation fails.
+ */
+size_t
+point_batch_hull_compute (const point_batch_t *batch, uint32_t *indices, uint32_t threads)
+{
+  size_t result = 0;
+  if ((batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (indices != NULL) && (batch->count > 0U) && (batch->count <= UINT32_MAX))
+    {
+      hull_context_t hull = { .points = NULL, .batch = batch };
+      result = hull_compute (&hull, batch->count, indices, threads);
+    }
+
+  return result;
+}
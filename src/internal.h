@@ -1,12 +1,59 @@
 #ifndef _INTERNAL_H_
 #define _INTERNAL_H_
 
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/* Minimum number of points handled by a worker before a kernel is split across threads. */
+#define PARALLEL_MIN_CHUNK 65536U
+
+/* Upper bound on the number of workers started by a single parallel run. */
+#define PARALLEL_MAX_WORKERS 256U
+
 struct point
 {
   uint32_t x;
   uint32_t y;
 };
 
-#endif
\ No newline at end of file
+/* Task executed by a parallel worker over the index range [begin, end). */
+typedef void (*parallel_task_fn) (void *context, uint32_t worker, size_t begin, size_t end);
+
+/* Task executed by the thread pool, embedded as the first member of larger task records. */
+typedef struct pool_task pool_task_t;
+struct pool_task
+{
+  void (*run) (pool_task_t *task);
+  pool_task_t *next;
+};
+
+/* Allocation */
+void *allocator_alloc (size_t size);
+void allocator_free (void *memory, size_t size);
+
+#ifdef LIB_STATS
+/* Statistics */
+uint64_t stats_now_ns (void);
+void stats_record_create (size_t bytes, uint64_t alloc_ns);
+void stats_record_destroy (size_t bytes);
+#endif
+
+/* Parallel Execution */
+uint32_t parallel_resolve_threads (uint32_t threads);
+uint32_t parallel_plan (uint32_t threads, size_t count, size_t min_chunk);
+void parallel_run (uint32_t workers, size_t count, parallel_task_fn task, void *context);
+
+/* Thread Pool */
+void pool_submit (pool_task_t *task);
+void pool_complete (atomic_size_t *remaining);
+void pool_wait (atomic_size_t *remaining);
+
+/* Sorting */
+void sort_keys (uint64_t *keys, uint32_t *values, uint64_t *tmp_keys, uint32_t *tmp_values, size_t count);
+
+/* Geometry */
+int32_t geometry_orientation (uint64_t origin, uint64_t a, uint64_t b);
+
+#endif
@@ -0,0 +1,404 @@
+#include "internal.h"
+#include "library.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/* Number of matches a worker buffers before delivering them to the callback. */
+#define JOIN_BUFFER_SIZE 1024U
+
+/* Minimum number of left points handled by a worker; every point scans a neighborhood. */
+#define JOIN_MIN_CHUNK 4096U
+
+/**
+ * @brief One input of a join, bucketed into grid cells.
+ *
+ * The present points are sorted by the key of their cell, holding the row above the
+ * column, so a cell and its horizontal neighbors form a contiguous run of sorted
+ * positions.
+ */
+typedef struct
+{
+  point_t *const *points;
+  const point_batch_t *batch;
+  size_t count;
+  size_t present;
+  uint64_t *keys;
+  uint32_t *values;
+  uint32_t *x;
+  uint32_t *y;
+} join_input_t;
+
+/**
+ * @brief Shared state of a join.
+ */
+typedef struct
+{
+  join_input_t left;
+  join_input_t right;
+  uint32_t distance;
+  uint64_t distance_squared;
+  uint32_t side;
+  point_join_fn callback;
+  void *user_context;
+  pthread_mutex_t lock;
+  atomic_bool is_stopped;
+} join_context_t;
+
+/**
+ * @brief The matches found by a worker and not yet delivered.
+ */
+typedef struct
+{
+  uint32_t left[JOIN_BUFFER_SIZE];
+  uint32_t right[JOIN_BUFFER_SIZE];
+  size_t count;
+} join_buffer_t;
+
+/**
+ * @brief Read a point of the batch or the array of an input.
+ *
+ * @param input A pointer to the input.
+ * @param index The index of the point.
+ * @param x A pointer receiving the x-coordinate.
+ * @param y A pointer receiving the y-coordinate.
+ *
+ * @return true if the point exists, false if the array entry is NULL.
+ */
+static bool
+join_read (const join_input_t *input, size_t index, uint32_t *x, uint32_t *y)
+{
+  bool result = true;
+  if (input->batch != NULL)
+    {
+      *x = input->batch->x[index];
+      *y = input->batch->y[index];
+    }
+  else
+    {
+      const point_t *point = input->points[index];
+      result = (point != NULL);
+      *x = result ? point->x : 0U;
+      *y = result ? point->y : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the first sorted position of an input whose key is not below a key.
+ *
+ * @param input A pointer to the sorted input.
+ * @param key The key to search.
+ *
+ * @return The position, or the number of present points if every key is below.
+ */
+static size_t
+join_search (const join_input_t *input, uint64_t key)
+{
+  size_t low = 0;
+  size_t high = input->present;
+  while (low < high)
+    {
+      size_t middle = low + ((high - low) / 2U);
+      low = (input->keys[middle] < key) ? (middle + 1U) : low;
+      high = (input->keys[middle] < key) ? high : middle;
+    }
+
+  return low;
+}
+
+/**
+ * @brief Parallel task gathering the coordinates of a slice of sorted positions.
+ *
+ * @param context A pointer to the join_input_t to gather.
+ * @param worker The index of the worker, unused.
+ * @param begin The first sorted position of the slice.
+ * @param end One past the last sorted position of the slice.
+ */
+static void
+join_gather_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const join_input_t *input = context;
+  for (size_t i = begin; i < end; ++i)
+    {
+      (void)join_read (input, input->values[i], &input->x[i], &input->y[i]);
+    }
+}
+
+/**
+ * @brief Bucket the present points of an input into grid cells.
+ *
+ * @param input A pointer to the input with its points or batch and count set.
+ * @param side The side of the cells.
+ * @param block A buffer of input->count * 24 bytes holding the sorted points.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ */
+static void
+join_prepare (join_input_t *input, uint32_t side, uint64_t *block, uint32_t threads)
+{
+  size_t count = input->count;
+  uint64_t *tmp_keys = &block[count];
+  uint32_t *tmp_values = (uint32_t *)&block[count * 2U];
+  input->keys = block;
+  input->values = &tmp_values[count];
+
+  size_t present = 0;
+  for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t x = 0U;
+      uint32_t y = 0U;
+      if (join_read (input, i, &x, &y))
+        {
+          input->keys[present] = ((uint64_t)(y / side) << 32U) | (x / side);
+          input->values[present++] = (uint32_t)i;
+        }
+    }
+  sort_keys (input->keys, input->values, tmp_keys, tmp_values, present);
+
+  /* Once sorted, the scratch keys hold the coordinates */
+  input->present = present;
+  input->x = (uint32_t *)tmp_keys;
+  input->y = &input->x[count];
+  parallel_run (parallel_plan (threads, present, PARALLEL_MIN_CHUNK), present, join_gather_task, input);
+}
+
+/**
+ * @brief Deliver the buffered matches of a worker to the callback.
+ *
+ * Deliveries are serialized, so the callback need not be thread-safe, and stop once
+ * the callback asked to.
+ *
+ * @param join_context A pointer to the context of the join.
+ * @param buffer A pointer to the buffer of the worker, emptied on return.
+ */
+static void
+join_flush (join_context_t *join_context, join_buffer_t *buffer)
+{
+  if (buffer->count > 0U)
+    {
+      (void)pthread_mutex_lock (&join_context->lock);
+      if (!atomic_load (&join_context->is_stopped)
+          && !join_context->callback (join_context->user_context, buffer->left, buffer->right, buffer->count))
+        {
+          atomic_store (&join_context->is_stopped, true);
+        }
+      (void)pthread_mutex_unlock (&join_context->lock);
+      buffer->count = 0U;
+    }
+}
+
+/**
+ * @brief Parallel task joining the left cells starting in a slice with the right points near them.
+ *
+ * With cells as wide as the distance, matches lie in the 3 by 3 cells around a
+ * left cell, which are three runs of right positions. Along a row of left cells
+ * the runs only move forward, so they are searched again only on a new row.
+ *
+ * @param context A pointer to the join_context_t of the join.
+ * @param worker The index of the worker, unused.
+ * @param begin The first left sorted position of the slice.
+ * @param end One past the last left sorted position of the slice.
+ */
+static void
+join_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  join_context_t *join_context = context;
+  const join_input_t *left = &join_context->left;
+  const join_input_t *right = &join_context->right;
+  const uint32_t *restrict right_x = right->x;
+  const uint32_t *restrict right_y = right->y;
+  uint64_t distance = join_context->distance;
+  uint64_t distance_squared = join_context->distance_squared;
+  join_buffer_t buffer;
+  buffer.count = 0U;
+  size_t cursors[3] = { 0U, 0U, 0U };
+  uint64_t cursor_row = UINT64_MAX;
+
+  /* A slice starts at the first cell starting in it, and finishes its last cell */
+  size_t first = begin;
+  while ((first > 0U) && (first < left->present) && (left->keys[first] == left->keys[first - 1U]))
+    {
+      ++first;
+    }
+
+  for (size_t cell = first; (cell < end) && !atomic_load (&join_context->is_stopped);)
+    {
+      uint64_t key = left->keys[cell];
+      size_t cell_end = cell + 1U;
+      while ((cell_end < left->present) && (left->keys[cell_end] == key))
+        {
+          ++cell_end;
+        }
+
+      int64_t column = (int64_t)(key & UINT32_MAX);
+      int64_t row = (int64_t)(key >> 32U);
+      size_t runs[3][2] = { { 0U, 0U }, { 0U, 0U }, { 0U, 0U } };
+      for (int64_t dy = -1; dy <= 1; ++dy)
+        {
+          if (((row + dy) < 0) || ((row + dy) > (int64_t)UINT32_MAX))
+            {
+              continue;
+            }
+
+          uint64_t base = (uint64_t)(row + dy) << 32U;
+          uint64_t low = base | (uint64_t)((column > 0) ? (column - 1) : 0);
+          uint64_t high = base | (uint64_t)((column < (int64_t)UINT32_MAX) ? (column + 1) : column);
+          size_t *cursor = &cursors[dy + 1];
+          *cursor = (cursor_row == (uint64_t)row) ? *cursor : join_search (right, low);
+          while ((*cursor < right->present) && (right->keys[*cursor] < low))
+            {
+              ++*cursor;
+            }
+
+          size_t run_end = *cursor;
+          while ((run_end < right->present) && (right->keys[run_end] <= high))
+            {
+              ++run_end;
+            }
+          runs[dy + 1][0] = *cursor;
+          runs[dy + 1][1] = run_end;
+        }
+      cursor_row = (uint64_t)row;
+
+      for (size_t i = cell; i < cell_end; ++i)
+        {
+          uint32_t px = left->x[i];
+          uint32_t py = left->y[i];
+          for (uint32_t r = 0; r < 3U; ++r)
+            {
+              for (size_t j = runs[r][0]; j < runs[r][1]; ++j)
+                {
+                  /* The subtraction may wrap when dy exceeds the distance, but the test then fails */
+                  uint64_t dx = (px > right_x[j]) ? (px - right_x[j]) : (right_x[j] - px);
+                  uint64_t dy = (py > right_y[j]) ? (py - right_y[j]) : (right_y[j] - py);
+                  if ((dx <= distance) & (dy <= distance) & ((dx * dx) <= (distance_squared - (dy * dy))))
+                    {
+                      buffer.left[buffer.count] = left->values[i];
+                      buffer.right[buffer.count++] = right->values[j];
+                      if (buffer.count == JOIN_BUFFER_SIZE)
+                        {
+                          join_flush (join_context, &buffer);
+                        }
+                    }
+                }
+            }
+        }
+      cell = cell_end;
+    }
+
+  join_flush (join_context, &buffer);
+}
+
+/**
+ * @brief Join two inputs by distance.
+ *
+ * @param join_context A pointer to the context with both inputs, the distance and the callback set.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if the inputs were joined, false on allocation failure.
+ */
+static bool
+join_compute (join_context_t *join_context, uint32_t threads)
+{
+  bool result = false;
+  size_t left_count = join_context->left.count;
+  size_t right_count = join_context->right.count;
+
+  /* A single block holds the keys, the values and their sort scratch of both inputs */
+  uint64_t *block = malloc ((((left_count + right_count) * 3U) + 1U) * sizeof (uint64_t));
+  if ((block != NULL) && (pthread_mutex_init (&join_context->lock, NULL) == 0))
+    {
+      join_context->side = (join_context->distance > 0U) ? join_context->distance : 1U;
+      join_context->distance_squared = (uint64_t)join_context->distance * join_context->distance;
+      atomic_init (&join_context->is_stopped, false);
+      join_prepare (&join_context->left, join_context->side, block, threads);
+      join_prepare (&join_context->right, join_context->side, &block[left_count * 3U], threads);
+
+      uint32_t workers = parallel_plan (threads, join_context->left.present, JOIN_MIN_CHUNK);
+      parallel_run (workers, join_context->left.present, join_task, join_context);
+      (void)pthread_mutex_destroy (&join_context->lock);
+      result = true;
+    }
+  free (block);
+
+  return result;
+}
+
+/**
+ * @brief Find every pair of points of two arrays within a distance of each other.
+ *
+ * Both arrays are bucketed into grid cells as wide as the distance, and every left
+ * point is only tested against the right points of the 3 by 3 cells around its own,
+ * with the left cells split across threads. Workers buffer their matches and
+ * deliver them in blocks, without allocating per match.
+ *
+ * The callback receives blocks of matches, as indices into the left and the right
+ * array, one block at a time in an unspecified order. If it returns false, no
+ * further blocks are delivered.
+ *
+ * @param left An array of pointers to the left points, of which NULL entries are skipped.
+ * @param left_count The number of entries in the left array, at most UINT32_MAX.
+ * @param right An array of pointers to the right points, of which NULL entries are skipped.
+ * @param right_count The number of entries in the right array, at most UINT32_MAX.
+ * @param distance The largest Euclidean distance of a match.
+ * @param callback The function receiving the matches.
+ * @param context A pointer passed unchanged to the callback.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the arrays were joined, false if an argument is NULL or out of
+ * range, or memory allocation fails.
+ */
+bool
+point_join_compute (point_t *const *left, size_t left_count, point_t *const *right, size_t right_count, uint32_t distance, point_join_fn callback,
+                    void *context, uint32_t threads)
+{
+  bool result = false;
+  if ((left != NULL) && (left_count <= UINT32_MAX) && (right != NULL) && (right_count <= UINT32_MAX) && (callback != NULL))
+    {
+      join_context_t join_context = { .left = { .points = left, .count = left_count },
+                                      .right = { .points = right, .count = right_count },
+                                      .distance = distance,
+                                      .callback = callback,
+                                      .user_context = context };
+      result = join_compute (&join_context, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find every pair of points of two batches within a distance of each other.
+ *
+ * The coordinates are read in place, otherwise the batches are joined as by
+ * point_join_compute.
+ *
+ * @param left A pointer to the left batch, of at most UINT32_MAX points.
+ * @param right A pointer to the right batch, of at most UINT32_MAX points.
+ * @param distance The largest Euclidean distance of a match.
+ * @param callback The function receiving the matches.
+ * @param context A pointer passed unchanged to the callback.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the batches were joined, false if an argument is NULL or out of
+ * range, or memory allocation fails.
+ */
+bool
+point_batch_join_compute (const point_batch_t *left, const point_batch_t *right, uint32_t distance, point_join_fn callback, void *context,
+                          uint32_t threads)
+{
+  bool result = false;
+  if ((left != NULL) && (left->x != NULL) && (left->y != NULL) && (left->count <= UINT32_MAX) && (right != NULL) && (right->x != NULL)
+      && (right->y != NULL) && (right->count <= UINT32_MAX) && (callback != NULL))
+    {
+      join_context_t join_context = { .left = { .batch = left, .count = left->count },
+                                      .right = { .batch = right, .count = right->count },
+                                      .distance = distance,
+                                      .callback = callback,
+                                      .user_context = context };
+      result = join_compute (&join_context, threads);
+    }
+
+  return result;
+}
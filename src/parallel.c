@@ -0,0 +1,120 @@
+#include "internal.h"
+#include <unistd.h>
+
+/**
+ * @brief A slice of a parallel run, queued on the thread pool.
+ */
+typedef struct
+{
+  pool_task_t pool_task;
+  atomic_size_t *remaining;
+  parallel_task_fn task;
+  void *context;
+  uint32_t worker;
+  size_t begin;
+  size_t end;
+} parallel_slice_t;
+
+/**
+ * @brief Pool task executing one slice of a parallel run.
+ *
+ * @param pool_task A pointer to the parallel_slice_t describing the work of the slice.
+ */
+static void
+parallel_slice_run (pool_task_t *pool_task)
+{
+  const parallel_slice_t *slice = (const parallel_slice_t *)pool_task;
+  atomic_size_t *remaining = slice->remaining;
+  slice->task (slice->context, slice->worker, slice->begin, slice->end);
+  pool_complete (remaining);
+}
+
+/**
+ * @brief Resolve a requested thread count to an actual one.
+ *
+ * A request of 0 selects the number of online processors. The result is never
+ * smaller than 1 and never larger than PARALLEL_MAX_WORKERS.
+ *
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return The number of threads that should be used.
+ */
+uint32_t
+parallel_resolve_threads (uint32_t threads)
+{
+  uint32_t result = threads;
+  if (result == 0U)
+    {
+      long online = sysconf (_SC_NPROCESSORS_ONLN);
+      result = (online > 0) ? (uint32_t)online : 1U;
+    }
+
+  return (result > PARALLEL_MAX_WORKERS) ? PARALLEL_MAX_WORKERS : result;
+}
+
+/**
+ * @brief Determine how many workers should process a range of elements.
+ *
+ * Small ranges are not worth the cost of waking threads, so the number of
+ * workers is limited such that each one receives at least min_chunk elements.
+ *
+ * @param threads The requested number of threads, or 0 for all available processors.
+ * @param count The number of elements to process.
+ * @param min_chunk The minimum number of elements per worker.
+ *
+ * @return The number of workers to use, at least 1.
+ */
+uint32_t
+parallel_plan (uint32_t threads, size_t count, size_t min_chunk)
+{
+  uint32_t result = parallel_resolve_threads (threads);
+  size_t limit = (min_chunk > 0U) ? (count / min_chunk) : count;
+
+  if (limit < (size_t)result)
+    {
+      result = (limit > 0U) ? (uint32_t)limit : 1U;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Run a task over the range [0, count) split into contiguous slices.
+ *
+ * Slice 0 is executed on the calling thread; the remaining slices are queued on
+ * the thread pool, and the calling thread executes queued tasks until all of them
+ * finished, so the task always covers the full range, even from within a pool task.
+ *
+ * @param workers The number of slices to split the range into.
+ * @param count The number of elements in the range.
+ * @param task The task to execute for every slice.
+ * @param context A pointer passed unchanged to every task invocation.
+ */
+void
+parallel_run (uint32_t workers, size_t count, parallel_task_fn task, void *context)
+{
+  uint32_t slices = (workers == 0U) ? 1U : ((workers > PARALLEL_MAX_WORKERS) ? PARALLEL_MAX_WORKERS : workers);
+
+  parallel_slice_t slice[PARALLEL_MAX_WORKERS];
+  atomic_size_t remaining;
+  atomic_init (&remaining, slices - 1U);
+
+  for (uint32_t i = 0; i < slices; ++i)
+    {
+      slice[i].pool_task.run = parallel_slice_run;
+      slice[i].remaining = &remaining;
+      slice[i].task = task;
+      slice[i].context = context;
+      slice[i].worker = i;
+      slice[i].begin = (count / slices) * i + ((i < (count % slices)) ? i : (count % slices));
+      slice[i].end = slice[i].begin + (count / slices) + ((i < (count % slices)) ? 1U : 0U);
+    }
+
+  for (uint32_t i = 1U; i < slices; ++i)
+    {
+      pool_submit (&slice[i].pool_task);
+    }
+
+  task (context, 0U, slice[0].begin, slice[0].end);
+  pool_wait (&remaining);
+}
@@ -1,13 +1,19 @@
 #include "internal.h"
 #include "library.h"
-#include <stdlib.h>
+#include <string.h>
+
+/* point_value_from_point copies a point as a whole, which requires identical layouts. */
+_Static_assert (sizeof (point_value_t) == sizeof (struct point), "point_value_t must match the size of struct point");
+_Static_assert (offsetof (point_value_t, y) == offsetof (struct point, y), "point_value_t must match the layout of struct point");
 
 /**
  * @brief Create a new point with the specified coordinates.
  *
  * This function allocates memory for a new point structure and initializes its
- * coordinates based on the provided values. The caller is responsible for freeing
- * the memory allocated by this function when it is no longer needed.
+ * coordinates based on the provided values. The memory is obtained from the
+ * allocator installed with point_set_allocator, or malloc by default. The caller is
+ * responsible for freeing the memory allocated by this function when it is no
+ * longer needed.
  *
  * @param x The x-coordinate of the point.
  * @param y The y-coordinate of the point.
@@ -18,11 +24,19 @@
 point_t *
 point_create (uint32_t x, uint32_t y)
 {
-  point_t *point = malloc (sizeof (struct point));
+#ifdef LIB_STATS
+  uint64_t start = stats_now_ns ();
+#endif
+
+  point_t *point = allocator_alloc (sizeof (struct point));
   if (point != NULL)
     {
       point->x = x;
       point->y = y;
+
+#ifdef LIB_STATS
+      stats_record_create (sizeof (struct point), stats_now_ns () - start);
+#endif
     }
 
   return point;
@@ -45,8 +59,12 @@ point_destroy (point_t *point)
   bool result = false;
   if (point != NULL)
     {
-      free (point);
+      allocator_free (point, sizeof (struct point));
       result = true;
+
+#ifdef LIB_STATS
+      stats_record_destroy (sizeof (struct point));
+#endif
     }
 
   return result;
@@ -95,3 +113,41 @@ point_get_y (const point_t *point)
 
   return result;
 }
+
+/**
+ * @brief Copy the coordinates of a point into a point value.
+ *
+ * The point is copied with a single 8-byte move rather than coordinate by coordinate.
+ *
+ * @param point A pointer to the point to copy.
+ *
+ * @return The point value, or a value at the origin if the input point pointer is
+ * NULL.
+ */
+point_value_t
+point_value_from_point (const point_t *point)
+{
+  point_value_t result = { 0U, 0U };
+  if (point != NULL)
+    {
+      memcpy (&result, point, sizeof (result));
+    }
+
+  return result;
+}
+
+/**
+ * @brief Create a new point with the coordinates of a point value.
+ *
+ * The point is created with point_create and must be destroyed with point_destroy.
+ *
+ * @param value The point value to copy.
+ *
+ * @return A pointer to the newly created point if allocation succeeds, or NULL if
+ * memory allocation fails.
+ */
+point_t *
+point_value_to_point (point_value_t value)
+{
+  return point_create (value.x, value.y);
+}
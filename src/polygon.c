@@ -0,0 +1,661 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Upper bound on the number of horizontal bands of a prepared polygon. */
+#define POLYGON_MAX_BANDS 1024U
+
+/* Upper bound on the average number of bands an edge is stored in. */
+#define POLYGON_MAX_COPIES 8U
+
+/* Upper bound on the number of cells per side of the grid locating points among polygons. */
+#define POLYGON_MAX_CELLS 256U
+
+/* Index reported for points that no polygon contains. */
+#define POLYGON_NO_INDEX UINT32_MAX
+
+/**
+ * @brief A polygon prepared for point-in-polygon tests.
+ *
+ * The bounding box of the polygon is divided into horizontal bands of equal height,
+ * and every band lists the edges spanning part of it, so a test only evaluates the
+ * edges that a horizontal ray through the point can cross. Edges are stored as
+ * structure-of-arrays doubles, from their lower end with the inverse slope
+ * precomputed, so the crossing count of a band is a branch-free vectorizable loop.
+ * Horizontal edges can never be crossed and are dropped.
+ */
+struct point_polygon
+{
+  point_bbox_t bbox;
+  uint32_t bands;
+  size_t *band_offsets;
+  double *low;
+  double *high;
+  double *x;
+  double *slope;
+};
+
+/**
+ * @brief Shared state of a batch of point-in-polygon tests.
+ *
+ * A batch either tests every point against one polygon, writing a bitmap, or
+ * locates every point among several polygons through a grid over their bounding
+ * boxes, writing polygon indices.
+ */
+typedef struct
+{
+  point_t *const *points;
+  const point_batch_t *batch;
+  size_t count;
+  const point_polygon_t *polygon;
+  uint64_t *bitmap;
+  point_polygon_t *const *polygons;
+  uint32_t *indices;
+  point_bbox_t bounds;
+  uint32_t cells;
+  uint32_t *cell_offsets;
+  uint32_t *cell_polygons;
+} polygon_context_t;
+
+/**
+ * @brief Map a coordinate to one of count equal divisions of a range.
+ *
+ * @param value The coordinate, at least minimum and at most maximum.
+ * @param minimum The lower end of the range.
+ * @param maximum The upper end of the range.
+ * @param count The number of divisions.
+ *
+ * @return The index of the division holding the coordinate, below count.
+ */
+static uint32_t
+polygon_division (uint32_t value, uint32_t minimum, uint32_t maximum, uint32_t count)
+{
+  return (uint32_t)(((uint64_t)(value - minimum) * count) / ((uint64_t)(maximum - minimum) + 1U));
+}
+
+/**
+ * @brief Count the stored edges of a polygon divided into a number of bands.
+ *
+ * An edge from y-coordinate low to high is crossed by rays with low <= y < high,
+ * so it is stored in the bands from the one of low to the one of high - 1.
+ *
+ * @param vertices The vertices of the polygon.
+ * @param count The number of vertices.
+ * @param bbox The bounding box of the vertices.
+ * @param bands The number of bands.
+ * @param band_counts A buffer of bands elements receiving the edges per band, or NULL.
+ *
+ * @return The number of stored edges over all bands.
+ */
+static size_t
+polygon_count_edges (const point_value_t *vertices, size_t count, const point_bbox_t *bbox, uint32_t bands, size_t *band_counts)
+{
+  size_t result = 0;
+  for (size_t i = 0; i < count; ++i)
+    {
+      const point_value_t *from = &vertices[i];
+      const point_value_t *to = &vertices[((i + 1U) < count) ? (i + 1U) : 0U];
+      if (from->y != to->y)
+        {
+          uint32_t low = (from->y < to->y) ? from->y : to->y;
+          uint32_t high = (from->y < to->y) ? to->y : from->y;
+          uint32_t first = polygon_division (low, bbox->min_y, bbox->max_y, bands);
+          uint32_t last = polygon_division (high - 1U, bbox->min_y, bbox->max_y, bands);
+          result += (size_t)(last - first) + 1U;
+          for (uint32_t band = first; (band_counts != NULL) && (band <= last); ++band)
+            {
+              ++band_counts[band];
+            }
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Test whether a polygon contains a point with the crossing number rule.
+ *
+ * @param polygon A pointer to the prepared polygon.
+ * @param px The x-coordinate of the point.
+ * @param py The y-coordinate of the point.
+ *
+ * @return true if a ray from the point towards positive x crosses an odd number of edges.
+ */
+static bool
+polygon_contains (const point_polygon_t *polygon, uint32_t px, uint32_t py)
+{
+  bool result = false;
+  const point_bbox_t *bbox = &polygon->bbox;
+
+  if ((px >= bbox->min_x) && (px <= bbox->max_x) && (py >= bbox->min_y) && (py <= bbox->max_y))
+    {
+      uint32_t band = polygon_division (py, bbox->min_y, bbox->max_y, polygon->bands);
+      size_t end = polygon->band_offsets[band + 1U];
+      const double *restrict low = polygon->low;
+      const double *restrict high = polygon->high;
+      const double *restrict x = polygon->x;
+      const double *restrict slope = polygon->slope;
+      double point_x = (double)px;
+      double point_y = (double)py;
+
+      /* The count is a double so the loop vectorizes, and small integers add up exactly */
+      double crossings = 0.0;
+      for (size_t e = polygon->band_offsets[band]; e < end; ++e)
+        {
+          crossings += ((low[e] <= point_y) & (point_y < high[e]) & (point_x < (x[e] + ((point_y - low[e]) * slope[e])))) ? 1.0 : 0.0;
+        }
+      result = (((uint32_t)crossings) & 1U) != 0U;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Read a point of the batch or the array of a context.
+ *
+ * @param polygon_context A pointer to the context.
+ * @param index The index of the point.
+ * @param x A pointer receiving the x-coordinate.
+ * @param y A pointer receiving the y-coordinate.
+ *
+ * @return true if the point exists, false if the array entry is NULL.
+ */
+static bool
+polygon_read (const polygon_context_t *polygon_context, size_t index, uint32_t *x, uint32_t *y)
+{
+  bool result = true;
+  if (polygon_context->batch != NULL)
+    {
+      *x = polygon_context->batch->x[index];
+      *y = polygon_context->batch->y[index];
+    }
+  else
+    {
+      const point_t *point = polygon_context->points[index];
+      result = (point != NULL);
+      *x = result ? point->x : 0U;
+      *y = result ? point->y : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Parallel task testing the points of a slice of bitmap words against one polygon.
+ *
+ * Slices are made of whole words, so no two workers write the same word.
+ *
+ * @param context A pointer to the polygon_context_t of the batch.
+ * @param worker The index of the worker, unused.
+ * @param begin The first bitmap word of the slice.
+ * @param end One past the last bitmap word of the slice.
+ */
+static void
+polygon_test_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const polygon_context_t *polygon_context = context;
+
+  for (size_t word = begin; word < end; ++word)
+    {
+      uint64_t bits = 0U;
+      size_t first = word * 64U;
+      size_t last = ((polygon_context->count - first) < 64U) ? polygon_context->count : (first + 64U);
+      for (size_t i = first; i < last; ++i)
+        {
+          uint32_t x = 0U;
+          uint32_t y = 0U;
+          bool is_inside = polygon_read (polygon_context, i, &x, &y) && polygon_contains (polygon_context->polygon, x, y);
+          bits |= (uint64_t)(is_inside ? 1U : 0U) << (i - first);
+        }
+      polygon_context->bitmap[word] = bits;
+    }
+}
+
+/**
+ * @brief Parallel task locating the points of a slice among the polygons of the grid.
+ *
+ * @param context A pointer to the polygon_context_t of the batch.
+ * @param worker The index of the worker, unused.
+ * @param begin The first point of the slice.
+ * @param end One past the last point of the slice.
+ */
+static void
+polygon_locate_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const polygon_context_t *polygon_context = context;
+  const point_bbox_t *bounds = &polygon_context->bounds;
+
+  for (size_t i = begin; i < end; ++i)
+    {
+      uint32_t x = 0U;
+      uint32_t y = 0U;
+      uint32_t result = POLYGON_NO_INDEX;
+
+      if (polygon_read (polygon_context, i, &x, &y) && (x >= bounds->min_x) && (x <= bounds->max_x) && (y >= bounds->min_y) && (y <= bounds->max_y))
+        {
+          uint32_t column = polygon_division (x, bounds->min_x, bounds->max_x, polygon_context->cells);
+          uint32_t row = polygon_division (y, bounds->min_y, bounds->max_y, polygon_context->cells);
+          uint32_t cell = (row * polygon_context->cells) + column;
+
+          /* Candidates are listed in ascending order, so the first hit has the lowest index */
+          for (uint32_t n = polygon_context->cell_offsets[cell]; (result == POLYGON_NO_INDEX) && (n < polygon_context->cell_offsets[cell + 1U]); ++n)
+            {
+              uint32_t candidate = polygon_context->cell_polygons[n];
+              result = polygon_contains (polygon_context->polygons[candidate], x, y) ? candidate : POLYGON_NO_INDEX;
+            }
+        }
+      polygon_context->indices[i] = result;
+    }
+}
+
+/**
+ * @brief Store the edges of a polygon in the bands they span.
+ *
+ * The band offsets must hold the first position of every band, and are advanced to
+ * the end of the band while its edges are stored.
+ *
+ * @param polygon A pointer to the polygon with its bands and edge buffers allocated.
+ * @param vertices The vertices of the polygon.
+ * @param count The number of vertices.
+ */
+static void
+polygon_store_edges (point_polygon_t *polygon, const point_value_t *vertices, size_t count)
+{
+  const point_bbox_t *bbox = &polygon->bbox;
+  for (size_t i = 0; i < count; ++i)
+    {
+      const point_value_t *from = &vertices[i];
+      const point_value_t *to = &vertices[((i + 1U) < count) ? (i + 1U) : 0U];
+      if (from->y != to->y)
+        {
+          const point_value_t *low = (from->y < to->y) ? from : to;
+          const point_value_t *high = (from->y < to->y) ? to : from;
+          uint32_t first = polygon_division (low->y, bbox->min_y, bbox->max_y, polygon->bands);
+          uint32_t last = polygon_division (high->y - 1U, bbox->min_y, bbox->max_y, polygon->bands);
+          for (uint32_t band = first; band <= last; ++band)
+            {
+              size_t e = polygon->band_offsets[band]++;
+              polygon->low[e] = (double)low->y;
+              polygon->high[e] = (double)high->y;
+              polygon->x[e] = (double)low->x;
+              polygon->slope[e] = ((double)high->x - (double)low->x) / ((double)high->y - (double)low->y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Determine the range of grid cells that a bounding box overlaps.
+ *
+ * @param bbox The bounding box, within the bounds of the grid.
+ * @param bounds The bounds covered by the grid.
+ * @param cells The number of cells per side of the grid.
+ * @param span An array receiving the first and last column and the first and last row.
+ */
+static void
+polygon_grid_span (const point_bbox_t *bbox, const point_bbox_t *bounds, uint32_t cells, uint32_t span[4])
+{
+  span[0] = polygon_division (bbox->min_x, bounds->min_x, bounds->max_x, cells);
+  span[1] = polygon_division (bbox->max_x, bounds->min_x, bounds->max_x, cells);
+  span[2] = polygon_division (bbox->min_y, bounds->min_y, bounds->max_y, cells);
+  span[3] = polygon_division (bbox->max_y, bounds->min_y, bounds->max_y, cells);
+}
+
+/**
+ * @brief Locate points among polygons through a grid over the polygon bounding boxes.
+ *
+ * The grid covers the union of the bounding boxes with about one polygon per cell,
+ * and every cell lists the polygons whose bounding box overlaps it in ascending
+ * order, so a point is only tested against the polygons near it. The grid is
+ * coarsened while polygons would be listed in too many cells.
+ *
+ * @param polygon_context A pointer to the context with its input, polygons and indices set.
+ * @param polygon_count The number of polygons, at most UINT32_MAX.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ *
+ * @return true if the points were located, false on allocation failure.
+ */
+static bool
+polygon_locate (polygon_context_t *polygon_context, size_t polygon_count, uint32_t threads)
+{
+  bool result = false;
+  size_t present = 0;
+  point_bbox_t *bounds = &polygon_context->bounds;
+  *bounds = (point_bbox_t){ UINT32_MAX, UINT32_MAX, 0U, 0U };
+
+  for (size_t i = 0; i < polygon_count; ++i)
+    {
+      const point_polygon_t *polygon = polygon_context->polygons[i];
+      if (polygon != NULL)
+        {
+          bounds->min_x = (polygon->bbox.min_x < bounds->min_x) ? polygon->bbox.min_x : bounds->min_x;
+          bounds->min_y = (polygon->bbox.min_y < bounds->min_y) ? polygon->bbox.min_y : bounds->min_y;
+          bounds->max_x = (polygon->bbox.max_x > bounds->max_x) ? polygon->bbox.max_x : bounds->max_x;
+          bounds->max_y = (polygon->bbox.max_y > bounds->max_y) ? polygon->bbox.max_y : bounds->max_y;
+          ++present;
+        }
+    }
+
+  uint32_t cells = 1U;
+  while ((((size_t)cells * cells) < present) && (cells < POLYGON_MAX_CELLS))
+    {
+      cells *= 2U;
+    }
+
+  size_t entries = 0;
+  for (bool is_sized = false; !is_sized; cells /= 2U)
+    {
+      entries = 0U;
+      for (size_t i = 0; i < polygon_count; ++i)
+        {
+          uint32_t span[4];
+          if (polygon_context->polygons[i] != NULL)
+            {
+              polygon_grid_span (&polygon_context->polygons[i]->bbox, bounds, cells, span);
+              entries += (size_t)(span[1] - span[0] + 1U) * (span[3] - span[2] + 1U);
+            }
+        }
+      polygon_context->cells = cells;
+      is_sized = (entries <= (POLYGON_MAX_COPIES * present)) || (cells == 1U);
+    }
+
+  size_t cell_count = (size_t)polygon_context->cells * polygon_context->cells;
+  uint32_t *block = (entries <= UINT32_MAX) ? calloc (cell_count + 1U + entries, sizeof (uint32_t)) : NULL;
+  if (block != NULL)
+    {
+      polygon_context->cell_offsets = block;
+      polygon_context->cell_polygons = &block[cell_count + 1U];
+
+      /* The lists are filled twice: once to count the entries per cell, then to store them */
+      for (uint32_t pass = 0; pass < 2U; ++pass)
+        {
+          for (size_t i = 0; i < polygon_count; ++i)
+            {
+              uint32_t span[4];
+              if (polygon_context->polygons[i] == NULL)
+                {
+                  continue;
+                }
+
+              polygon_grid_span (&polygon_context->polygons[i]->bbox, bounds, polygon_context->cells, span);
+              for (uint32_t row = span[2]; row <= span[3]; ++row)
+                {
+                  for (uint32_t column = span[0]; column <= span[1]; ++column)
+                    {
+                      uint32_t cell = (row * polygon_context->cells) + column;
+                      if (pass == 0U)
+                        {
+                          ++block[cell + 1U];
+                        }
+                      else
+                        {
+                          polygon_context->cell_polygons[block[cell]++] = (uint32_t)i;
+                        }
+                    }
+                }
+            }
+
+          /* Turn the counts into offsets, then restore them after the store advanced them */
+          for (size_t cell = 0; (pass == 0U) && (cell < cell_count); ++cell)
+            {
+              block[cell + 1U] += block[cell];
+            }
+          for (size_t cell = cell_count; (pass == 1U) && (cell > 0U); --cell)
+            {
+              block[cell] = block[cell - 1U];
+            }
+          block[0] = 0U;
+        }
+
+      uint32_t workers = parallel_plan (threads, polygon_context->count, PARALLEL_MIN_CHUNK);
+      parallel_run (workers, polygon_context->count, polygon_locate_task, polygon_context);
+      free (block);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Test the points of a context against its polygon into its bitmap.
+ *
+ * @param polygon_context A pointer to the context with its input, polygon and bitmap set.
+ * @param threads The requested number of threads, or 0 for all available processors.
+ */
+static void
+polygon_test (polygon_context_t *polygon_context, uint32_t threads)
+{
+  size_t words = (polygon_context->count + 63U) / 64U;
+  uint32_t workers = parallel_plan (threads, words, PARALLEL_MIN_CHUNK / 64U);
+  parallel_run (workers, words, polygon_test_task, polygon_context);
+}
+
+/**
+ * @brief Create a polygon prepared for point-in-polygon tests.
+ *
+ * The polygon is the closed ring through the vertices, with an edge from the last
+ * vertex back to the first. Its interior follows the even-odd rule, so rings that
+ * intersect themselves are supported. The edges are distributed over horizontal
+ * bands such that they are stored at most 8 times on average.
+ *
+ * @param vertices The vertices of the polygon.
+ * @param count The number of vertices, at least 3.
+ *
+ * @return A pointer to the polygon, or NULL if the vertices are NULL or too few, or
+ * memory allocation fails.
+ */
+point_polygon_t *
+point_polygon_create (const point_value_t *vertices, size_t count)
+{
+  point_polygon_t *result = NULL;
+  if ((vertices != NULL) && (count >= 3U))
+    {
+      point_bbox_t bbox = { UINT32_MAX, UINT32_MAX, 0U, 0U };
+      for (size_t i = 0; i < count; ++i)
+        {
+          bbox.min_x = (vertices[i].x < bbox.min_x) ? vertices[i].x : bbox.min_x;
+          bbox.min_y = (vertices[i].y < bbox.min_y) ? vertices[i].y : bbox.min_y;
+          bbox.max_x = (vertices[i].x > bbox.max_x) ? vertices[i].x : bbox.max_x;
+          bbox.max_y = (vertices[i].y > bbox.max_y) ? vertices[i].y : bbox.max_y;
+        }
+
+      /* About two edges per band, then halved while tall edges are stored too often */
+      size_t edges = polygon_count_edges (vertices, count, &bbox, 1U, NULL);
+      uint32_t bands = (uint32_t)(((edges / 2U) < POLYGON_MAX_BANDS) ? (edges / 2U) : POLYGON_MAX_BANDS);
+      bands = (bands > 0U) ? bands : 1U;
+      size_t stored = polygon_count_edges (vertices, count, &bbox, bands, NULL);
+      while ((stored > (POLYGON_MAX_COPIES * edges)) && (bands > 1U))
+        {
+          bands /= 2U;
+          stored = polygon_count_edges (vertices, count, &bbox, bands, NULL);
+        }
+
+      /* A single block holds the polygon, the band offsets and four doubles per stored edge */
+      size_t size = sizeof (point_polygon_t) + (((size_t)bands + 1U) * sizeof (size_t)) + (stored * 4U * sizeof (double));
+      result = calloc (1U, size);
+      if (result != NULL)
+        {
+          result->bbox = bbox;
+          result->bands = bands;
+          result->band_offsets = (size_t *)&result[1];
+          result->low = (double *)&result->band_offsets[bands + 1U];
+          result->high = &result->low[stored];
+          result->x = &result->high[stored];
+          result->slope = &result->x[stored];
+
+          (void)polygon_count_edges (vertices, count, &bbox, bands, &result->band_offsets[1]);
+          for (uint32_t band = 0; band < bands; ++band)
+            {
+              result->band_offsets[band + 1U] += result->band_offsets[band];
+            }
+          polygon_store_edges (result, vertices, count);
+          for (uint32_t band = bands; band > 0U; --band)
+            {
+              result->band_offsets[band] = result->band_offsets[band - 1U];
+            }
+          result->band_offsets[0] = 0U;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Destroy a prepared polygon.
+ *
+ * @param polygon A pointer to the polygon.
+ *
+ * @return true if the polygon was destroyed, false if it is NULL.
+ */
+bool
+point_polygon_destroy (point_polygon_t *polygon)
+{
+  bool result = false;
+  if (polygon != NULL)
+    {
+      free (polygon);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Test whether a prepared polygon contains a point.
+ *
+ * Points outside the bounding box are rejected at once, and the others are tested
+ * against the edges of their band only. Points exactly on an edge may be reported
+ * either way.
+ *
+ * @param polygon A pointer to the polygon.
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ *
+ * @return true if the polygon contains the point, false if it does not or the polygon is NULL.
+ */
+bool
+point_polygon_contains (const point_polygon_t *polygon, uint32_t x, uint32_t y)
+{
+  return (polygon != NULL) && polygon_contains (polygon, x, y);
+}
+
+/**
+ * @brief Test every point of an array against a prepared polygon.
+ *
+ * Bit i % 64 of word i / 64 of the bitmap is set if the polygon contains point i,
+ * and cleared otherwise, including for NULL entries. Large arrays are split across
+ * threads by whole bitmap words.
+ *
+ * @param polygon A pointer to the polygon.
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the array.
+ * @param bitmap A buffer of (count + 63) / 64 words receiving the results.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were tested, false if an argument is NULL.
+ */
+bool
+point_polygon_test (const point_polygon_t *polygon, point_t *const *points, size_t count, uint64_t *bitmap, uint32_t threads)
+{
+  bool result = false;
+  if ((polygon != NULL) && (points != NULL) && (bitmap != NULL))
+    {
+      polygon_context_t polygon_context = { .points = points, .count = count, .polygon = polygon, .bitmap = bitmap };
+      polygon_test (&polygon_context, threads);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Test every point of a batch against a prepared polygon.
+ *
+ * The coordinates are read in place, otherwise the points are tested as by
+ * point_polygon_test.
+ *
+ * @param polygon A pointer to the polygon.
+ * @param batch A pointer to the batch of points.
+ * @param bitmap A buffer of (batch->count + 63) / 64 words receiving the results.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were tested, false if an argument is NULL.
+ */
+bool
+point_batch_polygon_test (const point_polygon_t *polygon, const point_batch_t *batch, uint64_t *bitmap, uint32_t threads)
+{
+  bool result = false;
+  if ((polygon != NULL) && (batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (bitmap != NULL))
+    {
+      polygon_context_t polygon_context = { .batch = batch, .count = batch->count, .polygon = polygon, .bitmap = bitmap };
+      polygon_test (&polygon_context, threads);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the polygon containing every point of an array.
+ *
+ * A grid over the bounding boxes of the polygons limits the polygons a point is
+ * tested against to the few whose bounding box is near it, so the cost grows with
+ * the overlap of the polygons rather than with their number. Large arrays are split
+ * across threads.
+ *
+ * @param polygons An array of pointers to the polygons, of which NULL entries are skipped.
+ * @param polygon_count The number of entries in the polygon array, at most UINT32_MAX.
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the point array.
+ * @param indices A buffer of count elements receiving the lowest index of a polygon
+ * containing each point, or UINT32_MAX for points, and NULL entries, outside all of them.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were located, false if an argument is NULL, there are
+ * too many polygons or memory allocation fails.
+ */
+bool
+point_polygon_locate (point_polygon_t *const *polygons, size_t polygon_count, point_t *const *points, size_t count, uint32_t *indices,
+                      uint32_t threads)
+{
+  bool result = false;
+  if ((polygons != NULL) && (polygon_count <= UINT32_MAX) && (points != NULL) && (indices != NULL))
+    {
+      polygon_context_t polygon_context = { .points = points, .count = count, .polygons = polygons, .indices = indices };
+      result = polygon_locate (&polygon_context, polygon_count, threads);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the polygon containing every point of a batch.
+ *
+ * The coordinates are read in place, otherwise the points are located as by
+ * point_polygon_locate.
+ *
+ * @param polygons An array of pointers to the polygons, of which NULL entries are skipped.
+ * @param polygon_count The number of entries in the polygon array, at most UINT32_MAX.
+ * @param batch A pointer to the batch of points.
+ * @param indices A buffer of batch->count elements receiving the lowest index of a
+ * polygon containing each point, or UINT32_MAX for points outside all of them.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the points were located, false if an argument is NULL, there are
+ * too many polygons or memory allocation fails.
+ */
+bool
+point_batch_polygon_locate (point_polygon_t *const *polygons, size_t polygon_count, const point_batch_t *batch, uint32_t *indices, uint32_t threads)
+{
+  bool result = false;
+  if ((polygons != NULL) && (polygon_count <= UINT32_MAX) && (batch != NULL) && (batch->x != NULL) && (batch->y != NULL)
+      && (indices != NULL))
+    {
+      polygon_context_t polygon_context = { .batch = batch, .count = batch->count, .polygons = polygons, .indices = indices };
+      result = polygon_locate (&polygon_context, polygon_count, threads);
+    }
+
+  return result;
+}
@@ -0,0 +1,740 @@
+#ifdef __linux__
+/* pthread_setaffinity_np and sched_getaffinity are GNU extensions */
+#define _GNU_SOURCE
+#endif
+
+#include "internal.h"
+#include "library.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+/* Capacity of the deque of every worker, a power of two; tasks beyond it go to the shared queue. */
+#define POOL_DEQUE_SIZE 4096U
+
+/* Number of failed attempts to find a task after which a thread goes to sleep. */
+#define POOL_SPIN_ROUNDS 64U
+
+/* Number of chunks per pool thread that point_parallel_for aims for without a grain size. */
+#define POOL_FOR_CHUNKS_PER_THREAD 8U
+
+/* Upper bound on the number of chunks of one point_parallel_for call. */
+#define POOL_FOR_MAX_CHUNKS 65536U
+
+/* Size of a cache line, separating the indices of a deque written by different threads. */
+#define POOL_CACHE_LINE 64U
+
+/**
+ * @brief A Chase-Lev work-stealing deque of tasks.
+ *
+ * The owning worker pushes and pops tasks at the bottom without locking, while
+ * other threads steal from the top with a compare-and-swap. The capacity is fixed,
+ * so tasks are never reclaimed while a thief may still read them.
+ */
+typedef struct
+{
+  _Alignas (POOL_CACHE_LINE) _Atomic (int64_t) top;
+  _Alignas (POOL_CACHE_LINE) _Atomic (int64_t) bottom;
+  _Atomic (pool_task_t *) tasks[POOL_DEQUE_SIZE];
+} pool_deque_t;
+
+/**
+ * @brief A thread of the pool with its deque.
+ */
+typedef struct
+{
+  pool_deque_t deque;
+  pthread_t thread;
+  uint32_t index;
+  bool is_started;
+} pool_worker_t;
+
+/**
+ * @brief The thread pool shared by all parallel algorithms of the library.
+ *
+ * Tasks submitted by pool threads go to their own deque, and tasks submitted by
+ * other threads go to a shared queue. Idle threads pop their own deque, then the
+ * shared queue, then steal from the other deques, and sleep on the wake condition
+ * once nothing was found for a while. Pending counts the tasks that are queued but
+ * not taken yet. Threads counts the started pool threads while the pool runs, so
+ * that it is read without taking the configuration lock.
+ */
+typedef struct
+{
+  pthread_mutex_t config_lock;
+  pthread_mutex_t queue_lock;
+  pthread_mutex_t sleep_lock;
+  pthread_cond_t wake;
+  pool_worker_t *workers;
+  uint32_t workers_count;
+  bool is_pinned;
+  pool_task_t *head;
+  pool_task_t *tail;
+  atomic_bool is_running;
+  atomic_bool is_stopping;
+  atomic_size_t pending;
+  atomic_size_t injected;
+  atomic_uint sleepers;
+  atomic_uint threads;
+} pool_t;
+
+/**
+ * @brief A range of chunks of a point_parallel_for call.
+ */
+typedef struct
+{
+  pool_task_t task;
+  struct pool_for *loop;
+  size_t first;
+  size_t last;
+} pool_range_t;
+
+/**
+ * @brief The state of a point_parallel_for call.
+ *
+ * Ranges split in halves until they hold a single chunk. The upper half of a range
+ * is stored in the record of its first chunk, which no other range starts with, so
+ * one record per chunk suffices.
+ */
+typedef struct pool_for
+{
+  point_range_fn body;
+  void *context;
+  size_t count;
+  size_t chunk;
+  atomic_size_t remaining;
+  pool_range_t *ranges;
+} pool_for_t;
+
+struct point_future
+{
+  pool_task_t task;
+  point_task_fn function;
+  void *context;
+  atomic_size_t remaining;
+};
+
+static pool_t g_pool = {
+  .config_lock = PTHREAD_MUTEX_INITIALIZER,
+  .queue_lock = PTHREAD_MUTEX_INITIALIZER,
+  .sleep_lock = PTHREAD_MUTEX_INITIALIZER,
+  .wake = PTHREAD_COND_INITIALIZER,
+};
+static _Thread_local pool_worker_t *t_pool_worker = NULL;
+static _Thread_local uint32_t t_pool_seed = 0U;
+
+static void pool_shutdown (void) __attribute__ ((destructor));
+
+/**
+ * @brief Push a task to the bottom of a deque, called by its owner only.
+ *
+ * @param deque A pointer to the deque.
+ * @param task A pointer to the task.
+ *
+ * @return true if the task was pushed, false if the deque is full.
+ */
+static bool
+pool_deque_push (pool_deque_t *deque, pool_task_t *task)
+{
+  bool result = false;
+  int64_t bottom = atomic_load_explicit (&deque->bottom, memory_order_relaxed);
+  int64_t top = atomic_load_explicit (&deque->top, memory_order_acquire);
+
+  if ((bottom - top) < (int64_t)POOL_DEQUE_SIZE)
+    {
+      atomic_store_explicit (&deque->tasks[(uint64_t)bottom & (POOL_DEQUE_SIZE - 1U)], task, memory_order_relaxed);
+      atomic_thread_fence (memory_order_release);
+      atomic_store_explicit (&deque->bottom, bottom + 1, memory_order_relaxed);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Pop the most recently pushed task from the bottom of a deque, called by its owner only.
+ *
+ * @param deque A pointer to the deque.
+ *
+ * @return A pointer to the task, or NULL if the deque is empty or a thief took the
+ * last task.
+ */
+static pool_task_t *
+pool_deque_pop (pool_deque_t *deque)
+{
+  pool_task_t *result = NULL;
+  int64_t bottom = atomic_load_explicit (&deque->bottom, memory_order_relaxed) - 1;
+  atomic_store_explicit (&deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence (memory_order_seq_cst);
+  int64_t top = atomic_load_explicit (&deque->top, memory_order_relaxed);
+
+  if (top <= bottom)
+    {
+      result = atomic_load_explicit (&deque->tasks[(uint64_t)bottom & (POOL_DEQUE_SIZE - 1U)], memory_order_relaxed);
+      if (top == bottom)
+        {
+          /* The last task races with thieves for the top */
+          if (!atomic_compare_exchange_strong_explicit (&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+            {
+              result = NULL;
+            }
+          atomic_store_explicit (&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    }
+  else
+    {
+      atomic_store_explicit (&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Steal the oldest task from the top of a deque, called by any thread.
+ *
+ * @param deque A pointer to the deque.
+ *
+ * @return A pointer to the task, or NULL if the deque is empty or another thread
+ * took the task first.
+ */
+static pool_task_t *
+pool_deque_steal (pool_deque_t *deque)
+{
+  pool_task_t *result = NULL;
+  int64_t top = atomic_load_explicit (&deque->top, memory_order_acquire);
+  atomic_thread_fence (memory_order_seq_cst);
+  int64_t bottom = atomic_load_explicit (&deque->bottom, memory_order_acquire);
+
+  if (top < bottom)
+    {
+      result = atomic_load_explicit (&deque->tasks[(uint64_t)top & (POOL_DEQUE_SIZE - 1U)], memory_order_relaxed);
+      if (!atomic_compare_exchange_strong_explicit (&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+        {
+          result = NULL;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Wake all sleeping threads, if any, after a task was queued or a group completed.
+ */
+static void
+pool_notify (void)
+{
+  if (atomic_load (&g_pool.sleepers) > 0U)
+    {
+      (void)pthread_mutex_lock (&g_pool.sleep_lock);
+      (void)pthread_cond_broadcast (&g_pool.wake);
+      (void)pthread_mutex_unlock (&g_pool.sleep_lock);
+    }
+}
+
+/**
+ * @brief Sleep until a task is queued, the pool stops or a group completes.
+ *
+ * The sleeper count is raised before the conditions are checked, and notifiers
+ * change the conditions before they read the count, so no wake-up is lost.
+ *
+ * @param remaining A pointer to the number of unfinished tasks of the group the
+ * thread waits for, or NULL for an idle pool thread.
+ */
+static void
+pool_sleep (atomic_size_t *remaining)
+{
+  (void)pthread_mutex_lock (&g_pool.sleep_lock);
+  (void)atomic_fetch_add (&g_pool.sleepers, 1U);
+  while ((atomic_load (&g_pool.pending) == 0U) && !atomic_load (&g_pool.is_stopping) && ((remaining == NULL) || (atomic_load (remaining) > 0U)))
+    {
+      (void)pthread_cond_wait (&g_pool.wake, &g_pool.sleep_lock);
+    }
+  (void)atomic_fetch_sub (&g_pool.sleepers, 1U);
+  (void)pthread_mutex_unlock (&g_pool.sleep_lock);
+}
+
+/**
+ * @brief Take a task to execute: from the own deque, the shared queue, or another deque.
+ *
+ * @param self A pointer to the worker of the calling thread, or NULL outside the pool.
+ *
+ * @return A pointer to the task, or NULL if none was found.
+ */
+static pool_task_t *
+pool_take (pool_worker_t *self)
+{
+  pool_task_t *result = (self != NULL) ? pool_deque_pop (&self->deque) : NULL;
+
+  if ((result == NULL) && (atomic_load (&g_pool.injected) > 0U))
+    {
+      (void)pthread_mutex_lock (&g_pool.queue_lock);
+      result = g_pool.head;
+      if (result != NULL)
+        {
+          g_pool.head = result->next;
+          g_pool.tail = (g_pool.head != NULL) ? g_pool.tail : NULL;
+          (void)atomic_fetch_sub (&g_pool.injected, 1U);
+        }
+      (void)pthread_mutex_unlock (&g_pool.queue_lock);
+    }
+
+  /* Victims are visited from a random start, so thieves spread over the deques */
+  uint32_t count = g_pool.workers_count;
+  t_pool_seed = (t_pool_seed * 1664525U) + 1013904223U;
+  for (uint32_t i = 0; (result == NULL) && (i < count); ++i)
+    {
+      pool_worker_t *victim = &g_pool.workers[((t_pool_seed >> 8U) + i) % count];
+      result = (victim != self) ? pool_deque_steal (&victim->deque) : NULL;
+    }
+
+  if (result != NULL)
+    {
+      (void)atomic_fetch_sub (&g_pool.pending, 1U);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Pin the calling pool thread to one of the processors the process may run on.
+ *
+ * @param index The index of the worker, selecting the processor round-robin.
+ */
+static void
+pool_pin (uint32_t index)
+{
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO (&allowed);
+  int32_t count = (sched_getaffinity (0, sizeof (allowed), &allowed) == 0) ? CPU_COUNT (&allowed) : 0;
+
+  int32_t target = (count > 0) ? (int32_t)(index % (uint32_t)count) : -1;
+  for (int32_t cpu = 0; (target >= 0) && (cpu < CPU_SETSIZE); ++cpu)
+    {
+      if (CPU_ISSET (cpu, &allowed) && (target-- == 0))
+        {
+          cpu_set_t pinned;
+          CPU_ZERO (&pinned);
+          CPU_SET (cpu, &pinned);
+          (void)pthread_setaffinity_np (pthread_self (), sizeof (pinned), &pinned);
+        }
+    }
+#else
+  (void)index;
+#endif
+}
+
+/**
+ * @brief Entry point of a pool thread.
+ *
+ * @param argument A pointer to the pool_worker_t of the thread.
+ *
+ * @return Always NULL.
+ */
+static void *
+pool_worker_main (void *argument)
+{
+  pool_worker_t *worker = argument;
+  t_pool_worker = worker;
+  t_pool_seed = worker->index + 1U;
+  if (g_pool.is_pinned)
+    {
+      pool_pin (worker->index);
+    }
+
+  uint32_t idle = 0;
+  for (;;)
+    {
+      pool_task_t *task = pool_take (worker);
+      if (task != NULL)
+        {
+          task->run (task);
+          idle = 0U;
+        }
+      else if (atomic_load (&g_pool.is_stopping) && (atomic_load (&g_pool.pending) == 0U))
+        {
+          break;
+        }
+      else if (++idle < POOL_SPIN_ROUNDS)
+        {
+          (void)sched_yield ();
+        }
+      else
+        {
+          pool_sleep (NULL);
+          idle = 0U;
+        }
+    }
+
+  return NULL;
+}
+
+/**
+ * @brief Start the threads of the pool. Must be called with config_lock held.
+ *
+ * @param threads The number of threads to start.
+ * @param is_pinned Whether every thread is pinned to a processor.
+ *
+ * @return true if at least one thread was started, false otherwise.
+ */
+static bool
+pool_start (uint32_t threads, bool is_pinned)
+{
+  /* The deques are over-aligned, so the size is rounded up to their alignment */
+  size_t size = ((threads * sizeof (pool_worker_t)) + POOL_CACHE_LINE - 1U) & ~(size_t)(POOL_CACHE_LINE - 1U);
+  pool_worker_t *workers = aligned_alloc (POOL_CACHE_LINE, size);
+  uint32_t started = 0U;
+
+  if (workers != NULL)
+    {
+      for (uint32_t i = 0; i < threads; ++i)
+        {
+          atomic_init (&workers[i].deque.top, 0);
+          atomic_init (&workers[i].deque.bottom, 0);
+          workers[i].index = i;
+          workers[i].is_started = false;
+        }
+
+      g_pool.workers = workers;
+      g_pool.workers_count = threads;
+      g_pool.is_pinned = is_pinned;
+      atomic_store (&g_pool.is_stopping, false);
+
+      for (uint32_t i = 0; i < threads; ++i)
+        {
+          workers[i].is_started = (pthread_create (&workers[i].thread, NULL, pool_worker_main, &workers[i]) == 0);
+          started += workers[i].is_started ? 1U : 0U;
+        }
+    }
+
+  /* Without threads, tasks still run on the threads waiting for them */
+  atomic_store_explicit (&g_pool.threads, started, memory_order_relaxed);
+  atomic_store_explicit (&g_pool.is_running, true, memory_order_release);
+
+  return started > 0U;
+}
+
+/**
+ * @brief Stop the threads of the pool after they finished the queued tasks. Must be
+ * called with config_lock held.
+ */
+static void
+pool_stop (void)
+{
+  if (atomic_load (&g_pool.is_running))
+    {
+      atomic_store (&g_pool.is_stopping, true);
+      (void)pthread_mutex_lock (&g_pool.sleep_lock);
+      (void)pthread_cond_broadcast (&g_pool.wake);
+      (void)pthread_mutex_unlock (&g_pool.sleep_lock);
+
+      for (uint32_t i = 0; i < g_pool.workers_count; ++i)
+        {
+          if (g_pool.workers[i].is_started)
+            {
+              (void)pthread_join (g_pool.workers[i].thread, NULL);
+            }
+        }
+
+      free (g_pool.workers);
+      g_pool.workers = NULL;
+      g_pool.workers_count = 0U;
+      atomic_store (&g_pool.is_running, false);
+      atomic_store (&g_pool.threads, 0U);
+    }
+}
+
+/**
+ * @brief Stop the threads of the pool when the library is unloaded or the process exits.
+ *
+ * Otherwise the threads would keep running, or sleeping, in code that dlclose
+ * unmaps. The pool is left alone if the process exits from one of its threads,
+ * which cannot join itself.
+ */
+static void
+pool_shutdown (void)
+{
+  if (t_pool_worker == NULL)
+    {
+      (void)pthread_mutex_lock (&g_pool.config_lock);
+      pool_stop ();
+      (void)pthread_mutex_unlock (&g_pool.config_lock);
+    }
+}
+
+/**
+ * @brief Queue a task on the thread pool, starting the pool on first use.
+ *
+ * Tasks queued by a pool thread go to its own deque, where they are popped in
+ * last-in first-out order unless other threads steal them first.
+ *
+ * @param task A pointer to the task, which must stay valid until it has run.
+ */
+void
+pool_submit (pool_task_t *task)
+{
+  if (!atomic_load_explicit (&g_pool.is_running, memory_order_acquire))
+    {
+      (void)pthread_mutex_lock (&g_pool.config_lock);
+      if (!atomic_load (&g_pool.is_running))
+        {
+          (void)pool_start (parallel_resolve_threads (0U), false);
+        }
+      (void)pthread_mutex_unlock (&g_pool.config_lock);
+    }
+
+  (void)atomic_fetch_add (&g_pool.pending, 1U);
+  pool_worker_t *worker = t_pool_worker;
+  if ((worker == NULL) || !pool_deque_push (&worker->deque, task))
+    {
+      task->next = NULL;
+      (void)pthread_mutex_lock (&g_pool.queue_lock);
+      if (g_pool.tail != NULL)
+        {
+          g_pool.tail->next = task;
+        }
+      else
+        {
+          g_pool.head = task;
+        }
+      g_pool.tail = task;
+      (void)atomic_fetch_add (&g_pool.injected, 1U);
+      (void)pthread_mutex_unlock (&g_pool.queue_lock);
+    }
+
+  pool_notify ();
+}
+
+/**
+ * @brief Mark one task of a group as finished, as the last access of the task to the group.
+ *
+ * @param remaining A pointer to the number of unfinished tasks of the group.
+ */
+void
+pool_complete (atomic_size_t *remaining)
+{
+  if (atomic_fetch_sub (remaining, 1U) == 1U)
+    {
+      pool_notify ();
+    }
+}
+
+/**
+ * @brief Wait until every task of a group finished, executing queued tasks meanwhile.
+ *
+ * Waiting threads help instead of blocking, so nested parallel calls from within
+ * pool tasks cannot starve the pool. A thread only sleeps when no task is queued.
+ *
+ * @param remaining A pointer to the number of unfinished tasks of the group.
+ */
+void
+pool_wait (atomic_size_t *remaining)
+{
+  uint32_t idle = 0;
+  while (atomic_load (remaining) > 0U)
+    {
+      pool_task_t *task = pool_take (t_pool_worker);
+      if (task != NULL)
+        {
+          task->run (task);
+          idle = 0U;
+        }
+      else if (++idle < POOL_SPIN_ROUNDS)
+        {
+          (void)sched_yield ();
+        }
+      else
+        {
+          pool_sleep (remaining);
+          idle = 0U;
+        }
+    }
+}
+
+/**
+ * @brief Task running a range of chunks of a point_parallel_for call.
+ *
+ * The range is halved until a single chunk is left, queuing the upper halves, so
+ * idle threads steal large ranges while the owner works depth-first.
+ *
+ * @param task A pointer to the pool_range_t.
+ */
+static void
+pool_for_run (pool_task_t *task)
+{
+  const pool_range_t *range = (const pool_range_t *)task;
+  pool_for_t *loop = range->loop;
+  size_t first = range->first;
+  size_t last = range->last;
+
+  while ((last - first) > 1U)
+    {
+      size_t middle = first + ((last - first) / 2U);
+      pool_range_t *half = &loop->ranges[middle];
+      half->task.run = pool_for_run;
+      half->loop = loop;
+      half->first = middle;
+      half->last = last;
+      pool_submit (&half->task);
+      last = middle;
+    }
+
+  size_t begin = first * loop->chunk;
+  size_t end = ((loop->count - begin) < loop->chunk) ? loop->count : (begin + loop->chunk);
+  loop->body (loop->context, begin, end);
+  pool_complete (&loop->remaining);
+}
+
+/**
+ * @brief Task running a point_future_t.
+ *
+ * @param task A pointer to the point_future_t.
+ */
+static void
+pool_future_run (pool_task_t *task)
+{
+  point_future_t *future = (point_future_t *)task;
+  future->function (future->context);
+  pool_complete (&future->remaining);
+}
+
+/**
+ * @brief Configure the thread pool running the parallel algorithms of the library.
+ *
+ * The pool starts with one thread per online processor on first use. Configuring
+ * it stops the current threads after they finished the queued tasks and starts the
+ * new ones, so it must not be called while parallel work is in progress.
+ *
+ * @param threads The number of pool threads, or 0 for one per online processor.
+ * @param is_pinned Whether every pool thread is pinned to one of the processors the
+ * process may run on, which keeps its caches warm. Ignored outside Linux.
+ *
+ * @return true if the pool threads were started, false if the function is called
+ * from a pool thread or no thread could be started.
+ */
+bool
+point_pool_configure (uint32_t threads, bool is_pinned)
+{
+  bool result = false;
+  if (t_pool_worker == NULL)
+    {
+      (void)pthread_mutex_lock (&g_pool.config_lock);
+      pool_stop ();
+      result = pool_start (parallel_resolve_threads (threads), is_pinned);
+      (void)pthread_mutex_unlock (&g_pool.config_lock);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Get the number of threads of the thread pool.
+ *
+ * The count is read without locking, so that point_parallel_for can query it on
+ * every call.
+ *
+ * @return The number of pool threads that will run tasks, which is the number of
+ * online processors if the pool was not configured.
+ */
+uint32_t
+point_pool_get_threads (void)
+{
+  bool is_running = atomic_load_explicit (&g_pool.is_running, memory_order_acquire);
+  return is_running ? atomic_load_explicit (&g_pool.threads, memory_order_relaxed) : parallel_resolve_threads (0U);
+}
+
+/**
+ * @brief Run a function over the index range [0, count) on the thread pool.
+ *
+ * The range is cut into chunks of grain indices, which are distributed by work
+ * stealing, so uneven chunks balance across the pool threads. The calling thread
+ * takes part and returns once every chunk ran. Calls may be nested within the
+ * body of another call or a submitted task.
+ *
+ * @param count The number of indices.
+ * @param grain The number of indices per chunk, or 0 to cut the range into a few
+ * chunks per pool thread. It is raised if the range would exceed 65536 chunks.
+ * @param body The function called with the context and the bounds of every chunk.
+ * @param context A pointer passed unchanged to every call of the body.
+ *
+ * @return true if the range was processed, false if the body is NULL.
+ */
+bool
+point_parallel_for (size_t count, size_t grain, point_range_fn body, void *context)
+{
+  bool result = (body != NULL);
+
+  /* A pool whose threads all failed to start has none, and the calling thread runs every chunk */
+  uint32_t threads = point_pool_get_threads ();
+  size_t target = (size_t)((threads > 0U) ? threads : 1U) * POOL_FOR_CHUNKS_PER_THREAD;
+  size_t chunk = (grain > 0U) ? grain : ((count + target - 1U) / target);
+  size_t minimum = (count + POOL_FOR_MAX_CHUNKS - 1U) / POOL_FOR_MAX_CHUNKS;
+  chunk = (chunk > minimum) ? chunk : minimum;
+  chunk = (chunk > 0U) ? chunk : 1U;
+  size_t chunks = (count + chunk - 1U) / chunk;
+
+  pool_range_t *ranges = (result && (chunks > 1U)) ? malloc (chunks * sizeof (pool_range_t)) : NULL;
+  if (ranges != NULL)
+    {
+      pool_for_t loop = { .body = body, .context = context, .count = count, .chunk = chunk, .ranges = ranges };
+      atomic_init (&loop.remaining, chunks);
+      ranges[0] = (pool_range_t){ .task = { pool_for_run, NULL }, .loop = &loop, .first = 0U, .last = chunks };
+      pool_for_run (&ranges[0].task);
+      pool_wait (&loop.remaining);
+      free (ranges);
+    }
+  else if (result && (count > 0U))
+    {
+      body (context, 0U, count);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Submit a task to the thread pool.
+ *
+ * @param task The function to run on a pool thread.
+ * @param context A pointer passed unchanged to the function.
+ *
+ * @return A future that must be passed to point_future_wait exactly once, or NULL
+ * if the task is NULL or memory allocation fails.
+ */
+point_future_t *
+point_task_submit (point_task_fn task, void *context)
+{
+  point_future_t *future = (task != NULL) ? malloc (sizeof (struct point_future)) : NULL;
+  if (future != NULL)
+    {
+      future->task.run = pool_future_run;
+      future->function = task;
+      future->context = context;
+      atomic_init (&future->remaining, 1U);
+      pool_submit (&future->task);
+    }
+
+  return future;
+}
+
+/**
+ * @brief Wait for a submitted task to finish and release its future.
+ *
+ * The calling thread runs queued tasks while it waits.
+ *
+ * @param future A pointer to the future returned by point_task_submit.
+ *
+ * @return true if the task finished, false if the future is NULL.
+ */
+bool
+point_future_wait (point_future_t *future)
+{
+  bool result = false;
+  if (future != NULL)
+    {
+      pool_wait (&future->remaining);
+      free (future);
+      result = true;
+    }
+
+  return result;
+}
@@ -0,0 +1,870 @@
+#include "internal.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Marker for a missing node or item index. */
+#define QUADTREE_NONE UINT32_MAX
+
+/* Initial number of pooled nodes and items. */
+#define QUADTREE_INITIAL_NODES 64U
+#define QUADTREE_INITIAL_ITEMS 64U
+
+/* Number of pending merges after which they are applied without an explicit rebalance. */
+#define QUADTREE_DIRTY_LIMIT 64U
+
+/* Depth of the traversal stack; every level pushes at most four children. */
+#define QUADTREE_STACK_SIZE (4U * 66U)
+
+/**
+ * @brief A node of the quadtree, stored in a pooled array.
+ *
+ * The four children of an internal node are allocated as one contiguous block
+ * starting at first_child. Leaves keep their points in a doubly linked list
+ * threaded through the item array.
+ */
+typedef struct
+{
+  point_bbox_t bounds;
+  uint32_t first_child;
+  uint32_t parent;
+  uint32_t first_item;
+  uint32_t count;
+  bool is_dirty;
+} quadtree_node_t;
+
+/**
+ * @brief A point stored in the quadtree, addressed by its identifier.
+ */
+typedef struct
+{
+  uint32_t x;
+  uint32_t y;
+  uint32_t leaf;
+  uint32_t next;
+  uint32_t prev;
+} quadtree_item_t;
+
+struct point_quadtree
+{
+  quadtree_node_t *nodes;
+  uint32_t nodes_count;
+  uint32_t nodes_capacity;
+  uint32_t free_blocks;
+
+  quadtree_item_t *items;
+  uint32_t items_count;
+  uint32_t items_capacity;
+  uint32_t free_items;
+
+  uint32_t *dirty;
+  uint32_t dirty_count;
+
+  uint32_t leaf_capacity;
+  size_t count;
+};
+
+/**
+ * @brief Check whether a point lies inside a bounding box.
+ *
+ * @param bounds A pointer to the bounding box, with inclusive limits.
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ *
+ * @return true if the point lies inside the bounding box, false otherwise.
+ */
+static bool
+quadtree_bounds_contain (const point_bbox_t *bounds, uint32_t x, uint32_t y)
+{
+  return (x >= bounds->min_x) && (x <= bounds->max_x) && (y >= bounds->min_y) && (y <= bounds->max_y);
+}
+
+/**
+ * @brief Compute the squared distance from a point to a bounding box.
+ *
+ * @param bounds A pointer to the bounding box.
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ *
+ * @return The squared distance, saturated at UINT64_MAX.
+ */
+static uint64_t
+quadtree_bounds_distance (const point_bbox_t *bounds, uint32_t x, uint32_t y)
+{
+  uint64_t dx = (x < bounds->min_x) ? (bounds->min_x - x) : ((x > bounds->max_x) ? (x - bounds->max_x) : 0U);
+  uint64_t dy = (y < bounds->min_y) ? (bounds->min_y - y) : ((y > bounds->max_y) ? (y - bounds->max_y) : 0U);
+  uint64_t dx2 = dx * dx;
+  uint64_t sum = dx2 + (dy * dy);
+
+  return (sum < dx2) ? UINT64_MAX : sum;
+}
+
+/**
+ * @brief Select the child quadrant of a node containing a point.
+ *
+ * @param node A pointer to the internal node.
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ *
+ * @return The index of the child node containing the point.
+ */
+static uint32_t
+quadtree_child_of (const quadtree_node_t *node, uint32_t x, uint32_t y)
+{
+  uint32_t mid_x = node->bounds.min_x + ((node->bounds.max_x - node->bounds.min_x) / 2U);
+  uint32_t mid_y = node->bounds.min_y + ((node->bounds.max_y - node->bounds.min_y) / 2U);
+
+  return node->first_child + ((x > mid_x) ? 1U : 0U) + ((y > mid_y) ? 2U : 0U);
+}
+
+/**
+ * @brief Double the capacity of a pooled array.
+ *
+ * The new capacity is computed in size_t and rejected when its indices would reach
+ * QUADTREE_NONE or its size in bytes would overflow, so that it never wraps around.
+ *
+ * @param array The array to grow.
+ * @param capacity A pointer to the number of elements of the array, updated on success.
+ * @param element_size The size of one element in bytes.
+ *
+ * @return A pointer to the grown array, or NULL if the capacity cannot grow or memory
+ * allocation fails, in which case the array is left unchanged.
+ */
+static void *
+quadtree_grow (void *array, uint32_t *capacity, size_t element_size)
+{
+  void *result = NULL;
+  size_t grown = (size_t)*capacity * 2U;
+
+  if ((grown < QUADTREE_NONE) && (grown <= (SIZE_MAX / element_size)))
+    {
+      result = realloc (array, grown * element_size);
+      if (result != NULL)
+        {
+          *capacity = (uint32_t)grown;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Take a block of four nodes from the pool, growing it if necessary.
+ *
+ * @param tree A pointer to the quadtree.
+ *
+ * @return The index of the first node of the block, or QUADTREE_NONE if memory
+ * allocation fails.
+ */
+static uint32_t
+quadtree_block_acquire (point_quadtree_t *tree)
+{
+  uint32_t result = tree->free_blocks;
+
+  if (result != QUADTREE_NONE)
+    {
+      tree->free_blocks = tree->nodes[result].first_item;
+    }
+  else
+    {
+      if ((tree->nodes_count + 4U) > tree->nodes_capacity)
+        {
+          quadtree_node_t *nodes = quadtree_grow (tree->nodes, &tree->nodes_capacity, sizeof (quadtree_node_t));
+          tree->nodes = (nodes != NULL) ? nodes : tree->nodes;
+        }
+
+      if ((tree->nodes_count + 4U) <= tree->nodes_capacity)
+        {
+          result = tree->nodes_count;
+          tree->nodes_count += 4U;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Return a block of four nodes to the pool.
+ *
+ * The free list is threaded through first_item, so released nodes keep looking like
+ * leaves to merges that are still queued for them.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param block The index of the first node of the block.
+ */
+static void
+quadtree_block_release (point_quadtree_t *tree, uint32_t block)
+{
+  tree->nodes[block].first_item = tree->free_blocks;
+  tree->free_blocks = block;
+}
+
+/**
+ * @brief Link an item into the item list of a leaf.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param leaf The index of the leaf.
+ * @param id The identifier of the item.
+ */
+static void
+quadtree_leaf_link (point_quadtree_t *tree, uint32_t leaf, uint32_t id)
+{
+  quadtree_node_t *node = &tree->nodes[leaf];
+  quadtree_item_t *item = &tree->items[id];
+
+  item->leaf = leaf;
+  item->prev = QUADTREE_NONE;
+  item->next = node->first_item;
+  if (node->first_item != QUADTREE_NONE)
+    {
+      tree->items[node->first_item].prev = id;
+    }
+  node->first_item = id;
+}
+
+/**
+ * @brief Unlink an item from the item list of its leaf.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param id The identifier of the item.
+ */
+static void
+quadtree_leaf_unlink (point_quadtree_t *tree, uint32_t id)
+{
+  const quadtree_item_t *item = &tree->items[id];
+
+  if (item->prev != QUADTREE_NONE)
+    {
+      tree->items[item->prev].next = item->next;
+    }
+  else
+    {
+      tree->nodes[item->leaf].first_item = item->next;
+    }
+
+  if (item->next != QUADTREE_NONE)
+    {
+      tree->items[item->next].prev = item->prev;
+    }
+}
+
+/**
+ * @brief Split an overfull leaf into four children and distribute its items.
+ *
+ * Children that are still overfull are split recursively. A leaf covering a single
+ * coordinate cannot be split and is allowed to exceed the leaf capacity. If no
+ * nodes can be allocated, the leaf stays overfull, which is still a valid tree.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param leaf The index of the leaf to split.
+ */
+static void
+quadtree_split (point_quadtree_t *tree, uint32_t leaf)
+{
+  const point_bbox_t bounds = tree->nodes[leaf].bounds;
+  if ((bounds.min_x == bounds.max_x) && (bounds.min_y == bounds.max_y))
+    {
+      return;
+    }
+
+  uint32_t block = quadtree_block_acquire (tree);
+  if (block == QUADTREE_NONE)
+    {
+      return;
+    }
+
+  uint32_t mid_x = bounds.min_x + ((bounds.max_x - bounds.min_x) / 2U);
+  uint32_t mid_y = bounds.min_y + ((bounds.max_y - bounds.min_y) / 2U);
+
+  for (uint32_t i = 0; i < 4U; ++i)
+    {
+      quadtree_node_t *child = &tree->nodes[block + i];
+      child->bounds.min_x = ((i & 1U) != 0U) ? (mid_x + 1U) : bounds.min_x;
+      child->bounds.max_x = ((i & 1U) != 0U) ? bounds.max_x : mid_x;
+      child->bounds.min_y = ((i & 2U) != 0U) ? (mid_y + 1U) : bounds.min_y;
+      child->bounds.max_y = ((i & 2U) != 0U) ? bounds.max_y : mid_y;
+      child->first_child = QUADTREE_NONE;
+      child->parent = leaf;
+      child->first_item = QUADTREE_NONE;
+      child->count = 0U;
+      child->is_dirty = false;
+    }
+
+  quadtree_node_t *node = &tree->nodes[leaf];
+  uint32_t id = node->first_item;
+  node->first_item = QUADTREE_NONE;
+  node->first_child = block;
+
+  while (id != QUADTREE_NONE)
+    {
+      uint32_t next = tree->items[id].next;
+      uint32_t child = quadtree_child_of (&tree->nodes[leaf], tree->items[id].x, tree->items[id].y);
+      quadtree_leaf_link (tree, child, id);
+      ++tree->nodes[child].count;
+      id = next;
+    }
+
+  for (uint32_t i = 0; i < 4U; ++i)
+    {
+      if (tree->nodes[block + i].count > tree->leaf_capacity)
+        {
+          quadtree_split (tree, block + i);
+        }
+    }
+}
+
+/**
+ * @brief Move every item below a node into the item list of that node.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param target The index of the node receiving the items.
+ * @param node The index of the node whose subtree is collected.
+ */
+static void
+quadtree_collect (point_quadtree_t *tree, uint32_t target, uint32_t node)
+{
+  uint32_t block = tree->nodes[node].first_child;
+
+  if (block == QUADTREE_NONE)
+    {
+      uint32_t id = tree->nodes[node].first_item;
+      while (id != QUADTREE_NONE)
+        {
+          uint32_t next = tree->items[id].next;
+          quadtree_leaf_link (tree, target, id);
+          id = next;
+        }
+      tree->nodes[node].first_item = QUADTREE_NONE;
+    }
+  else
+    {
+      for (uint32_t i = 0; i < 4U; ++i)
+        {
+          quadtree_collect (tree, target, block + i);
+        }
+      quadtree_block_release (tree, block);
+      tree->nodes[node].first_child = QUADTREE_NONE;
+    }
+}
+
+/**
+ * @brief Apply all pending merges of underfull subtrees.
+ *
+ * @param tree A pointer to the quadtree.
+ */
+static void
+quadtree_apply_merges (point_quadtree_t *tree)
+{
+  for (uint32_t i = 0; i < tree->dirty_count; ++i)
+    {
+      quadtree_node_t *node = &tree->nodes[tree->dirty[i]];
+      node->is_dirty = false;
+
+      /* The node may have been merged into an ancestor or refilled meanwhile */
+      if ((node->first_child != QUADTREE_NONE) && (node->count <= tree->leaf_capacity))
+        {
+          uint32_t block = node->first_child;
+          for (uint32_t j = 0; j < 4U; ++j)
+            {
+              quadtree_collect (tree, tree->dirty[i], block + j);
+            }
+          quadtree_block_release (tree, block);
+          tree->nodes[tree->dirty[i]].first_child = QUADTREE_NONE;
+        }
+    }
+
+  tree->dirty_count = 0U;
+}
+
+/**
+ * @brief Update the counts on the path above a leaf after an item left it.
+ *
+ * The highest internal node on the path that became underfull is queued for a
+ * merge. Merges are deferred until the queue is full or the tree is rebalanced
+ * explicitly, so points oscillating around a boundary do not cause repeated split
+ * and merge work. The queue is only checked with quadtree_merges_check once the item
+ * is linked again, since a merge may release the nodes it is placed into.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param leaf The index of the leaf the item left.
+ * @param stop The index of the first ancestor whose count is left unchanged, or
+ * QUADTREE_NONE to update the path up to the root.
+ */
+static void
+quadtree_path_decrement (point_quadtree_t *tree, uint32_t leaf, uint32_t stop)
+{
+  uint32_t candidate = QUADTREE_NONE;
+
+  for (uint32_t node = leaf; node != stop; node = tree->nodes[node].parent)
+    {
+      --tree->nodes[node].count;
+      if ((tree->nodes[node].first_child != QUADTREE_NONE) && (tree->nodes[node].count <= (tree->leaf_capacity / 2U)))
+        {
+          candidate = node;
+        }
+    }
+
+  if ((candidate != QUADTREE_NONE) && (tree->nodes[candidate].is_dirty == false))
+    {
+      tree->nodes[candidate].is_dirty = true;
+      tree->dirty[tree->dirty_count++] = candidate;
+    }
+}
+
+/**
+ * @brief Apply the deferred merges if their queue is full.
+ *
+ * Every update queues at most one merge, so checking after each update keeps the
+ * queue within QUADTREE_DIRTY_LIMIT.
+ *
+ * @param tree A pointer to the quadtree.
+ */
+static void
+quadtree_merges_check (point_quadtree_t *tree)
+{
+  if (tree->dirty_count == QUADTREE_DIRTY_LIMIT)
+    {
+      quadtree_apply_merges (tree);
+    }
+}
+
+/**
+ * @brief Place an item below a node, updating the counts along the way.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param node The index of the node to descend from; it must contain the item.
+ * @param id The identifier of the item.
+ */
+static void
+quadtree_place (point_quadtree_t *tree, uint32_t node, uint32_t id)
+{
+  uint32_t x = tree->items[id].x;
+  uint32_t y = tree->items[id].y;
+
+  ++tree->nodes[node].count;
+  while (tree->nodes[node].first_child != QUADTREE_NONE)
+    {
+      node = quadtree_child_of (&tree->nodes[node], x, y);
+      ++tree->nodes[node].count;
+    }
+
+  quadtree_leaf_link (tree, node, id);
+  if (tree->nodes[node].count > tree->leaf_capacity)
+    {
+      quadtree_split (tree, node);
+    }
+}
+
+/**
+ * @brief Check whether an identifier refers to a stored point.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param id The identifier to check.
+ *
+ * @return true if the identifier is in use, false otherwise.
+ */
+static bool
+quadtree_is_valid_id (const point_quadtree_t *tree, uint32_t id)
+{
+  return (id < tree->items_count) && (tree->items[id].leaf != QUADTREE_NONE);
+}
+
+/**
+ * @brief Create an empty quadtree covering a fixed region.
+ *
+ * Nodes and points are kept in pooled arrays that grow geometrically, so inserting,
+ * moving and removing points does not allocate memory per operation.
+ *
+ * @param bounds A pointer to the region covered by the tree, with inclusive limits.
+ * @param leaf_capacity The number of points a leaf holds before it is split.
+ *
+ * @return A pointer to the new quadtree, or NULL if an argument is invalid or memory
+ * allocation fails.
+ */
+point_quadtree_t *
+point_quadtree_create (const point_bbox_t *bounds, uint32_t leaf_capacity)
+{
+  point_quadtree_t *tree = NULL;
+
+  if ((bounds != NULL) && (bounds->min_x <= bounds->max_x) && (bounds->min_y <= bounds->max_y) && (leaf_capacity > 0U))
+    {
+      tree = malloc (sizeof (struct point_quadtree));
+      if (tree != NULL)
+        {
+          tree->nodes = malloc (QUADTREE_INITIAL_NODES * sizeof (quadtree_node_t));
+          tree->items = malloc (QUADTREE_INITIAL_ITEMS * sizeof (quadtree_item_t));
+          tree->dirty = malloc (QUADTREE_DIRTY_LIMIT * sizeof (uint32_t));
+
+          if ((tree->nodes != NULL) && (tree->items != NULL) && (tree->dirty != NULL))
+            {
+              tree->nodes_count = 1U;
+              tree->nodes_capacity = QUADTREE_INITIAL_NODES;
+              tree->free_blocks = QUADTREE_NONE;
+              tree->items_count = 0U;
+              tree->items_capacity = QUADTREE_INITIAL_ITEMS;
+              tree->free_items = QUADTREE_NONE;
+              tree->dirty_count = 0U;
+              tree->leaf_capacity = leaf_capacity;
+              tree->count = 0U;
+
+              quadtree_node_t *root = &tree->nodes[0];
+              root->bounds = *bounds;
+              root->first_child = QUADTREE_NONE;
+              root->parent = QUADTREE_NONE;
+              root->first_item = QUADTREE_NONE;
+              root->count = 0U;
+              root->is_dirty = false;
+            }
+          else
+            {
+              free (tree->nodes);
+              free (tree->items);
+              free (tree->dirty);
+              free (tree);
+              tree = NULL;
+            }
+        }
+    }
+
+  return tree;
+}
+
+/**
+ * @brief Destroy a quadtree and release its associated memory.
+ *
+ * @param tree A pointer to the quadtree to be destroyed.
+ *
+ * @return true if the quadtree was successfully destroyed, false if the input
+ * pointer is NULL.
+ */
+bool
+point_quadtree_destroy (point_quadtree_t *tree)
+{
+  bool result = false;
+  if (tree != NULL)
+    {
+      free (tree->nodes);
+      free (tree->items);
+      free (tree->dirty);
+      free (tree);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Insert a point into a quadtree.
+ *
+ * Identifiers of removed points are reused by later insertions.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ * @param id A pointer receiving the identifier of the inserted point.
+ *
+ * @return true if the point was inserted, false if an argument is NULL, the point
+ * lies outside the bounds of the tree or memory allocation fails.
+ */
+bool
+point_quadtree_insert (point_quadtree_t *tree, uint32_t x, uint32_t y, uint32_t *id)
+{
+  bool result = false;
+
+  if ((tree != NULL) && (id != NULL) && quadtree_bounds_contain (&tree->nodes[0].bounds, x, y))
+    {
+      uint32_t item = tree->free_items;
+      if (item != QUADTREE_NONE)
+        {
+          tree->free_items = tree->items[item].next;
+        }
+      else
+        {
+          if (tree->items_count == tree->items_capacity)
+            {
+              quadtree_item_t *items = quadtree_grow (tree->items, &tree->items_capacity, sizeof (quadtree_item_t));
+              tree->items = (items != NULL) ? items : tree->items;
+            }
+
+          if (tree->items_count < tree->items_capacity)
+            {
+              item = tree->items_count++;
+            }
+        }
+
+      if (item != QUADTREE_NONE)
+        {
+          tree->items[item].x = x;
+          tree->items[item].y = y;
+          quadtree_place (tree, 0U, item);
+          ++tree->count;
+
+          *id = item;
+          result = true;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Remove a point from a quadtree.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param id The identifier of the point.
+ *
+ * @return true if the point was removed, false if the tree is NULL or the identifier
+ * does not refer to a stored point.
+ */
+bool
+point_quadtree_remove (point_quadtree_t *tree, uint32_t id)
+{
+  bool result = false;
+
+  if ((tree != NULL) && quadtree_is_valid_id (tree, id))
+    {
+      uint32_t leaf = tree->items[id].leaf;
+      quadtree_leaf_unlink (tree, id);
+      quadtree_path_decrement (tree, leaf, QUADTREE_NONE);
+
+      tree->items[id].leaf = QUADTREE_NONE;
+      tree->items[id].next = tree->free_items;
+      tree->free_items = id;
+      --tree->count;
+      quadtree_merges_check (tree);
+
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Move a stored point to a new position.
+ *
+ * A point that stays within its leaf is updated in place. Otherwise it is detached
+ * from its leaf and placed again starting from the lowest ancestor containing the
+ * new position, so the cost depends on the distance moved rather than on the size
+ * of the tree. Merges of subtrees that became underfull are deferred.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param id The identifier of the point.
+ * @param x The new x-coordinate of the point.
+ * @param y The new y-coordinate of the point.
+ *
+ * @return true if the point was moved, false if the tree is NULL, the identifier
+ * does not refer to a stored point or the position lies outside the tree.
+ */
+bool
+point_quadtree_move (point_quadtree_t *tree, uint32_t id, uint32_t x, uint32_t y)
+{
+  bool result = false;
+
+  if ((tree != NULL) && quadtree_is_valid_id (tree, id) && quadtree_bounds_contain (&tree->nodes[0].bounds, x, y))
+    {
+      uint32_t leaf = tree->items[id].leaf;
+      tree->items[id].x = x;
+      tree->items[id].y = y;
+
+      if (quadtree_bounds_contain (&tree->nodes[leaf].bounds, x, y) == false)
+        {
+          uint32_t ancestor = tree->nodes[leaf].parent;
+          while (quadtree_bounds_contain (&tree->nodes[ancestor].bounds, x, y) == false)
+            {
+              ancestor = tree->nodes[ancestor].parent;
+            }
+
+          /* Counts above the common ancestor are unchanged */
+          quadtree_leaf_unlink (tree, id);
+          quadtree_path_decrement (tree, leaf, ancestor);
+          --tree->nodes[ancestor].count;
+          quadtree_place (tree, ancestor, id);
+          quadtree_merges_check (tree);
+        }
+
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Apply all deferred merges of underfull subtrees.
+ *
+ * Merges are also applied automatically once enough of them are pending, so calling
+ * this function is optional. It is typically called once per update cycle, after
+ * all points have been moved.
+ *
+ * @param tree A pointer to the quadtree.
+ *
+ * @return true if the tree was rebalanced, false if the input pointer is NULL.
+ */
+bool
+point_quadtree_rebalance (point_quadtree_t *tree)
+{
+  bool result = false;
+  if (tree != NULL)
+    {
+      quadtree_apply_merges (tree);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Get the number of points stored in a quadtree.
+ *
+ * @param tree A pointer to the quadtree.
+ *
+ * @return The number of stored points, or 0 if the input pointer is NULL.
+ */
+size_t
+point_quadtree_get_count (const point_quadtree_t *tree)
+{
+  size_t result = 0U;
+  if (tree != NULL)
+    {
+      result = tree->count;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find all points inside a rectangular range.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param range A pointer to the range, with inclusive limits.
+ * @param ids A buffer receiving the identifiers of the points found; may be NULL if
+ * capacity is 0.
+ * @param capacity The number of identifiers the buffer can hold.
+ *
+ * @return The number of points inside the range. If it exceeds capacity, only the
+ * first capacity identifiers were written.
+ */
+size_t
+point_quadtree_query_range (const point_quadtree_t *tree, const point_bbox_t *range, uint32_t *ids, size_t capacity)
+{
+  size_t result = 0U;
+
+  if ((tree != NULL) && (range != NULL) && ((ids != NULL) || (capacity == 0U)))
+    {
+      uint32_t stack[QUADTREE_STACK_SIZE];
+      uint32_t depth = 0U;
+      stack[depth++] = 0U;
+
+      while (depth > 0U)
+        {
+          const quadtree_node_t *node = &tree->nodes[stack[--depth]];
+          const point_bbox_t *bounds = &node->bounds;
+
+          if ((node->count == 0U) || (bounds->min_x > range->max_x) || (bounds->max_x < range->min_x) || (bounds->min_y > range->max_y)
+              || (bounds->max_y < range->min_y))
+            {
+              continue;
+            }
+
+          if (node->first_child != QUADTREE_NONE)
+            {
+              for (uint32_t i = 0; i < 4U; ++i)
+                {
+                  stack[depth++] = node->first_child + i;
+                }
+            }
+          else
+            {
+              for (uint32_t id = node->first_item; id != QUADTREE_NONE; id = tree->items[id].next)
+                {
+                  if (quadtree_bounds_contain (range, tree->items[id].x, tree->items[id].y))
+                    {
+                      if (result < capacity)
+                        {
+                          ids[result] = id;
+                        }
+                      ++result;
+                    }
+                }
+            }
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Find the stored point nearest to a position.
+ *
+ * Subtrees are visited closest first and skipped once they cannot contain a point
+ * closer than the best one found so far. Ties are resolved arbitrarily.
+ *
+ * @param tree A pointer to the quadtree.
+ * @param x The x-coordinate of the position.
+ * @param y The y-coordinate of the position.
+ * @param id A pointer receiving the identifier of the nearest point.
+ *
+ * @return true if a point was found, false if an argument is NULL or the tree is empty.
+ */
+bool
+point_quadtree_query_nearest (const point_quadtree_t *tree, uint32_t x, uint32_t y, uint32_t *id)
+{
+  bool result = false;
+
+  if ((tree != NULL) && (id != NULL) && (tree->count > 0U))
+    {
+      uint64_t best = UINT64_MAX;
+      uint32_t stack[QUADTREE_STACK_SIZE];
+      uint32_t depth = 0U;
+      stack[depth++] = 0U;
+
+      while (depth > 0U)
+        {
+          const quadtree_node_t *node = &tree->nodes[stack[--depth]];
+          if ((node->count == 0U) || (result && (quadtree_bounds_distance (&node->bounds, x, y) >= best)))
+            {
+              continue;
+            }
+
+          if (node->first_child != QUADTREE_NONE)
+            {
+              /* Push the children farthest first so the closest one is visited next */
+              uint64_t distances[4];
+              uint32_t order[4] = { 0U, 1U, 2U, 3U };
+              for (uint32_t i = 0; i < 4U; ++i)
+                {
+                  distances[i] = quadtree_bounds_distance (&tree->nodes[node->first_child + i].bounds, x, y);
+                }
+
+              for (uint32_t i = 1U; i < 4U; ++i)
+                {
+                  for (uint32_t j = i; (j > 0U) && (distances[order[j - 1U]] < distances[order[j]]); --j)
+                    {
+                      uint32_t swap = order[j];
+                      order[j] = order[j - 1U];
+                      order[j - 1U] = swap;
+                    }
+                }
+
+              for (uint32_t i = 0; i < 4U; ++i)
+                {
+                  stack[depth++] = node->first_child + order[i];
+                }
+            }
+          else
+            {
+              for (uint32_t item = node->first_item; item != QUADTREE_NONE; item = tree->items[item].next)
+                {
+                  point_bbox_t position = { tree->items[item].x, tree->items[item].y, tree->items[item].x, tree->items[item].y };
+                  uint64_t distance = quadtree_bounds_distance (&position, x, y);
+                  if ((result == false) || (distance < best))
+                    {
+                      best = distance;
+                      *id = item;
+                      result = true;
+                    }
+                }
+            }
+        }
+    }
+
+  return result;
+}
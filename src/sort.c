@@ -0,0 +1,83 @@
+#include "internal.h"
+#include <string.h>
+
+/* Number of bits consumed by a single radix pass. */
+#define SORT_RADIX_BITS 8U
+#define SORT_RADIX_SIZE (1U << SORT_RADIX_BITS)
+#define SORT_PASSES (64U / SORT_RADIX_BITS)
+
+/**
+ * @brief Sort 64-bit keys in ascending order, carrying a 32-bit value along with each key.
+ *
+ * This is a stable least-significant-digit radix sort. The histograms of all digits are
+ * collected in a single pass over the keys, and passes whose digit is identical for every
+ * key are skipped, so narrow key ranges are sorted in fewer passes. The caller provides
+ * the temporary buffers, which keeps the function free of allocations.
+ *
+ * @param keys The keys to sort; holds the sorted keys on return.
+ * @param values The values attached to the keys; permuted along with the keys.
+ * @param tmp_keys A scratch buffer of at least count keys.
+ * @param tmp_values A scratch buffer of at least count values.
+ * @param count The number of keys to sort.
+ */
+void
+sort_keys (uint64_t *keys, uint32_t *values, uint64_t *tmp_keys, uint32_t *tmp_values, size_t count)
+{
+  size_t counts[SORT_PASSES][SORT_RADIX_SIZE];
+  memset (counts, 0, sizeof (counts));
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      uint64_t key = keys[i];
+      for (uint32_t pass = 0; pass < SORT_PASSES; ++pass)
+        {
+          ++counts[pass][(key >> (pass * SORT_RADIX_BITS)) & (SORT_RADIX_SIZE - 1U)];
+        }
+    }
+
+  uint64_t *src_keys = keys;
+  uint32_t *src_values = values;
+  uint64_t *dst_keys = tmp_keys;
+  uint32_t *dst_values = tmp_values;
+
+  for (uint32_t pass = 0; pass < SORT_PASSES; ++pass)
+    {
+      size_t *digit_counts = counts[pass];
+      uint32_t shift = pass * SORT_RADIX_BITS;
+
+      /* Skip the pass when every key shares the same digit */
+      if ((count == 0U) || (digit_counts[(src_keys[0] >> shift) & (SORT_RADIX_SIZE - 1U)] == count))
+        {
+          continue;
+        }
+
+      size_t offset = 0;
+      for (uint32_t digit = 0; digit < SORT_RADIX_SIZE; ++digit)
+        {
+          size_t digit_count = digit_counts[digit];
+          digit_counts[digit] = offset;
+          offset += digit_count;
+        }
+
+      for (size_t i = 0; i < count; ++i)
+        {
+          size_t position = digit_counts[(src_keys[i] >> shift) & (SORT_RADIX_SIZE - 1U)]++;
+          dst_keys[position] = src_keys[i];
+          dst_values[position] = src_values[i];
+        }
+
+      uint64_t *swap_keys = src_keys;
+      uint32_t *swap_values = src_values;
+      src_keys = dst_keys;
+      src_values = dst_values;
+      dst_keys = swap_keys;
+      dst_values = swap_values;
+    }
+
+  /* An odd number of passes leaves the result in the scratch buffers */
+  if (src_keys != keys)
+    {
+      memcpy (keys, src_keys, count * sizeof (*keys));
+      memcpy (values, src_values, count * sizeof (*values));
+    }
+}
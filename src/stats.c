@@ -0,0 +1,341 @@
+#include "internal.h"
+#include "library.h"
+
+#ifdef LIB_STATS
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Number of operations after which a thread publishes its change of the live count. */
+#define STATS_FLUSH_INTERVAL 64U
+
+/**
+ * @brief A set of counters, as summed over threads.
+ */
+typedef struct
+{
+  uint64_t creates;
+  uint64_t destroys;
+  uint64_t bytes_allocated;
+  uint64_t bytes_freed;
+  uint64_t alloc_ns;
+} stats_counters_t;
+
+/**
+ * @brief The counters of one thread.
+ *
+ * Only the owning thread writes the atomic counters, so they are updated with plain
+ * relaxed loads and stores instead of read-modify-write instructions, and readers
+ * never contend with the hot path.
+ */
+typedef struct stats_slot
+{
+  _Atomic uint64_t creates;
+  _Atomic uint64_t destroys;
+  _Atomic uint64_t bytes_allocated;
+  _Atomic uint64_t bytes_freed;
+  _Atomic uint64_t alloc_ns;
+  int64_t pending_live;
+  uint32_t pending_operations;
+  struct stats_slot *previous;
+  struct stats_slot *next;
+} stats_slot_t;
+
+static pthread_mutex_t g_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t g_stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_stats_key;
+static stats_slot_t *g_stats_slots = NULL;
+static stats_counters_t g_stats_retired = { 0U, 0U, 0U, 0U, 0U };
+static stats_counters_t g_stats_baseline = { 0U, 0U, 0U, 0U, 0U };
+static _Atomic int64_t g_stats_live = 0;
+static _Atomic uint64_t g_stats_peak = 0U;
+static _Thread_local stats_slot_t *t_stats_slot = NULL;
+
+/**
+ * @brief Add a value to a counter that is written by a single thread only.
+ *
+ * @param counter A pointer to the counter.
+ * @param value The value to add.
+ */
+static void
+stats_add (_Atomic uint64_t *counter, uint64_t value)
+{
+  atomic_store_explicit (counter, atomic_load_explicit (counter, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+/**
+ * @brief Raise the peak live count to at least the given value.
+ *
+ * @param live The observed live count.
+ */
+static void
+stats_raise_peak (uint64_t live)
+{
+  uint64_t peak = atomic_load_explicit (&g_stats_peak, memory_order_relaxed);
+  while ((live > peak) && !atomic_compare_exchange_weak_explicit (&g_stats_peak, &peak, live, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Publish the change of the live count accumulated by a thread.
+ *
+ * @param slot A pointer to the slot of the calling thread.
+ */
+static void
+stats_publish (stats_slot_t *slot)
+{
+  int64_t live = atomic_fetch_add_explicit (&g_stats_live, slot->pending_live, memory_order_relaxed) + slot->pending_live;
+  if (live > 0)
+    {
+      stats_raise_peak ((uint64_t)live);
+    }
+
+  slot->pending_live = 0;
+  slot->pending_operations = 0U;
+}
+
+/**
+ * @brief Add the counters of a slot to a set of totals.
+ *
+ * @param totals A pointer to the totals to extend.
+ * @param slot A pointer to the slot to read.
+ */
+static void
+stats_accumulate (stats_counters_t *totals, stats_slot_t *slot)
+{
+  totals->creates += atomic_load_explicit (&slot->creates, memory_order_relaxed);
+  totals->destroys += atomic_load_explicit (&slot->destroys, memory_order_relaxed);
+  totals->bytes_allocated += atomic_load_explicit (&slot->bytes_allocated, memory_order_relaxed);
+  totals->bytes_freed += atomic_load_explicit (&slot->bytes_freed, memory_order_relaxed);
+  totals->alloc_ns += atomic_load_explicit (&slot->alloc_ns, memory_order_relaxed);
+}
+
+/**
+ * @brief Fold the counters of an exiting thread into the retired totals.
+ *
+ * @param argument A pointer to the slot of the exiting thread.
+ */
+static void
+stats_slot_retire (void *argument)
+{
+  stats_slot_t *slot = argument;
+  stats_publish (slot);
+
+  (void)pthread_mutex_lock (&g_stats_lock);
+  stats_accumulate (&g_stats_retired, slot);
+  if (slot->previous != NULL)
+    {
+      slot->previous->next = slot->next;
+    }
+  else
+    {
+      g_stats_slots = slot->next;
+    }
+  if (slot->next != NULL)
+    {
+      slot->next->previous = slot->previous;
+    }
+  (void)pthread_mutex_unlock (&g_stats_lock);
+
+  t_stats_slot = NULL;
+  free (slot);
+}
+
+/**
+ * @brief Create the thread-specific key whose destructor retires slots.
+ */
+static void
+stats_init (void)
+{
+  (void)pthread_key_create (&g_stats_key, stats_slot_retire);
+}
+
+/**
+ * @brief Get the slot of the calling thread, registering it on first use.
+ *
+ * @return A pointer to the slot, or NULL if it could not be allocated.
+ */
+static stats_slot_t *
+stats_slot_get (void)
+{
+  stats_slot_t *result = t_stats_slot;
+  if (result == NULL)
+    {
+      (void)pthread_once (&g_stats_once, stats_init);
+
+      result = calloc (1U, sizeof (stats_slot_t));
+      if (result != NULL)
+        {
+          (void)pthread_mutex_lock (&g_stats_lock);
+          result->next = g_stats_slots;
+          if (g_stats_slots != NULL)
+            {
+              g_stats_slots->previous = result;
+            }
+          g_stats_slots = result;
+          (void)pthread_mutex_unlock (&g_stats_lock);
+
+          (void)pthread_setspecific (g_stats_key, result);
+          t_stats_slot = result;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Sum the counters of all threads, past and present.
+ *
+ * @return The totals since the library was loaded.
+ */
+static stats_counters_t
+stats_collect (void)
+{
+  (void)pthread_mutex_lock (&g_stats_lock);
+  stats_counters_t result = g_stats_retired;
+  for (stats_slot_t *slot = g_stats_slots; slot != NULL; slot = slot->next)
+    {
+      stats_accumulate (&result, slot);
+    }
+  (void)pthread_mutex_unlock (&g_stats_lock);
+
+  return result;
+}
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The current time in nanoseconds.
+ */
+uint64_t
+stats_now_ns (void)
+{
+  struct timespec now;
+  (void)clock_gettime (CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Count a point creation on the calling thread.
+ *
+ * @param bytes The number of bytes allocated for the point.
+ * @param alloc_ns The time spent in the allocator, in nanoseconds.
+ */
+void
+stats_record_create (size_t bytes, uint64_t alloc_ns)
+{
+  stats_slot_t *slot = stats_slot_get ();
+  if (slot != NULL)
+    {
+      stats_add (&slot->creates, 1U);
+      stats_add (&slot->bytes_allocated, bytes);
+      stats_add (&slot->alloc_ns, alloc_ns);
+
+      ++slot->pending_live;
+      if (++slot->pending_operations >= STATS_FLUSH_INTERVAL)
+        {
+          stats_publish (slot);
+        }
+    }
+}
+
+/**
+ * @brief Count a point destruction on the calling thread.
+ *
+ * @param bytes The number of bytes released with the point.
+ */
+void
+stats_record_destroy (size_t bytes)
+{
+  stats_slot_t *slot = stats_slot_get ();
+  if (slot != NULL)
+    {
+      stats_add (&slot->destroys, 1U);
+      stats_add (&slot->bytes_freed, bytes);
+
+      --slot->pending_live;
+      if (++slot->pending_operations >= STATS_FLUSH_INTERVAL)
+        {
+          stats_publish (slot);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Read the point allocation statistics.
+ *
+ * Statistics are only gathered when the library is built with LIB_STATS defined
+ * (the LIBRARY_STATS CMake option); otherwise point creation carries no
+ * instrumentation and this function fails. Every thread counts into its own slot,
+ * and the slots are summed on read. The live counts are exact for the sum of all
+ * operations completed before the call. The peak is sampled whenever a thread
+ * publishes its live count, every 64 operations, and on every read, so short
+ * excursions of fewer than 64 points per thread above the reported peak may be
+ * missed.
+ *
+ * @param stats A pointer receiving the statistics. Creates, destroys, allocated
+ * bytes and allocation time count from the last point_stats_reset call.
+ *
+ * @return true if the statistics were read, false if stats is NULL or the library
+ * was built without statistics.
+ */
+bool
+point_stats_get (point_stats_t *stats)
+{
+  bool result = false;
+#ifdef LIB_STATS
+  if (stats != NULL)
+    {
+      stats_counters_t totals = stats_collect ();
+      uint64_t live = (totals.creates > totals.destroys) ? (totals.creates - totals.destroys) : 0U;
+      stats_raise_peak (live);
+
+      (void)pthread_mutex_lock (&g_stats_lock);
+      stats_counters_t baseline = g_stats_baseline;
+      (void)pthread_mutex_unlock (&g_stats_lock);
+
+      stats->creates = totals.creates - baseline.creates;
+      stats->destroys = totals.destroys - baseline.destroys;
+      stats->live = live;
+      stats->peak_live = atomic_load_explicit (&g_stats_peak, memory_order_relaxed);
+      stats->bytes_allocated = totals.bytes_allocated - baseline.bytes_allocated;
+      stats->bytes_live = (totals.bytes_allocated > totals.bytes_freed) ? (totals.bytes_allocated - totals.bytes_freed) : 0U;
+      stats->alloc_ns = totals.alloc_ns - baseline.alloc_ns;
+      result = true;
+    }
+#else
+  (void)stats;
+#endif
+
+  return result;
+}
+
+/**
+ * @brief Restart the point allocation statistics.
+ *
+ * The cumulative counters restart from zero and the peak restarts from the current
+ * live count. The live counts themselves are unaffected.
+ *
+ * @return true if the statistics were reset, false if the library was built without
+ * statistics.
+ */
+bool
+point_stats_reset (void)
+{
+  bool result = false;
+#ifdef LIB_STATS
+  stats_counters_t totals = stats_collect ();
+  uint64_t live = (totals.creates > totals.destroys) ? (totals.creates - totals.destroys) : 0U;
+
+  (void)pthread_mutex_lock (&g_stats_lock);
+  g_stats_baseline = totals;
+  atomic_store_explicit (&g_stats_peak, live, memory_order_relaxed);
+  (void)pthread_mutex_unlock (&g_stats_lock);
+  result = true;
+#endif
+
+  return result;
+}
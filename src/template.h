@@ -0,0 +1,246 @@
+#ifndef _TEMPLATE_H_
+#define _TEMPLATE_H_
+
+/*
+ * Template of the point types, specialized for one coordinate type and dimension.
+ *
+ * TEMPLATE_DEFINE_2D and TEMPLATE_DEFINE_3D define the structure and the API functions
+ * of one point type, as declared by POINT_TYPE_DECLARE in library.h, from the following
+ * parameters:
+ *  - name: the prefix of the public types and functions, such as point_u16.
+ *  - type: the type of the coordinates, such as uint16_t.
+ *  - lowest: the lowest value of the coordinates.
+ *  - highest: the highest value of the coordinates.
+ *  - lanes: the number of independent running extremes of reductions, 1 for integers,
+ *    whose reductions the compiler vectorizes by itself, and the number of coordinates
+ *    per vector for floating point.
+ *
+ * The including file provides internal.h and library.h. The kernels work on the concrete
+ * type without dispatching at run time, so the compiler vectorizes them with the
+ * instructions of that type.
+ */
+
+#ifdef LIB_STATS
+#define TEMPLATE_STATS_START() stats_now_ns ()
+#define TEMPLATE_STATS_CREATE(bytes, start) stats_record_create (bytes, stats_now_ns () - (start))
+#define TEMPLATE_STATS_DESTROY(bytes) stats_record_destroy (bytes)
+#else
+#define TEMPLATE_STATS_START() 0U
+#define TEMPLATE_STATS_CREATE(bytes, start) (void)(start)
+#define TEMPLATE_STATS_DESTROY(bytes) (void)(bytes)
+#endif
+
+/* Apply a per-axis snippet to every axis of a dimension, passing it two parameters. */
+#define TEMPLATE_AXES_2D(APPLY, first, second) APPLY (first, second, x) APPLY (first, second, y)
+#define TEMPLATE_AXES_3D(APPLY, first, second) APPLY (first, second, x) APPLY (first, second, y) APPLY (first, second, z)
+
+/* Per-axis snippets of the generated functions. */
+#define TEMPLATE_FIELD(type, unused, axis) type axis;
+#define TEMPLATE_ASSIGN(point, unused, axis) point->axis = axis;
+#define TEMPLATE_MERGE(merged, other, axis)                                                                                                          \
+  merged.min_##axis = (other.min_##axis < merged.min_##axis) ? other.min_##axis : merged.min_##axis;                                                 \
+  merged.max_##axis = (other.max_##axis > merged.max_##axis) ? other.max_##axis : merged.max_##axis;
+#define TEMPLATE_REDUCE(name, batch, axis) types_##name##_reduce (batch->axis, begin, end, &partial->min_##axis, &partial->max_##axis);
+#define TEMPLATE_HAS_AXIS(batch, unused, axis) && (batch->axis != NULL)
+#define TEMPLATE_IS_ORDERED(bbox, unused, axis) && (bbox.min_##axis <= bbox.max_##axis)
+#define TEMPLATE_IS_INSIDE(points, box, axis) & (points.axis[i] >= box.min_##axis) & (points.axis[i] <= box.max_##axis)
+
+/**
+ * @brief Define the reduction of one coordinate array of a slice to its extremes.
+ *
+ * The reduction keeps lanes independent running extremes. The compiler turns them into
+ * minimum and maximum instructions of the type, which it does not do for a single
+ * floating-point extreme without fast-math reassociation.
+ */
+#define TEMPLATE_DEFINE_REDUCE(name, type, lowest, highest, lanes)                                                                                   \
+  static void types_##name##_reduce (const type *values, size_t begin, size_t end, type *low, type *high)                                            \
+  {                                                                                                                                                  \
+    type minimum[lanes];                                                                                                                             \
+    type maximum[lanes];                                                                                                                             \
+    for (size_t lane = 0; lane < (lanes); ++lane)                                                                                                    \
+      {                                                                                                                                              \
+        minimum[lane] = (highest);                                                                                                                   \
+        maximum[lane] = (lowest);                                                                                                                    \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    size_t i = begin;                                                                                                                                \
+    for (; (i + (lanes)) <= end; i += (lanes))                                                                                                       \
+      {                                                                                                                                              \
+        for (size_t lane = 0; lane < (lanes); ++lane)                                                                                                \
+          {                                                                                                                                          \
+            minimum[lane] = (values[i + lane] < minimum[lane]) ? values[i + lane] : minimum[lane];                                                   \
+            maximum[lane] = (values[i + lane] > maximum[lane]) ? values[i + lane] : maximum[lane];                                                   \
+          }                                                                                                                                          \
+      }                                                                                                                                              \
+    for (; i < end; ++i)                                                                                                                             \
+      {                                                                                                                                              \
+        minimum[0] = (values[i] < minimum[0]) ? values[i] : minimum[0];                                                                              \
+        maximum[0] = (values[i] > maximum[0]) ? values[i] : maximum[0];                                                                              \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    *low = minimum[0];                                                                                                                               \
+    *high = maximum[0];                                                                                                                              \
+    for (size_t lane = 1U; lane < (lanes); ++lane)                                                                                                   \
+      {                                                                                                                                              \
+        *low = (minimum[lane] < *low) ? minimum[lane] : *low;                                                                                        \
+        *high = (maximum[lane] > *high) ? maximum[lane] : *high;                                                                                     \
+      }                                                                                                                                              \
+  }
+
+/**
+ * @brief Define the parallel task reducing one slice of a batch into its partial
+ * bounding box, one coordinate array after the other.
+ */
+#define TEMPLATE_DEFINE_BBOX_TASK(name, axes)                                                                                                        \
+  static void types_##name##_bbox_task (void *context, uint32_t worker, size_t begin, size_t end)                                                    \
+  {                                                                                                                                                  \
+    types_##name##_context_t *template_context = context;                                                                                            \
+    const name##_batch_t *batch = template_context->batch;                                                                                           \
+    name##_bbox_t *partial = &template_context->partial[worker];                                                                                     \
+    axes (TEMPLATE_REDUCE, name, batch)                                                                                                              \
+  }
+
+/**
+ * @brief Define the creation of a point. The memory is obtained from the allocator
+ * installed with point_set_allocator, or malloc by default.
+ */
+#define TEMPLATE_DEFINE_CREATE(name, axes, parameters)                                                                                               \
+  API name##_t *name##_create parameters                                                                                                             \
+  {                                                                                                                                                  \
+    uint64_t start = TEMPLATE_STATS_START ();                                                                                                        \
+    name##_t *point = allocator_alloc (sizeof (struct name));                                                                                        \
+    if (point != NULL)                                                                                                                               \
+      {                                                                                                                                              \
+        axes (TEMPLATE_ASSIGN, point, ~)                                                                                                             \
+        TEMPLATE_STATS_CREATE (sizeof (struct name), start);                                                                                         \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    return point;                                                                                                                                    \
+  }
+
+/**
+ * @brief Define the destruction of a point, which returns false if it is NULL.
+ */
+#define TEMPLATE_DEFINE_DESTROY(name)                                                                                                                \
+  API bool name##_destroy (name##_t *point)                                                                                                          \
+  {                                                                                                                                                  \
+    bool result = false;                                                                                                                             \
+    if (point != NULL)                                                                                                                               \
+      {                                                                                                                                              \
+        allocator_free (point, sizeof (struct name));                                                                                                \
+        TEMPLATE_STATS_DESTROY (sizeof (struct name));                                                                                               \
+        result = true;                                                                                                                               \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    return result;                                                                                                                                   \
+  }
+
+/**
+ * @brief Define the getter of one coordinate of a point, which returns 0 if it is NULL.
+ */
+#define TEMPLATE_DEFINE_GET(name, type, axis)                                                                                                        \
+  API type name##_get_##axis (const name##_t *point)                                                                                                 \
+  {                                                                                                                                                  \
+    type result = 0;                                                                                                                                 \
+    if (point != NULL)                                                                                                                               \
+      {                                                                                                                                              \
+        result = point->axis;                                                                                                                        \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    return result;                                                                                                                                   \
+  }
+
+/**
+ * @brief Define the bounding box of a batch. Large batches are split across threads,
+ * each of which reduces its slice into a private bounding box before the partial results
+ * are merged. Floating-point coordinates that are NaN are ignored, and the function
+ * returns false if an argument is NULL or no coordinate is ordered.
+ */
+#define TEMPLATE_DEFINE_BBOX_COMPUTE(name, axes)                                                                                                     \
+  API bool name##_batch_bbox_compute (const name##_batch_t *batch, name##_bbox_t *bbox, uint32_t threads)                                            \
+  {                                                                                                                                                  \
+    bool result = false;                                                                                                                             \
+    if ((batch != NULL) axes (TEMPLATE_HAS_AXIS, batch, ~) && (bbox != NULL) && (batch->count > 0U))                                                 \
+      {                                                                                                                                              \
+        types_##name##_context_t template_context = { .batch = batch };                                                                              \
+        uint32_t workers = parallel_plan (threads, batch->count, PARALLEL_MIN_CHUNK);                                                                \
+        parallel_run (workers, batch->count, types_##name##_bbox_task, &template_context);                                                           \
+                                                                                                                                                     \
+        name##_bbox_t merged = template_context.partial[0];                                                                                          \
+        for (uint32_t i = 1U; i < workers; ++i)                                                                                                      \
+          {                                                                                                                                          \
+            axes (TEMPLATE_MERGE, merged, template_context.partial[i])                                                                               \
+          }                                                                                                                                          \
+                                                                                                                                                     \
+        result = true axes (TEMPLATE_IS_ORDERED, merged, ~);                                                                                         \
+        if (result)                                                                                                                                  \
+          {                                                                                                                                          \
+            *bbox = merged;                                                                                                                          \
+          }                                                                                                                                          \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    return result;                                                                                                                                   \
+  }
+
+/**
+ * @brief Define the search of the points of a batch inside a box with inclusive limits.
+ * The coordinates are compared without branches, so the scan does not suffer
+ * mispredictions however the points fall around the box. Every index is written while
+ * there is room in ids and kept only if inside, and the function returns the number of
+ * points inside.
+ */
+#define TEMPLATE_DEFINE_QUERY_RANGE(name, axes)                                                                                                      \
+  API size_t name##_batch_query_range (const name##_batch_t *batch, const name##_bbox_t *range, uint32_t *ids, size_t capacity)                      \
+  {                                                                                                                                                  \
+    size_t result = 0U;                                                                                                                              \
+    if ((batch != NULL) axes (TEMPLATE_HAS_AXIS, batch, ~) && (range != NULL) && ((ids != NULL) || (capacity == 0U))                                 \
+        && (batch->count <= UINT32_MAX))                                                                                                             \
+      {                                                                                                                                              \
+        const name##_batch_t points = *batch;                                                                                                        \
+        const name##_bbox_t box = *range;                                                                                                            \
+        for (size_t i = 0; i < points.count; ++i)                                                                                                    \
+          {                                                                                                                                          \
+            bool inside = true axes (TEMPLATE_IS_INSIDE, points, box);                                                                               \
+            if (result < capacity)                                                                                                                   \
+              {                                                                                                                                      \
+                ids[result] = (uint32_t)i;                                                                                                           \
+              }                                                                                                                                      \
+            result += inside ? 1U : 0U;                                                                                                              \
+          }                                                                                                                                          \
+      }                                                                                                                                              \
+                                                                                                                                                     \
+    return result;                                                                                                                                   \
+  }
+
+/**
+ * @brief Define the structure, the kernels and the API functions of a point type whose
+ * axes are listed by an axes macro, such as TEMPLATE_AXES_2D, and whose creation takes
+ * the parenthesized parameters.
+ */
+#define TEMPLATE_DEFINE(name, type, lowest, highest, lanes, axes, parameters)                                                                        \
+  struct name                                                                                                                                        \
+  {                                                                                                                                                  \
+    axes (TEMPLATE_FIELD, type, ~)                                                                                                                   \
+  };                                                                                                                                                 \
+                                                                                                                                                     \
+  typedef struct                                                                                                                                     \
+  {                                                                                                                                                  \
+    const name##_batch_t *batch;                                                                                                                     \
+    name##_bbox_t partial[PARALLEL_MAX_WORKERS];                                                                                                     \
+  } types_##name##_context_t;                                                                                                                        \
+                                                                                                                                                     \
+  TEMPLATE_DEFINE_REDUCE (name, type, lowest, highest, lanes)                                                                                        \
+  TEMPLATE_DEFINE_BBOX_TASK (name, axes)                                                                                                             \
+  TEMPLATE_DEFINE_CREATE (name, axes, parameters)                                                                                                    \
+  TEMPLATE_DEFINE_DESTROY (name)                                                                                                                     \
+  axes (TEMPLATE_DEFINE_GET, name, type)                                                                                                             \
+  TEMPLATE_DEFINE_BBOX_COMPUTE (name, axes)                                                                                                          \
+  TEMPLATE_DEFINE_QUERY_RANGE (name, axes)
+
+/* Define a point type in the plane, or in space. */
+#define TEMPLATE_DEFINE_2D(name, type, lowest, highest, lanes)                                                                                       \
+  TEMPLATE_DEFINE (name, type, lowest, highest, lanes, TEMPLATE_AXES_2D, (type x, type y))
+#define TEMPLATE_DEFINE_3D(name, type, lowest, highest, lanes)                                                                                       \
+  TEMPLATE_DEFINE (name, type, lowest, highest, lanes, TEMPLATE_AXES_3D, (type x, type y, type z))
+
+#endif
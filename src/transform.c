@@ -0,0 +1,568 @@
+#include "internal.h"
+#include "library.h"
+#include <math.h>
+#include <stdlib.h>
+
+/* Number of points transformed together; the coordinates of a block stay in the L1 cache. */
+#define TRANSFORM_BLOCK 256U
+
+/* Initial number of stages of a transform. */
+#define TRANSFORM_INITIAL_STAGES 4U
+
+/* Largest coordinate, as a double. */
+#define TRANSFORM_MAX_COORDINATE 4294967295.0
+
+/* Offset mapping unsigned 32-bit coordinates into the signed range and back. */
+#define TRANSFORM_SIGN_OFFSET 2147483648.0
+
+/* Adding and subtracting 1.5 * 2^52 rounds a double of magnitude below 2^51 to an integer. */
+#define TRANSFORM_ROUND_MAGIC 6755399441055744.0
+#define TRANSFORM_ROUND_LIMIT 2251799813685248.0
+
+/**
+ * @brief The kind of a transform stage.
+ */
+typedef enum
+{
+  TRANSFORM_AFFINE,
+  TRANSFORM_CLAMP,
+  TRANSFORM_QUANTIZE
+} transform_kind_t;
+
+/**
+ * @brief A stage of a transform.
+ *
+ * An affine stage maps (x, y) to (m[0] x + m[1] y + m[2], m[3] x + m[4] y + m[5]).
+ * A clamp stage limits the coordinates to its bounds, and a quantize stage rounds
+ * them down to a multiple of its steps.
+ */
+typedef struct
+{
+  transform_kind_t kind;
+  double matrix[6];
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+  double step_x;
+  double step_y;
+} transform_stage_t;
+
+struct point_transform
+{
+  transform_stage_t *stages;
+  uint32_t stages_count;
+  uint32_t stages_capacity;
+};
+
+/**
+ * @brief Shared state of a parallel transform run.
+ */
+typedef struct
+{
+  const point_transform_t *transform;
+  point_t *const *points;
+  point_value_t *values;
+  const point_batch_t *batch;
+  const point_batch_t *output;
+} transform_context_t;
+
+/**
+ * @brief Append a stage to a transform, growing its stage array if needed.
+ *
+ * @param transform A pointer to the transform.
+ *
+ * @return A pointer to the new stage, or NULL if memory allocation fails.
+ */
+static transform_stage_t *
+transform_append (point_transform_t *transform)
+{
+  transform_stage_t *result = NULL;
+
+  if (transform->stages_count == transform->stages_capacity)
+    {
+      uint32_t capacity = transform->stages_capacity * 2U;
+      transform_stage_t *stages = realloc (transform->stages, capacity * sizeof (transform_stage_t));
+      if (stages != NULL)
+        {
+          transform->stages = stages;
+          transform->stages_capacity = capacity;
+        }
+    }
+
+  if (transform->stages_count < transform->stages_capacity)
+    {
+      result = &transform->stages[transform->stages_count++];
+    }
+
+  return result;
+}
+
+/**
+ * @brief Append an affine map to a transform.
+ *
+ * If the last stage is affine as well, the map is composed into its matrix, so
+ * that any chain of affine maps costs a single stage when the transform is applied.
+ *
+ * @param transform A pointer to the transform.
+ * @param matrix The map, applied after the preceding stages.
+ *
+ * @return true if the map was appended, false if memory allocation fails.
+ */
+static bool
+transform_append_affine (point_transform_t *transform, const double *matrix)
+{
+  bool result = false;
+
+  transform_stage_t *last = (transform->stages_count > 0U) ? &transform->stages[transform->stages_count - 1U] : NULL;
+  if ((last != NULL) && (last->kind == TRANSFORM_AFFINE))
+    {
+      const double *m = last->matrix;
+      double composed[6] = {
+        (matrix[0] * m[0]) + (matrix[1] * m[3]), (matrix[0] * m[1]) + (matrix[1] * m[4]), (matrix[0] * m[2]) + (matrix[1] * m[5]) + matrix[2],
+        (matrix[3] * m[0]) + (matrix[4] * m[3]), (matrix[3] * m[1]) + (matrix[4] * m[4]), (matrix[3] * m[2]) + (matrix[4] * m[5]) + matrix[5],
+      };
+      for (uint32_t i = 0; i < 6U; ++i)
+        {
+          last->matrix[i] = composed[i];
+        }
+      result = true;
+    }
+  else
+    {
+      transform_stage_t *stage = transform_append (transform);
+      if (stage != NULL)
+        {
+          stage->kind = TRANSFORM_AFFINE;
+          for (uint32_t i = 0; i < 6U; ++i)
+            {
+              stage->matrix[i] = matrix[i];
+            }
+          result = true;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Round a double down to an integer.
+ *
+ * Unlike floor, this compiles to plain additions and comparisons, so loops calling
+ * it vectorize without SSE4.1. Values of magnitude 2^51 and above are returned
+ * unchanged, which only affects values that saturate when stored as coordinates.
+ *
+ * @param value The value to round.
+ *
+ * @return The largest integer not above the value.
+ */
+static inline double
+transform_floor (double value)
+{
+  double rounded = (value + TRANSFORM_ROUND_MAGIC) - TRANSFORM_ROUND_MAGIC;
+  rounded -= (rounded > value) ? 1.0 : 0.0;
+  return ((value < TRANSFORM_ROUND_LIMIT) && (value > -TRANSFORM_ROUND_LIMIT)) ? rounded : value;
+}
+
+/**
+ * @brief Convert a block of unsigned coordinates to doubles.
+ *
+ * The coordinates are shifted into the signed range first, which compilers
+ * vectorize with packed signed conversions.
+ *
+ * @param coordinates The coordinates to convert.
+ * @param values The converted coordinates.
+ * @param count The number of coordinates.
+ */
+static void
+transform_load (const uint32_t *restrict coordinates, double *restrict values, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    {
+      values[i] = (double)(int32_t)(coordinates[i] ^ 0x80000000U) + TRANSFORM_SIGN_OFFSET;
+    }
+}
+
+/**
+ * @brief Round a block of doubles to the nearest coordinates, saturating at the limits.
+ *
+ * @param values The values to convert.
+ * @param coordinates The converted coordinates.
+ * @param count The number of values.
+ */
+static void
+transform_store (const double *restrict values, uint32_t *restrict coordinates, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    {
+      double value = transform_floor (values[i] + 0.5);
+      value = (value > 0.0) ? value : 0.0;
+      value = (value < TRANSFORM_MAX_COORDINATE) ? value : TRANSFORM_MAX_COORDINATE;
+      coordinates[i] = (uint32_t)(int32_t)(value - TRANSFORM_SIGN_OFFSET) ^ 0x80000000U;
+    }
+}
+
+/**
+ * @brief Run every stage of a transform over a block of coordinates.
+ *
+ * Each stage is a branch-free loop over the block, which compilers vectorize, and
+ * the block stays in the L1 cache between the stages.
+ *
+ * @param transform A pointer to the transform.
+ * @param x The x-coordinates, transformed in place.
+ * @param y The y-coordinates, transformed in place.
+ * @param count The number of coordinates, at most TRANSFORM_BLOCK.
+ */
+static void
+transform_run (const point_transform_t *transform, double *restrict x, double *restrict y, size_t count)
+{
+  for (uint32_t s = 0; s < transform->stages_count; ++s)
+    {
+      const transform_stage_t *stage = &transform->stages[s];
+      switch (stage->kind)
+        {
+        case TRANSFORM_AFFINE:
+          {
+            const double *m = stage->matrix;
+            for (size_t i = 0; i < count; ++i)
+              {
+                double px = x[i];
+                double py = y[i];
+                x[i] = (m[0] * px) + (m[1] * py) + m[2];
+                y[i] = (m[3] * px) + (m[4] * py) + m[5];
+              }
+          }
+          break;
+        case TRANSFORM_CLAMP:
+          for (size_t i = 0; i < count; ++i)
+            {
+              double px = (x[i] > stage->min_x) ? x[i] : stage->min_x;
+              double py = (y[i] > stage->min_y) ? y[i] : stage->min_y;
+              x[i] = (px < stage->max_x) ? px : stage->max_x;
+              y[i] = (py < stage->max_y) ? py : stage->max_y;
+            }
+          break;
+        case TRANSFORM_QUANTIZE:
+          for (size_t i = 0; i < count; ++i)
+            {
+              x[i] = transform_floor (x[i] / stage->step_x) * stage->step_x;
+              y[i] = transform_floor (y[i] / stage->step_y) * stage->step_y;
+            }
+          break;
+        default:
+          break;
+        }
+    }
+}
+
+/**
+ * @brief Parallel task transforming one slice of the input block by block.
+ *
+ * Every point is read and written exactly once, whatever the number of stages.
+ *
+ * @param context A pointer to the transform_context_t of the run.
+ * @param worker The index of the worker, unused.
+ * @param begin The first index of the slice.
+ * @param end One past the last index of the slice.
+ */
+static void
+transform_task (void *context, uint32_t worker, size_t begin, size_t end)
+{
+  (void)worker;
+  const transform_context_t *transform_context = context;
+  double x[TRANSFORM_BLOCK];
+  double y[TRANSFORM_BLOCK];
+
+  for (size_t block = begin; block < end; block += TRANSFORM_BLOCK)
+    {
+      size_t count = ((end - block) < TRANSFORM_BLOCK) ? (end - block) : TRANSFORM_BLOCK;
+
+      if (transform_context->batch != NULL)
+        {
+          const point_batch_t *batch = transform_context->batch;
+          const point_batch_t *output = transform_context->output;
+          transform_load (&batch->x[block], x, count);
+          transform_load (&batch->y[block], y, count);
+          transform_run (transform_context->transform, x, y, count);
+          transform_store (x, &output->x[block], count);
+          transform_store (y, &output->y[block], count);
+        }
+      else
+        {
+          point_t *const *points = &transform_context->points[block];
+          uint32_t coordinates[2][TRANSFORM_BLOCK];
+          for (size_t i = 0; i < count; ++i)
+            {
+              coordinates[0][i] = (points[i] != NULL) ? points[i]->x : 0U;
+              coordinates[1][i] = (points[i] != NULL) ? points[i]->y : 0U;
+            }
+
+          transform_load (coordinates[0], x, count);
+          transform_load (coordinates[1], y, count);
+          transform_run (transform_context->transform, x, y, count);
+          transform_store (x, coordinates[0], count);
+          transform_store (y, coordinates[1], count);
+
+          point_value_t *values = (transform_context->values != NULL) ? &transform_context->values[block] : NULL;
+          for (size_t i = 0; i < count; ++i)
+            {
+              if ((points[i] != NULL) && (values != NULL))
+                {
+                  values[i].x = coordinates[0][i];
+                  values[i].y = coordinates[1][i];
+                }
+              else if (points[i] != NULL)
+                {
+                  points[i]->x = coordinates[0][i];
+                  points[i]->y = coordinates[1][i];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Create an empty transform, which maps every point to itself.
+ *
+ * Operations appended to the transform are only recorded; they are executed when
+ * the transform is applied to points.
+ *
+ * @return A pointer to the newly created transform, or NULL if memory allocation
+ * fails.
+ */
+point_transform_t *
+point_transform_create (void)
+{
+  point_transform_t *transform = malloc (sizeof (struct point_transform));
+  if (transform != NULL)
+    {
+      transform->stages = malloc (TRANSFORM_INITIAL_STAGES * sizeof (transform_stage_t));
+      transform->stages_count = 0U;
+      transform->stages_capacity = TRANSFORM_INITIAL_STAGES;
+      if (transform->stages == NULL)
+        {
+          free (transform);
+          transform = NULL;
+        }
+    }
+
+  return transform;
+}
+
+/**
+ * @brief Destroy a transform and release its associated memory.
+ *
+ * @param transform A pointer to the transform to be destroyed.
+ *
+ * @return true if the transform was destroyed, false if the input pointer is NULL.
+ */
+bool
+point_transform_destroy (point_transform_t *transform)
+{
+  bool result = false;
+  if (transform != NULL)
+    {
+      free (transform->stages);
+      free (transform);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Append a translation to a transform.
+ *
+ * @param transform A pointer to the transform.
+ * @param dx The offset added to the x-coordinates.
+ * @param dy The offset added to the y-coordinates.
+ *
+ * @return true if the translation was appended, false if the transform is NULL, an
+ * offset is not finite or memory allocation fails.
+ */
+bool
+point_transform_translate (point_transform_t *transform, double dx, double dy)
+{
+  bool result = false;
+  if ((transform != NULL) && isfinite (dx) && isfinite (dy))
+    {
+      const double matrix[6] = { 1.0, 0.0, dx, 0.0, 1.0, dy };
+      result = transform_append_affine (transform, matrix);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Append a scaling about the origin to a transform.
+ *
+ * @param transform A pointer to the transform.
+ * @param sx The factor applied to the x-coordinates.
+ * @param sy The factor applied to the y-coordinates.
+ *
+ * @return true if the scaling was appended, false if the transform is NULL, a factor
+ * is not finite or memory allocation fails.
+ */
+bool
+point_transform_scale (point_transform_t *transform, double sx, double sy)
+{
+  bool result = false;
+  if ((transform != NULL) && isfinite (sx) && isfinite (sy))
+    {
+      const double matrix[6] = { sx, 0.0, 0.0, 0.0, sy, 0.0 };
+      result = transform_append_affine (transform, matrix);
+    }
+
+  return result;
+}
+
+/**
+ * @brief Append a general affine map to a transform.
+ *
+ * The map sends (x, y) to (m[0] x + m[1] y + m[2], m[3] x + m[4] y + m[5]).
+ * Consecutive translations, scalings and affine maps are composed into a single
+ * matrix when they are appended.
+ *
+ * @param transform A pointer to the transform.
+ * @param matrix The six coefficients of the map, in row-major order.
+ *
+ * @return true if the map was appended, false if an argument is NULL, a coefficient
+ * is not finite or memory allocation fails.
+ */
+bool
+point_transform_affine (point_transform_t *transform, const double *matrix)
+{
+  bool result = (transform != NULL) && (matrix != NULL);
+  for (uint32_t i = 0; result && (i < 6U); ++i)
+    {
+      result = isfinite (matrix[i]);
+    }
+
+  return result && transform_append_affine (transform, matrix);
+}
+
+/**
+ * @brief Append a clamp of the coordinates to a bounding box to a transform.
+ *
+ * @param transform A pointer to the transform.
+ * @param bounds A pointer to the bounding box, with inclusive limits.
+ *
+ * @return true if the clamp was appended, false if an argument is NULL, the bounding
+ * box is empty or memory allocation fails.
+ */
+bool
+point_transform_clamp (point_transform_t *transform, const point_bbox_t *bounds)
+{
+  bool result = false;
+  if ((transform != NULL) && (bounds != NULL) && (bounds->min_x <= bounds->max_x) && (bounds->min_y <= bounds->max_y))
+    {
+      transform_stage_t *stage = transform_append (transform);
+      if (stage != NULL)
+        {
+          stage->kind = TRANSFORM_CLAMP;
+          stage->min_x = (double)bounds->min_x;
+          stage->min_y = (double)bounds->min_y;
+          stage->max_x = (double)bounds->max_x;
+          stage->max_y = (double)bounds->max_y;
+          result = true;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Append a quantization of the coordinates to a grid to a transform.
+ *
+ * The coordinates are rounded down to the nearest multiple of the steps, which
+ * snaps points to the origins of the grid cells containing them.
+ *
+ * @param transform A pointer to the transform.
+ * @param step_x The grid step along the x-axis.
+ * @param step_y The grid step along the y-axis.
+ *
+ * @return true if the quantization was appended, false if the transform is NULL, a
+ * step is zero or memory allocation fails.
+ */
+bool
+point_transform_quantize (point_transform_t *transform, uint32_t step_x, uint32_t step_y)
+{
+  bool result = false;
+  if ((transform != NULL) && (step_x > 0U) && (step_y > 0U))
+    {
+      transform_stage_t *stage = transform_append (transform);
+      if (stage != NULL)
+        {
+          stage->kind = TRANSFORM_QUANTIZE;
+          stage->step_x = (double)step_x;
+          stage->step_y = (double)step_y;
+          result = true;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * @brief Apply a transform to an array of points.
+ *
+ * The recorded stages are executed in a single fused pass: the coordinates are
+ * gathered block by block, run through every stage, rounded to the nearest
+ * coordinates and saturated to the range of uint32_t. NULL entries in the array
+ * are skipped. Large arrays are split across threads.
+ *
+ * @param transform A pointer to the transform.
+ * @param points An array of pointers to the points.
+ * @param count The number of entries in the array.
+ * @param output A buffer of count point values receiving the transformed points, or
+ * NULL to transform the points in place. Entries of NULL points are left unchanged.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the transform was applied, false if the transform or the array is
+ * NULL.
+ */
+bool
+point_transform_apply (const point_transform_t *transform, point_t *const *points, size_t count, point_value_t *output, uint32_t threads)
+{
+  bool result = false;
+  if ((transform != NULL) && (points != NULL))
+    {
+      transform_context_t transform_context = { .transform = transform, .points = points, .values = output };
+      parallel_run (parallel_plan (threads, count, PARALLEL_MIN_CHUNK), count, transform_task, &transform_context);
+      result = true;
+    }
+
+  return result;
+}
+
+/**
+ * @brief Apply a transform to a batch of points.
+ *
+ * The recorded stages are executed in a single fused pass as for
+ * point_transform_apply, which compilers vectorize over the structure-of-arrays
+ * coordinates. Large batches are split across threads.
+ *
+ * @param transform A pointer to the transform.
+ * @param batch A pointer to the batch of points.
+ * @param output A pointer to a batch of at least batch->count points receiving the
+ * transformed coordinates. It may be the input batch itself to transform in place,
+ * but its coordinates must not partially overlap those of the input.
+ * @param threads The maximum number of threads to use, or 0 for all available processors.
+ *
+ * @return true if the transform was applied, false if an argument is NULL or the
+ * output is smaller than the batch.
+ */
+bool
+point_batch_transform_apply (const point_transform_t *transform, const point_batch_t *batch, const point_batch_t *output, uint32_t threads)
+{
+  bool result = false;
+  if ((transform != NULL) && (batch != NULL) && (batch->x != NULL) && (batch->y != NULL) && (output != NULL) && (output->x != NULL)
+      && (output->y != NULL) && (output->count >= batch->count))
+    {
+      transform_context_t transform_context = { .transform = transform, .batch = batch, .output = output };
+      parallel_run (parallel_plan (threads, batch->count, PARALLEL_MIN_CHUNK), batch->count, transform_task, &transform_context);
+      result = true;
+    }
+
+  return result;
+}
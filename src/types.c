@@ -0,0 +1,16 @@
+#include "internal.h"
+#include "library.h"
+#include "template.h"
+#include <math.h>
+
+/* Points with 16-bit unsigned coordinates, for small tiles. */
+TEMPLATE_DEFINE_2D (point_u16, uint16_t, 0U, UINT16_MAX, 1U)
+
+/* Points with 64-bit signed coordinates, for extents beyond 32 bits and negative positions. */
+TEMPLATE_DEFINE_2D (point_i64, int64_t, INT64_MIN, INT64_MAX, 1U)
+
+/* Points with single-precision coordinates. */
+TEMPLATE_DEFINE_2D (point_f32, float, (-INFINITY), INFINITY, 8U)
+
+/* Points in space with single-precision coordinates. */
+TEMPLATE_DEFINE_3D (point3_f32, float, (-INFINITY), INFINITY, 8U)
@@ -0,0 +1,61 @@
+#define CLOVE_SUITE_NAME allocator
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+typedef struct
+{
+  size_t allocations;
+  size_t releases;
+  size_t bytes;
+} counting_allocator_t;
+
+static void *
+counting_alloc (size_t size, void *user_data)
+{
+  counting_allocator_t *allocator = user_data;
+  ++allocator->allocations;
+  allocator->bytes += size;
+  return malloc (size);
+}
+
+static void
+counting_free (void *memory, size_t size, void *user_data)
+{
+  counting_allocator_t *allocator = user_data;
+  ++allocator->releases;
+  allocator->bytes -= size;
+  free (memory);
+}
+
+CLOVE_TEST (point_set_allocator)
+{
+  counting_allocator_t allocator = { 0U, 0U, 0U };
+  CLOVE_IS_TRUE (point_set_allocator (counting_alloc, counting_free, &allocator));
+
+  point_t *point = point_create (10U, 20U);
+  CLOVE_NOT_NULL (point);
+  CLOVE_UINT_EQ (1U, allocator.allocations);
+  CLOVE_IS_TRUE (allocator.bytes > 0U);
+  CLOVE_UINT_EQ (20U, point_get_y (point));
+
+  (void)point_destroy (point);
+  CLOVE_UINT_EQ (1U, allocator.releases);
+  CLOVE_UINT_EQ (0U, allocator.bytes);
+
+  CLOVE_IS_TRUE (point_set_allocator (NULL, NULL, NULL));
+  point = point_create (1U, 2U);
+  (void)point_destroy (point);
+  CLOVE_UINT_EQ (1U, allocator.allocations);
+}
+
+CLOVE_TEST (point_set_allocator__on_null)
+{
+  counting_allocator_t allocator = { 0U, 0U, 0U };
+  CLOVE_IS_FALSE (point_set_allocator (counting_alloc, NULL, &allocator));
+  CLOVE_IS_FALSE (point_set_allocator (NULL, counting_free, &allocator));
+
+  point_t *point = point_create (1U, 2U);
+  (void)point_destroy (point);
+  CLOVE_UINT_EQ (0U, allocator.allocations);
+}
@@ -0,0 +1,203 @@
+#define CLOVE_SUITE_NAME arena
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of allocations made concurrently by the pool threads. */
+#define CONCURRENT_ALLOCATIONS 20000U
+
+/**
+ * Allocates one slot per index of a chunk from the arena and records it.
+ */
+static void
+allocate_range (void *context, size_t begin, size_t end)
+{
+  void **slots = context;
+  point_arena_t *arena = slots[CONCURRENT_ALLOCATIONS];
+  for (size_t i = begin; i < end; ++i)
+    {
+      uint64_t *slot = point_arena_alloc (sizeof (uint64_t), arena);
+      if (slot != NULL)
+        {
+          *slot = i;
+        }
+      slots[i] = slot;
+    }
+}
+
+CLOVE_TEST (point_arena_create)
+{
+  point_arena_options_t options = { .capacity = 1000000U, .numa_node = -1 };
+  point_arena_t *arena = point_arena_create (&options);
+  point_arena_info_t info = { 0 };
+  CLOVE_NOT_NULL (arena);
+  CLOVE_IS_TRUE (point_arena_get_info (arena, &info));
+  CLOVE_ULLONG_EQ (2U * 1024U * 1024U, info.capacity);
+  CLOVE_ULLONG_EQ (0U, info.used);
+  CLOVE_IS_FALSE (info.is_huge_explicit);
+  CLOVE_IS_FALSE (info.is_huge_transparent);
+  CLOVE_IS_FALSE (info.is_numa_bound);
+  CLOVE_IS_TRUE (point_arena_destroy (arena));
+
+  /* Huge pages and the first node are used where available, and the arena works either way */
+  options = (point_arena_options_t){ .capacity = 4U * 1024U * 1024U, .is_huge = true, .numa_node = 0, .is_prefaulted = true, .threads = 4U };
+  arena = point_arena_create (&options);
+  CLOVE_NOT_NULL (arena);
+  uint8_t *memory = point_arena_alloc (options.capacity, arena);
+  CLOVE_NOT_NULL (memory);
+  memory[0] = 1U;
+  memory[options.capacity - 1U] = 2U;
+  CLOVE_UINT_EQ (0U, memory[options.capacity / 2U]);
+  CLOVE_IS_TRUE (point_arena_destroy (arena));
+}
+
+CLOVE_TEST (point_arena_create__unavailable)
+{
+  /* A node that does not exist leaves the default placement */
+  point_arena_options_t options = { .capacity = 4096U, .numa_node = 1000000 };
+  point_arena_t *arena = point_arena_create (&options);
+  point_arena_info_t info = { 0 };
+  CLOVE_NOT_NULL (arena);
+  CLOVE_IS_TRUE (point_arena_get_info (arena, &info));
+  CLOVE_IS_FALSE (info.is_numa_bound);
+  (void)point_arena_destroy (arena);
+}
+
+CLOVE_TEST (point_arena_create__on_null)
+{
+  point_arena_options_t options = { .capacity = 0U, .numa_node = -1 };
+  CLOVE_NULL (point_arena_create (NULL));
+  CLOVE_NULL (point_arena_create (&options));
+  options.capacity = SIZE_MAX;
+  CLOVE_NULL (point_arena_create (&options));
+}
+
+CLOVE_TEST (point_arena_destroy)
+{
+  CLOVE_IS_FALSE (point_arena_destroy (NULL));
+}
+
+CLOVE_TEST (point_arena_alloc)
+{
+  point_arena_options_t options = { .capacity = 4096U, .numa_node = -1 };
+  point_arena_t *arena = point_arena_create (&options);
+  point_arena_info_t info = { 0 };
+
+  /* Points are packed, and larger allocations aligned */
+  uint8_t *first = point_arena_alloc (8U, arena);
+  uint8_t *second = point_arena_alloc (8U, arena);
+  uint8_t *third = point_arena_alloc (12U, arena);
+  uint8_t *batch = point_arena_alloc (100U, arena);
+  CLOVE_PTR_EQ (&first[8], second);
+  CLOVE_PTR_EQ (&first[16], third);
+  CLOVE_PTR_EQ (&first[64], batch);
+  CLOVE_ULLONG_EQ (0U, (uintptr_t)first % (2U * 1024U * 1024U));
+
+  (void)point_arena_get_info (arena, &info);
+  CLOVE_ULLONG_EQ (164U, info.used);
+  CLOVE_NULL (point_arena_alloc (info.capacity - 191U, arena));
+  CLOVE_NOT_NULL (point_arena_alloc (info.capacity - 192U, arena));
+  CLOVE_NULL (point_arena_alloc (1U, arena));
+  CLOVE_NULL (point_arena_alloc (0U, arena));
+  CLOVE_NULL (point_arena_alloc (8U, NULL));
+
+  /* Installed as the point allocator, points are contiguous */
+  CLOVE_IS_TRUE (point_arena_reset (arena));
+  CLOVE_IS_TRUE (point_set_allocator (point_arena_alloc, point_arena_free, arena));
+  point_t *points[3] = { point_create (1U, 2U), point_create (3U, 4U), point_create (5U, 6U) };
+  CLOVE_IS_TRUE (point_set_allocator (NULL, NULL, NULL));
+  CLOVE_PTR_EQ ((void *)first, (void *)points[0]);
+  CLOVE_PTR_EQ ((void *)&first[16], (void *)points[2]);
+  CLOVE_UINT_EQ (4U, point_get_y (points[1]));
+  (void)point_arena_destroy (arena);
+}
+
+CLOVE_TEST (point_arena_alloc__concurrent)
+{
+  point_arena_options_t options = { .capacity = CONCURRENT_ALLOCATIONS * sizeof (uint64_t), .numa_node = -1 };
+  void **slots = calloc (CONCURRENT_ALLOCATIONS + 1U, sizeof (void *));
+  CLOVE_NOT_NULL (slots);
+  point_arena_t *arena = point_arena_create (&options);
+  slots[CONCURRENT_ALLOCATIONS] = arena;
+
+  CLOVE_IS_TRUE (point_parallel_for (CONCURRENT_ALLOCATIONS, 100U, allocate_range, slots));
+
+  /* Every slot was allocated once, so no other allocation overwrote its index */
+  bool is_valid = true;
+  for (size_t i = 0; i < CONCURRENT_ALLOCATIONS; ++i)
+    {
+      is_valid = is_valid && (slots[i] != NULL) && (*(uint64_t *)slots[i] == i);
+    }
+  CLOVE_IS_TRUE (is_valid);
+
+  (void)point_arena_destroy (arena);
+  free (slots);
+}
+
+CLOVE_TEST (point_arena_free)
+{
+  point_arena_options_t options = { .capacity = 4096U, .numa_node = -1 };
+  point_arena_t *arena = point_arena_create (&options);
+  point_arena_info_t info = { 0 };
+
+  /* Only the latest allocation is reused */
+  void *first = point_arena_alloc (64U, arena);
+  void *second = point_arena_alloc (64U, arena);
+  point_arena_free (first, 64U, arena);
+  (void)point_arena_get_info (arena, &info);
+  CLOVE_ULLONG_EQ (128U, info.used);
+  point_arena_free (second, 64U, arena);
+  (void)point_arena_get_info (arena, &info);
+  CLOVE_ULLONG_EQ (64U, info.used);
+  CLOVE_PTR_EQ (second, point_arena_alloc (64U, arena));
+
+  point_arena_free (NULL, 64U, arena);
+  point_arena_free (second, 64U, NULL);
+  (void)point_arena_get_info (arena, &info);
+  CLOVE_ULLONG_EQ (128U, info.used);
+  (void)point_arena_destroy (arena);
+}
+
+CLOVE_TEST (point_arena_free__foreign)
+{
+  point_arena_options_t options = { .capacity = 4096U, .numa_node = -1 };
+  point_arena_t *arena = point_arena_create (&options);
+  point_arena_info_t info = { 0 };
+  point_t *point = point_create (1U, 2U);
+
+  /* A point created before the arena was installed is left to its own allocator */
+  CLOVE_IS_TRUE (point_set_allocator (point_arena_alloc, point_arena_free, arena));
+  CLOVE_NOT_NULL (point_arena_alloc (64U, arena));
+  point_arena_free (point, sizeof (uint64_t), arena);
+  CLOVE_IS_TRUE (point_set_allocator (NULL, NULL, NULL));
+
+  (void)point_arena_get_info (arena, &info);
+  CLOVE_ULLONG_EQ (64U, info.used);
+  CLOVE_UINT_EQ (2U, point_get_y (point));
+  (void)point_destroy (point);
+  (void)point_arena_destroy (arena);
+}
+
+CLOVE_TEST (point_arena_reset)
+{
+  point_arena_options_t options = { .capacity = 4096U, .numa_node = -1 };
+  point_arena_t *arena = point_arena_create (&options);
+  void *first = point_arena_alloc (100U, arena);
+  (void)point_arena_alloc (100U, arena);
+
+  CLOVE_IS_TRUE (point_arena_reset (arena));
+  CLOVE_PTR_EQ (first, point_arena_alloc (100U, arena));
+  CLOVE_IS_FALSE (point_arena_reset (NULL));
+  (void)point_arena_destroy (arena);
+}
+
+CLOVE_TEST (point_arena_get_info)
+{
+  point_arena_options_t options = { .capacity = 4096U, .numa_node = -1 };
+  point_arena_t *arena = point_arena_create (&options);
+  point_arena_info_t info = { 0 };
+
+  CLOVE_IS_FALSE (point_arena_get_info (arena, NULL));
+  CLOVE_IS_FALSE (point_arena_get_info (NULL, &info));
+  (void)point_arena_destroy (arena);
+}
@@ -0,0 +1,119 @@
+#define CLOVE_SUITE_NAME bbox
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+CLOVE_TEST (point_bbox_compute)
+{
+  point_t *points[3] = { point_create (5U, 9U), point_create (2U, 14U), point_create (8U, 3U) };
+  point_bbox_t bbox = { 0 };
+
+  CLOVE_IS_TRUE (point_bbox_compute (points, 3U, &bbox, 1U));
+  CLOVE_UINT_EQ (2U, bbox.min_x);
+  CLOVE_UINT_EQ (3U, bbox.min_y);
+  CLOVE_UINT_EQ (8U, bbox.max_x);
+  CLOVE_UINT_EQ (14U, bbox.max_y);
+
+  for (uint32_t i = 0; i < 3U; ++i)
+    {
+      (void)point_destroy (points[i]);
+    }
+}
+
+CLOVE_TEST (point_bbox_compute__skips_null_entries)
+{
+  point_t *points[3] = { NULL, point_create (7U, 1U), NULL };
+  point_bbox_t bbox = { 0 };
+
+  CLOVE_IS_TRUE (point_bbox_compute (points, 3U, &bbox, 0U));
+  CLOVE_UINT_EQ (7U, bbox.min_x);
+  CLOVE_UINT_EQ (7U, bbox.max_x);
+  CLOVE_UINT_EQ (1U, bbox.min_y);
+  CLOVE_UINT_EQ (1U, bbox.max_y);
+
+  (void)point_destroy (points[1]);
+}
+
+CLOVE_TEST (point_bbox_compute__on_null)
+{
+  point_t *points[1] = { NULL };
+  point_bbox_t bbox = { 0 };
+
+  CLOVE_IS_FALSE (point_bbox_compute (NULL, 1U, &bbox, 1U));
+  CLOVE_IS_FALSE (point_bbox_compute (points, 1U, &bbox, 1U));
+}
+
+CLOVE_TEST (point_batch_bbox_compute)
+{
+  uint32_t x[11] = { 40U, 12U, 90U, 33U, 7U, 61U, 58U, 21U, 80U, 15U, 3U };
+  uint32_t y[11] = { 17U, 5U, 22U, 99U, 64U, 1U, 38U, 46U, 27U, 73U, 50U };
+  point_batch_t batch = { x, y, 11U };
+  point_bbox_t bbox = { 0 };
+
+  CLOVE_IS_TRUE (point_batch_bbox_compute (&batch, &bbox, 1U));
+  CLOVE_UINT_EQ (3U, bbox.min_x);
+  CLOVE_UINT_EQ (1U, bbox.min_y);
+  CLOVE_UINT_EQ (90U, bbox.max_x);
+  CLOVE_UINT_EQ (99U, bbox.max_y);
+}
+
+CLOVE_TEST (point_batch_bbox_compute__full_range)
+{
+  /* Coordinates on both sides of the sign bit are ordered as unsigned values */
+  uint32_t x[8] = { 0x80000000U, 0x7FFFFFFFU, UINT32_MAX, 0x80000001U, 0x7FFFFFFEU, 0xC0000000U, 0x40000000U, 0x80000000U };
+  uint32_t y[8] = { 0x7FFFFFFFU, 0x80000000U, 0x7FFFFFFFU, 0x80000000U, 0x80000001U, 0x7FFFFFFEU, 0x80000000U, 0x80000000U };
+  point_batch_t batch = { x, y, 8U };
+  point_bbox_t bbox = { 0 };
+
+  CLOVE_IS_TRUE (point_batch_bbox_compute (&batch, &bbox, 1U));
+  CLOVE_UINT_EQ (0x40000000U, bbox.min_x);
+  CLOVE_UINT_EQ (0x7FFFFFFEU, bbox.min_y);
+  CLOVE_UINT_EQ (UINT32_MAX, bbox.max_x);
+  CLOVE_UINT_EQ (0x80000001U, bbox.max_y);
+}
+
+CLOVE_TEST (point_batch_bbox_compute__parallel)
+{
+  const size_t count = 300007U;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+
+  uint32_t state = 12345U;
+  for (size_t i = 0; i < count; ++i)
+    {
+      state = (state * 1103515245U) + 12345U;
+      x[i] = 1000U + (state % 50000U);
+      y[i] = 2000U + ((state >> 8) % 70000U);
+    }
+  x[count - 1U] = 999U;
+  y[count / 2U] = 90000U;
+
+  point_batch_t batch = { x, y, count };
+  point_bbox_t serial = { 0 };
+  point_bbox_t parallel = { 0 };
+
+  CLOVE_IS_TRUE (point_batch_bbox_compute (&batch, &serial, 1U));
+  CLOVE_IS_TRUE (point_batch_bbox_compute (&batch, &parallel, 4U));
+  CLOVE_UINT_EQ (999U, parallel.min_x);
+  CLOVE_UINT_EQ (90000U, parallel.max_y);
+  CLOVE_UINT_EQ (serial.min_x, parallel.min_x);
+  CLOVE_UINT_EQ (serial.min_y, parallel.min_y);
+  CLOVE_UINT_EQ (serial.max_x, parallel.max_x);
+  CLOVE_UINT_EQ (serial.max_y, parallel.max_y);
+
+  free (x);
+  free (y);
+}
+
+CLOVE_TEST (point_batch_bbox_compute__on_empty)
+{
+  uint32_t x[1] = { 0U };
+  uint32_t y[1] = { 0U };
+  point_batch_t batch = { x, y, 0U };
+  point_bbox_t bbox = { 0 };
+
+  CLOVE_IS_FALSE (point_batch_bbox_compute (&batch, &bbox, 1U));
+  CLOVE_IS_FALSE (point_batch_bbox_compute (NULL, &bbox, 1U));
+}
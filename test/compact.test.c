@@ -0,0 +1,203 @@
+#define CLOVE_SUITE_NAME compact
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* Number of points of the tiled test batches, covering two full blocks and a partial one. */
+#define TILED_POINTS 10000U
+
+/**
+ * Fills a batch with pseudo-random points, each run of 4096 points in its own tile of
+ * 65536 by 65536, the last tile touching the maximum x-coordinate.
+ */
+static void
+tiles_fill (uint32_t *x, uint32_t *y, size_t count, uint32_t seed)
+{
+  uint32_t state = seed;
+  for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t tile = (uint32_t)(i / 4096U);
+      uint32_t origin = (tile < 2U) ? (tile * 1000000U) : (UINT32_MAX - UINT16_MAX);
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = origin + (state >> 16U);
+      state = (state * 1664525U) + 1013904223U;
+      y[i] = (UINT32_MAX - UINT16_MAX) - origin + (state >> 16U);
+    }
+  x[count - 1U] = UINT32_MAX;
+  y[count - 1U] = UINT16_MAX;
+}
+
+CLOVE_TEST (point_compact_create)
+{
+  uint32_t x[TILED_POINTS];
+  uint32_t y[TILED_POINTS];
+  tiles_fill (x, y, TILED_POINTS, 5U);
+  point_batch_t batch = { x, y, TILED_POINTS };
+
+  point_compact_t *compact = point_compact_create (&batch, 4U);
+  CLOVE_NOT_NULL (compact);
+  CLOVE_ULLONG_EQ (TILED_POINTS, point_compact_get_count (compact));
+
+  bool is_equal = true;
+  for (size_t i = 0; i < TILED_POINTS; ++i)
+    {
+      point_value_t value = { 0U, 0U };
+      is_equal = is_equal && point_compact_get (compact, i, &value) && (value.x == x[i]) && (value.y == y[i]);
+    }
+  CLOVE_IS_TRUE (is_equal);
+  CLOVE_IS_TRUE (point_compact_destroy (compact));
+
+  point_batch_t empty = { x, y, 0U };
+  compact = point_compact_create (&empty, 1U);
+  CLOVE_NOT_NULL (compact);
+  CLOVE_ULLONG_EQ (0U, point_compact_get_count (compact));
+  (void)point_compact_destroy (compact);
+}
+
+CLOVE_TEST (point_compact_create__out_of_range)
+{
+  /* The first block spans 65536 on the y axis, one more than its offsets can hold */
+  uint32_t x[5000] = { 0U };
+  uint32_t y[5000] = { 0U };
+  y[4095] = 65536U;
+  point_batch_t batch = { x, y, 5000U };
+  CLOVE_NULL (point_compact_create (&batch, 1U));
+
+  /* Only the span within a block is limited, not the distance between blocks */
+  y[4095] = 65535U;
+  for (size_t i = 4096U; i < 5000U; ++i)
+    {
+      y[i] = 1000000U + (uint32_t)i;
+    }
+  point_compact_t *compact = point_compact_create (&batch, 1U);
+  CLOVE_NOT_NULL (compact);
+  (void)point_compact_destroy (compact);
+}
+
+CLOVE_TEST (point_compact_destroy)
+{
+  CLOVE_IS_FALSE (point_compact_destroy (NULL));
+}
+
+CLOVE_TEST (point_compact_get_count)
+{
+  CLOVE_ULLONG_EQ (0U, point_compact_get_count (NULL));
+}
+
+CLOVE_TEST (point_compact_get)
+{
+  uint32_t x[3] = { 7U, 9U, 8U };
+  uint32_t y[3] = { 100U, 90U, 95U };
+  point_batch_t batch = { x, y, 3U };
+  point_compact_t *compact = point_compact_create (&batch, 1U);
+  point_value_t value = { 0U, 0U };
+
+  CLOVE_IS_TRUE (point_compact_get (compact, 1U, &value));
+  CLOVE_UINT_EQ (9U, value.x);
+  CLOVE_UINT_EQ (90U, value.y);
+  CLOVE_IS_FALSE (point_compact_get (compact, 3U, &value));
+  CLOVE_IS_FALSE (point_compact_get (compact, 0U, NULL));
+  CLOVE_IS_FALSE (point_compact_get (NULL, 0U, &value));
+  (void)point_compact_destroy (compact);
+}
+
+CLOVE_TEST (point_compact_export)
+{
+  uint32_t x[TILED_POINTS];
+  uint32_t y[TILED_POINTS];
+  uint32_t output_x[TILED_POINTS];
+  uint32_t output_y[TILED_POINTS];
+  tiles_fill (x, y, TILED_POINTS, 11U);
+  point_batch_t batch = { x, y, TILED_POINTS };
+  point_batch_t output = { output_x, output_y, TILED_POINTS };
+  point_compact_t *compact = point_compact_create (&batch, 1U);
+
+  CLOVE_IS_TRUE (point_compact_export (compact, &output, 4U));
+  bool is_equal = true;
+  for (size_t i = 0; i < TILED_POINTS; ++i)
+    {
+      is_equal = is_equal && (output_x[i] == x[i]) && (output_y[i] == y[i]);
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  output.count = TILED_POINTS - 1U;
+  CLOVE_IS_FALSE (point_compact_export (compact, &output, 1U));
+  CLOVE_IS_FALSE (point_compact_export (compact, NULL, 1U));
+  CLOVE_IS_FALSE (point_compact_export (NULL, &output, 1U));
+  (void)point_compact_destroy (compact);
+}
+
+CLOVE_TEST (point_compact_bbox_compute)
+{
+  uint32_t x[TILED_POINTS];
+  uint32_t y[TILED_POINTS];
+  tiles_fill (x, y, TILED_POINTS, 13U);
+  point_batch_t batch = { x, y, TILED_POINTS };
+  point_compact_t *compact = point_compact_create (&batch, 1U);
+  point_bbox_t expected = { 0U, 0U, 0U, 0U };
+  point_bbox_t bbox = { 0U, 0U, 0U, 0U };
+
+  CLOVE_IS_TRUE (point_batch_bbox_compute (&batch, &expected, 1U));
+  CLOVE_IS_TRUE (point_compact_bbox_compute (compact, &bbox));
+  CLOVE_UINT_EQ (expected.min_x, bbox.min_x);
+  CLOVE_UINT_EQ (expected.min_y, bbox.min_y);
+  CLOVE_UINT_EQ (expected.max_x, bbox.max_x);
+  CLOVE_UINT_EQ (expected.max_y, bbox.max_y);
+  CLOVE_IS_FALSE (point_compact_bbox_compute (compact, NULL));
+  (void)point_compact_destroy (compact);
+
+  point_batch_t empty = { x, y, 0U };
+  compact = point_compact_create (&empty, 1U);
+  CLOVE_IS_FALSE (point_compact_bbox_compute (compact, &bbox));
+  (void)point_compact_destroy (compact);
+}
+
+CLOVE_TEST (point_compact_query_range)
+{
+  uint32_t x[TILED_POINTS];
+  uint32_t y[TILED_POINTS];
+  uint32_t ids[TILED_POINTS];
+  tiles_fill (x, y, TILED_POINTS, 17U);
+  point_batch_t batch = { x, y, TILED_POINTS };
+  point_compact_t *compact = point_compact_create (&batch, 1U);
+
+  /* Ranges cutting through one tile, covering one tile whole, and straddling the last tiles */
+  const point_bbox_t ranges[3] = { { 10000U, UINT32_MAX - UINT16_MAX + 20000U, 30000U, UINT32_MAX - 30000U },
+                                   { 1000000U, 0U, 1000000U + UINT16_MAX, UINT32_MAX },
+                                   { 1000000U + 40000U, 0U, UINT32_MAX, UINT32_MAX - 60000U } };
+  bool is_equal = true;
+  for (size_t r = 0; r < 3U; ++r)
+    {
+      const point_bbox_t *range = &ranges[r];
+      size_t found = point_compact_query_range (compact, range, ids, TILED_POINTS);
+      size_t expected = 0;
+      for (size_t i = 0; i < TILED_POINTS; ++i)
+        {
+          if ((x[i] >= range->min_x) && (x[i] <= range->max_x) && (y[i] >= range->min_y) && (y[i] <= range->max_y))
+            {
+              is_equal = is_equal && (expected < found) && (ids[expected] == i);
+              ++expected;
+            }
+        }
+      is_equal = is_equal && (expected == found) && (found > 0U);
+
+      /* A buffer too small receives the first indices, and the total is still counted */
+      uint32_t first[2] = { UINT32_MAX, UINT32_MAX };
+      is_equal = is_equal && (point_compact_query_range (compact, range, first, 1U) == found) && (first[0] == ids[0]) && (first[1] == UINT32_MAX);
+      is_equal = is_equal && (point_compact_query_range (compact, range, NULL, 0U) == found);
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  CLOVE_ULLONG_EQ (0U, point_compact_query_range (compact, NULL, ids, TILED_POINTS));
+  CLOVE_ULLONG_EQ (0U, point_compact_query_range (compact, &ranges[0], NULL, TILED_POINTS));
+  (void)point_compact_destroy (compact);
+}
+
+CLOVE_TEST (point_compact_create__on_null)
+{
+  uint32_t x[1] = { 0U };
+  point_batch_t batch = { NULL, x, 1U };
+
+  CLOVE_NULL (point_compact_create (NULL, 1U));
+  CLOVE_NULL (point_compact_create (&batch, 1U));
+}
@@ -0,0 +1,203 @@
+#define CLOVE_SUITE_NAME dbscan
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * Tests whether two points are within a radius with a plain formula, as the reference.
+ */
+static bool
+reference_is_within (uint32_t ax, uint32_t ay, uint32_t bx, uint32_t by, uint32_t epsilon)
+{
+  uint64_t dx = (ax > bx) ? (uint64_t)(ax - bx) : (uint64_t)(bx - ax);
+  uint64_t dy = (ay > by) ? (uint64_t)(ay - by) : (uint64_t)(by - ay);
+  return ((dx * dx) + (dy * dy)) <= ((uint64_t)epsilon * epsilon);
+}
+
+/**
+ * Finds the root of a set of a plain union-find with path halving, as the reference.
+ */
+static uint32_t
+reference_find (uint32_t *parents, uint32_t index)
+{
+  uint32_t result = index;
+  while (parents[result] != result)
+    {
+      parents[result] = parents[parents[result]];
+      result = parents[result];
+    }
+
+  return result;
+}
+
+/**
+ * Fills a batch with points around a few blob centers, and a tenth of scattered noise.
+ */
+static void
+blobs_fill (uint32_t *x, uint32_t *y, size_t count, uint32_t seed)
+{
+  uint32_t state = seed;
+  for (size_t i = 0; i < count; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      uint32_t blob = (state >> 16U) % 8U;
+      bool is_noise = ((state >> 8U) % 10U) == 0U;
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = is_noise ? (state >> 18U) : (1000U + ((blob % 4U) * 3000U) + ((state >> 22U) % 700U));
+      state = (state * 1664525U) + 1013904223U;
+      y[i] = is_noise ? (state >> 18U) : (1000U + ((blob / 4U) * 3000U) + ((state >> 22U) % 700U));
+    }
+}
+
+CLOVE_TEST (point_dbscan_compute)
+{
+  /* Two groups of three points, a lone point, and a point bordering the first group */
+  point_t *points[9] = { point_create (0U, 0U),  point_create (3U, 0U),     point_create (0U, 4U),  NULL,
+                         point_create (100U, 100U), point_create (101U, 101U), point_create (99U, 100U), point_create (50U, 50U),
+                         point_create (8U, 0U) };
+  uint32_t labels[9] = { 0U };
+  size_t cluster_count = 0;
+
+  CLOVE_IS_TRUE (point_dbscan_compute (points, 9U, 5U, 3U, labels, &cluster_count, 1U));
+  CLOVE_ULLONG_EQ (2U, cluster_count);
+  CLOVE_UINT_EQ (0U, labels[0]);
+  CLOVE_UINT_EQ (0U, labels[1]);
+  CLOVE_UINT_EQ (0U, labels[2]);
+  CLOVE_UINT_EQ (UINT32_MAX, labels[3]);
+  CLOVE_UINT_EQ (1U, labels[4]);
+  CLOVE_UINT_EQ (1U, labels[5]);
+  CLOVE_UINT_EQ (1U, labels[6]);
+  CLOVE_UINT_EQ (UINT32_MAX, labels[7]);
+  CLOVE_UINT_EQ (0U, labels[8]);
+
+  CLOVE_IS_FALSE (point_dbscan_compute (points, 9U, 5U, 0U, labels, NULL, 1U));
+  CLOVE_IS_FALSE (point_dbscan_compute (points, 9U, 5U, 3U, NULL, NULL, 1U));
+  CLOVE_IS_FALSE (point_dbscan_compute (NULL, 9U, 5U, 3U, labels, NULL, 1U));
+
+  for (size_t i = 0; i < 9U; ++i)
+    {
+      (void)point_destroy (points[i]);
+    }
+}
+
+CLOVE_TEST (point_dbscan_compute__duplicates)
+{
+  /* With a radius of 0, only identical points are neighbors */
+  point_t *points[4] = { point_create (7U, 7U), point_create (8U, 7U), point_create (7U, 7U), point_create (UINT32_MAX, UINT32_MAX) };
+  uint32_t labels[4] = { 0U };
+  size_t cluster_count = 0;
+
+  CLOVE_IS_TRUE (point_dbscan_compute (points, 4U, 0U, 2U, labels, &cluster_count, 1U));
+  CLOVE_ULLONG_EQ (1U, cluster_count);
+  CLOVE_UINT_EQ (0U, labels[0]);
+  CLOVE_UINT_EQ (UINT32_MAX, labels[1]);
+  CLOVE_UINT_EQ (0U, labels[2]);
+  CLOVE_UINT_EQ (UINT32_MAX, labels[3]);
+
+  for (size_t i = 0; i < 4U; ++i)
+    {
+      (void)point_destroy (points[i]);
+    }
+}
+
+CLOVE_TEST (point_batch_dbscan_compute)
+{
+  /* Two slices of the minimum parallel chunk, few enough for a quadratic reference */
+  size_t count = 8192U;
+  uint32_t epsilon = 40U;
+  uint32_t min_points = 6U;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  uint32_t *labels = malloc (count * sizeof (uint32_t));
+  uint32_t *serial = malloc (count * sizeof (uint32_t));
+  bool *is_core = calloc (count, sizeof (bool));
+  uint32_t *parents = malloc (count * sizeof (uint32_t));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+  CLOVE_NOT_NULL (labels);
+  CLOVE_NOT_NULL (serial);
+  CLOVE_NOT_NULL (is_core);
+  CLOVE_NOT_NULL (parents);
+
+  blobs_fill (x, y, count, 17U);
+  point_batch_t batch = { x, y, count };
+  size_t cluster_count = 0;
+  size_t serial_count = 0;
+  CLOVE_IS_TRUE (point_batch_dbscan_compute (&batch, epsilon, min_points, labels, &cluster_count, 4U));
+  CLOVE_IS_TRUE (point_batch_dbscan_compute (&batch, epsilon, min_points, serial, &serial_count, 1U));
+  CLOVE_ULLONG_EQ (serial_count, cluster_count);
+  CLOVE_IS_TRUE (cluster_count > 1U);
+
+  bool is_equal = true;
+  for (size_t i = 0; i < count; ++i)
+    {
+      size_t neighbors = 0;
+      for (size_t j = 0; j < count; ++j)
+        {
+          neighbors += reference_is_within (x[i], y[i], x[j], y[j], epsilon) ? 1U : 0U;
+        }
+      is_core[i] = (neighbors >= min_points);
+      is_equal = is_equal && (labels[i] == serial[i]);
+    }
+
+  /* Core points within epsilon share a cluster, and there are as many clusters as linked groups of them */
+  size_t components = 0;
+  for (size_t i = 0; i < count; ++i)
+    {
+      parents[i] = (uint32_t)i;
+    }
+  for (size_t i = 0; i < count; ++i)
+    {
+      for (size_t j = 0; is_core[i] && (j < i); ++j)
+        {
+          bool is_linked = is_core[j] && reference_is_within (x[i], y[i], x[j], y[j], epsilon);
+          is_equal = is_equal && (!is_linked || (labels[i] == labels[j]));
+          if (is_linked)
+            {
+              parents[reference_find (parents, (uint32_t)i)] = reference_find (parents, (uint32_t)j);
+            }
+        }
+      is_equal = is_equal && (!is_core[i] || (labels[i] < cluster_count));
+    }
+  for (size_t i = 0; i < count; ++i)
+    {
+      components += (is_core[i] && (parents[i] == i)) ? 1U : 0U;
+    }
+  CLOVE_ULLONG_EQ (components, cluster_count);
+
+  /* Other points border a core point of their cluster, or have no core point within epsilon */
+  for (size_t i = 0; i < count; ++i)
+    {
+      bool has_core = false;
+      bool has_cluster_core = false;
+      for (size_t j = 0; !is_core[i] && (j < count); ++j)
+        {
+          bool is_linked = is_core[j] && reference_is_within (x[i], y[i], x[j], y[j], epsilon);
+          has_core = has_core || is_linked;
+          has_cluster_core = has_cluster_core || (is_linked && (labels[j] == labels[i]));
+        }
+      is_equal = is_equal && (is_core[i] || (has_core ? has_cluster_core : (labels[i] == UINT32_MAX)));
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  free (x);
+  free (y);
+  free (labels);
+  free (serial);
+  free (is_core);
+  free (parents);
+}
+
+CLOVE_TEST (point_batch_dbscan_compute__on_null)
+{
+  uint32_t x[1] = { 0U };
+  uint32_t labels[1] = { 0U };
+  point_batch_t batch = { x, x, 1U };
+  point_batch_t empty = { x, x, 0U };
+  size_t cluster_count = 1U;
+
+  CLOVE_IS_FALSE (point_batch_dbscan_compute (NULL, 1U, 1U, labels, NULL, 1U));
+  CLOVE_IS_FALSE (point_batch_dbscan_compute (&batch, 1U, 1U, NULL, NULL, 1U));
+  CLOVE_IS_TRUE (point_batch_dbscan_compute (&empty, 1U, 1U, labels, &cluster_count, 1U));
+  CLOVE_ULLONG_EQ (0U, cluster_count);
+}
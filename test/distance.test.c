@@ -0,0 +1,178 @@
+#define CLOVE_SUITE_NAME distance
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * Computes a squared distance with a plain nested-loop formula, as the reference.
+ */
+static uint64_t
+reference_distance (uint32_t ax, uint32_t ay, uint32_t bx, uint32_t by)
+{
+  uint64_t dx = (ax > bx) ? (uint64_t)(ax - bx) : (uint64_t)(bx - ax);
+  uint64_t dy = (ay > by) ? (uint64_t)(ay - by) : (uint64_t)(by - ay);
+  return (dx * dx) + (dy * dy);
+}
+
+CLOVE_TEST (point_distance_matrix_compute)
+{
+  point_t *rows[2] = { point_create (0U, 0U), NULL };
+  point_t *columns[3] = { point_create (3U, 4U), NULL, point_create (1U, 1U) };
+  uint64_t matrix[6] = { 0 };
+
+  CLOVE_IS_TRUE (point_distance_matrix_compute (rows, 2U, columns, 3U, matrix, 1U));
+  CLOVE_ULLONG_EQ (25U, matrix[0]);
+  CLOVE_ULLONG_EQ (UINT64_MAX, matrix[1]);
+  CLOVE_ULLONG_EQ (2U, matrix[2]);
+  CLOVE_ULLONG_EQ (UINT64_MAX, matrix[3]);
+  CLOVE_ULLONG_EQ (UINT64_MAX, matrix[5]);
+
+  CLOVE_IS_FALSE (point_distance_matrix_compute (rows, 2U, NULL, 3U, matrix, 1U));
+  CLOVE_IS_FALSE (point_distance_matrix_compute (rows, 2U, columns, 3U, NULL, 1U));
+
+  (void)point_destroy (rows[0]);
+  (void)point_destroy (columns[0]);
+  (void)point_destroy (columns[2]);
+}
+
+CLOVE_TEST (point_batch_distance_matrix_compute)
+{
+  /* Enough rows and columns to span several tiles, row blocks and threads */
+  size_t row_count = 150U;
+  size_t column_count = 2500U;
+  uint32_t *coordinates = malloc ((row_count + column_count) * 2U * sizeof (uint32_t));
+  uint64_t *matrix = malloc (row_count * column_count * sizeof (uint64_t));
+  CLOVE_NOT_NULL (coordinates);
+  CLOVE_NOT_NULL (matrix);
+
+  uint32_t state = 7U;
+  for (size_t i = 0; i < ((row_count + column_count) * 2U); ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      coordinates[i] = state;
+    }
+
+  point_batch_t rows = { coordinates, &coordinates[row_count], row_count };
+  point_batch_t columns = { &coordinates[row_count * 2U], &coordinates[(row_count * 2U) + column_count], column_count };
+  CLOVE_IS_TRUE (point_batch_distance_matrix_compute (&rows, &columns, matrix, 4U));
+
+  bool is_equal = true;
+  for (size_t i = 0; i < row_count; ++i)
+    {
+      for (size_t j = 0; j < column_count; ++j)
+        {
+          uint64_t expected = reference_distance (rows.x[i], rows.y[i], columns.x[j], columns.y[j]);
+          uint64_t square_x = reference_distance (rows.x[i], 0U, columns.x[j], 0U);
+          expected = (expected < square_x) ? UINT64_MAX : expected;
+          is_equal = is_equal && (matrix[(i * column_count) + j] == expected);
+        }
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  free (coordinates);
+  free (matrix);
+}
+
+CLOVE_TEST (point_batch_distance_matrix_compute__saturated)
+{
+  uint32_t row_x[1] = { 0U };
+  uint32_t row_y[1] = { 0U };
+  uint32_t column_x[2] = { UINT32_MAX, UINT32_MAX };
+  uint32_t column_y[2] = { UINT32_MAX, 0U };
+  point_batch_t rows = { row_x, row_y, 1U };
+  point_batch_t columns = { column_x, column_y, 2U };
+  uint64_t matrix[2] = { 0 };
+
+  CLOVE_IS_TRUE (point_batch_distance_matrix_compute (&rows, &columns, matrix, 1U));
+  CLOVE_ULLONG_EQ (UINT64_MAX, matrix[0]);
+  CLOVE_ULLONG_EQ (18446744065119617025U, matrix[1]);
+}
+
+CLOVE_TEST (point_distance_top_k_compute)
+{
+  point_t *rows[2] = { point_create (10U, 10U), NULL };
+  point_t *columns[4] = { point_create (20U, 10U), point_create (11U, 10U), NULL, point_create (10U, 9U) };
+  uint32_t indices[6] = { 0 };
+  uint64_t distances[6] = { 0 };
+
+  CLOVE_IS_TRUE (point_distance_top_k_compute (rows, 2U, columns, 4U, 3U, indices, distances, 1U));
+  CLOVE_UINT_EQ (1U, indices[0]);
+  CLOVE_UINT_EQ (3U, indices[1]);
+  CLOVE_UINT_EQ (0U, indices[2]);
+  CLOVE_ULLONG_EQ (1U, distances[0]);
+  CLOVE_ULLONG_EQ (1U, distances[1]);
+  CLOVE_ULLONG_EQ (100U, distances[2]);
+  CLOVE_UINT_EQ (UINT32_MAX, indices[3]);
+  CLOVE_ULLONG_EQ (UINT64_MAX, distances[5]);
+
+  CLOVE_IS_FALSE (point_distance_top_k_compute (rows, 2U, columns, 4U, 0U, indices, distances, 1U));
+  CLOVE_IS_FALSE (point_distance_top_k_compute (rows, 2U, columns, 4U, 3U, NULL, distances, 1U));
+
+  (void)point_destroy (rows[0]);
+  (void)point_destroy (columns[0]);
+  (void)point_destroy (columns[1]);
+  (void)point_destroy (columns[3]);
+}
+
+CLOVE_TEST (point_batch_distance_top_k_compute)
+{
+  size_t row_count = 300U;
+  size_t column_count = 3000U;
+  uint32_t k = 5U;
+  uint32_t *coordinates = malloc ((row_count + column_count) * 2U * sizeof (uint32_t));
+  uint32_t *indices = malloc (row_count * k * sizeof (uint32_t));
+  CLOVE_NOT_NULL (coordinates);
+  CLOVE_NOT_NULL (indices);
+
+  /* Small coordinates produce many ties, which are broken by the column index */
+  uint32_t state = 3U;
+  for (size_t i = 0; i < ((row_count + column_count) * 2U); ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      coordinates[i] = state >> 24U;
+    }
+
+  point_batch_t rows = { coordinates, &coordinates[row_count], row_count };
+  point_batch_t columns = { &coordinates[row_count * 2U], &coordinates[(row_count * 2U) + column_count], column_count };
+  CLOVE_IS_TRUE (point_batch_distance_top_k_compute (&rows, &columns, k, indices, NULL, 4U));
+
+  bool is_equal = true;
+  for (size_t i = 0; i < row_count; ++i)
+    {
+      /* Every pick must be the closest column not picked before, the lowest index first */
+      uint64_t previous = 0U;
+      uint32_t previous_index = 0U;
+      for (uint32_t n = 0; n < k; ++n)
+        {
+          uint32_t expected = UINT32_MAX;
+          uint64_t best = UINT64_MAX;
+          for (uint32_t j = 0; j < column_count; ++j)
+            {
+              uint64_t d = reference_distance (rows.x[i], rows.y[i], columns.x[j], columns.y[j]);
+              bool is_after = (n == 0U) || (d > previous) || ((d == previous) && (j > previous_index));
+              if (is_after && ((d < best) || (expected == UINT32_MAX)))
+                {
+                  best = d;
+                  expected = j;
+                }
+            }
+          is_equal = is_equal && (indices[(i * k) + n] == expected);
+          previous = best;
+          previous_index = expected;
+        }
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  free (coordinates);
+  free (indices);
+}
+
+CLOVE_TEST (point_batch_distance_top_k_compute__on_null)
+{
+  uint32_t x[1] = { 0U };
+  uint32_t indices[1] = { 0U };
+  point_batch_t batch = { x, x, 1U };
+  CLOVE_IS_FALSE (point_batch_distance_top_k_compute (NULL, &batch, 1U, indices, NULL, 1U));
+  CLOVE_IS_FALSE (point_batch_distance_top_k_compute (&batch, &batch, 0U, indices, NULL, 1U));
+  CLOVE_IS_FALSE (point_batch_distance_matrix_compute (&batch, NULL, NULL, 1U));
+}
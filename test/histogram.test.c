@@ -0,0 +1,106 @@
+#define CLOVE_SUITE_NAME histogram
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+CLOVE_TEST (point_histogram_compute)
+{
+  point_t *points[5] = { point_create (100U, 100U), point_create (115U, 105U), point_create (119U, 119U), NULL, point_create (99U, 110U) };
+  point_grid_t grid = { 100U, 100U, 10U, 10U, 2U, 2U };
+  uint32_t cells[4] = { 0 };
+
+  CLOVE_IS_TRUE (point_histogram_compute (points, 5U, &grid, cells, 1U));
+  CLOVE_UINT_EQ (1U, cells[0]);
+  CLOVE_UINT_EQ (1U, cells[1]);
+  CLOVE_UINT_EQ (0U, cells[2]);
+  CLOVE_UINT_EQ (1U, cells[3]);
+
+  for (uint32_t i = 0; i < 5U; ++i)
+    {
+      (void)point_destroy (points[i]);
+    }
+}
+
+CLOVE_TEST (point_histogram_compute__on_null)
+{
+  point_grid_t grid = { 0U, 0U, 1U, 1U, 1U, 1U };
+  uint32_t cells[1] = { 0 };
+
+  CLOVE_IS_FALSE (point_histogram_compute (NULL, 1U, &grid, cells, 1U));
+}
+
+CLOVE_TEST (point_batch_histogram_compute)
+{
+  uint32_t x[6] = { 0U, 2U, 3U, 5U, 6U, 9U };
+  uint32_t y[6] = { 0U, 4U, 3U, 1U, 5U, 0U };
+  point_batch_t batch = { x, y, 6U };
+  point_grid_t grid = { 0U, 0U, 3U, 3U, 3U, 2U };
+  uint32_t cells[6] = { 0 };
+
+  CLOVE_IS_TRUE (point_batch_histogram_compute (&batch, &grid, cells, 1U));
+  CLOVE_IS_TRUE (point_batch_histogram_compute (&batch, &grid, cells, 1U));
+  CLOVE_UINT_EQ (2U, cells[0]);
+  CLOVE_UINT_EQ (2U, cells[1]);
+  CLOVE_UINT_EQ (0U, cells[2]);
+  CLOVE_UINT_EQ (2U, cells[3]);
+  CLOVE_UINT_EQ (2U, cells[4]);
+  CLOVE_UINT_EQ (2U, cells[5]);
+}
+
+CLOVE_TEST (point_batch_histogram_compute__parallel)
+{
+  const size_t count = 500000U;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  uint32_t *serial = calloc (7U * 5U, sizeof (uint32_t));
+  uint32_t *parallel = calloc (7U * 5U, sizeof (uint32_t));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+  CLOVE_NOT_NULL (serial);
+  CLOVE_NOT_NULL (parallel);
+
+  uint32_t state = 99U;
+  for (size_t i = 0; i < count; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = state % 1000U;
+      state = (state * 1664525U) + 1013904223U;
+      y[i] = state % 1000U;
+    }
+
+  point_batch_t batch = { x, y, count };
+  point_grid_t grid = { 50U, 100U, 123U, 157U, 7U, 5U };
+
+  CLOVE_IS_TRUE (point_batch_histogram_compute (&batch, &grid, serial, 1U));
+  CLOVE_IS_TRUE (point_batch_histogram_compute (&batch, &grid, parallel, 4U));
+
+  uint32_t expected = 0U;
+  for (size_t i = 0; i < count; ++i)
+    {
+      expected += ((x[i] >= 50U) && (x[i] < (50U + (123U * 7U))) && (y[i] >= 100U) && (y[i] < (100U + (157U * 5U)))) ? 1U : 0U;
+    }
+
+  uint32_t total = 0U;
+  for (uint32_t i = 0; i < (7U * 5U); ++i)
+    {
+      CLOVE_UINT_EQ (serial[i], parallel[i]);
+      total += parallel[i];
+    }
+  CLOVE_UINT_EQ (expected, total);
+
+  free (x);
+  free (y);
+  free (serial);
+  free (parallel);
+}
+
+CLOVE_TEST (point_batch_histogram_compute__on_invalid_grid)
+{
+  uint32_t x[1] = { 0U };
+  uint32_t y[1] = { 0U };
+  point_batch_t batch = { x, y, 1U };
+  point_grid_t grid = { 0U, 0U, 0U, 1U, 1U, 1U };
+  uint32_t cells[1] = { 0 };
+
+  CLOVE_IS_FALSE (point_batch_histogram_compute (&batch, &grid, cells, 1U));
+}
@@ -0,0 +1,102 @@
+#define CLOVE_SUITE_NAME hull
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+CLOVE_TEST (point_hull_compute)
+{
+  point_t *points[6] = { point_create (5U, 5U),  point_create (10U, 10U), point_create (0U, 0U),
+                         point_create (0U, 10U), point_create (5U, 0U),   point_create (10U, 0U) };
+  uint32_t indices[6] = { 0 };
+
+  CLOVE_UINT_EQ (4U, point_hull_compute (points, 6U, indices, 1U));
+  CLOVE_UINT_EQ (2U, indices[0]);
+  CLOVE_UINT_EQ (5U, indices[1]);
+  CLOVE_UINT_EQ (1U, indices[2]);
+  CLOVE_UINT_EQ (3U, indices[3]);
+
+  for (uint32_t i = 0; i < 6U; ++i)
+    {
+      (void)point_destroy (points[i]);
+    }
+}
+
+CLOVE_TEST (point_hull_compute__on_null)
+{
+  uint32_t indices[1] = { 0 };
+  CLOVE_UINT_EQ (0U, point_hull_compute (NULL, 1U, indices, 1U));
+}
+
+CLOVE_TEST (point_batch_hull_compute)
+{
+  uint32_t x[5] = { 2U, 4U, 2U, 0U, 2U };
+  uint32_t y[5] = { 0U, 2U, 4U, 2U, 2U };
+  point_batch_t batch = { x, y, 5U };
+  uint32_t indices[5] = { 0 };
+
+  CLOVE_UINT_EQ (4U, point_batch_hull_compute (&batch, indices, 1U));
+  CLOVE_UINT_EQ (3U, indices[0]);
+  CLOVE_UINT_EQ (0U, indices[1]);
+  CLOVE_UINT_EQ (1U, indices[2]);
+  CLOVE_UINT_EQ (2U, indices[3]);
+}
+
+CLOVE_TEST (point_batch_hull_compute__collinear)
+{
+  uint32_t x[4] = { 3U, 1U, 2U, 1U };
+  uint32_t y[4] = { 3U, 1U, 2U, 1U };
+  point_batch_t batch = { x, y, 4U };
+  uint32_t indices[4] = { 0 };
+
+  CLOVE_UINT_EQ (2U, point_batch_hull_compute (&batch, indices, 1U));
+  CLOVE_UINT_EQ (1U, indices[0]);
+  CLOVE_UINT_EQ (0U, indices[1]);
+}
+
+CLOVE_TEST (point_batch_hull_compute__extreme_coordinates)
+{
+  uint32_t x[5] = { 0U, UINT32_MAX, UINT32_MAX, 0U, UINT32_MAX / 2U };
+  uint32_t y[5] = { 0U, 0U, UINT32_MAX, UINT32_MAX, UINT32_MAX - 1U };
+  point_batch_t batch = { x, y, 5U };
+  uint32_t indices[5] = { 0 };
+
+  CLOVE_UINT_EQ (4U, point_batch_hull_compute (&batch, indices, 1U));
+}
+
+CLOVE_TEST (point_batch_hull_compute__parallel)
+{
+  const size_t count = 400009U;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  uint32_t *serial = malloc (count * sizeof (uint32_t));
+  uint32_t *parallel = malloc (count * sizeof (uint32_t));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+  CLOVE_NOT_NULL (serial);
+  CLOVE_NOT_NULL (parallel);
+
+  uint32_t state = 777U;
+  for (size_t i = 0; i < count; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = state % 1000000U;
+      state = (state * 1664525U) + 1013904223U;
+      y[i] = state % 1000000U;
+    }
+
+  point_batch_t batch = { x, y, count };
+  size_t serial_count = point_batch_hull_compute (&batch, serial, 1U);
+  size_t parallel_count = point_batch_hull_compute (&batch, parallel, 4U);
+
+  CLOVE_IS_TRUE (serial_count >= 3U);
+  CLOVE_UINT_EQ (serial_count, parallel_count);
+  for (size_t i = 0; i < serial_count; ++i)
+    {
+      CLOVE_UINT_EQ (serial[i], parallel[i]);
+    }
+
+  free (x);
+  free (y);
+  free (serial);
+  free (parallel);
+}
@@ -0,0 +1,166 @@
+#define CLOVE_SUITE_NAME join
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+/**
+ * Matches collected by the test callback, as left index above right index.
+ */
+typedef struct
+{
+  uint64_t *pairs;
+  size_t count;
+  size_t capacity;
+  size_t blocks;
+  bool is_stopping;
+} collector_t;
+
+/**
+ * Appends a block of matches to a collector, growing it as needed.
+ */
+static bool
+collector_add (void *context, const uint32_t *left, const uint32_t *right, size_t count)
+{
+  collector_t *collector = context;
+  if ((collector->count + count) > collector->capacity)
+    {
+      size_t capacity = (collector->capacity * 2U) + count;
+      uint64_t *pairs = realloc (collector->pairs, capacity * sizeof (uint64_t));
+      collector->pairs = (pairs != NULL) ? pairs : collector->pairs;
+      collector->capacity = (pairs != NULL) ? capacity : collector->capacity;
+    }
+  for (size_t i = 0; (i < count) && (collector->count < collector->capacity); ++i)
+    {
+      collector->pairs[collector->count++] = ((uint64_t)left[i] << 32U) | right[i];
+    }
+  ++collector->blocks;
+
+  return !collector->is_stopping;
+}
+
+/**
+ * Orders pairs for qsort.
+ */
+static int
+pair_compare (const void *a, const void *b)
+{
+  uint64_t pair_a = *(const uint64_t *)a;
+  uint64_t pair_b = *(const uint64_t *)b;
+  return (pair_a > pair_b) - (pair_a < pair_b);
+}
+
+CLOVE_TEST (point_join_compute)
+{
+  point_t *left[3] = { point_create (10U, 10U), NULL, point_create (100U, 100U) };
+  point_t *right[4] = { point_create (13U, 14U), point_create (14U, 14U), point_create (100U, 100U), point_create (10U, 10U) };
+  collector_t collector = { 0 };
+
+  CLOVE_IS_TRUE (point_join_compute (left, 3U, right, 4U, 5U, collector_add, &collector, 1U));
+  qsort (collector.pairs, collector.count, sizeof (uint64_t), pair_compare);
+  CLOVE_ULLONG_EQ (3U, collector.count);
+  CLOVE_ULLONG_EQ (((uint64_t)0U << 32U) | 0U, collector.pairs[0]);
+  CLOVE_ULLONG_EQ (((uint64_t)0U << 32U) | 3U, collector.pairs[1]);
+  CLOVE_ULLONG_EQ (((uint64_t)2U << 32U) | 2U, collector.pairs[2]);
+
+  CLOVE_IS_FALSE (point_join_compute (left, 3U, NULL, 4U, 5U, collector_add, &collector, 1U));
+  CLOVE_IS_FALSE (point_join_compute (left, 3U, right, 4U, 5U, NULL, &collector, 1U));
+
+  (void)point_destroy (left[0]);
+  (void)point_destroy (left[2]);
+  for (size_t i = 0; i < 4U; ++i)
+    {
+      (void)point_destroy (right[i]);
+    }
+  free (collector.pairs);
+}
+
+CLOVE_TEST (point_join_compute__stopped)
+{
+  /* Every left point matches every right point, which needs several blocks */
+  size_t count = 100U;
+  point_t *left[100];
+  point_t *right[100];
+  for (size_t i = 0; i < count; ++i)
+    {
+      left[i] = point_create ((uint32_t)i, 0U);
+      right[i] = point_create (0U, (uint32_t)i);
+    }
+  collector_t collector = { .is_stopping = true };
+
+  CLOVE_IS_TRUE (point_join_compute (left, count, right, count, 200U, collector_add, &collector, 1U));
+  CLOVE_ULLONG_EQ (1U, collector.blocks);
+  CLOVE_IS_TRUE (collector.count < (count * count));
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      (void)point_destroy (left[i]);
+      (void)point_destroy (right[i]);
+    }
+  free (collector.pairs);
+}
+
+CLOVE_TEST (point_batch_join_compute)
+{
+  /* Enough left points to split across workers, few enough for a quadratic reference */
+  size_t left_count = 9000U;
+  size_t right_count = 7000U;
+  uint32_t distance = 300U;
+  uint32_t *coordinates = malloc ((left_count + right_count) * 2U * sizeof (uint32_t));
+  uint64_t *expected = malloc (left_count * 64U * sizeof (uint64_t));
+  CLOVE_NOT_NULL (coordinates);
+  CLOVE_NOT_NULL (expected);
+
+  uint32_t state = 3U;
+  for (size_t i = 0; i < ((left_count + right_count) * 2U); ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      coordinates[i] = state >> 16U;
+    }
+
+  point_batch_t left = { coordinates, &coordinates[left_count], left_count };
+  point_batch_t right = { &coordinates[left_count * 2U], &coordinates[(left_count * 2U) + right_count], right_count };
+  collector_t collector = { 0 };
+  CLOVE_IS_TRUE (point_batch_join_compute (&left, &right, distance, collector_add, &collector, 4U));
+
+  size_t expected_count = 0;
+  for (size_t i = 0; i < left_count; ++i)
+    {
+      for (size_t j = 0; j < right_count; ++j)
+        {
+          int64_t dx = (int64_t)left.x[i] - right.x[j];
+          int64_t dy = (int64_t)left.y[i] - right.y[j];
+          if ((((dx * dx) + (dy * dy)) <= ((int64_t)distance * distance)) && (expected_count < (left_count * 64U)))
+            {
+              expected[expected_count++] = ((uint64_t)i << 32U) | j;
+            }
+        }
+    }
+  qsort (collector.pairs, collector.count, sizeof (uint64_t), pair_compare);
+
+  bool is_equal = (collector.count == expected_count) && (expected_count > 0U);
+  for (size_t i = 0; is_equal && (i < expected_count); ++i)
+    {
+      is_equal = (collector.pairs[i] == expected[i]);
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  free (coordinates);
+  free (expected);
+  free (collector.pairs);
+}
+
+CLOVE_TEST (point_batch_join_compute__on_null)
+{
+  uint32_t x[1] = { 0U };
+  point_batch_t batch = { x, x, 1U };
+  point_batch_t empty = { x, x, 0U };
+  collector_t collector = { 0 };
+
+  CLOVE_IS_FALSE (point_batch_join_compute (NULL, &batch, 1U, collector_add, &collector, 1U));
+  CLOVE_IS_FALSE (point_batch_join_compute (&batch, &batch, 1U, NULL, &collector, 1U));
+  CLOVE_IS_TRUE (point_batch_join_compute (&empty, &batch, 1U, collector_add, &collector, 1U));
+  CLOVE_ULLONG_EQ (0U, collector.blocks);
+  CLOVE_IS_TRUE (point_batch_join_compute (&batch, &batch, 0U, collector_add, &collector, 1U));
+  CLOVE_ULLONG_EQ (1U, collector.count);
+  free (collector.pairs);
+}
@@ -0,0 +1,20 @@
+#define CLOVE_SUITE_NAME values
+#include "clove-unit.h"
+#include "library.h"
+
+CLOVE_TEST (point_value_make)
+{
+  point_value_t value = point_value_make (10U, 20U);
+  CLOVE_UINT_EQ (10U, value.x);
+  CLOVE_UINT_EQ (20U, value.y);
+}
+
+CLOVE_TEST (point_value_get_x)
+{
+  CLOVE_UINT_EQ (10U, point_value_get_x (point_value_make (10U, 20U)));
+}
+
+CLOVE_TEST (point_value_get_y)
+{
+  CLOVE_UINT_EQ (20U, point_value_get_y (point_value_make (10U, 20U)));
+}
@@ -34,3 +34,28 @@ CLOVE_TEST (point_get_y)
   CLOVE_UINT_EQ (20U, point_get_y (point));
   (void)point_destroy (point);
 }
+
+CLOVE_TEST (point_value_from_point)
+{
+  point_t *point = point_create (10U, 20U);
+  point_value_t value = point_value_from_point (point);
+  CLOVE_UINT_EQ (10U, value.x);
+  CLOVE_UINT_EQ (20U, value.y);
+  (void)point_destroy (point);
+}
+
+CLOVE_TEST (point_value_from_point__on_null)
+{
+  point_value_t value = point_value_from_point (NULL);
+  CLOVE_UINT_EQ (0U, value.x);
+  CLOVE_UINT_EQ (0U, value.y);
+}
+
+CLOVE_TEST (point_value_to_point)
+{
+  point_t *point = point_value_to_point (point_value_make (10U, 20U));
+  CLOVE_NOT_NULL (point);
+  CLOVE_UINT_EQ (10U, point_get_x (point));
+  CLOVE_UINT_EQ (20U, point_get_y (point));
+  (void)point_destroy (point);
+}
@@ -0,0 +1,281 @@
+#define CLOVE_SUITE_NAME polygon
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+/* An L-shaped polygon, concave at (10, 10). */
+static const point_value_t L_SHAPE[6] = { { 0U, 0U }, { 20U, 0U }, { 20U, 10U }, { 10U, 10U }, { 10U, 20U }, { 0U, 20U } };
+
+/**
+ * Tests a point against a ring with exact integer arithmetic, as the reference.
+ * Sets on_edge if the point lies on an edge, where the result may differ.
+ */
+static bool
+reference_contains (const point_value_t *vertices, size_t count, uint32_t px, uint32_t py, bool *on_edge)
+{
+  bool result = false;
+  *on_edge = false;
+  for (size_t i = 0; i < count; ++i)
+    {
+      const point_value_t *a = &vertices[i];
+      const point_value_t *b = &vertices[(i + 1U) % count];
+      int64_t cross = (((int64_t)b->x - a->x) * ((int64_t)py - a->y)) - (((int64_t)px - a->x) * ((int64_t)b->y - a->y));
+      bool is_within = (px >= ((a->x < b->x) ? a->x : b->x)) && (px <= ((a->x > b->x) ? a->x : b->x)) && (py >= ((a->y < b->y) ? a->y : b->y))
+                       && (py <= ((a->y > b->y) ? a->y : b->y));
+      *on_edge = *on_edge || ((cross == 0) && is_within);
+
+      if ((a->y > py) != (b->y > py))
+        {
+          /* The ray crosses if the point is left of the edge, oriented upwards */
+          result = (((b->y > a->y) ? cross : -cross) > 0) ? !result : result;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Fills a ring with a star-shaped polygon around (1000, 1000) whose vertices walk a
+ * square, alternating long and short pseudo-random radii.
+ */
+static void
+star_fill (point_value_t *vertices, size_t count, uint32_t seed)
+{
+  uint32_t state = seed;
+  for (size_t i = 0; i < count; ++i)
+    {
+      /* Walk the eight octants of a square ring, at a pseudo-random radius */
+      state = (state * 1664525U) + 1013904223U;
+      uint32_t radius = ((i % 2U) == 0U) ? (600U + (state >> 24U)) : (100U + (state >> 25U));
+      size_t side = (i * 8U) / count;
+      uint32_t step = (uint32_t)(((i * 8U) % count) * 2U * radius / count);
+      int64_t x = 0;
+      int64_t y = 0;
+      switch (side)
+        {
+        case 0:
+          x = radius;
+          y = step;
+          break;
+        case 1:
+          x = radius - step;
+          y = radius;
+          break;
+        case 2:
+          x = -(int64_t)step;
+          y = radius;
+          break;
+        case 3:
+          x = -(int64_t)radius;
+          y = radius - step;
+          break;
+        case 4:
+          x = -(int64_t)radius;
+          y = -(int64_t)step;
+          break;
+        case 5:
+          x = -(int64_t)radius + step;
+          y = -(int64_t)radius;
+          break;
+        case 6:
+          x = step;
+          y = -(int64_t)radius;
+          break;
+        default:
+          x = radius;
+          y = -(int64_t)radius + step;
+          break;
+        }
+      vertices[i] = (point_value_t){ (uint32_t)(x + 1000), (uint32_t)(y + 1000) };
+    }
+}
+
+CLOVE_TEST (point_polygon_create)
+{
+  point_polygon_t *polygon = point_polygon_create (L_SHAPE, 6U);
+  CLOVE_NOT_NULL (polygon);
+  CLOVE_NULL (point_polygon_create (L_SHAPE, 2U));
+  CLOVE_NULL (point_polygon_create (NULL, 6U));
+  (void)point_polygon_destroy (polygon);
+}
+
+CLOVE_TEST (point_polygon_destroy)
+{
+  CLOVE_IS_TRUE (point_polygon_destroy (point_polygon_create (L_SHAPE, 6U)));
+}
+
+CLOVE_TEST (point_polygon_destroy__on_null)
+{
+  CLOVE_IS_FALSE (point_polygon_destroy (NULL));
+}
+
+CLOVE_TEST (point_polygon_contains)
+{
+  point_polygon_t *polygon = point_polygon_create (L_SHAPE, 6U);
+  CLOVE_IS_TRUE (point_polygon_contains (polygon, 5U, 5U));
+  CLOVE_IS_TRUE (point_polygon_contains (polygon, 15U, 5U));
+  CLOVE_IS_TRUE (point_polygon_contains (polygon, 5U, 15U));
+  CLOVE_IS_FALSE (point_polygon_contains (polygon, 15U, 15U));
+  CLOVE_IS_FALSE (point_polygon_contains (polygon, 25U, 5U));
+  CLOVE_IS_FALSE (point_polygon_contains (NULL, 5U, 5U));
+  (void)point_polygon_destroy (polygon);
+}
+
+CLOVE_TEST (point_polygon_contains__self_intersecting)
+{
+  /* A bow tie whose lobes meet at (10, 10) */
+  const point_value_t vertices[4] = { { 0U, 0U }, { 20U, 20U }, { 20U, 0U }, { 0U, 20U } };
+  point_polygon_t *polygon = point_polygon_create (vertices, 4U);
+  CLOVE_IS_TRUE (point_polygon_contains (polygon, 17U, 10U));
+  CLOVE_IS_TRUE (point_polygon_contains (polygon, 3U, 10U));
+  CLOVE_IS_FALSE (point_polygon_contains (polygon, 10U, 3U));
+  (void)point_polygon_destroy (polygon);
+}
+
+CLOVE_TEST (point_polygon_test)
+{
+  point_polygon_t *polygon = point_polygon_create (L_SHAPE, 6U);
+  point_t *points[4] = { point_create (5U, 5U), NULL, point_create (15U, 15U), point_create (5U, 15U) };
+  uint64_t bitmap[1] = { UINT64_MAX };
+
+  CLOVE_IS_TRUE (point_polygon_test (polygon, points, 4U, bitmap, 1U));
+  CLOVE_ULLONG_EQ (9U, bitmap[0]);
+  CLOVE_IS_FALSE (point_polygon_test (NULL, points, 4U, bitmap, 1U));
+  CLOVE_IS_FALSE (point_polygon_test (polygon, points, 4U, NULL, 1U));
+
+  (void)point_destroy (points[0]);
+  (void)point_destroy (points[2]);
+  (void)point_destroy (points[3]);
+  (void)point_polygon_destroy (polygon);
+}
+
+CLOVE_TEST (point_batch_polygon_test)
+{
+  size_t vertex_count = 200U;
+  size_t count = 100000U;
+  point_value_t *vertices = malloc (vertex_count * sizeof (point_value_t));
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  uint64_t *bitmap = malloc (((count + 63U) / 64U) * sizeof (uint64_t));
+  CLOVE_NOT_NULL (vertices);
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+  CLOVE_NOT_NULL (bitmap);
+
+  star_fill (vertices, vertex_count, 11U);
+  uint32_t state = 5U;
+  for (size_t i = 0; i < count; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = 200U + (state >> 21U);
+      state = (state * 1664525U) + 1013904223U;
+      y[i] = 200U + (state >> 21U);
+    }
+
+  point_polygon_t *polygon = point_polygon_create (vertices, vertex_count);
+  point_batch_t batch = { x, y, count };
+  CLOVE_IS_TRUE (point_batch_polygon_test (polygon, &batch, bitmap, 4U));
+
+  bool is_equal = true;
+  size_t inside = 0;
+  for (size_t i = 0; i < count; ++i)
+    {
+      bool on_edge = false;
+      bool expected = reference_contains (vertices, vertex_count, x[i], y[i], &on_edge);
+      bool actual = ((bitmap[i / 64U] >> (i % 64U)) & 1U) != 0U;
+      is_equal = is_equal && (on_edge || (expected == actual));
+      inside += actual ? 1U : 0U;
+    }
+  CLOVE_IS_TRUE (is_equal);
+  CLOVE_IS_TRUE ((inside > 0U) && (inside < count));
+  CLOVE_IS_FALSE (point_batch_polygon_test (polygon, NULL, bitmap, 1U));
+
+  (void)point_polygon_destroy (polygon);
+  free (vertices);
+  free (x);
+  free (y);
+  free (bitmap);
+}
+
+CLOVE_TEST (point_polygon_locate)
+{
+  /* Two adjacent squares and a larger one overlapping both */
+  const point_value_t left[4] = { { 0U, 0U }, { 10U, 0U }, { 10U, 10U }, { 0U, 10U } };
+  const point_value_t right[4] = { { 10U, 0U }, { 20U, 0U }, { 20U, 10U }, { 10U, 10U } };
+  const point_value_t large[4] = { { 5U, 5U }, { 30U, 5U }, { 30U, 30U }, { 5U, 30U } };
+  point_polygon_t *polygons[4] = { point_polygon_create (large, 4U), NULL, point_polygon_create (left, 4U), point_polygon_create (right, 4U) };
+  point_t *points[5] = { point_create (2U, 2U), point_create (15U, 2U), point_create (7U, 7U), point_create (25U, 25U), NULL };
+  uint32_t indices[5] = { 0U };
+
+  CLOVE_IS_TRUE (point_polygon_locate (polygons, 4U, points, 5U, indices, 1U));
+  CLOVE_UINT_EQ (2U, indices[0]);
+  CLOVE_UINT_EQ (3U, indices[1]);
+  CLOVE_UINT_EQ (0U, indices[2]);
+  CLOVE_UINT_EQ (0U, indices[3]);
+  CLOVE_UINT_EQ (UINT32_MAX, indices[4]);
+  CLOVE_IS_FALSE (point_polygon_locate (NULL, 4U, points, 5U, indices, 1U));
+
+  for (size_t i = 0; i < 4U; ++i)
+    {
+      (void)point_destroy (points[i]);
+      (void)point_polygon_destroy (polygons[i]);
+    }
+}
+
+CLOVE_TEST (point_batch_polygon_locate)
+{
+  /* A hundred stars of various sizes scattered over a plane */
+  size_t polygon_count = 100U;
+  size_t count = 20000U;
+  point_polygon_t *polygons[100];
+  point_value_t vertices[40];
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  uint32_t *indices = malloc (count * sizeof (uint32_t));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+  CLOVE_NOT_NULL (indices);
+
+  for (size_t i = 0; i < polygon_count; ++i)
+    {
+      star_fill (vertices, 40U, (uint32_t)i + 1U);
+      for (size_t v = 0; v < 40U; ++v)
+        {
+          vertices[v].x += (uint32_t)(i % 10U) * 1500U;
+          vertices[v].y += (uint32_t)(i / 10U) * 1500U;
+        }
+      polygons[i] = point_polygon_create (vertices, 40U);
+    }
+
+  uint32_t state = 9U;
+  for (size_t i = 0; i < count; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = state % 17000U;
+      state = (state * 1664525U) + 1013904223U;
+      y[i] = state % 17000U;
+    }
+
+  point_batch_t batch = { x, y, count };
+  CLOVE_IS_TRUE (point_batch_polygon_locate (polygons, polygon_count, &batch, indices, 4U));
+
+  bool is_equal = true;
+  for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t expected = UINT32_MAX;
+      for (uint32_t p = 0; (expected == UINT32_MAX) && (p < polygon_count); ++p)
+        {
+          expected = point_polygon_contains (polygons[p], x[i], y[i]) ? p : UINT32_MAX;
+        }
+      is_equal = is_equal && (indices[i] == expected);
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  for (size_t i = 0; i < polygon_count; ++i)
+    {
+      (void)point_polygon_destroy (polygons[i]);
+    }
+  free (x);
+  free (y);
+  free (indices);
+}
@@ -0,0 +1,201 @@
+#ifdef __linux__
+/* RTLD_NEXT is a GNU extension */
+#define _GNU_SOURCE
+#endif
+
+#define CLOVE_SUITE_NAME pool
+#include "clove-unit.h"
+#include "library.h"
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+
+/* Whether pthread_create fails, as when the process runs out of threads */
+static bool g_is_thread_failing = false;
+
+/**
+ * Replaces pthread_create for the library, failing while g_is_thread_failing is set.
+ */
+int
+pthread_create (pthread_t *thread, const pthread_attr_t *attributes, void *(*start) (void *), void *argument)
+{
+  int (*create) (pthread_t *, const pthread_attr_t *, void *(*) (void *), void *) = NULL;
+  *(void **)&create = dlsym (RTLD_NEXT, "pthread_create");
+  return (g_is_thread_failing || (create == NULL)) ? EAGAIN : create (thread, attributes, start, argument);
+}
+#endif
+
+/**
+ * Writes twice the index of every element of a chunk.
+ */
+static void
+double_range (void *context, size_t begin, size_t end)
+{
+  uint32_t *values = context;
+  for (size_t i = begin; i < end; ++i)
+    {
+      values[i] = (uint32_t)i * 2U;
+    }
+}
+
+/**
+ * Runs a nested parallel loop over every row of a chunk of a 64-column matrix.
+ */
+static void
+double_rows (void *context, size_t begin, size_t end)
+{
+  uint32_t *values = context;
+  for (size_t row = begin; row < end; ++row)
+    {
+      (void)point_parallel_for (64U, 8U, double_range, &values[row * 64U]);
+    }
+}
+
+/**
+ * A range of values and their sum computed by a task.
+ */
+typedef struct
+{
+  const uint32_t *values;
+  size_t count;
+  uint64_t total;
+} test_sum_t;
+
+/**
+ * Sums the values of a test_sum_t into its total.
+ */
+static void
+sum_values (void *context)
+{
+  test_sum_t *sum = context;
+  for (size_t i = 0; i < sum->count; ++i)
+    {
+      sum->total += sum->values[i];
+    }
+}
+
+CLOVE_TEST (point_pool_configure)
+{
+  CLOVE_IS_TRUE (point_pool_configure (2U, true));
+  CLOVE_UINT_EQ (2U, point_pool_get_threads ());
+
+  uint32_t values[1000];
+  CLOVE_IS_TRUE (point_parallel_for (1000U, 10U, double_range, values));
+  CLOVE_UINT_EQ (1998U, values[999]);
+
+  CLOVE_IS_TRUE (point_pool_configure (0U, false));
+}
+
+CLOVE_TEST (point_pool_get_threads)
+{
+  CLOVE_IS_TRUE (point_pool_configure (3U, false));
+  CLOVE_UINT_EQ (3U, point_pool_get_threads ());
+  CLOVE_IS_TRUE (point_pool_configure (0U, false));
+  CLOVE_IS_TRUE (point_pool_get_threads () > 0U);
+}
+
+CLOVE_TEST (point_parallel_for)
+{
+  size_t count = 100003U;
+  uint32_t *values = calloc (count, sizeof (uint32_t));
+  CLOVE_NOT_NULL (values);
+
+  CLOVE_IS_TRUE (point_parallel_for (count, 0U, double_range, values));
+  bool is_equal = true;
+  for (size_t i = 0; i < count; ++i)
+    {
+      is_equal = is_equal && (values[i] == (uint32_t)i * 2U);
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  free (values);
+}
+
+CLOVE_TEST (point_parallel_for__without_threads)
+{
+#ifdef __linux__
+  /* The pool keeps running without threads, and the calling threads run the work */
+  g_is_thread_failing = true;
+  CLOVE_IS_FALSE (point_pool_configure (2U, false));
+  CLOVE_UINT_EQ (0U, point_pool_get_threads ());
+
+  uint32_t values[1000];
+  CLOVE_IS_TRUE (point_parallel_for (1000U, 0U, double_range, values));
+  CLOVE_UINT_EQ (0U, values[0]);
+  CLOVE_UINT_EQ (1998U, values[999]);
+
+  g_is_thread_failing = false;
+  CLOVE_IS_TRUE (point_pool_configure (0U, false));
+#endif
+  CLOVE_PASS ();
+}
+
+CLOVE_TEST (point_parallel_for__nested)
+{
+  size_t rows = 500U;
+  uint32_t *values = calloc (rows * 64U, sizeof (uint32_t));
+  CLOVE_NOT_NULL (values);
+
+  CLOVE_IS_TRUE (point_parallel_for (rows, 1U, double_rows, values));
+  bool is_equal = true;
+  for (size_t i = 0; i < rows * 64U; ++i)
+    {
+      is_equal = is_equal && (values[i] == (uint32_t)(i % 64U) * 2U);
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  free (values);
+}
+
+CLOVE_TEST (point_parallel_for__on_null)
+{
+  CLOVE_IS_FALSE (point_parallel_for (10U, 1U, NULL, NULL));
+  CLOVE_IS_TRUE (point_parallel_for (0U, 1U, double_range, NULL));
+}
+
+CLOVE_TEST (point_task_submit)
+{
+  uint32_t values[256];
+  test_sum_t sums[4];
+  point_future_t *futures[4];
+  for (uint32_t i = 0; i < 256U; ++i)
+    {
+      values[i] = i;
+    }
+
+  for (uint32_t i = 0; i < 4U; ++i)
+    {
+      sums[i] = (test_sum_t){ &values[i * 64U], 64U, 0U };
+      futures[i] = point_task_submit (sum_values, &sums[i]);
+      CLOVE_NOT_NULL (futures[i]);
+    }
+
+  uint64_t total = 0U;
+  for (uint32_t i = 0; i < 4U; ++i)
+    {
+      CLOVE_IS_TRUE (point_future_wait (futures[i]));
+      total += sums[i].total;
+    }
+  CLOVE_ULLONG_EQ (32640U, total);
+}
+
+CLOVE_TEST (point_task_submit__on_null)
+{
+  CLOVE_NULL (point_task_submit (NULL, NULL));
+}
+
+CLOVE_TEST (point_future_wait)
+{
+  uint32_t values[3] = { 1U, 2U, 3U };
+  test_sum_t sum = { values, 3U, 0U };
+  CLOVE_IS_TRUE (point_future_wait (point_task_submit (sum_values, &sum)));
+  CLOVE_ULLONG_EQ (6U, sum.total);
+}
+
+CLOVE_TEST (point_future_wait__on_null)
+{
+  CLOVE_IS_FALSE (point_future_wait (NULL));
+}
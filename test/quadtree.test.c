@@ -0,0 +1,282 @@
+#define CLOVE_SUITE_NAME quadtree
+#include "clove-unit.h"
+#include "library.h"
+
+static const point_bbox_t g_bounds = { 0U, 0U, 1023U, 1023U };
+
+CLOVE_TEST (point_quadtree_create)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 4U);
+  CLOVE_NOT_NULL (tree);
+  CLOVE_UINT_EQ (0U, point_quadtree_get_count (tree));
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_create__on_invalid_bounds)
+{
+  point_bbox_t bounds = { 10U, 0U, 5U, 10U };
+  CLOVE_NULL (point_quadtree_create (&bounds, 4U));
+  CLOVE_NULL (point_quadtree_create (&g_bounds, 0U));
+}
+
+CLOVE_TEST (point_quadtree_destroy)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 4U);
+  CLOVE_IS_TRUE (point_quadtree_destroy (tree));
+}
+
+CLOVE_TEST (point_quadtree_destroy__on_null)
+{
+  CLOVE_IS_FALSE (point_quadtree_destroy (NULL));
+}
+
+CLOVE_TEST (point_quadtree_insert)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 2U);
+  uint32_t ids[3] = { 0 };
+
+  CLOVE_IS_TRUE (point_quadtree_insert (tree, 10U, 10U, &ids[0]));
+  CLOVE_IS_TRUE (point_quadtree_insert (tree, 900U, 10U, &ids[1]));
+  CLOVE_IS_TRUE (point_quadtree_insert (tree, 10U, 900U, &ids[2]));
+  CLOVE_UINT_EQ (3U, point_quadtree_get_count (tree));
+  CLOVE_IS_TRUE ((ids[0] != ids[1]) && (ids[1] != ids[2]));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_insert__out_of_bounds)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 2U);
+  uint32_t id = 0U;
+
+  CLOVE_IS_FALSE (point_quadtree_insert (tree, 1024U, 0U, &id));
+  CLOVE_UINT_EQ (0U, point_quadtree_get_count (tree));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_remove)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 2U);
+  uint32_t id = 0U;
+  uint32_t reused = 0U;
+
+  (void)point_quadtree_insert (tree, 5U, 5U, &id);
+  CLOVE_IS_TRUE (point_quadtree_remove (tree, id));
+  CLOVE_IS_FALSE (point_quadtree_remove (tree, id));
+  CLOVE_UINT_EQ (0U, point_quadtree_get_count (tree));
+
+  CLOVE_IS_TRUE (point_quadtree_insert (tree, 6U, 6U, &reused));
+  CLOVE_UINT_EQ (id, reused);
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_move)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 1U);
+  uint32_t ids[4] = { 0 };
+  uint32_t found[4] = { 0 };
+  point_bbox_t corner = { 1000U, 1000U, 1023U, 1023U };
+
+  (void)point_quadtree_insert (tree, 1U, 1U, &ids[0]);
+  (void)point_quadtree_insert (tree, 2U, 2U, &ids[1]);
+  (void)point_quadtree_insert (tree, 3U, 3U, &ids[2]);
+  (void)point_quadtree_insert (tree, 500U, 500U, &ids[3]);
+
+  CLOVE_IS_TRUE (point_quadtree_move (tree, ids[1], 1010U, 1020U));
+  CLOVE_UINT_EQ (1U, point_quadtree_query_range (tree, &corner, found, 4U));
+  CLOVE_UINT_EQ (ids[1], found[0]);
+  CLOVE_IS_FALSE (point_quadtree_move (tree, ids[1], 2000U, 0U));
+  CLOVE_UINT_EQ (4U, point_quadtree_get_count (tree));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_move__many_ticks)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 4U);
+  uint32_t ids[256] = { 0 };
+  uint32_t x[256] = { 0 };
+  uint32_t y[256] = { 0 };
+  uint32_t state = 5U;
+
+  for (uint32_t i = 0; i < 256U; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = state % 1024U;
+      y[i] = (state >> 12) % 1024U;
+      CLOVE_IS_TRUE (point_quadtree_insert (tree, x[i], y[i], &ids[i]));
+    }
+
+  for (uint32_t tick = 0; tick < 50U; ++tick)
+    {
+      for (uint32_t i = 0; i < 256U; ++i)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          x[i] = (tick < 25U) ? ((x[i] + (state % 7U)) % 1024U) : (x[i] / 2U);
+          y[i] = (tick < 25U) ? ((y[i] + ((state >> 8) % 5U)) % 1024U) : (y[i] / 2U);
+          CLOVE_IS_TRUE (point_quadtree_move (tree, ids[i], x[i], y[i]));
+        }
+      CLOVE_IS_TRUE (point_quadtree_rebalance (tree));
+    }
+
+  point_bbox_t range = { 0U, 0U, 15U, 15U };
+  uint32_t expected = 0U;
+  for (uint32_t i = 0; i < 256U; ++i)
+    {
+      expected += ((x[i] <= 15U) && (y[i] <= 15U)) ? 1U : 0U;
+    }
+
+  CLOVE_UINT_EQ (expected, point_quadtree_query_range (tree, &range, NULL, 0U));
+  CLOVE_UINT_EQ (256U, point_quadtree_query_range (tree, &g_bounds, NULL, 0U));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_move__random)
+{
+  /* With one point per leaf, moves and removals leave subtrees to merge while the point is detached */
+  point_bbox_t bounds = { 0U, 0U, 511U, 511U };
+  uint32_t found[16] = { 0 };
+  bool is_equal = true;
+
+  for (uint32_t seed = 1U; is_equal && (seed <= 8U); ++seed)
+    {
+      point_quadtree_t *tree = point_quadtree_create (&bounds, 1U);
+      uint32_t ids[16] = { 0 };
+      uint32_t x[16] = { 0 };
+      uint32_t y[16] = { 0 };
+      bool is_stored[16] = { false };
+      uint32_t state = seed;
+
+      for (uint32_t step = 0; is_equal && (step < 5000U); ++step)
+        {
+          state = (state * 1664525U) + 1013904223U;
+          uint32_t i = (state >> 8) % 16U;
+          uint32_t operation = (state >> 20) % 8U;
+          state = (state * 1664525U) + 1013904223U;
+          uint32_t next_x = (state >> 4) % 512U;
+          uint32_t next_y = (state >> 16) % 512U;
+
+          if (is_stored[i] == false)
+            {
+              is_stored[i] = point_quadtree_insert (tree, next_x, next_y, &ids[i]);
+            }
+          else if (operation == 0U)
+            {
+              is_stored[i] = (point_quadtree_remove (tree, ids[i]) == false);
+            }
+          else
+            {
+              /* Mostly short moves, as between ticks, and some across the tree */
+              next_x = (operation < 6U) ? ((x[i] + (next_x % 9U) + 508U) % 512U) : next_x;
+              next_y = (operation < 6U) ? ((y[i] + (next_y % 9U) + 508U) % 512U) : next_y;
+              is_equal = point_quadtree_move (tree, ids[i], next_x, next_y);
+            }
+          x[i] = next_x;
+          y[i] = next_y;
+
+          /* Every stored point is found at its position, and no other point is stored */
+          size_t expected = 0U;
+          for (uint32_t j = 0; j < 16U; ++j)
+            {
+              point_bbox_t position = { x[j], y[j], x[j], y[j] };
+              size_t count = point_quadtree_query_range (tree, &position, found, 16U);
+              bool has_id = false;
+              for (size_t k = 0; is_stored[j] && (k < count) && (k < 16U); ++k)
+                {
+                  has_id = has_id || (found[k] == ids[j]);
+                }
+              is_equal = is_equal && (has_id || !is_stored[j]);
+              expected += is_stored[j] ? 1U : 0U;
+            }
+          is_equal = is_equal && (expected == point_quadtree_query_range (tree, &bounds, NULL, 0U));
+          is_equal = is_equal && (expected == point_quadtree_get_count (tree));
+        }
+
+      (void)point_quadtree_destroy (tree);
+    }
+
+  CLOVE_IS_TRUE (is_equal);
+}
+
+CLOVE_TEST (point_quadtree_rebalance)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 2U);
+  uint32_t ids[16] = { 0 };
+
+  for (uint32_t i = 0; i < 16U; ++i)
+    {
+      (void)point_quadtree_insert (tree, i * 60U, i * 60U, &ids[i]);
+    }
+  for (uint32_t i = 1U; i < 16U; ++i)
+    {
+      (void)point_quadtree_remove (tree, ids[i]);
+    }
+
+  CLOVE_IS_TRUE (point_quadtree_rebalance (tree));
+  CLOVE_UINT_EQ (1U, point_quadtree_query_range (tree, &g_bounds, NULL, 0U));
+  CLOVE_IS_FALSE (point_quadtree_rebalance (NULL));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_get_count)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 2U);
+  uint32_t id = 0U;
+
+  (void)point_quadtree_insert (tree, 1U, 2U, &id);
+  CLOVE_UINT_EQ (1U, point_quadtree_get_count (tree));
+  CLOVE_UINT_EQ (0U, point_quadtree_get_count (NULL));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_query_range)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 2U);
+  point_bbox_t range = { 100U, 100U, 200U, 200U };
+  uint32_t id = 0U;
+  uint32_t found[2] = { 0 };
+
+  (void)point_quadtree_insert (tree, 100U, 150U, &id);
+  (void)point_quadtree_insert (tree, 200U, 200U, &id);
+  (void)point_quadtree_insert (tree, 201U, 150U, &id);
+  (void)point_quadtree_insert (tree, 150U, 99U, &id);
+  (void)point_quadtree_insert (tree, 150U, 150U, &id);
+
+  CLOVE_UINT_EQ (3U, point_quadtree_query_range (tree, &range, found, 2U));
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_query_nearest)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 1U);
+  uint32_t ids[4] = { 0 };
+  uint32_t nearest = 0U;
+
+  (void)point_quadtree_insert (tree, 10U, 10U, &ids[0]);
+  (void)point_quadtree_insert (tree, 600U, 600U, &ids[1]);
+  (void)point_quadtree_insert (tree, 520U, 480U, &ids[2]);
+  (void)point_quadtree_insert (tree, 1000U, 20U, &ids[3]);
+
+  CLOVE_IS_TRUE (point_quadtree_query_nearest (tree, 511U, 511U, &nearest));
+  CLOVE_UINT_EQ (ids[2], nearest);
+  CLOVE_IS_TRUE (point_quadtree_query_nearest (tree, 900U, 0U, &nearest));
+  CLOVE_UINT_EQ (ids[3], nearest);
+
+  (void)point_quadtree_destroy (tree);
+}
+
+CLOVE_TEST (point_quadtree_query_nearest__on_empty)
+{
+  point_quadtree_t *tree = point_quadtree_create (&g_bounds, 1U);
+  uint32_t nearest = 0U;
+
+  CLOVE_IS_FALSE (point_quadtree_query_nearest (tree, 0U, 0U, &nearest));
+
+  (void)point_quadtree_destroy (tree);
+}
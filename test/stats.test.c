@@ -0,0 +1,60 @@
+#define CLOVE_SUITE_NAME stats
+#include "clove-unit.h"
+#include "library.h"
+
+CLOVE_TEST (point_stats_get)
+{
+  point_stats_t before;
+  if (point_stats_get (&before))
+    {
+      point_t *first = point_create (1U, 2U);
+      point_t *second = point_create (3U, 4U);
+      (void)point_destroy (first);
+
+      point_stats_t after;
+      CLOVE_IS_TRUE (point_stats_get (&after));
+      CLOVE_ULLONG_EQ (before.creates + 2U, after.creates);
+      CLOVE_ULLONG_EQ (before.destroys + 1U, after.destroys);
+      CLOVE_ULLONG_EQ (before.live + 1U, after.live);
+      CLOVE_IS_TRUE (after.peak_live >= after.live);
+      CLOVE_IS_TRUE (after.bytes_live > before.bytes_live);
+      CLOVE_IS_TRUE (after.bytes_allocated > before.bytes_allocated);
+
+      (void)point_destroy (second);
+    }
+  else
+    {
+      /* Built without LIB_STATS */
+      CLOVE_PASS ();
+    }
+}
+
+CLOVE_TEST (point_stats_get__on_null)
+{
+  CLOVE_IS_FALSE (point_stats_get (NULL));
+}
+
+CLOVE_TEST (point_stats_reset)
+{
+  if (point_stats_reset ())
+    {
+      point_t *point = point_create (1U, 2U);
+
+      point_stats_t stats;
+      CLOVE_IS_TRUE (point_stats_get (&stats));
+      CLOVE_ULLONG_EQ (1U, stats.creates);
+      CLOVE_ULLONG_EQ (0U, stats.destroys);
+      CLOVE_IS_TRUE (stats.peak_live >= 1U);
+
+      (void)point_destroy (point);
+      CLOVE_IS_TRUE (point_stats_reset ());
+      CLOVE_IS_TRUE (point_stats_get (&stats));
+      CLOVE_ULLONG_EQ (0U, stats.creates);
+      CLOVE_ULLONG_EQ (stats.live, stats.peak_live);
+    }
+  else
+    {
+      point_stats_t stats;
+      CLOVE_IS_FALSE (point_stats_get (&stats));
+    }
+}
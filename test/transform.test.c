@@ -0,0 +1,228 @@
+#define CLOVE_SUITE_NAME transform
+#include "clove-unit.h"
+#include "library.h"
+#include <math.h>
+#include <stdlib.h>
+
+CLOVE_TEST (point_transform_create)
+{
+  point_transform_t *transform = point_transform_create ();
+  CLOVE_NOT_NULL (transform);
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_destroy)
+{
+  CLOVE_IS_TRUE (point_transform_destroy (point_transform_create ()));
+}
+
+CLOVE_TEST (point_transform_destroy__on_null)
+{
+  CLOVE_IS_FALSE (point_transform_destroy (NULL));
+}
+
+CLOVE_TEST (point_transform_translate)
+{
+  point_transform_t *transform = point_transform_create ();
+  uint32_t x[2] = { 10U, 5U };
+  uint32_t y[2] = { 20U, 1U };
+  point_batch_t batch = { x, y, 2U };
+
+  CLOVE_IS_TRUE (point_transform_translate (transform, 5.0, -10.0));
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &batch, 1U));
+  CLOVE_UINT_EQ (15U, x[0]);
+  CLOVE_UINT_EQ (10U, y[0]);
+  CLOVE_UINT_EQ (10U, x[1]);
+  CLOVE_UINT_EQ (0U, y[1]);
+
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_scale)
+{
+  point_transform_t *transform = point_transform_create ();
+  uint32_t x[1] = { 10U };
+  uint32_t y[1] = { 3U };
+  point_batch_t batch = { x, y, 1U };
+
+  CLOVE_IS_TRUE (point_transform_scale (transform, 2.5, 0.5));
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &batch, 1U));
+  CLOVE_UINT_EQ (25U, x[0]);
+  CLOVE_UINT_EQ (2U, y[0]);
+
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_scale__on_invalid)
+{
+  point_transform_t *transform = point_transform_create ();
+  CLOVE_IS_FALSE (point_transform_scale (NULL, 1.0, 1.0));
+  CLOVE_IS_FALSE (point_transform_scale (transform, INFINITY, 1.0));
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_affine)
+{
+  /* A rotation by 90 degrees about the origin followed by a translation */
+  const double matrix[6] = { 0.0, -1.0, 100.0, 1.0, 0.0, 0.0 };
+  point_transform_t *transform = point_transform_create ();
+  uint32_t x[1] = { 10U };
+  uint32_t y[1] = { 20U };
+  point_batch_t batch = { x, y, 1U };
+
+  CLOVE_IS_TRUE (point_transform_affine (transform, matrix));
+  CLOVE_IS_FALSE (point_transform_affine (transform, NULL));
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &batch, 1U));
+  CLOVE_UINT_EQ (80U, x[0]);
+  CLOVE_UINT_EQ (10U, y[0]);
+
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_clamp)
+{
+  point_transform_t *transform = point_transform_create ();
+  point_bbox_t bounds = { 10U, 10U, 20U, 20U };
+  uint32_t x[3] = { 5U, 15U, 25U };
+  uint32_t y[3] = { 25U, 15U, 5U };
+  point_batch_t batch = { x, y, 3U };
+
+  CLOVE_IS_TRUE (point_transform_clamp (transform, &bounds));
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &batch, 1U));
+  CLOVE_UINT_EQ (10U, x[0]);
+  CLOVE_UINT_EQ (20U, y[0]);
+  CLOVE_UINT_EQ (15U, x[1]);
+  CLOVE_UINT_EQ (15U, y[1]);
+  CLOVE_UINT_EQ (20U, x[2]);
+  CLOVE_UINT_EQ (10U, y[2]);
+
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_clamp__on_empty)
+{
+  point_transform_t *transform = point_transform_create ();
+  point_bbox_t bounds = { 20U, 10U, 10U, 20U };
+  CLOVE_IS_FALSE (point_transform_clamp (transform, &bounds));
+  CLOVE_IS_FALSE (point_transform_clamp (transform, NULL));
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_quantize)
+{
+  point_transform_t *transform = point_transform_create ();
+  uint32_t x[2] = { 17U, 4294967295U };
+  uint32_t y[2] = { 29U, 3U };
+  point_batch_t batch = { x, y, 2U };
+
+  CLOVE_IS_TRUE (point_transform_quantize (transform, 8U, 10U));
+  CLOVE_IS_FALSE (point_transform_quantize (transform, 0U, 10U));
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &batch, 1U));
+  CLOVE_UINT_EQ (16U, x[0]);
+  CLOVE_UINT_EQ (20U, y[0]);
+  CLOVE_UINT_EQ (4294967288U, x[1]);
+  CLOVE_UINT_EQ (0U, y[1]);
+
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_apply)
+{
+  point_transform_t *transform = point_transform_create ();
+  point_bbox_t bounds = { 0U, 0U, 100U, 100U };
+  point_t *points[3] = { point_create (10U, 20U), NULL, point_create (60U, 5U) };
+  point_value_t values[3] = { { 7U, 7U }, { 7U, 7U }, { 7U, 7U } };
+
+  (void)point_transform_translate (transform, 1.0, 1.0);
+  (void)point_transform_scale (transform, 2.0, 2.0);
+  (void)point_transform_clamp (transform, &bounds);
+  (void)point_transform_quantize (transform, 10U, 10U);
+
+  CLOVE_IS_TRUE (point_transform_apply (transform, points, 3U, values, 1U));
+  CLOVE_UINT_EQ (20U, values[0].x);
+  CLOVE_UINT_EQ (40U, values[0].y);
+  CLOVE_UINT_EQ (7U, values[1].x);
+  CLOVE_UINT_EQ (100U, values[2].x);
+  CLOVE_UINT_EQ (10U, values[2].y);
+  CLOVE_UINT_EQ (10U, point_get_x (points[0]));
+
+  CLOVE_IS_TRUE (point_transform_apply (transform, points, 3U, NULL, 1U));
+  CLOVE_UINT_EQ (20U, point_get_x (points[0]));
+  CLOVE_UINT_EQ (40U, point_get_y (points[0]));
+
+  (void)point_destroy (points[0]);
+  (void)point_destroy (points[2]);
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_transform_apply__on_null)
+{
+  point_transform_t *transform = point_transform_create ();
+  point_t *points[1] = { NULL };
+  CLOVE_IS_FALSE (point_transform_apply (NULL, points, 1U, NULL, 1U));
+  CLOVE_IS_FALSE (point_transform_apply (transform, NULL, 1U, NULL, 1U));
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_batch_transform_apply)
+{
+  point_transform_t *transform = point_transform_create ();
+  uint32_t x[3] = { 0U, 1000U, 4294967295U };
+  uint32_t y[3] = { 4294967295U, 1000U, 0U };
+  uint32_t out_x[3] = { 0 };
+  uint32_t out_y[3] = { 0 };
+  point_batch_t batch = { x, y, 3U };
+  point_batch_t output = { out_x, out_y, 3U };
+
+  /* Translations and scalings compose into one matrix, and the result saturates */
+  (void)point_transform_translate (transform, -10.0, 10.0);
+  (void)point_transform_scale (transform, 0.5, 0.5);
+  (void)point_transform_translate (transform, 0.25, 0.0);
+
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &output, 1U));
+  CLOVE_UINT_EQ (0U, out_x[0]);
+  CLOVE_UINT_EQ (2147483653U, out_y[0]);
+  CLOVE_UINT_EQ (495U, out_x[1]);
+  CLOVE_UINT_EQ (505U, out_y[1]);
+  CLOVE_UINT_EQ (2147483643U, out_x[2]);
+  CLOVE_UINT_EQ (5U, out_y[2]);
+  CLOVE_UINT_EQ (1000U, x[1]);
+
+  output.count = 2U;
+  CLOVE_IS_FALSE (point_batch_transform_apply (transform, &batch, &output, 1U));
+  CLOVE_IS_FALSE (point_batch_transform_apply (transform, &batch, NULL, 1U));
+
+  (void)point_transform_destroy (transform);
+}
+
+CLOVE_TEST (point_batch_transform_apply__parallel)
+{
+  size_t count = 300000U;
+  uint32_t *x = malloc (count * sizeof (uint32_t));
+  uint32_t *y = malloc (count * sizeof (uint32_t));
+  point_transform_t *transform = point_transform_create ();
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      x[i] = (uint32_t)i;
+      y[i] = (uint32_t)(count - i);
+    }
+
+  point_batch_t batch = { x, y, count };
+  (void)point_transform_scale (transform, 3.0, 1.0);
+  (void)point_transform_quantize (transform, 4U, 1U);
+  CLOVE_IS_TRUE (point_batch_transform_apply (transform, &batch, &batch, 4U));
+
+  bool is_equal = true;
+  for (size_t i = 0; i < count; ++i)
+    {
+      is_equal = is_equal && (x[i] == (((uint32_t)i * 3U) & ~3U)) && (y[i] == (uint32_t)(count - i));
+    }
+  CLOVE_IS_TRUE (is_equal);
+
+  (void)point_transform_destroy (transform);
+  free (x);
+  free (y);
+}
@@ -0,0 +1,204 @@
+#define CLOVE_SUITE_NAME types
+#include "clove-unit.h"
+#include "library.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+/* Number of points of the batch reduced by several threads, enough for three slices. */
+#define SPLIT_POINTS 200000U
+
+/* Spell the coordinates of a point in the plane, or in space with its depth equal to its height. */
+#define TYPES_2D(x, y) x, y
+#define TYPES_3D(x, y) x, y, y
+
+/*
+ * The tests shared by every point type, on points at the limits of its coordinates.
+ * The third point of the batches is outside the range only along x, and the fourth
+ * only along y.
+ */
+#define TYPES_TESTS(name, type, EQ, low, high, DIMENSION)                                                                                            \
+  CLOVE_TEST (name##_create)                                                                                                                         \
+  {                                                                                                                                                  \
+    name##_t *point = name##_create (DIMENSION (3, high));                                                                                           \
+    CLOVE_NOT_NULL (point);                                                                                                                          \
+    EQ (3, name##_get_x (point));                                                                                                                    \
+    EQ (high, name##_get_y (point));                                                                                                                 \
+    CLOVE_IS_TRUE (name##_destroy (point));                                                                                                          \
+  }                                                                                                                                                  \
+                                                                                                                                                     \
+  CLOVE_TEST (name##_destroy)                                                                                                                        \
+  {                                                                                                                                                  \
+    CLOVE_IS_FALSE (name##_destroy (NULL));                                                                                                          \
+  }                                                                                                                                                  \
+                                                                                                                                                     \
+  CLOVE_TEST (name##_get_x)                                                                                                                          \
+  {                                                                                                                                                  \
+    EQ (0, name##_get_x (NULL));                                                                                                                     \
+  }                                                                                                                                                  \
+                                                                                                                                                     \
+  CLOVE_TEST (name##_get_y)                                                                                                                          \
+  {                                                                                                                                                  \
+    EQ (0, name##_get_y (NULL));                                                                                                                     \
+  }                                                                                                                                                  \
+                                                                                                                                                     \
+  CLOVE_TEST (name##_batch_bbox_compute)                                                                                                             \
+  {                                                                                                                                                  \
+    type x[4] = { 3, low, high, 2 };                                                                                                                 \
+    type y[4] = { high, 2, 3, low };                                                                                                                 \
+    name##_batch_t batch = { DIMENSION (x, y), 4U };                                                                                                 \
+    name##_bbox_t bbox = { 0 };                                                                                                                      \
+                                                                                                                                                     \
+    CLOVE_IS_TRUE (name##_batch_bbox_compute (&batch, &bbox, 1U));                                                                                   \
+    EQ (low, bbox.min_x);                                                                                                                            \
+    EQ (low, bbox.min_y);                                                                                                                            \
+    EQ (high, bbox.max_x);                                                                                                                           \
+    EQ (high, bbox.max_y);                                                                                                                           \
+                                                                                                                                                     \
+    batch.count = 0U;                                                                                                                                \
+    CLOVE_IS_FALSE (name##_batch_bbox_compute (&batch, &bbox, 1U));                                                                                  \
+    CLOVE_IS_FALSE (name##_batch_bbox_compute (NULL, &bbox, 1U));                                                                                    \
+    CLOVE_IS_FALSE (name##_batch_bbox_compute (&batch, NULL, 1U));                                                                                   \
+  }                                                                                                                                                  \
+                                                                                                                                                     \
+  CLOVE_TEST (name##_batch_query_range)                                                                                                              \
+  {                                                                                                                                                  \
+    type x[4] = { 3, low, high, 2 };                                                                                                                 \
+    type y[4] = { high, 2, 3, low };                                                                                                                 \
+    name##_batch_t batch = { DIMENSION (x, y), 4U };                                                                                                 \
+    name##_bbox_t range = { DIMENSION (low, 2), DIMENSION (3, high) };                                                                               \
+    uint32_t ids[4] = { 0U };                                                                                                                        \
+                                                                                                                                                     \
+    CLOVE_ULLONG_EQ (2U, name##_batch_query_range (&batch, &range, ids, 4U));                                                                        \
+    CLOVE_UINT_EQ (0U, ids[0]);                                                                                                                      \
+    CLOVE_UINT_EQ (1U, ids[1]);                                                                                                                      \
+                                                                                                                                                     \
+    /* Only the first index fits in the buffer, but every point inside is counted */                                                                 \
+    ids[0] = UINT32_MAX;                                                                                                                             \
+    CLOVE_ULLONG_EQ (2U, name##_batch_query_range (&batch, &range, ids, 1U));                                                                        \
+    CLOVE_UINT_EQ (0U, ids[0]);                                                                                                                      \
+    CLOVE_ULLONG_EQ (2U, name##_batch_query_range (&batch, &range, NULL, 0U));                                                                       \
+    CLOVE_ULLONG_EQ (0U, name##_batch_query_range (&batch, NULL, ids, 4U));                                                                          \
+  }
+
+TYPES_TESTS (point_u16, uint16_t, CLOVE_UINT_EQ, 0U, UINT16_MAX, TYPES_2D)
+TYPES_TESTS (point_i64, int64_t, CLOVE_LLONG_EQ, INT64_MIN, INT64_MAX, TYPES_2D)
+TYPES_TESTS (point_f32, float, CLOVE_FLOAT_EQ, -FLT_MAX, FLT_MAX, TYPES_2D)
+TYPES_TESTS (point3_f32, float, CLOVE_FLOAT_EQ, -FLT_MAX, FLT_MAX, TYPES_3D)
+
+CLOVE_TEST (point_u16_batch_bbox_compute__threads)
+{
+  uint16_t *x = malloc (SPLIT_POINTS * sizeof (uint16_t));
+  uint16_t *y = malloc (SPLIT_POINTS * sizeof (uint16_t));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+
+  uint32_t state = 7U;
+  for (size_t i = 0; i < SPLIT_POINTS; ++i)
+    {
+      state = (state * 1664525U) + 1013904223U;
+      x[i] = (uint16_t)(1000U + ((state >> 16U) % 50000U));
+      y[i] = (uint16_t)(2000U + ((state >> 8U) % 30000U));
+    }
+  x[123456] = 17U;
+  y[199999] = UINT16_MAX;
+
+  point_u16_batch_t batch = { x, y, SPLIT_POINTS };
+  point_u16_bbox_t bbox = { 0U, 0U, 0U, 0U };
+  CLOVE_IS_TRUE (point_u16_batch_bbox_compute (&batch, &bbox, 4U));
+  CLOVE_UINT_EQ (17U, bbox.min_x);
+  CLOVE_UINT_EQ (2000U, bbox.min_y);
+  CLOVE_UINT_EQ (50999U, bbox.max_x);
+  CLOVE_UINT_EQ (UINT16_MAX, bbox.max_y);
+
+  free (x);
+  free (y);
+}
+
+CLOVE_TEST (point_f32_batch_bbox_compute__nan)
+{
+  /* NaN coordinates are ignored */
+  float x[4] = { 0.5F, -2.0F, NAN, 8.0F };
+  float y[4] = { NAN, 1.0F, -1.0F, 3.5F };
+  point_f32_batch_t batch = { x, y, 4U };
+  point_f32_bbox_t bbox = { 0.0F, 0.0F, 0.0F, 0.0F };
+
+  CLOVE_IS_TRUE (point_f32_batch_bbox_compute (&batch, &bbox, 1U));
+  CLOVE_FLOAT_EQ (-2.0F, bbox.min_x);
+  CLOVE_FLOAT_EQ (-1.0F, bbox.min_y);
+  CLOVE_FLOAT_EQ (8.0F, bbox.max_x);
+  CLOVE_FLOAT_EQ (3.5F, bbox.max_y);
+
+  float nan[1] = { NAN };
+  point_f32_batch_t undefined = { nan, nan, 1U };
+  CLOVE_IS_FALSE (point_f32_batch_bbox_compute (&undefined, &bbox, 1U));
+}
+
+CLOVE_TEST (point_f32_batch_query_range__nan)
+{
+  float x[4] = { 0.5F, -2.0F, NAN, 8.0F };
+  float y[4] = { 0.0F, 1.0F, -1.0F, 3.5F };
+  point_f32_batch_t batch = { x, y, 4U };
+  point_f32_bbox_t range = { -INFINITY, -1.0F, 1.0F, 1.0F };
+  uint32_t ids[4] = { 0U };
+
+  CLOVE_ULLONG_EQ (2U, point_f32_batch_query_range (&batch, &range, ids, 4U));
+  CLOVE_UINT_EQ (0U, ids[0]);
+  CLOVE_UINT_EQ (1U, ids[1]);
+}
+
+CLOVE_TEST (point3_f32_get_z)
+{
+  point3_f32_t *point = point3_f32_create (1.0F, 2.0F, -3.0F);
+  CLOVE_NOT_NULL (point);
+  CLOVE_FLOAT_EQ (-3.0F, point3_f32_get_z (point));
+  CLOVE_IS_TRUE (point3_f32_destroy (point));
+  CLOVE_FLOAT_EQ (0.0F, point3_f32_get_z (NULL));
+}
+
+CLOVE_TEST (point3_f32_batch_bbox_compute__threads)
+{
+  float *x = malloc (SPLIT_POINTS * sizeof (float));
+  float *y = malloc (SPLIT_POINTS * sizeof (float));
+  float *z = malloc (SPLIT_POINTS * sizeof (float));
+  CLOVE_NOT_NULL (x);
+  CLOVE_NOT_NULL (y);
+  CLOVE_NOT_NULL (z);
+
+  for (size_t i = 0; i < SPLIT_POINTS; ++i)
+    {
+      x[i] = (float)i;
+      y[i] = -(float)i;
+      z[i] = (float)(i % 100U) * 0.5F;
+    }
+
+  point3_f32_batch_t batch = { x, y, z, SPLIT_POINTS };
+  point3_f32_bbox_t bbox = { 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F };
+  CLOVE_IS_TRUE (point3_f32_batch_bbox_compute (&batch, &bbox, 4U));
+  CLOVE_FLOAT_EQ (0.0F, bbox.min_x);
+  CLOVE_FLOAT_EQ (-(float)(SPLIT_POINTS - 1U), bbox.min_y);
+  CLOVE_FLOAT_EQ (0.0F, bbox.min_z);
+  CLOVE_FLOAT_EQ ((float)(SPLIT_POINTS - 1U), bbox.max_x);
+  CLOVE_FLOAT_EQ (0.0F, bbox.max_y);
+  CLOVE_FLOAT_EQ (49.5F, bbox.max_z);
+
+  batch.z = NULL;
+  CLOVE_IS_FALSE (point3_f32_batch_bbox_compute (&batch, &bbox, 1U));
+  free (x);
+  free (y);
+  free (z);
+}
+
+CLOVE_TEST (point3_f32_batch_query_range__depth)
+{
+  float x[3] = { 0.0F, 1.0F, 2.0F };
+  float y[3] = { 0.0F, 1.0F, 2.0F };
+  float z[3] = { 5.0F, 0.0F, 0.0F };
+  point3_f32_batch_t batch = { x, y, z, 3U };
+  point3_f32_bbox_t range = { 0.0F, 0.0F, -1.0F, 1.5F, 1.5F, 1.0F };
+  uint32_t ids[3] = { 0U };
+
+  /* The first point is inside in the plane, but not in depth */
+  CLOVE_ULLONG_EQ (1U, point3_f32_batch_query_range (&batch, &range, ids, 3U));
+  CLOVE_UINT_EQ (1U, ids[0]);
+}
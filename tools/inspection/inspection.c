@@ -0,0 +1,3996 @@
+#include "inspection.h"
+#include <ctype.h>
+#include <dirent.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/* Max array lengths */
+#define MAX_PARAMETERS 8
+#define MAX_PARAMETER_SYMBOLS 128
+#define MAX_SIGNATURE_SYMBOLS (MAX_PARAMETER_SYMBOLS + 32)
+#define MAX_PROTOTYPES 512
+#define MAX_TEST_BRANCHES 8
+#define MAX_TESTS (MAX_PROTOTYPES * MAX_TEST_BRANCHES)
+#define MAX_SYMBOLS 65536U
+#define MAX_WATCHES (INSPECTION_MAX_PATHS * 3U)
+#define MAX_MACROS 256U
+#define MAX_MACRO_PARAMETERS 16U
+#define MAX_MACRO_FILES 16U
+#define MAX_MACRO_DEPTH 64U
+
+/* Max string lengths */
+#define LENGTH_FUNCTION_NAME 128U
+
+/* Default project layout */
+#define LIBRARY_PREFIX_API "API"
+#define LIBRARY_PREFIX_API_INLINE "API_INLINE"
+#define LIBRARY_PATH_INCLUDE "include/library.h"
+#define LIBRARY_PATH_SRC "src"
+#define LIBRARY_PATH_TEST "test"
+#define LIBRARY_EXTENSION_SRC ".c"
+#define LIBRARY_EXTENSION_TEST ".test.c"
+
+/* Default test formatting */
+#define FORMAT_TEST "CLOVE_TEST"
+#define FORMAT_TEST_ANNOTATION "@covers"
+#define FORMAT_TEST_VARIATION "__"
+
+/* Symbol table */
+#define SYMBOL_NONE UINT32_MAX
+#define SYMBOL_TABLE_SIZE (MAX_SYMBOLS * 2U)
+#define SYMBOL_FNV_OFFSET 2166136261U
+#define SYMBOL_FNV_PRIME 16777619U
+
+/* Watch mode */
+#define WATCH_DEBOUNCE_MS 20
+#define WATCH_MAX_CHANGES 64U
+
+/* Compile commands */
+#define COMPILE_COMMANDS_CHUNK 65536U
+#define COMPILE_COMMANDS_LENGTH_KEY 16U
+
+/* Signature fingerprints */
+#define SIGNATURES_FNV_OFFSET 14695981039346656037ULL
+#define SIGNATURES_FNV_PRIME 1099511628211ULL
+
+/* Report formatting */
+#define REPORT_ALIGNMENT_DOTS 40U
+#define REPORT_ERROR "\033[1;31m"
+#define REPORT_WARN "\033[1;33m"
+#define REPORT_INFO "\033[1;36m"
+#define REPORT_END "\033[0m\n"
+
+/**
+ * Classifies the tokens produced by the lexer.
+ */
+typedef enum
+{
+  TOKEN_IDENTIFIER,
+  TOKEN_NUMBER,
+  TOKEN_PUNCTUATOR,
+  TOKEN_STRING,
+  TOKEN_COMMENT,
+  TOKEN_DIRECTIVE
+} token_kind_t;
+
+/**
+ * Represents a token of a file. Identifiers and punctuators carry their interned
+ * symbol, while numbers are only interned when a signature needs them, see
+ * source_get_symbol, and the text of strings, comments and preprocessor directives
+ * is only referenced within the file buffer.
+ */
+typedef struct
+{
+  uint32_t symbol;
+  uint32_t line;
+  uint32_t offset;
+  uint32_t length;
+  token_kind_t kind;
+} token_t;
+
+/**
+ * Interns the texts of identifiers and punctuators. Symbols are dense indices into
+ * a pool of null-terminated strings, so equal texts compare equal by their symbol
+ * alone. The table is reset by every inspection_load, so that it only holds the
+ * symbols of the current files, clearing only the slots of the table that hold them.
+ * The symbols of single characters, which include every punctuator, are also
+ * indexed by their character, so that the most frequent tokens are interned without
+ * hashing or probing. Both indices hold the symbol plus one, zero marking an empty
+ * entry.
+ */
+typedef struct
+{
+  char *text;
+  uint32_t text_size;
+  uint32_t text_capacity;
+  uint32_t offsets[MAX_SYMBOLS];
+  uint32_t lengths[MAX_SYMBOLS];
+  uint32_t slots[MAX_SYMBOLS];
+  uint32_t table[SYMBOL_TABLE_SIZE];
+  uint32_t characters[UINT8_MAX + 1U];
+  uint32_t count;
+} symbols_t;
+
+/**
+ * Represents a file read into memory along with its tokens.
+ */
+typedef struct
+{
+  char *text;
+  size_t size;
+  size_t capacity;
+  token_t *tokens;
+  uint32_t tokens_count;
+  uint32_t tokens_capacity;
+  symbols_t *symbols;
+} source_t;
+
+/**
+ * Represents a growable list of tokens whose texts lie within one source.
+ */
+typedef struct
+{
+  token_t *tokens;
+  uint32_t count;
+  uint32_t capacity;
+} token_list_t;
+
+/**
+ * Represents a function-like macro. The body is a range of tokens of the
+ * definitions of the macro table, and the parameters are the symbols of their
+ * names, the last one being __VA_ARGS__ for a variadic macro.
+ */
+typedef struct
+{
+  uint32_t symbol;
+  uint32_t parameters[MAX_MACRO_PARAMETERS];
+  uint32_t parameters_count;
+  uint32_t begin;
+  uint32_t end;
+  bool is_variadic;
+  bool is_active;
+} macro_t;
+
+/**
+ * Represents the function-like macros visible in a file: those defined by the file
+ * itself and by the files it includes with quotes. The bodies of the macros are
+ * copied into the text of the definitions and tokenized there, and is_macro flags
+ * the symbols naming a macro, so that other identifiers are passed over quickly.
+ */
+typedef struct
+{
+  source_t definitions;
+  macro_t macros[MAX_MACROS];
+  uint32_t count;
+  uint64_t is_macro[MAX_SYMBOLS / 64U];
+  char files[MAX_MACRO_FILES][INSPECTION_LENGTH_PATH * 2U];
+  uint32_t files_count;
+  bool is_full;
+} macros_t;
+
+/**
+ * Represents coverage information for a specific test path.
+ */
+typedef struct
+{
+  char test_path[INSPECTION_LENGTH_PATH];
+  uint32_t line;
+  bool is_annotation;
+} coverage_t;
+
+/**
+ * Represents the canonical signature of a function: the symbols of its return
+ * type, name and parameter list, without storage specifiers, comments and
+ * whitespace. The fingerprint hashes the text of the symbols, so that equal
+ * signatures have equal fingerprints, also across runs.
+ */
+typedef struct
+{
+  uint64_t fingerprint;
+  uint32_t symbols[MAX_SIGNATURE_SYMBOLS];
+  uint32_t symbols_count;
+} signature_t;
+
+/**
+ * Represents the signature fingerprint of a function recorded by a previous run.
+ */
+typedef struct
+{
+  char function_name[LENGTH_FUNCTION_NAME];
+  uint64_t fingerprint;
+} fingerprint_t;
+
+/**
+ * Represents a function declaration along with related information.
+ */
+typedef struct
+{
+  char function_name[LENGTH_FUNCTION_NAME];
+  char source_path[INSPECTION_LENGTH_PATH];
+  char expected_test_path[INSPECTION_LENGTH_PATH];
+  uint32_t symbol;
+  uint32_t include_index;
+  signature_t signature;
+  coverage_t coverages[MAX_TEST_BRANCHES];
+  uint32_t coverages_count;
+  uint32_t coverage_annotation_count;
+  uint32_t definition_line_number;
+  uint32_t declaration_line_number;
+  bool is_prototype_match;
+  bool has_test_file;
+  bool is_executed;
+  bool is_inline;
+} declaration_t;
+
+/**
+ * Represents the data of a library that is loaded on demand. Every stage loads
+ * the stages it depends on first and is loaded at most once per inspection_load:
+ * the units depend on nothing, the prototypes on nothing, the definitions and
+ * the coverages of the test files on the units and prototypes, and the runtime
+ * executions on the prototypes.
+ */
+typedef enum
+{
+  STAGE_UNITS = 1U << 0U,
+  STAGE_PROTOTYPES = 1U << 1U,
+  STAGE_DEFINITIONS = 1U << 2U,
+  STAGE_COVERAGES = 1U << 3U,
+  STAGE_EXECUTIONS = 1U << 4U
+} stage_t;
+
+/**
+ * Represents a translation unit of compile_commands.json that lies within a source
+ * or test directory of the library, with its resolved absolute path.
+ */
+typedef struct
+{
+  char *path;
+  bool is_test;
+} unit_t;
+
+/**
+ * Represents the state of the streaming parser of compile_commands.json.
+ *
+ * Only the "directory" and "file" members of the objects of the top-level array
+ * are kept; every other value, such as the command line, is skipped byte by byte
+ * without being stored. The resolved source and test directories of the library
+ * select the units that are inspected.
+ */
+typedef struct
+{
+  char key[COMPILE_COMMANDS_LENGTH_KEY];
+  char directory[PATH_MAX];
+  char file[PATH_MAX];
+  char string[PATH_MAX];
+  size_t string_length;
+  uint32_t depth;
+  bool is_string;
+  bool is_escape;
+  bool is_key;
+  bool is_truncated;
+  char sources[INSPECTION_MAX_PATHS][PATH_MAX];
+  char tests[INSPECTION_MAX_PATHS][PATH_MAX];
+} compile_commands_t;
+
+/**
+ * Represents the state of the inspection of one library: its configuration, the
+ * declarations with their definitions and coverages, the invalid tests and the
+ * interned symbols of its files.
+ */
+struct inspection
+{
+  inspection_config_t config;
+
+  declaration_t decls[MAX_PROTOTYPES];
+  uint32_t decls_count;
+
+  coverage_t tests[MAX_TESTS];
+  uint32_t tests_count;
+
+  fingerprint_t fingerprints[MAX_PROTOTYPES];
+  uint32_t fingerprints_count;
+
+  symbols_t symbols;
+
+  unit_t *units;
+  uint32_t units_count;
+  uint32_t units_capacity;
+  bool has_compile_commands;
+
+  bool has_coverage;
+
+  /* Loaded and failed stages, see stage_t */
+  uint32_t stages_loaded;
+  uint32_t stages_failed;
+
+  /* Report Flags */
+  bool print_undefined;
+  bool print_uncovered;
+  bool print_missing_test_files;
+  bool print_test_mismatches;
+  bool print_prototype_mismatches;
+  bool print_invalid_tests;
+  bool print_unexecuted;
+  bool print_signature_changes;
+};
+
+/**
+ * Represents a watched directory of a library, which is either the directory of an
+ * include file or a source or test directory.
+ */
+typedef struct
+{
+  int32_t descriptor;
+  uint32_t library;
+  const char *directory;
+  const char *include_name;
+  bool is_source;
+} watch_t;
+
+/**
+ * Represents a changed source or test file of a library.
+ */
+typedef struct
+{
+  uint32_t library;
+  char path[INSPECTION_LENGTH_PATH * 2U];
+  bool is_source;
+} change_t;
+
+/* Miscellaneous Utilities */
+static bool file_exists (const char *path);
+static bool string_ends_with (const char *string, const char *suffix);
+static bool path_join (char *buffer, size_t size, const char *directory, const char *name);
+
+/* String Utilities */
+static char *string_get_spacing_dots (int32_t length, char *buffer);
+static bool character_is_space (char character);
+static bool character_is_digit (char character);
+static bool character_is_identifier (char character, bool is_digit_allowed);
+
+/* Symbol Table */
+static uint32_t symbol_lookup (symbols_t *symbols, const char *text, uint32_t length, bool is_insert);
+static uint32_t symbol_find (symbols_t *symbols, const char *text, uint32_t length, uint32_t hash, bool is_insert);
+static uint32_t symbol_hash_step (uint32_t hash, char character);
+static void symbols_reset (symbols_t *symbols);
+
+/* Source Utilities */
+static bool source_load (symbols_t *symbols, const char *path, source_t *source);
+static bool source_tokenize (source_t *source, size_t offset, bool is_line_start);
+static size_t source_skip_block_comment (const char *text, size_t index, size_t size, uint32_t *line);
+static size_t source_append_text (source_t *source, const char *text, size_t length);
+static bool source_expand (const inspection_t *inspection, source_t *source, const char *path);
+static void source_release (source_t *source);
+static bool source_append_token (source_t *source, token_kind_t kind, uint32_t line, size_t begin, size_t end, uint32_t hash);
+static uint32_t source_skip_comments (const source_t *source, uint32_t index);
+static uint32_t source_find_closing (const source_t *source, uint32_t index);
+static bool source_is_punctuator (const source_t *source, uint32_t index, char punctuator);
+static uint32_t source_get_symbol (const source_t *source, uint32_t index);
+static bool source_get_parameters (const source_t *source, uint32_t open, uint32_t close, uint32_t *parameters, uint32_t *count);
+
+/* Macro Expansion */
+static void macros_collect (const inspection_t *inspection, macros_t *macros, const source_t *source, const char *path);
+static void macros_define (const inspection_t *inspection, macros_t *macros, const char *text, size_t length);
+static void macros_include (const inspection_t *inspection, macros_t *macros, const char *text, size_t length, const char *path);
+static size_t macros_skip_spaces (const char *text, size_t length, size_t index);
+static macro_t *macros_find (macros_t *macros, const token_t *token);
+static bool macros_expand (macros_t *macros, source_t *source, const token_t *tokens, uint32_t count, token_list_t *output, uint32_t depth);
+static uint32_t macros_split (const source_t *source, const macro_t *macro, const token_t *tokens, uint32_t open, uint32_t count,
+                              uint32_t (*arguments)[2]);
+static bool macros_substitute (macros_t *macros, source_t *source, const macro_t *macro, const token_t *tokens, const uint32_t (*arguments)[2],
+                               uint32_t line, token_list_t *output, uint32_t depth);
+static uint32_t macros_parameter (const macro_t *macro, const token_t *token);
+static bool macros_is_paste (const source_t *definitions, uint32_t index, uint32_t end);
+static bool macros_stringify (source_t *source, const token_t *tokens, const uint32_t *argument, uint32_t line, token_list_t *output);
+static bool macros_paste (source_t *source, token_list_t *output, const source_t *from, const token_t *token, uint32_t line);
+static bool token_list_append (source_t *source, token_list_t *list, const source_t *from, const token_t *token, uint32_t line);
+static bool token_is_punctuator (const source_t *source, const token_t *token, char punctuator);
+
+/* Signatures */
+static bool signature_build (const inspection_t *inspection, const source_t *source, uint32_t begin, uint32_t name, uint32_t open,
+                             uint32_t close, signature_t *signature);
+static bool signature_equals (const signature_t *signature, const signature_t *other);
+static const fingerprint_t *fingerprints_find (const inspection_t *inspection, const char *function_name);
+static void fingerprints_load (inspection_t *inspection);
+
+/* Runtime Coverage */
+static void coverage_load (inspection_t *inspection);
+
+/* Compile Commands */
+static bool compile_commands_load (inspection_t *inspection);
+static void compile_commands_parse (inspection_t *inspection, compile_commands_t *parser, char character);
+static void compile_commands_add (inspection_t *inspection, const compile_commands_t *parser);
+static bool compile_commands_contains (const char (*directories)[PATH_MAX], const char *path);
+static int compile_commands_compare (const void *lhs, const void *rhs);
+static void compile_commands_release (inspection_t *inspection);
+
+/* Declarations Management */
+static bool decls_append (inspection_t *inspection, const source_t *source, uint32_t include_index, uint32_t begin, uint32_t end,
+                          bool is_inline);
+static declaration_t *decls_find (inspection_t *inspection, uint32_t symbol);
+static bool decls_update_tests (inspection_t *inspection, const source_t *source, const char *test_path);
+static void decls_update_definitions (inspection_t *inspection, const source_t *source, const char *src_path);
+static bool decls_update_annotations (inspection_t *inspection, const source_t *source, const token_t *comment, const char *test_path);
+static bool decls_update_test (inspection_t *inspection, const source_t *source, const token_t *name, uint32_t line_number, const char *test_path);
+
+/* Invalid Test Management */
+static bool tests_append (inspection_t *inspection, const char *test_path, uint32_t line_number);
+static void tests_remove (inspection_t *inspection, uint32_t index);
+
+/* Declaration Management */
+static bool declaration_add_coverage (declaration_t *declaration, const char *test_path, uint32_t line_number, bool is_annotation);
+static void declaration_remove_coverages (declaration_t *declaration, const char *test_path);
+static void declaration_remove_definition (declaration_t *declaration);
+static void declaration_update_validation (const inspection_t *inspection, declaration_t *declaration, const source_t *source, uint32_t begin,
+                                          uint32_t name, uint32_t open, uint32_t close);
+static void declaration_update_test_file (const inspection_t *inspection, declaration_t *declaration);
+
+/* Project Loaders */
+static bool load_prototypes (inspection_t *inspection);
+static bool load_definitions (inspection_t *inspection);
+static void load_source (inspection_t *inspection, const char *path);
+static bool load_tests (inspection_t *inspection);
+static bool load_test (inspection_t *inspection, const char *path);
+
+/* Inspection */
+static bool stage_load (inspection_t *inspection, stage_t stage);
+static uint32_t stage_dependencies (inspection_report_t report);
+static bool inspection_update_source (inspection_t *inspection, const char *path);
+static bool inspection_update_test (inspection_t *inspection, const char *path);
+static void status_update (inspection_t *inspection);
+
+/* Reports */
+static bool report_undefined (const inspection_t *inspection);
+static bool report_uncovered (const inspection_t *inspection);
+static bool report_missing_test_files (const inspection_t *inspection);
+static bool report_test_mismatches (const inspection_t *inspection);
+static bool report_prototype_mismatches (const inspection_t *inspection);
+static bool report_invalid_tests (const inspection_t *inspection);
+static bool report_unexecuted (const inspection_t *inspection);
+static bool report_signature_changes (const inspection_t *inspection);
+
+/* Watch Mode */
+static uint32_t watch_report (inspection_t *const *inspections, uint32_t count);
+
+/**
+ * Fills a configuration with the layout and naming conventions of this template.
+ *
+ * @param config The configuration to fill.
+ * @param root The root directory of the library.
+ */
+void
+inspection_config_init (inspection_config_t *config, const char *root)
+{
+  memset (config, 0, sizeof (inspection_config_t));
+  (void)snprintf (config->name, sizeof (config->name), "%s", root);
+  (void)inspection_config_add_path (config->includes, &config->includes_count, root, LIBRARY_PATH_INCLUDE);
+  (void)inspection_config_add_path (config->sources, &config->sources_count, root, LIBRARY_PATH_SRC);
+  (void)inspection_config_add_path (config->tests, &config->tests_count, root, LIBRARY_PATH_TEST);
+  (void)snprintf (config->api_prefix, sizeof (config->api_prefix), "%s", LIBRARY_PREFIX_API);
+  (void)snprintf (config->inline_prefix, sizeof (config->inline_prefix), "%s", LIBRARY_PREFIX_API_INLINE);
+  (void)snprintf (config->test_macro, sizeof (config->test_macro), "%s", FORMAT_TEST);
+  (void)snprintf (config->test_annotation, sizeof (config->test_annotation), "%s", FORMAT_TEST_ANNOTATION);
+  (void)snprintf (config->test_variation, sizeof (config->test_variation), "%s", FORMAT_TEST_VARIATION);
+  (void)snprintf (config->source_extension, sizeof (config->source_extension), "%s", LIBRARY_EXTENSION_SRC);
+  (void)snprintf (config->test_extension, sizeof (config->test_extension), "%s", LIBRARY_EXTENSION_TEST);
+}
+
+/**
+ * Appends a path to one of the path lists of a configuration.
+ *
+ * @param paths The path list to extend.
+ * @param count The number of paths in the list, incremented on success.
+ * @param root The directory relative paths are resolved against, or NULL to keep
+ * them relative to the working directory.
+ * @param path The path to append.
+ * @return true if the path was appended, false if the list is full or the path is
+ * too long.
+ */
+bool
+inspection_config_add_path (char (*paths)[INSPECTION_LENGTH_PATH], uint32_t *count, const char *root, const char *path)
+{
+  bool result = false;
+
+  if (*count < INSPECTION_MAX_PATHS)
+    {
+      result = ((root == NULL) || (path[0] == '/')) ? (snprintf (paths[*count], INSPECTION_LENGTH_PATH, "%s", path) < (int32_t)INSPECTION_LENGTH_PATH)
+                                                   : path_join (paths[*count], INSPECTION_LENGTH_PATH, root, path);
+      *count += result ? 1U : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * Creates the inspection state of a library.
+ *
+ * @param config The configuration of the library, which is copied.
+ * @return The inspection state, to be loaded with inspection_load and destroyed
+ * with inspection_destroy, or NULL if memory allocation fails.
+ */
+inspection_t *
+inspection_create (const inspection_config_t *config)
+{
+  inspection_t *result = calloc (1U, sizeof (inspection_t));
+  if (result != NULL)
+    {
+      result->config = *config;
+      fingerprints_load (result);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate the inspection of '%s'\n", config->name);
+    }
+
+  return result;
+}
+
+/**
+ * Destroys the inspection state of a library.
+ *
+ * @param inspection The inspection state, may be NULL.
+ */
+void
+inspection_destroy (inspection_t *inspection)
+{
+  if (inspection != NULL)
+    {
+      compile_commands_release (inspection);
+      free (inspection->symbols.text);
+      free (inspection);
+    }
+}
+
+/**
+ * Loads the data that a report depends on, unless it is already loaded.
+ *
+ * @param inspection The loaded inspection state.
+ * @param report The report to prepare.
+ * @return true if the data was loaded, false otherwise.
+ */
+bool
+inspection_prepare (inspection_t *inspection, inspection_report_t report)
+{
+  bool result = true;
+  uint32_t stages = stage_dependencies (report);
+
+  for (uint32_t stage = STAGE_UNITS; stage <= STAGE_EXECUTIONS; stage <<= 1U)
+    {
+      result = (((stages & stage) != 0U) ? stage_load (inspection, (stage_t)stage) : true) && result;
+    }
+
+  return result;
+}
+
+/**
+ * Prints one report of a library if it has something to report, loading the data
+ * it depends on first.
+ *
+ * @param inspection The loaded inspection state.
+ * @param report The report to print.
+ * @return true if the report was printed or its data could not be loaded, false
+ * if there is nothing to report.
+ */
+bool
+inspection_report (inspection_t *inspection, inspection_report_t report)
+{
+  bool result = false;
+
+  /* A report whose data cannot be loaded is an issue, the cause is already printed */
+  if (inspection_prepare (inspection, report) == false)
+    {
+      return true;
+    }
+
+  switch (report)
+    {
+    case INSPECTION_REPORT_UNDEFINED:
+      result = report_undefined (inspection);
+      break;
+    case INSPECTION_REPORT_UNCOVERED:
+      result = report_uncovered (inspection);
+      break;
+    case INSPECTION_REPORT_MISSING_TEST_FILES:
+      result = report_missing_test_files (inspection);
+      break;
+    case INSPECTION_REPORT_TEST_MISMATCHES:
+      result = report_test_mismatches (inspection);
+      break;
+    case INSPECTION_REPORT_PROTOTYPE_MISMATCHES:
+      result = report_prototype_mismatches (inspection);
+      break;
+    case INSPECTION_REPORT_INVALID_TESTS:
+      result = report_invalid_tests (inspection);
+      break;
+    case INSPECTION_REPORT_UNEXECUTED:
+      result = report_unexecuted (inspection);
+      break;
+    case INSPECTION_REPORT_SIGNATURE_CHANGES:
+      result = report_signature_changes (inspection);
+      break;
+    default:
+      break;
+    }
+
+  return result;
+}
+
+/**
+ * Prints every report of a library that describes an issue, followed by the
+ * informational signature changes.
+ *
+ * @param inspection The loaded inspection state.
+ * @return The number of printed issue reports.
+ */
+uint32_t
+inspection_report_all (inspection_t *inspection)
+{
+  uint32_t result = 0U;
+  for (uint32_t report = 0; report < INSPECTION_REPORT_SIGNATURE_CHANGES; ++report)
+    {
+      result += inspection_report (inspection, (inspection_report_t)report) ? 1U : 0U;
+    }
+  (void)inspection_report (inspection, INSPECTION_REPORT_SIGNATURE_CHANGES);
+
+  return result;
+}
+
+/**
+ * Prints the prototypes that have no definition.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_undefined (const inspection_t *inspection)
+{
+  if (inspection->print_undefined)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_ERROR "Define the following prototype declarations: " REPORT_END);
+      char dots_buffer[REPORT_ALIGNMENT_DOTS + 1] = { 0 };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+          if (declaration->definition_line_number == 0)
+            {
+              int32_t name_count = printf (" - %s", declaration->function_name);
+              (void)printf ("%s", string_get_spacing_dots (name_count, dots_buffer));
+              (void)printf ("(%s:%u)\n", inspection->config.includes[declaration->include_index], declaration->declaration_line_number);
+            }
+        }
+    }
+
+  return inspection->print_undefined;
+}
+
+/**
+ * Prints the defined prototypes that are not covered by any test.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_uncovered (const inspection_t *inspection)
+{
+  if (inspection->print_uncovered)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_WARN "Create tests for the following declarations: " REPORT_END);
+      char dots_buffer[REPORT_ALIGNMENT_DOTS + 1] = { 0 };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+          if ((declaration->coverages_count == 0) && (declaration->definition_line_number > 0))
+            {
+              int32_t name_count = printf (" - %s", declaration->function_name);
+              (void)printf ("%s", string_get_spacing_dots (name_count, dots_buffer));
+              (void)printf ("(%s:%u) => Expected in: %s\n", declaration->source_path, declaration->definition_line_number,
+                            declaration->expected_test_path);
+            }
+        }
+    }
+
+  return inspection->print_uncovered;
+}
+
+/**
+ * Prints the test files that are expected but do not exist.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_missing_test_files (const inspection_t *inspection)
+{
+  if (inspection->print_missing_test_files)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_ERROR "Create the following test files: " REPORT_END);
+      bool visited[MAX_PROTOTYPES] = { false };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+          if (((declaration->coverages_count == 0) || (declaration->coverage_annotation_count < declaration->coverages_count))
+              && (declaration->definition_line_number > 0) && (declaration->has_test_file == false) && (visited[i] == false))
+            {
+              (void)printf (" - %s\n", declaration->expected_test_path);
+              for (uint32_t j = i + 1U; j < inspection->decls_count; ++j)
+                {
+                  if (strcmp (declaration->expected_test_path, inspection->decls[j].expected_test_path) == 0)
+                    {
+                      visited[j] = true;
+                    }
+                }
+            }
+        }
+    }
+
+  return inspection->print_missing_test_files;
+}
+
+/**
+ * Prints the tests that are not located in the test file of their source file.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_test_mismatches (const inspection_t *inspection)
+{
+  if (inspection->print_test_mismatches)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_WARN "Move the following tests to their expected location: " REPORT_END);
+      char dots_buffer[REPORT_ALIGNMENT_DOTS + 1] = { 0 };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+          for (uint32_t j = 0; j < declaration->coverages_count; ++j)
+            {
+              if ((declaration->coverages[j].is_annotation == false)
+                  && (strcmp (declaration->coverages[j].test_path, declaration->expected_test_path) != 0))
+                {
+                  int32_t name_count = printf (" - %s", declaration->function_name);
+                  (void)printf ("%s", string_get_spacing_dots (name_count, dots_buffer));
+                  (void)printf ("(%s:%u) => Expected in: %s\n", declaration->coverages[j].test_path, declaration->coverages[j].line,
+                                declaration->expected_test_path);
+                }
+            }
+        }
+    }
+
+  return inspection->print_test_mismatches;
+}
+
+/**
+ * Prints the definitions whose signature differs from their prototype.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_prototype_mismatches (const inspection_t *inspection)
+{
+  if (inspection->print_prototype_mismatches)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_WARN "Make sure that the signatures of the following definitions match their prototype: " REPORT_END);
+      char dots_buffer[REPORT_ALIGNMENT_DOTS + 1] = { 0 };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+
+          if ((declaration->definition_line_number > 0) && (declaration->is_prototype_match == false))
+            {
+              int32_t name_count = printf (" - %s", declaration->function_name);
+              (void)printf ("%s", string_get_spacing_dots (name_count, dots_buffer));
+              (void)printf ("(%s:%u)\n", declaration->source_path, declaration->definition_line_number);
+            }
+        }
+    }
+
+  return inspection->print_prototype_mismatches;
+}
+
+/**
+ * Prints the tests that do not match any prototype.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_invalid_tests (const inspection_t *inspection)
+{
+  if (inspection->print_invalid_tests)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_WARN "Make sure that the following test names match an API endpoint or follow the variation format: " REPORT_END);
+      const coverage_t *invalid_test = NULL;
+
+      for (uint32_t i = 0; i < inspection->tests_count; ++i)
+        {
+          invalid_test = &inspection->tests[i];
+          (void)printf (" - %s:%d\n", invalid_test->test_path, invalid_test->line);
+        }
+    }
+
+  return inspection->print_invalid_tests;
+}
+
+/**
+ * Prints the defined prototypes that the tests did not execute according to the
+ * runtime coverage file.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_unexecuted (const inspection_t *inspection)
+{
+  if (inspection->print_unexecuted)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_WARN "Make sure that the tests execute the following declarations: " REPORT_END);
+      char dots_buffer[REPORT_ALIGNMENT_DOTS + 1] = { 0 };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+          if ((declaration->is_executed == false) && (declaration->is_inline == false) && (declaration->definition_line_number > 0))
+            {
+              int32_t name_count = printf (" - %s", declaration->function_name);
+              (void)printf ("%s", string_get_spacing_dots (name_count, dots_buffer));
+              (void)printf ("(%s:%u)\n", declaration->source_path, declaration->definition_line_number);
+            }
+        }
+    }
+
+  return inspection->print_unexecuted;
+}
+
+/**
+ * Prints the prototypes whose signature changed since the fingerprints were last
+ * recorded.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the report was printed, false if there is nothing to report.
+ */
+static bool
+report_signature_changes (const inspection_t *inspection)
+{
+  if (inspection->print_signature_changes)
+    {
+      (void)printf ("\n");
+      (void)printf (REPORT_INFO "The signatures of the following declarations changed since the last run: " REPORT_END);
+      char dots_buffer[REPORT_ALIGNMENT_DOTS + 1] = { 0 };
+      const declaration_t *declaration = NULL;
+
+      for (uint32_t i = 0; i < inspection->decls_count; ++i)
+        {
+          declaration = &inspection->decls[i];
+          const fingerprint_t *fingerprint = fingerprints_find (inspection, declaration->function_name);
+
+          if ((fingerprint != NULL) && (fingerprint->fingerprint != declaration->signature.fingerprint))
+            {
+              int32_t name_count = printf (" - %s", declaration->function_name);
+              (void)printf ("%s", string_get_spacing_dots (name_count, dots_buffer));
+              (void)printf ("(%s:%u)\n", inspection->config.includes[declaration->include_index], declaration->declaration_line_number);
+            }
+        }
+    }
+
+  return inspection->print_signature_changes;
+}
+
+/**
+ * Determines which reports have something to report.
+ *
+ * @param inspection The inspection state of the library.
+ */
+static void
+status_update (inspection_t *inspection)
+{
+  inspection->print_undefined = false;
+  inspection->print_uncovered = false;
+  inspection->print_missing_test_files = false;
+  inspection->print_test_mismatches = false;
+  inspection->print_prototype_mismatches = false;
+  inspection->print_invalid_tests = inspection->tests_count > 0;
+  inspection->print_unexecuted = false;
+  inspection->print_signature_changes = false;
+
+  const declaration_t *declaration = NULL;
+  for (uint32_t i = 0; i < inspection->decls_count; ++i)
+    {
+      declaration = &inspection->decls[i];
+
+      /* Check for test definition mismatches, excluding annotations */
+      for (uint32_t j = 0; (j < declaration->coverages_count) && (inspection->print_test_mismatches == false); ++j)
+        {
+          if ((declaration->coverages[j].is_annotation == false)
+              && (strcmp (declaration->coverages[j].test_path, declaration->expected_test_path) != 0))
+            {
+              inspection->print_test_mismatches = true;
+            }
+        }
+
+      /* If not all are annotated, tests should be defined within a test file */
+      if (((declaration->coverages_count == 0) || (declaration->coverage_annotation_count < declaration->coverages_count))
+          && (declaration->definition_line_number > 0) && (declaration->has_test_file == false))
+        {
+          inspection->print_missing_test_files = true;
+        }
+
+      /* Check if the prototype has been defined */
+      if (declaration->definition_line_number == 0)
+        {
+          inspection->print_undefined = true;
+        }
+
+      /* Check if the prototype has any coverage at all */
+      if ((declaration->coverages_count == 0) && (declaration->definition_line_number > 0))
+        {
+          inspection->print_uncovered = true;
+        }
+
+      /* Check if the definition fully matches the prototype */
+      if ((declaration->definition_line_number > 0) && (declaration->is_prototype_match == false))
+        {
+          inspection->print_prototype_mismatches = true;
+        }
+
+      /* Check if the tests executed the definition, if the runtime coverage is known; inline functions are not instrumented */
+      if (inspection->has_coverage && (declaration->definition_line_number > 0) && (declaration->is_executed == false)
+          && (declaration->is_inline == false))
+        {
+          inspection->print_unexecuted = true;
+        }
+
+      /* Check if the prototype changed since the fingerprints were recorded */
+      const fingerprint_t *fingerprint = fingerprints_find (inspection, declaration->function_name);
+      if ((fingerprint != NULL) && (fingerprint->fingerprint != declaration->signature.fingerprint))
+        {
+          inspection->print_signature_changes = true;
+        }
+    }
+}
+
+/**
+ * Loads the prototypes of a library from scratch.
+ *
+ * Every report depends on the prototypes, while the definitions, coverages and
+ * runtime executions are only loaded by the first report that depends on them, so
+ * that a single check only reads the files it needs.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the prototypes were loaded, false otherwise.
+ */
+bool
+inspection_load (inspection_t *inspection)
+{
+  memset (inspection->decls, 0, sizeof (inspection->decls));
+  inspection->decls_count = 0U;
+  inspection->tests_count = 0U;
+  symbols_reset (&inspection->symbols);
+  inspection->has_coverage = false;
+  inspection->stages_loaded = 0U;
+  inspection->stages_failed = 0U;
+
+  return stage_load (inspection, STAGE_PROTOTYPES);
+}
+
+/**
+ * Loads a stage of the data of a library after the stages it depends on.
+ *
+ * A stage is loaded once; a failed stage is remembered and not retried until the
+ * next inspection_load.
+ *
+ * @param inspection The inspection state of the library.
+ * @param stage The stage to load.
+ * @return true if the stage is loaded, false if it or a dependency failed.
+ */
+static bool
+stage_load (inspection_t *inspection, stage_t stage)
+{
+  if ((inspection->stages_loaded & (uint32_t)stage) == 0U)
+    {
+      bool result = false;
+      switch (stage)
+        {
+        case STAGE_UNITS:
+          result = compile_commands_load (inspection);
+          break;
+        case STAGE_PROTOTYPES:
+          result = load_prototypes (inspection);
+          break;
+        case STAGE_DEFINITIONS:
+          result = stage_load (inspection, STAGE_UNITS) && stage_load (inspection, STAGE_PROTOTYPES) && load_definitions (inspection);
+          break;
+        case STAGE_COVERAGES:
+          result = stage_load (inspection, STAGE_UNITS) && stage_load (inspection, STAGE_PROTOTYPES) && load_tests (inspection);
+          break;
+        case STAGE_EXECUTIONS:
+          result = stage_load (inspection, STAGE_PROTOTYPES);
+          if (result)
+            {
+              coverage_load (inspection);
+            }
+          break;
+        default:
+          break;
+        }
+
+      inspection->stages_loaded |= (uint32_t)stage;
+      inspection->stages_failed |= result ? 0U : (uint32_t)stage;
+      status_update (inspection);
+    }
+
+  return (inspection->stages_failed & (uint32_t)stage) == 0U;
+}
+
+/**
+ * Returns the stages a report depends on.
+ *
+ * @param report The report.
+ * @return The stages as a combination of stage_t flags.
+ */
+static uint32_t
+stage_dependencies (inspection_report_t report)
+{
+  uint32_t result = STAGE_PROTOTYPES;
+
+  switch (report)
+    {
+    case INSPECTION_REPORT_UNDEFINED:
+    case INSPECTION_REPORT_PROTOTYPE_MISMATCHES:
+      result = STAGE_DEFINITIONS;
+      break;
+    case INSPECTION_REPORT_UNCOVERED:
+    case INSPECTION_REPORT_MISSING_TEST_FILES:
+    case INSPECTION_REPORT_TEST_MISMATCHES:
+      result = STAGE_DEFINITIONS | STAGE_COVERAGES;
+      break;
+    case INSPECTION_REPORT_INVALID_TESTS:
+      result = STAGE_COVERAGES;
+      break;
+    case INSPECTION_REPORT_UNEXECUTED:
+      result = STAGE_DEFINITIONS | STAGE_EXECUTIONS;
+      break;
+    default:
+      break;
+    }
+
+  return result;
+}
+
+/**
+ * Re-evaluates the definitions after a source file was written or removed.
+ *
+ * Only the declarations defined in the file and the undefined declarations are
+ * searched again; the definitions found in other source files are kept.
+ *
+ * @param inspection The inspection state of the library.
+ * @param path The path of the source file.
+ * @return true if the definitions were updated, false otherwise.
+ */
+static bool
+inspection_update_source (inspection_t *inspection, const char *path)
+{
+  bool result = true;
+
+  /* Definitions that are not loaded yet will be read with the file as it is now */
+  if ((inspection->stages_loaded & (uint32_t)STAGE_DEFINITIONS) == 0U)
+    {
+      return result;
+    }
+
+  bool is_orphaned = false;
+  for (uint32_t i = 0; i < inspection->decls_count; ++i)
+    {
+      if ((inspection->decls[i].definition_line_number > 0) && (strcmp (inspection->decls[i].source_path, path) == 0))
+        {
+          declaration_remove_definition (&inspection->decls[i]);
+          is_orphaned = true;
+        }
+    }
+
+  if (file_exists (path))
+    {
+      load_source (inspection, path);
+    }
+
+  /* A definition removed from the file may still exist in another one */
+  for (uint32_t i = 0; is_orphaned && (i < inspection->decls_count); ++i)
+    {
+      if (inspection->decls[i].definition_line_number == 0)
+        {
+          result = load_definitions (inspection);
+          break;
+        }
+    }
+
+  status_update (inspection);
+
+  return result;
+}
+
+/**
+ * Re-evaluates the coverages after a test file was written or removed.
+ *
+ * The coverages and tests of the file are dropped and read again, while those of
+ * other test files are kept.
+ *
+ * @param inspection The inspection state of the library.
+ * @param path The path of the test file.
+ * @return true if the coverages were updated, false otherwise.
+ */
+static bool
+inspection_update_test (inspection_t *inspection, const char *path)
+{
+  bool result = true;
+
+  /* Coverages that are not loaded yet will be read with the file as it is now */
+  if ((inspection->stages_loaded & (uint32_t)STAGE_COVERAGES) == 0U)
+    {
+      return result;
+    }
+
+  for (uint32_t i = 0; i < inspection->decls_count; ++i)
+    {
+      declaration_remove_coverages (&inspection->decls[i], path);
+    }
+
+  for (uint32_t i = inspection->tests_count; i-- > 0U;)
+    {
+      if (strcmp (inspection->tests[i].test_path, path) == 0)
+        {
+          tests_remove (inspection, i);
+        }
+    }
+
+  if (file_exists (path))
+    {
+      result = load_test (inspection, path);
+    }
+
+  /* The file may have been created or removed */
+  for (uint32_t i = 0; i < inspection->decls_count; ++i)
+    {
+      if (inspection->decls[i].definition_line_number > 0)
+        {
+          declaration_update_test_file (inspection, &inspection->decls[i]);
+        }
+    }
+
+  status_update (inspection);
+
+  return result;
+}
+
+/**
+ * Watches the include files and the source and test directories of libraries,
+ * re-printing the reports whenever a file changes.
+ *
+ * Changes arriving within WATCH_DEBOUNCE_MS of each other are handled together. A
+ * change of an include file reloads its whole library, while changes of source and
+ * test files only re-evaluate the declarations that depend on them. The function
+ * only returns if the watches cannot be set up.
+ *
+ * @param inspections The loaded inspection states of the libraries.
+ * @param count The number of libraries.
+ */
+void
+inspection_watch (inspection_t *const *inspections, uint32_t count)
+{
+#ifdef __linux__
+  uint32_t watches_count = 0U;
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      const inspection_config_t *config = &inspections[i]->config;
+      watches_count += config->includes_count + config->sources_count + config->tests_count;
+    }
+
+  const uint32_t events = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+  int32_t watch_file = inotify_init1 (IN_CLOEXEC);
+  watch_t *watches = calloc (watches_count, sizeof (watch_t));
+  char (*include_directories)[INSPECTION_LENGTH_PATH] = calloc (watches_count, INSPECTION_LENGTH_PATH);
+  change_t *changes = calloc (WATCH_MAX_CHANGES, sizeof (change_t));
+  bool *reloads = calloc (count, sizeof (bool));
+  bool is_valid = (watch_file >= 0) && (watches != NULL) && (include_directories != NULL) && (changes != NULL) && (reloads != NULL);
+
+  /* Include files are watched through their directory, as editors replace files on save */
+  uint32_t watch = 0;
+  for (uint32_t i = 0; is_valid && (i < count); ++i)
+    {
+      inspection_config_t *config = &inspections[i]->config;
+      for (uint32_t j = 0; j < config->includes_count; ++j, ++watch)
+        {
+          (void)strcpy (include_directories[watch], config->includes[j]);
+          char *include_name = strrchr (include_directories[watch], '/');
+          if (include_name != NULL)
+            {
+              *include_name = '\0';
+            }
+          watches[watch].library = i;
+          watches[watch].directory = (include_name != NULL) ? include_directories[watch] : ".";
+          watches[watch].include_name = (include_name != NULL) ? &config->includes[j][include_name - include_directories[watch] + 1] : config->includes[j];
+        }
+      for (uint32_t j = 0; j < config->sources_count; ++j, ++watch)
+        {
+          watches[watch].library = i;
+          watches[watch].directory = config->sources[j];
+          watches[watch].is_source = true;
+        }
+      for (uint32_t j = 0; j < config->tests_count; ++j, ++watch)
+        {
+          watches[watch].library = i;
+          watches[watch].directory = config->tests[j];
+        }
+    }
+
+  for (watch = 0; is_valid && (watch < watches_count); ++watch)
+    {
+      watches[watch].descriptor = inotify_add_watch (watch_file, watches[watch].directory, events);
+      is_valid = (watches[watch].descriptor >= 0);
+    }
+
+  if (is_valid == false)
+    {
+      (void)fprintf (stderr, "Error: Unable to watch the project files for changes.\n");
+      if (watch_file >= 0)
+        {
+          (void)close (watch_file);
+        }
+      free (watches);
+      free (include_directories);
+      free (changes);
+      free (reloads);
+      return;
+    }
+
+  (void)watch_report (inspections, count);
+  (void)printf ("\nWatching %u directories of %u %s for changes.\n", watches_count, count, (count == 1U) ? "library" : "libraries");
+  (void)fflush (stdout);
+
+  for (;;)
+    {
+      uint32_t changes_count = 0U;
+      bool is_changed = false;
+      memset (reloads, 0, count * sizeof (bool));
+
+      /* Block until the first event, then collect the events of the same save */
+      struct pollfd poll_file = { watch_file, POLLIN, 0 };
+      int32_t timeout = -1;
+      while (poll (&poll_file, 1, timeout) > 0)
+        {
+          char buffer[4096] __attribute__ ((aligned (__alignof__ (struct inotify_event))));
+          ssize_t length = read (watch_file, buffer, sizeof (buffer));
+
+          for (ssize_t offset = 0; offset < length;)
+            {
+              const struct inotify_event *event = (const struct inotify_event *)&buffer[offset];
+              offset += (ssize_t)(sizeof (struct inotify_event) + event->len);
+
+              /* Libraries may share directories, so every watch of the descriptor is checked */
+              for (watch = 0; watch < watches_count; ++watch)
+                {
+                  const watch_t *entry = &watches[watch];
+                  const inspection_config_t *config = &inspections[entry->library]->config;
+                  const uint32_t library = entry->library;
+
+                  if ((event->mask & IN_Q_OVERFLOW) != 0U)
+                    {
+                      reloads[library] = true;
+                    }
+                  else if ((entry->descriptor != event->wd) || (event->len == 0U))
+                    {
+                      continue;
+                    }
+                  else if (entry->include_name != NULL)
+                    {
+                      reloads[library] = reloads[library] || (strcmp (event->name, entry->include_name) == 0);
+                    }
+                  else if (string_ends_with (event->name, entry->is_source ? config->source_extension : config->test_extension))
+                    {
+                      change_t change = { library, { 0 }, entry->is_source };
+                      (void)path_join (change.path, sizeof (change.path), entry->directory, event->name);
+
+                      uint32_t i = 0;
+                      while ((i < changes_count)
+                             && ((changes[i].library != change.library) || (changes[i].is_source != change.is_source)
+                                 || (strcmp (changes[i].path, change.path) != 0)))
+                        {
+                          ++i;
+                        }
+                      if ((i == changes_count) && (changes_count < WATCH_MAX_CHANGES))
+                        {
+                          changes[changes_count++] = change;
+                        }
+                      /* The compiled files are only known after rereading the compile commands */
+                      reloads[library] = reloads[library] || (i == WATCH_MAX_CHANGES) || inspections[library]->has_compile_commands;
+                    }
+                  is_changed = true;
+                }
+            }
+
+          timeout = WATCH_DEBOUNCE_MS;
+        }
+
+      if (is_changed == false)
+        {
+          continue;
+        }
+
+      struct timespec start = { 0 };
+      (void)clock_gettime (CLOCK_MONOTONIC, &start);
+
+      bool result = true;
+      for (uint32_t i = 0; i < count; ++i)
+        {
+          result = (reloads[i] ? inspection_load (inspections[i]) : true) && result;
+        }
+      for (uint32_t i = 0; i < changes_count; ++i)
+        {
+          inspection_t *inspection = inspections[changes[i].library];
+          if (reloads[changes[i].library] == false)
+            {
+              result = (changes[i].is_source ? inspection_update_source (inspection, changes[i].path) : inspection_update_test (inspection, changes[i].path))
+                       && result;
+            }
+        }
+
+      struct timespec end = { 0 };
+      (void)clock_gettime (CLOCK_MONOTONIC, &end);
+      double elapsed_ms = ((double)(end.tv_sec - start.tv_sec) * 1e3) + ((double)(end.tv_nsec - start.tv_nsec) / 1e6);
+
+      bool is_reload = false;
+      for (uint32_t i = 0; i < count; ++i)
+        {
+          is_reload = is_reload || reloads[i];
+        }
+
+      (void)printf ("\n--- %s after %s (%.3f ms) ---\n", is_reload ? "Reloaded" : "Re-evaluated", is_reload ? "include changes" : "file changes",
+                    elapsed_ms);
+      if (result == false)
+        {
+          (void)printf (REPORT_ERROR "The project could not be inspected, see the errors above." REPORT_END);
+        }
+      else
+        {
+          (void)watch_report (inspections, count);
+        }
+      (void)fflush (stdout);
+    }
+#else
+  (void)inspections;
+  (void)count;
+  (void)fprintf (stderr, "Error: Watch mode requires inotify and is only available on Linux.\n");
+#endif
+}
+
+/**
+ * Prints the reports of every watched library and records their fingerprints, so
+ * that the next evaluation reports the signature changes since this one.
+ *
+ * @param inspections The loaded inspection states of the libraries.
+ * @param count The number of libraries.
+ * @return The number of printed issue reports.
+ */
+static uint32_t
+watch_report (inspection_t *const *inspections, uint32_t count)
+{
+  uint32_t result = 0U;
+
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      if (count > 1U)
+        {
+          (void)printf ("\n== %s ==\n", inspections[i]->config.name);
+        }
+
+      uint32_t issues = inspection_report_all (inspections[i]);
+      if (issues == 0U)
+        {
+          (void)printf ("No inspection issues found.\n");
+        }
+
+      inspection_fingerprints_update (inspections[i]);
+      result += issues;
+    }
+
+  return result;
+}
+
+/**
+ * Check if a file exists.
+ *
+ * @param path The name of the file to be checked.
+ * @return Returns true if the file exists, and false otherwise.
+ */
+static bool
+file_exists (const char *path)
+{
+  struct stat buffer = { 0 };
+  return (stat (path, &buffer) == 0);
+}
+
+/**
+ * Checks if a string ends with a suffix.
+ *
+ * @param string The string to check.
+ * @param suffix The suffix to look for.
+ * @return true if the string ends with the suffix, false otherwise.
+ */
+static bool
+string_ends_with (const char *string, const char *suffix)
+{
+  size_t string_length = strlen (string);
+  size_t suffix_length = strlen (suffix);
+  return (string_length >= suffix_length) && (strcmp (&string[string_length - suffix_length], suffix) == 0);
+}
+
+/**
+ * Joins a directory and a file name into a path.
+ *
+ * @param buffer Receives the path.
+ * @param size The size of the buffer.
+ * @param directory The directory.
+ * @param name The name of the file within the directory.
+ * @return true if the path fits into the buffer, false if it was truncated.
+ */
+static bool
+path_join (char *buffer, size_t size, const char *directory, const char *name)
+{
+  size_t directory_length = strlen (directory);
+  size_t name_length = strlen (name);
+  bool result = (directory_length + name_length + 2U) <= size;
+
+  if (result)
+    {
+      memcpy (buffer, directory, directory_length);
+      buffer[directory_length] = '/';
+      memcpy (&buffer[directory_length + 1U], name, name_length + 1U);
+    }
+
+  return result;
+}
+
+/**
+ * Generates a string of spacing dots based on the specified alignment requirements.
+ *
+ * @param length The length of the string.
+ * @param buffer The buffer to store the spacing dots. Should be large enough to hold (at least) MAX_DOTS + 1 for the null
+ * terminator.
+ * @return A pointer to the buffer containing the required number of spacing dots for alignment.
+ */
+static char *
+string_get_spacing_dots (int32_t length, char *buffer)
+{
+  uint32_t dots_needed = REPORT_ALIGNMENT_DOTS - (uint32_t)length;
+  dots_needed = (dots_needed < 1) ? 1 : dots_needed;
+  dots_needed = dots_needed > REPORT_ALIGNMENT_DOTS ? REPORT_ALIGNMENT_DOTS : dots_needed;
+
+  memset (buffer, '.', REPORT_ALIGNMENT_DOTS);
+  buffer[dots_needed] = '\0';
+
+  return buffer;
+}
+
+/**
+ * Checks if a character is white space in the C locale, without the call of isspace.
+ *
+ * @param character The character to check.
+ * @return true if the character is a space, tab, newline, vertical tab, form feed or carriage return.
+ */
+static bool
+character_is_space (char character)
+{
+  return (character == ' ') || ((uint8_t)(character - '\t') <= (uint8_t)('\r' - '\t'));
+}
+
+/**
+ * Checks if a character is a decimal digit, without the call of isdigit.
+ *
+ * @param character The character to check.
+ * @return true if the character is a decimal digit, false otherwise.
+ */
+static bool
+character_is_digit (char character)
+{
+  return (uint8_t)(character - '0') <= 9U;
+}
+
+/**
+ * Checks if a character may appear in an identifier, without the calls of isalpha and isalnum.
+ *
+ * @param character The character to check.
+ * @param is_digit_allowed Whether digits are accepted, which they are not at the start of an identifier.
+ * @return true if the character is an ASCII letter, an underscore or an accepted digit, false otherwise.
+ */
+static bool
+character_is_identifier (char character, bool is_digit_allowed)
+{
+  return ((uint8_t)((character | 0x20) - 'a') < 26U) || (character == '_') || (is_digit_allowed && character_is_digit (character));
+}
+
+/**
+ * Looks up the symbol of a text, optionally interning it.
+ *
+ * Symbols are dense indices into a pool of null-terminated strings, so equal texts
+ * compare equal by their symbol alone. Single characters, which include every
+ * punctuator, are found by their index once interned.
+ *
+ * @param symbols The symbol table.
+ * @param text The text of the symbol, not necessarily null-terminated.
+ * @param length The length of the text.
+ * @param is_insert Whether to intern the text if it is not known yet.
+ * @return The symbol of the text, or SYMBOL_NONE if it is unknown and not inserted
+ * or the symbol table is full.
+ */
+static uint32_t
+symbol_lookup (symbols_t *symbols, const char *text, uint32_t length, bool is_insert)
+{
+  uint32_t result = SYMBOL_NONE;
+  uint32_t *character = (length == 1U) ? &symbols->characters[(uint8_t)text[0]] : NULL;
+
+  if ((character != NULL) && (*character != 0U))
+    {
+      result = *character - 1U;
+    }
+  else
+    {
+      uint32_t hash = SYMBOL_FNV_OFFSET;
+      for (uint32_t i = 0; i < length; ++i)
+        {
+          hash = symbol_hash_step (hash, text[i]);
+        }
+
+      result = symbol_find (symbols, text, length, hash, is_insert);
+      if ((character != NULL) && (result != SYMBOL_NONE))
+        {
+          *character = result + 1U;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Looks up the symbol of a text by its hash, optionally interning it.
+ *
+ * The lexer hashes identifiers while scanning them, so that their texts are not
+ * read a second time to intern them.
+ *
+ * @param symbols The symbol table.
+ * @param text The text of the symbol, not necessarily null-terminated.
+ * @param length The length of the text.
+ * @param hash The hash of the text, see symbol_hash_step.
+ * @param is_insert Whether to intern the text if it is not known yet.
+ * @return The symbol of the text, or SYMBOL_NONE if it is unknown and not inserted
+ * or the symbol table is full.
+ */
+static uint32_t
+symbol_find (symbols_t *symbols, const char *text, uint32_t length, uint32_t hash, bool is_insert)
+{
+  uint32_t result = SYMBOL_NONE;
+
+  uint32_t slot = hash & (SYMBOL_TABLE_SIZE - 1U);
+  while (symbols->table[slot] != 0U)
+    {
+      uint32_t symbol = symbols->table[slot] - 1U;
+      if ((symbols->lengths[symbol] == length) && (memcmp (&symbols->text[symbols->offsets[symbol]], text, length) == 0))
+        {
+          result = symbol;
+          break;
+        }
+      slot = (slot + 1U) & (SYMBOL_TABLE_SIZE - 1U);
+    }
+
+  if ((result == SYMBOL_NONE) && is_insert)
+    {
+      if ((symbols->text_size + length + 1U) > symbols->text_capacity)
+        {
+          uint32_t capacity = (symbols->text_capacity > 0U) ? (symbols->text_capacity * 2U) : 65536U;
+          capacity = ((symbols->text_size + length + 1U) > capacity) ? (symbols->text_size + length + 1U) : capacity;
+          char *symbol_text = realloc (symbols->text, capacity);
+          if (symbol_text != NULL)
+            {
+              symbols->text = symbol_text;
+              symbols->text_capacity = capacity;
+            }
+        }
+
+      if ((symbols->count < MAX_SYMBOLS) && ((symbols->text_size + length + 1U) <= symbols->text_capacity))
+        {
+          result = symbols->count++;
+          symbols->offsets[result] = symbols->text_size;
+          symbols->lengths[result] = length;
+          symbols->slots[result] = slot;
+          memcpy (&symbols->text[symbols->text_size], text, length);
+          symbols->text[symbols->text_size + length] = '\0';
+          symbols->text_size += length + 1U;
+          symbols->table[slot] = result + 1U;
+        }
+      else
+        {
+          (void)fprintf (stderr, "Error: Maximum number of symbols reached.\n");
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Hashes one more character of a text with FNV-1a, starting from SYMBOL_FNV_OFFSET.
+ *
+ * @param hash The hash of the preceding characters.
+ * @param character The next character.
+ * @return The hash including the character.
+ */
+static uint32_t
+symbol_hash_step (uint32_t hash, char character)
+{
+  return (hash ^ (uint8_t)character) * SYMBOL_FNV_PRIME;
+}
+
+/**
+ * Empties the symbol table, keeping its text pool for reuse. Only the slots of the
+ * interned symbols are cleared, rather than the whole table on every load.
+ *
+ * @param symbols The symbol table.
+ */
+static void
+symbols_reset (symbols_t *symbols)
+{
+  for (uint32_t i = 0; i < symbols->count; ++i)
+    {
+      symbols->table[symbols->slots[i]] = 0U;
+    }
+  memset (symbols->characters, 0, sizeof (symbols->characters));
+  symbols->text_size = 0U;
+  symbols->count = 0U;
+}
+
+/**
+ * Reads a file into memory and splits it into tokens.
+ *
+ * @param symbols The symbol table interning the symbols of the tokens.
+ * @param path The path of the file to read.
+ * @param source The source receiving the file and its tokens, to be released with
+ * source_release.
+ * @return true if the file was read and tokenized, false otherwise.
+ */
+static bool
+source_load (symbols_t *symbols, const char *path, source_t *source)
+{
+  bool result = false;
+  memset (source, 0, sizeof (source_t));
+  source->symbols = symbols;
+
+  FILE *file = fopen (path, "rb");
+  if (file != NULL)
+    {
+      long size = ((fseek (file, 0, SEEK_END) == 0) ? ftell (file) : -1L);
+      if ((size >= 0L) && (fseek (file, 0, SEEK_SET) == 0))
+        {
+          source->text = malloc ((size_t)size + 1U);
+          if (source->text != NULL)
+            {
+              source->size = fread (source->text, 1U, (size_t)size, file);
+              source->capacity = (size_t)size + 1U;
+              source->text[source->size] = '\0';
+              result = true;
+            }
+        }
+      (void)fclose (file);
+    }
+
+  result = result && source_tokenize (source, 0U, true);
+
+  if ((result == false) && (source->text != NULL))
+    {
+      source_release (source);
+    }
+
+  return result;
+}
+
+/**
+ * Splits the text of a source into tokens, from an offset to its end.
+ *
+ * The lexer recognizes identifiers, numbers, string and character literals,
+ * comments and preprocessor directives; every other character is a punctuator of
+ * its own. Line numbers are attached to every token, so that the file never has to
+ * be scanned again.
+ *
+ * @param source The source whose text to tokenize.
+ * @param offset The offset at which to start.
+ * @param is_line_start Whether the offset starts a line, where a '#' begins a
+ * directive rather than a punctuator.
+ * @return true if the text was tokenized, false if memory or symbols ran out.
+ */
+static bool
+source_tokenize (source_t *source, size_t offset, bool is_line_start)
+{
+  bool result = true;
+  const char *text = source->text;
+  size_t size = source->size;
+  size_t i = offset;
+  uint32_t line = 1U;
+
+  while (result && (i < size))
+    {
+      char current = text[i];
+      if (character_is_space (current))
+        {
+          /* Indentation comes in runs, which are skipped without returning to the token dispatch */
+          for (; (i < size) && character_is_space (text[i]); ++i)
+            {
+              line += (text[i] == '\n') ? 1U : 0U;
+              is_line_start = is_line_start || (text[i] == '\n');
+            }
+          continue;
+        }
+
+      size_t begin = i;
+      uint32_t begin_line = line;
+      uint32_t hash = SYMBOL_FNV_OFFSET;
+      token_kind_t kind = TOKEN_PUNCTUATOR;
+
+      if ((current == '/') && (text[i + 1U] == '/'))
+        {
+          kind = TOKEN_COMMENT;
+          const char *end = memchr (&text[i], '\n', size - i);
+          i = (end != NULL) ? (size_t)(end - text) : size;
+        }
+      else if ((current == '/') && (text[i + 1U] == '*'))
+        {
+          kind = TOKEN_COMMENT;
+          i = source_skip_block_comment (text, i + 2U, size, &line);
+        }
+      else if ((current == '#') && is_line_start)
+        {
+          /* Directives end at the first newline that is neither escaped nor inside a comment */
+          kind = TOKEN_DIRECTIVE;
+          while ((i < size) && (text[i] != '\n'))
+            {
+              if ((text[i] == '\\') && (text[i + 1U] == '\n'))
+                {
+                  ++line;
+                  i += 2U;
+                }
+              else if ((text[i] == '/') && (text[i + 1U] == '*'))
+                {
+                  i = source_skip_block_comment (text, i + 2U, size, &line);
+                }
+              else
+                {
+                  ++i;
+                }
+            }
+        }
+      else if ((current == '"') || (current == '\''))
+        {
+          kind = TOKEN_STRING;
+          ++i;
+          while ((i < size) && (text[i] != current) && (text[i] != '\n'))
+            {
+              i += ((text[i] == '\\') && ((i + 1U) < size)) ? 2U : 1U;
+            }
+          i += ((i < size) && (text[i] == current)) ? 1U : 0U;
+        }
+      else if (character_is_identifier (current, false))
+        {
+          kind = TOKEN_IDENTIFIER;
+          while ((i < size) && character_is_identifier (text[i], true))
+            {
+              hash = symbol_hash_step (hash, text[i]);
+              ++i;
+            }
+        }
+      else if (character_is_digit (current) || ((current == '.') && character_is_digit (text[i + 1U])))
+        {
+          kind = TOKEN_NUMBER;
+          ++i;
+          while ((i < size)
+                 && (character_is_identifier (text[i], true) || (text[i] == '.')
+                     || (((text[i] == '+') || (text[i] == '-')) && (strchr ("eEpP", text[i - 1U]) != NULL))))
+            {
+              ++i;
+            }
+        }
+      else
+        {
+          ++i;
+        }
+
+      is_line_start = false;
+      result = source_append_token (source, kind, begin_line, begin, i, hash);
+    }
+
+  return result;
+}
+
+/**
+ * Skips the rest of a block comment, counting the lines it spans.
+ *
+ * The comment is searched for its closing characters by memchr rather than by
+ * character, as block comments, mostly documentation, make up much of the files.
+ *
+ * @param text The text, null-terminated at its size.
+ * @param index The offset following the opening characters of the comment.
+ * @param size The size of the text.
+ * @param line Incremented by the number of newlines within the comment.
+ * @return The offset following the comment, or the size if it is not closed.
+ */
+static size_t
+source_skip_block_comment (const char *text, size_t index, size_t size, uint32_t *line)
+{
+  const char *star = memchr (&text[index], '*', size - index);
+  while ((star != NULL) && (star[1] != '/'))
+    {
+      star = memchr (&star[1], '*', size - (size_t)(&star[1] - text));
+    }
+
+  size_t result = (star != NULL) ? ((size_t)(star - text) + 2U) : size;
+  uint32_t lines = 0U;
+  for (size_t i = index; i < result; ++i)
+    {
+      lines += (text[i] == '\n') ? 1U : 0U;
+    }
+  *line += lines;
+
+  return result;
+}
+
+/**
+ * Appends text to a source, for the tokens that macro expansion generates.
+ *
+ * @param source The source to extend.
+ * @param text The text to append, which must not lie within the source.
+ * @param length The length of the text.
+ * @return The offset of the appended text, or SIZE_MAX if memory ran out.
+ */
+static size_t
+source_append_text (source_t *source, const char *text, size_t length)
+{
+  size_t result = SIZE_MAX;
+
+  if ((source->size + length + 1U) > source->capacity)
+    {
+      size_t capacity = (source->capacity * 2U) + length + 1U;
+      char *grown = realloc (source->text, capacity);
+      if (grown != NULL)
+        {
+          source->text = grown;
+          source->capacity = capacity;
+        }
+    }
+
+  if (((source->size + length + 1U) <= source->capacity) && ((source->size + length) < UINT32_MAX))
+    {
+      memcpy (&source->text[source->size], text, length);
+      result = source->size;
+      source->size += length;
+      source->text[source->size] = '\0';
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate the text of a file.\n");
+    }
+
+  return result;
+}
+
+/**
+ * Expands the invocations of function-like macros in a tokenized file.
+ *
+ * The macros are those defined in the file and in the files it includes with
+ * quotes, which are searched next to the including file and next to the include
+ * files of the library. Conditional directives are not evaluated, so the first
+ * definition of a macro applies. Object-like macros and the test macro are never
+ * expanded. The tokens of an expansion carry the line of the macro name.
+ *
+ * @param inspection The inspection state, providing the include files and the
+ * test macro.
+ * @param source The tokenized file, which is released if the expansion fails.
+ * @param path The path of the file.
+ * @return true if the file was expanded, false if memory or symbols ran out.
+ */
+static bool
+source_expand (const inspection_t *inspection, source_t *source, const char *path)
+{
+  bool result = false;
+
+  macros_t *macros = calloc (1U, sizeof (macros_t));
+  if (macros != NULL)
+    {
+      macros->definitions.symbols = source->symbols;
+      macros_collect (inspection, macros, source, path);
+
+      token_list_t output = { 0 };
+      result = (macros->count == 0U) || macros_expand (macros, source, source->tokens, source->tokens_count, &output, 0U);
+      if (result && (macros->count > 0U))
+        {
+          free (source->tokens);
+          source->tokens = output.tokens;
+          source->tokens_count = output.count;
+          source->tokens_capacity = output.capacity;
+        }
+      else
+        {
+          free (output.tokens);
+        }
+
+      source_release (&macros->definitions);
+      free (macros);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate the macros of a file.\n");
+    }
+
+  if (result == false)
+    {
+      source_release (source);
+    }
+
+  return result;
+}
+
+/**
+ * Releases the memory held by a source.
+ *
+ * @param source The source to release.
+ */
+static void
+source_release (source_t *source)
+{
+  free (source->text);
+  free (source->tokens);
+  memset (source, 0, sizeof (source_t));
+}
+
+/**
+ * Appends a token to a source, interning the symbol of identifiers and punctuators.
+ *
+ * @param source The source to extend.
+ * @param kind The kind of the token.
+ * @param line The line on which the token starts.
+ * @param begin The offset of the first character of the token.
+ * @param end The offset one past the last character of the token.
+ * @param hash The hash of an identifier, computed by the lexer while scanning it.
+ * @return true if the token was appended, false if memory or symbols ran out.
+ */
+static bool
+source_append_token (source_t *source, token_kind_t kind, uint32_t line, size_t begin, size_t end, uint32_t hash)
+{
+  bool result = true;
+
+  if (source->tokens_count == source->tokens_capacity)
+    {
+      uint32_t capacity = (source->tokens_capacity > 0U) ? (source->tokens_capacity * 2U) : (uint32_t)((source->size / 4U) + 16U);
+      token_t *tokens = realloc (source->tokens, capacity * sizeof (token_t));
+      if (tokens != NULL)
+        {
+          source->tokens = tokens;
+          source->tokens_capacity = capacity;
+        }
+      else
+        {
+          (void)fprintf (stderr, "Error: Unable to allocate the tokens of a file.\n");
+          result = false;
+        }
+    }
+
+  if (result)
+    {
+      token_t *token = &source->tokens[source->tokens_count++];
+      token->kind = kind;
+      token->line = line;
+      token->offset = (uint32_t)begin;
+      token->length = (uint32_t)(end - begin);
+      token->symbol = SYMBOL_NONE;
+
+      if (kind == TOKEN_IDENTIFIER)
+        {
+          token->symbol = symbol_find (source->symbols, &source->text[begin], token->length, hash, true);
+          result = (token->symbol != SYMBOL_NONE);
+        }
+      else if (kind == TOKEN_PUNCTUATOR)
+        {
+          token->symbol = symbol_lookup (source->symbols, &source->text[begin], token->length, true);
+          result = (token->symbol != SYMBOL_NONE);
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Finds the first code token at or after an index, skipping comments and directives.
+ *
+ * @param source The tokenized source.
+ * @param index The index to start at.
+ * @return The index of the code token, or the number of tokens if there is none.
+ */
+static uint32_t
+source_skip_comments (const source_t *source, uint32_t index)
+{
+  while ((index < source->tokens_count) && ((source->tokens[index].kind == TOKEN_COMMENT) || (source->tokens[index].kind == TOKEN_DIRECTIVE)))
+    {
+      ++index;
+    }
+
+  return index;
+}
+
+/**
+ * Finds the parenthesis closing the one at an index.
+ *
+ * @param source The tokenized source.
+ * @param index The index of an opening parenthesis.
+ * @return The index of the closing parenthesis, or the number of tokens if it is missing.
+ */
+static uint32_t
+source_find_closing (const source_t *source, uint32_t index)
+{
+  uint32_t depth = 0;
+
+  for (; index < source->tokens_count; index = source_skip_comments (source, index + 1U))
+    {
+      if (source_is_punctuator (source, index, '('))
+        {
+          ++depth;
+        }
+      else if (source_is_punctuator (source, index, ')') && (--depth == 0U))
+        {
+          break;
+        }
+    }
+
+  return index;
+}
+
+/**
+ * Checks if the token at an index is a given punctuator.
+ *
+ * @param source The tokenized source.
+ * @param index The index of the token, may be out of range.
+ * @param punctuator The punctuator character.
+ * @return true if the token is the punctuator, false otherwise.
+ */
+static bool
+source_is_punctuator (const source_t *source, uint32_t index, char punctuator)
+{
+  return (index < source->tokens_count) && token_is_punctuator (source, &source->tokens[index], punctuator);
+}
+
+/**
+ * Gets the symbol of a token, interning the text of a number on first use.
+ *
+ * @param source The tokenized source.
+ * @param index The index of the token.
+ * @return The symbol of the token, or SYMBOL_NONE if the symbol table is full.
+ */
+static uint32_t
+source_get_symbol (const source_t *source, uint32_t index)
+{
+  token_t *token = &source->tokens[index];
+  if ((token->kind == TOKEN_NUMBER) && (token->symbol == SYMBOL_NONE))
+    {
+      token->symbol = symbol_lookup (source->symbols, &source->text[token->offset], token->length, true);
+    }
+
+  return token->symbol;
+}
+
+/**
+ * Collects the symbols of a parameter list, ignoring comments and whitespace.
+ *
+ * @param source The tokenized source.
+ * @param open The index of the opening parenthesis of the list.
+ * @param close The index of the closing parenthesis of the list.
+ * @param parameters Receives up to MAX_PARAMETER_SYMBOLS symbols.
+ * @param count Receives the number of symbols.
+ * @return true if the list was collected, false if it exceeds MAX_PARAMETERS or
+ * MAX_PARAMETER_SYMBOLS.
+ */
+static bool
+source_get_parameters (const source_t *source, uint32_t open, uint32_t close, uint32_t *parameters, uint32_t *count)
+{
+  bool result = true;
+  uint32_t parameters_count = 1U;
+  uint32_t depth = 0;
+  *count = 0U;
+
+  for (uint32_t i = source_skip_comments (source, open + 1U); result && (i < close); i = source_skip_comments (source, i + 1U))
+    {
+      depth += source_is_punctuator (source, i, '(') ? 1U : 0U;
+      depth -= source_is_punctuator (source, i, ')') ? 1U : 0U;
+      parameters_count += ((depth == 0U) && source_is_punctuator (source, i, ',')) ? 1U : 0U;
+
+      uint32_t symbol = source_get_symbol (source, i);
+      if ((parameters_count <= MAX_PARAMETERS) && (*count < MAX_PARAMETER_SYMBOLS) && (symbol != SYMBOL_NONE))
+        {
+          parameters[(*count)++] = symbol;
+        }
+      else
+        {
+          result = false;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Collects the function-like macros defined by a file and by the files it
+ * includes with quotes, recursively up to MAX_MACRO_FILES files.
+ *
+ * @param inspection The inspection state, providing the include files and the
+ * test macro.
+ * @param macros The macro table to extend.
+ * @param source The tokenized file.
+ * @param path The path of the file.
+ */
+static void
+macros_collect (const inspection_t *inspection, macros_t *macros, const source_t *source, const char *path)
+{
+  (void)snprintf (macros->files[macros->files_count++], sizeof (macros->files[0]), "%s", path);
+
+  for (uint32_t i = 0; i < source->tokens_count; ++i)
+    {
+      const token_t *token = &source->tokens[i];
+      if (token->kind == TOKEN_DIRECTIVE)
+        {
+          const char *text = &source->text[token->offset];
+          size_t index = macros_skip_spaces (text, token->length, 1U);
+
+          if (((index + 6U) < token->length) && (strncmp (&text[index], "define", 6U) == 0) && (isspace ((uint8_t)text[index + 6U]) != 0))
+            {
+              macros_define (inspection, macros, &text[index + 6U], token->length - index - 6U);
+            }
+          else if (((index + 7U) < token->length) && (strncmp (&text[index], "include", 7U) == 0))
+            {
+              macros_include (inspection, macros, &text[index + 7U], token->length - index - 7U, path);
+            }
+        }
+    }
+}
+
+/**
+ * Adds a function-like macro to the macro table from the text following the define
+ * keyword of its definition. Object-like macros, the test macro and macros that
+ * are already defined are ignored.
+ *
+ * @param inspection The inspection state, providing the test macro.
+ * @param macros The macro table to extend.
+ * @param text The text of the definition.
+ * @param length The length of the text.
+ */
+static void
+macros_define (const inspection_t *inspection, macros_t *macros, const char *text, size_t length)
+{
+  symbols_t *symbols = macros->definitions.symbols;
+  macro_t macro = { 0 };
+
+  size_t name = macros_skip_spaces (text, length, 0U);
+  size_t index = name;
+  while ((index < length) && ((isalnum ((uint8_t)text[index]) != 0) || (text[index] == '_')))
+    {
+      ++index;
+    }
+
+  /* Function-like macros have no space between the name and the parameters */
+  const char *test_macro = inspection->config.test_macro;
+  bool is_valid = (index > name) && (index < length) && (text[index] == '(')
+                  && (((index - name) != strlen (test_macro)) || (strncmp (&text[name], test_macro, index - name) != 0));
+  if (is_valid)
+    {
+      macro.symbol = symbol_lookup (symbols, &text[name], (uint32_t)(index - name), true);
+      is_valid = (macro.symbol != SYMBOL_NONE) && ((macros->is_macro[macro.symbol / 64U] & (1ULL << (macro.symbol % 64U))) == 0U);
+    }
+
+  if (is_valid && (macros->count == MAX_MACROS))
+    {
+      /* The macros beyond the limit are left unexpanded, which is reported once per file */
+      if (macros->is_full == false)
+        {
+          (void)fprintf (stderr, "Error: Maximum number of macros reached.\n");
+        }
+      macros->is_full = true;
+      is_valid = false;
+    }
+
+  /* The parameters are names separated by commas, the last one possibly an ellipsis */
+  index = macros_skip_spaces (text, length, index + 1U);
+  bool is_closed = (index < length) && (text[index] == ')');
+  while (is_valid && (is_closed == false))
+    {
+      size_t parameter = index;
+      while ((index < length) && ((isalnum ((uint8_t)text[index]) != 0) || (text[index] == '_')))
+        {
+          ++index;
+        }
+
+      uint32_t symbol = SYMBOL_NONE;
+      if (index > parameter)
+        {
+          symbol = symbol_lookup (symbols, &text[parameter], (uint32_t)(index - parameter), true);
+        }
+      else if (((index + 3U) <= length) && (strncmp (&text[index], "...", 3U) == 0))
+        {
+          symbol = symbol_lookup (symbols, "__VA_ARGS__", 11U, true);
+          macro.is_variadic = true;
+          index += 3U;
+        }
+
+      index = macros_skip_spaces (text, length, index);
+      is_valid = (symbol != SYMBOL_NONE) && (macro.parameters_count < MAX_MACRO_PARAMETERS) && (index < length)
+                 && ((text[index] == ')') || ((text[index] == ',') && (macro.is_variadic == false)));
+      if (is_valid)
+        {
+          macro.parameters[macro.parameters_count++] = symbol;
+          is_closed = (text[index] == ')');
+          index = is_closed ? index : macros_skip_spaces (text, length, index + 1U);
+        }
+    }
+
+  /* The body is copied without line continuations, so that it forms a single line */
+  char *body = is_valid ? malloc (length - index) : NULL;
+  if (body != NULL)
+    {
+      size_t body_length = 0U;
+      for (size_t i = index + 1U; i < length; ++i)
+        {
+          bool is_continuation = (text[i] == '\\') && (((i + 1U) == length) || (text[i + 1U] == '\n') || (text[i + 1U] == '\r'));
+          body[body_length++] = (is_continuation || (text[i] == '\n') || (text[i] == '\r')) ? ' ' : text[i];
+        }
+
+      source_t *definitions = &macros->definitions;
+      size_t offset = source_append_text (definitions, body, body_length);
+      macro.begin = definitions->tokens_count;
+      if ((offset != SIZE_MAX) && source_tokenize (definitions, offset, false))
+        {
+          /* Comments are dropped, so that the operators and their operands are neighbors */
+          macro.end = macro.begin;
+          for (uint32_t i = macro.begin; i < definitions->tokens_count; ++i)
+            {
+              if (definitions->tokens[i].kind != TOKEN_COMMENT)
+                {
+                  definitions->tokens[macro.end++] = definitions->tokens[i];
+                }
+            }
+          definitions->tokens_count = macro.end;
+          macros->is_macro[macro.symbol / 64U] |= 1ULL << (macro.symbol % 64U);
+          macros->macros[macros->count++] = macro;
+        }
+
+      free (body);
+    }
+}
+
+/**
+ * Collects the macros of a file included with quotes, once per file. The file is
+ * searched next to the including file, then next to the include files of the
+ * library; files that are not found, such as those of other libraries, are skipped.
+ *
+ * @param inspection The inspection state, providing the include files.
+ * @param macros The macro table to extend.
+ * @param text The text following the include keyword.
+ * @param length The length of the text.
+ * @param path The path of the including file.
+ */
+static void
+macros_include (const inspection_t *inspection, macros_t *macros, const char *text, size_t length, const char *path)
+{
+  size_t begin = macros_skip_spaces (text, length, 0U) + 1U;
+  size_t end = begin;
+  while ((end < length) && (text[end] != '"'))
+    {
+      ++end;
+    }
+
+  char name[INSPECTION_LENGTH_PATH] = { 0 };
+  bool is_quoted = (begin <= length) && (text[begin - 1U] == '"') && (end < length) && ((end - begin) < sizeof (name));
+  if (is_quoted)
+    {
+      memcpy (name, &text[begin], end - begin);
+    }
+
+  char candidate[INSPECTION_LENGTH_PATH * 2U] = { 0 };
+  bool is_found = false;
+  for (uint32_t i = 0; is_quoted && (is_found == false) && (i <= inspection->config.includes_count); ++i)
+    {
+      const char *including = (i == 0U) ? path : inspection->config.includes[i - 1U];
+      const char *separator = strrchr (including, '/');
+      char directory[INSPECTION_LENGTH_PATH * 2U] = ".";
+      if (separator != NULL)
+        {
+          (void)snprintf (directory, sizeof (directory), "%.*s", (int32_t)(separator - including), including);
+        }
+
+      is_found = path_join (candidate, sizeof (candidate), directory, name) && file_exists (candidate);
+    }
+
+  for (uint32_t i = 0; is_found && (i < macros->files_count); ++i)
+    {
+      is_found = (strcmp (macros->files[i], candidate) != 0);
+    }
+
+  source_t include_file = { 0 };
+  if (is_found && (macros->files_count < MAX_MACRO_FILES) && source_load (macros->definitions.symbols, candidate, &include_file))
+    {
+      macros_collect (inspection, macros, &include_file, candidate);
+      source_release (&include_file);
+    }
+}
+
+/**
+ * Skips the whitespace and line continuations of a directive.
+ *
+ * @param text The text of the directive.
+ * @param length The length of the text.
+ * @param index The index to start at.
+ * @return The index of the next other character, or length if there is none.
+ */
+static size_t
+macros_skip_spaces (const char *text, size_t length, size_t index)
+{
+  while ((index < length) && ((isspace ((uint8_t)text[index]) != 0) || (text[index] == '\\')))
+    {
+      ++index;
+    }
+
+  return index;
+}
+
+/**
+ * Finds the macro named by a token.
+ *
+ * @param macros The macro table.
+ * @param token The token.
+ * @return A pointer to the macro, or NULL if the token does not name one.
+ */
+static macro_t *
+macros_find (macros_t *macros, const token_t *token)
+{
+  macro_t *result = NULL;
+
+  if ((token->kind == TOKEN_IDENTIFIER) && ((macros->is_macro[token->symbol / 64U] & (1ULL << (token->symbol % 64U))) != 0U))
+    {
+      for (uint32_t i = 0; (result == NULL) && (i < macros->count); ++i)
+        {
+          result = (macros->macros[i].symbol == token->symbol) ? &macros->macros[i] : NULL;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Expands the macro invocations of a list of tokens.
+ *
+ * The arguments of an invocation are expanded before they are substituted, unless
+ * they are stringified or pasted, and the result is expanded again while the macro
+ * is disabled, so that recursive macros terminate as with the preprocessor.
+ *
+ * @param macros The macro table.
+ * @param source The source holding the texts of the tokens.
+ * @param tokens The tokens to expand.
+ * @param count The number of tokens.
+ * @param output The list receiving the expanded tokens.
+ * @param depth The number of enclosing expansions, at most MAX_MACRO_DEPTH.
+ * @return true if the tokens were expanded, false if memory or symbols ran out.
+ */
+static bool
+macros_expand (macros_t *macros, source_t *source, const token_t *tokens, uint32_t count, token_list_t *output, uint32_t depth)
+{
+  bool result = true;
+
+  for (uint32_t i = 0; result && (i < count); ++i)
+    {
+      macro_t *macro = macros_find (macros, &tokens[i]);
+      uint32_t open = i + 1U;
+      while ((open < count) && (tokens[open].kind == TOKEN_COMMENT))
+        {
+          ++open;
+        }
+
+      uint32_t arguments[MAX_MACRO_PARAMETERS][2];
+      uint32_t close = count;
+      if ((macro != NULL) && (macro->is_active == false) && (depth < MAX_MACRO_DEPTH) && (open < count)
+          && token_is_punctuator (source, &tokens[open], '('))
+        {
+          close = macros_split (source, macro, tokens, open, count, arguments);
+        }
+
+      if (close < count)
+        {
+          token_list_t substituted = { 0 };
+          result = macros_substitute (macros, source, macro, tokens, (const uint32_t (*)[2])arguments, tokens[i].line, &substituted, depth);
+
+          macro->is_active = true;
+          result = result && macros_expand (macros, source, substituted.tokens, substituted.count, output, depth + 1U);
+          macro->is_active = false;
+
+          free (substituted.tokens);
+          i = close;
+        }
+      else
+        {
+          result = token_list_append (source, output, source, &tokens[i], tokens[i].line);
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Splits the arguments of a macro invocation at the commas outside of nested
+ * parentheses. The arguments beyond the named parameters of a variadic macro
+ * form its last argument.
+ *
+ * @param source The source holding the texts of the tokens.
+ * @param macro The invoked macro.
+ * @param tokens The tokens containing the invocation.
+ * @param open The index of the opening parenthesis of the arguments.
+ * @param count The number of tokens.
+ * @param arguments Receives the first and one past the last token index of every argument.
+ * @return The index of the closing parenthesis, or count if it is missing or the
+ * arguments do not match the parameters.
+ */
+static uint32_t
+macros_split (const source_t *source, const macro_t *macro, const token_t *tokens, uint32_t open, uint32_t count, uint32_t (*arguments)[2])
+{
+  uint32_t arguments_count = 0U;
+  uint32_t depth = 0U;
+  uint32_t begin = open + 1U;
+  uint32_t close = count;
+  bool is_valid = true;
+
+  for (uint32_t i = open + 1U; is_valid && (close == count) && (i < count); ++i)
+    {
+      bool is_last = macro->is_variadic && ((arguments_count + 1U) == macro->parameters_count);
+      bool is_close = token_is_punctuator (source, &tokens[i], ')');
+
+      if (token_is_punctuator (source, &tokens[i], '('))
+        {
+          ++depth;
+        }
+      else if (is_close && (depth > 0U))
+        {
+          --depth;
+        }
+      else if ((depth == 0U) && (is_close || ((is_last == false) && token_is_punctuator (source, &tokens[i], ','))))
+        {
+          is_valid = (arguments_count < MAX_MACRO_PARAMETERS);
+          if (is_valid)
+            {
+              arguments[arguments_count][0] = begin;
+              arguments[arguments_count++][1] = i;
+            }
+          begin = i + 1U;
+          close = is_close ? i : count;
+        }
+    }
+
+  /* Variadic arguments may be omitted, and a macro without parameters takes one empty argument */
+  if (is_valid && macro->is_variadic && ((arguments_count + 1U) == macro->parameters_count))
+    {
+      arguments[arguments_count][0] = close;
+      arguments[arguments_count++][1] = close;
+    }
+  bool is_empty = (macro->parameters_count == 0U) && (arguments_count == 1U) && (arguments[0][0] == arguments[0][1]);
+
+  return (is_valid && ((arguments_count == macro->parameters_count) || is_empty)) ? close : count;
+}
+
+/**
+ * Substitutes the arguments of an invocation into the body of a macro, applying
+ * the stringification and token pasting operators.
+ *
+ * @param macros The macro table.
+ * @param source The source holding the texts of the arguments, which receives the
+ * texts of the substituted tokens.
+ * @param macro The invoked macro.
+ * @param tokens The tokens containing the invocation.
+ * @param arguments The token ranges of the arguments, see macros_split.
+ * @param line The line of the invocation.
+ * @param output The list receiving the substituted tokens.
+ * @param depth The number of enclosing expansions.
+ * @return true if the arguments were substituted, false if memory or symbols ran out.
+ */
+static bool
+macros_substitute (macros_t *macros, source_t *source, const macro_t *macro, const token_t *tokens, const uint32_t (*arguments)[2],
+                   uint32_t line, token_list_t *output, uint32_t depth)
+{
+  bool result = true;
+  const source_t *definitions = &macros->definitions;
+
+  for (uint32_t i = macro->begin; result && (i < macro->end); ++i)
+    {
+      const token_t *token = &definitions->tokens[i];
+      uint32_t parameter = macros_parameter (macro, token);
+      uint32_t following = ((i + 1U) < macro->end) ? macros_parameter (macro, &definitions->tokens[i + 1U]) : macro->parameters_count;
+
+      if (macros_is_paste (definitions, i, macro->end))
+        {
+          /* The right operand is a token of the body or the first token of an argument */
+          uint32_t right = macros_parameter (macro, &definitions->tokens[i + 2U]);
+          if (right < macro->parameters_count)
+            {
+              for (uint32_t j = arguments[right][0]; result && (j < arguments[right][1]); ++j)
+                {
+                  result = (j == arguments[right][0]) ? macros_paste (source, output, source, &tokens[j], line)
+                                                      : token_list_append (source, output, source, &tokens[j], tokens[j].line);
+                }
+            }
+          else
+            {
+              result = macros_paste (source, output, definitions, &definitions->tokens[i + 2U], line);
+            }
+          i += 2U;
+        }
+      else if (token_is_punctuator (definitions, token, '#') && (following < macro->parameters_count))
+        {
+          result = macros_stringify (source, tokens, arguments[following], line, output);
+          ++i;
+        }
+      else if ((parameter < macro->parameters_count) && macros_is_paste (definitions, i + 1U, macro->end))
+        {
+          for (uint32_t j = arguments[parameter][0]; result && (j < arguments[parameter][1]); ++j)
+            {
+              result = token_list_append (source, output, source, &tokens[j], tokens[j].line);
+            }
+        }
+      else if (parameter < macro->parameters_count)
+        {
+          const uint32_t *argument = arguments[parameter];
+          result = macros_expand (macros, source, &tokens[argument[0]], argument[1] - argument[0], output, depth + 1U);
+        }
+      else
+        {
+          result = token_list_append (source, output, definitions, token, line);
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Finds the parameter of a macro named by a token of its body.
+ *
+ * @param macro The macro.
+ * @param token The token.
+ * @return The index of the parameter, or the number of parameters if the token
+ * names none.
+ */
+static uint32_t
+macros_parameter (const macro_t *macro, const token_t *token)
+{
+  uint32_t result = macro->parameters_count;
+
+  for (uint32_t i = 0; (token->kind == TOKEN_IDENTIFIER) && (result == macro->parameters_count) && (i < macro->parameters_count); ++i)
+    {
+      result = (token->symbol == macro->parameters[i]) ? i : result;
+    }
+
+  return result;
+}
+
+/**
+ * Checks if the tokens at an index of a macro body are the token pasting operator,
+ * two adjacent hashes followed by their right operand.
+ *
+ * @param definitions The definitions holding the body.
+ * @param index The index of the first hash.
+ * @param end One past the last token of the body.
+ * @return true if the tokens paste, false otherwise.
+ */
+static bool
+macros_is_paste (const source_t *definitions, uint32_t index, uint32_t end)
+{
+  return ((index + 2U) < end) && token_is_punctuator (definitions, &definitions->tokens[index], '#')
+         && token_is_punctuator (definitions, &definitions->tokens[index + 1U], '#')
+         && (definitions->tokens[index + 1U].offset == (definitions->tokens[index].offset + 1U));
+}
+
+/**
+ * Appends the string literal spelling the tokens of an argument to a list.
+ *
+ * @param source The source holding the texts of the argument, which receives the
+ * text of the literal.
+ * @param tokens The tokens containing the argument.
+ * @param argument The first and one past the last token index of the argument.
+ * @param line The line of the invocation.
+ * @param output The list to extend.
+ * @return true if the literal was appended, false if memory ran out.
+ */
+static bool
+macros_stringify (source_t *source, const token_t *tokens, const uint32_t *argument, uint32_t line, token_list_t *output)
+{
+  bool result = false;
+
+  size_t length = 2U;
+  for (uint32_t i = argument[0]; i < argument[1]; ++i)
+    {
+      length += (2U * tokens[i].length) + 1U;
+    }
+
+  char *text = malloc (length);
+  if (text != NULL)
+    {
+      /* Quotes and backslashes of string literals are escaped, and tokens separated by a space */
+      size_t used = 0U;
+      text[used++] = '"';
+      for (uint32_t i = argument[0]; i < argument[1]; ++i)
+        {
+          text[used] = ' ';
+          used += (i > argument[0]) ? 1U : 0U;
+          for (uint32_t j = 0; j < tokens[i].length; ++j)
+            {
+              char character = source->text[tokens[i].offset + j];
+              text[used] = '\\';
+              used += ((tokens[i].kind == TOKEN_STRING) && ((character == '"') || (character == '\\'))) ? 1U : 0U;
+              text[used++] = character;
+            }
+        }
+      text[used++] = '"';
+
+      token_t literal = { .symbol = SYMBOL_NONE, .line = line, .length = (uint32_t)used, .kind = TOKEN_STRING };
+      size_t offset = source_append_text (source, text, used);
+      literal.offset = (uint32_t)offset;
+      result = (offset != SIZE_MAX) && token_list_append (source, output, source, &literal, line);
+      free (text);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to allocate the text of a file.\n");
+    }
+
+  return result;
+}
+
+/**
+ * Pastes a token onto the last token of a list, forming a single identifier, number
+ * or punctuator, or appends it to an empty list.
+ *
+ * @param source The source holding the texts of the list, which receives the text
+ * of the pasted token.
+ * @param output The list to extend.
+ * @param from The source holding the text of the token.
+ * @param token The token to paste.
+ * @param line The line of the invocation.
+ * @return true if the token was pasted, false if memory or symbols ran out.
+ */
+static bool
+macros_paste (source_t *source, token_list_t *output, const source_t *from, const token_t *token, uint32_t line)
+{
+  bool result = false;
+
+  if (output->count == 0U)
+    {
+      result = token_list_append (source, output, from, token, line);
+    }
+  else
+    {
+      token_t *last = &output->tokens[output->count - 1U];
+      uint32_t length = last->length + token->length;
+      char *text = malloc (length);
+      if (text != NULL)
+        {
+          memcpy (text, &source->text[last->offset], last->length);
+          memcpy (&text[last->length], &from->text[token->offset], token->length);
+
+          size_t offset = source_append_text (source, text, length);
+          if (offset != SIZE_MAX)
+            {
+              uint8_t first = (uint8_t)source->text[offset];
+              last->kind = ((isalpha (first) != 0) || (first == '_')) ? TOKEN_IDENTIFIER : ((isdigit (first) != 0) ? TOKEN_NUMBER : TOKEN_PUNCTUATOR);
+              last->offset = (uint32_t)offset;
+              last->length = length;
+              last->symbol = (last->kind == TOKEN_NUMBER) ? SYMBOL_NONE : symbol_lookup (source->symbols, &source->text[offset], length, true);
+              result = (last->kind == TOKEN_NUMBER) || (last->symbol != SYMBOL_NONE);
+            }
+          free (text);
+        }
+      else
+        {
+          (void)fprintf (stderr, "Error: Unable to allocate the text of a file.\n");
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Appends a token to a list, copying its text into the source of the list if it
+ * lies within another source.
+ *
+ * @param source The source holding the texts of the list.
+ * @param list The list to extend.
+ * @param from The source holding the text of the token.
+ * @param token The token to append.
+ * @param line The line given to the appended token.
+ * @return true if the token was appended, false if memory ran out.
+ */
+static bool
+token_list_append (source_t *source, token_list_t *list, const source_t *from, const token_t *token, uint32_t line)
+{
+  bool result = true;
+
+  if (list->count == list->capacity)
+    {
+      uint32_t capacity = (list->capacity > 0U) ? (list->capacity * 2U) : 64U;
+      token_t *tokens = realloc (list->tokens, capacity * sizeof (token_t));
+      if (tokens != NULL)
+        {
+          list->tokens = tokens;
+          list->capacity = capacity;
+        }
+      else
+        {
+          (void)fprintf (stderr, "Error: Unable to allocate the tokens of a file.\n");
+          result = false;
+        }
+    }
+
+  if (result)
+    {
+      token_t *appended = &list->tokens[list->count];
+      *appended = *token;
+      appended->line = line;
+      if (from != source)
+        {
+          size_t offset = source_append_text (source, &from->text[token->offset], token->length);
+          appended->offset = (uint32_t)offset;
+          result = (offset != SIZE_MAX);
+        }
+      list->count += result ? 1U : 0U;
+    }
+
+  return result;
+}
+
+/**
+ * Checks if a token is a given punctuator.
+ *
+ * @param source The source holding the text of the token.
+ * @param token The token.
+ * @param punctuator The punctuator character.
+ * @return true if the token is the punctuator, false otherwise.
+ */
+static bool
+token_is_punctuator (const source_t *source, const token_t *token, char punctuator)
+{
+  return (token->kind == TOKEN_PUNCTUATOR) && (source->text[token->offset] == punctuator);
+}
+
+/**
+ * Builds the canonical signature of a function and its fingerprint.
+ *
+ * The return type consists of the tokens from begin up to the name, without the
+ * API prefix macro and the static, extern and inline specifiers.
+ *
+ * @param inspection The inspection state, providing the API prefix.
+ * @param source The tokenized file containing the function.
+ * @param begin The index of the first token of the declaration or definition.
+ * @param name The index of the function name.
+ * @param open The index of the opening parenthesis of the parameters.
+ * @param close The index of the closing parenthesis of the parameters.
+ * @param signature Receives the signature.
+ * @return true if the signature was built, false if it exceeds MAX_PARAMETERS or
+ * MAX_SIGNATURE_SYMBOLS, in which case it is truncated.
+ */
+static bool
+signature_build (const inspection_t *inspection, const source_t *source, uint32_t begin, uint32_t name, uint32_t open, uint32_t close,
+                 signature_t *signature)
+{
+  symbols_t *symbols = source->symbols;
+  const uint32_t ignored[] = {
+    symbol_lookup (symbols, inspection->config.api_prefix, (uint32_t)strlen (inspection->config.api_prefix), false),
+    symbol_lookup (symbols, inspection->config.inline_prefix, (uint32_t)strlen (inspection->config.inline_prefix), false),
+    symbol_lookup (symbols, "static", 6U, false),
+    symbol_lookup (symbols, "extern", 6U, false),
+    symbol_lookup (symbols, "inline", 6U, false),
+  };
+
+  /* The return type leaves room for the name, both parentheses and the parameters */
+  bool is_return_type_complete = true;
+  signature->symbols_count = 0U;
+  for (uint32_t i = source_skip_comments (source, begin); is_return_type_complete && (i < name); i = source_skip_comments (source, i + 1U))
+    {
+      bool is_ignored = false;
+      for (uint32_t j = 0; j < (sizeof (ignored) / sizeof (ignored[0])); ++j)
+        {
+          is_ignored = is_ignored || (source->tokens[i].symbol == ignored[j]);
+        }
+
+      if (is_ignored == false)
+        {
+          uint32_t symbol = source_get_symbol (source, i);
+          is_return_type_complete = (symbol != SYMBOL_NONE) && (signature->symbols_count < (MAX_SIGNATURE_SYMBOLS - MAX_PARAMETER_SYMBOLS - 3U));
+          if (is_return_type_complete)
+            {
+              signature->symbols[signature->symbols_count++] = symbol;
+            }
+        }
+    }
+
+  signature->symbols[signature->symbols_count++] = source->tokens[name].symbol;
+  signature->symbols[signature->symbols_count++] = source->tokens[open].symbol;
+
+  uint32_t parameters_count = 0U;
+  bool result = source_get_parameters (source, open, close, &signature->symbols[signature->symbols_count], &parameters_count)
+                && is_return_type_complete;
+  signature->symbols_count += parameters_count;
+  signature->symbols[signature->symbols_count++] = source->tokens[close].symbol;
+
+  /* FNV-1a over the symbol texts separated by spaces, which is stable across runs */
+  signature->fingerprint = SIGNATURES_FNV_OFFSET;
+  for (uint32_t i = 0; i < signature->symbols_count; ++i)
+    {
+      const char *text = &symbols->text[symbols->offsets[signature->symbols[i]]];
+      for (uint32_t j = 0; j < symbols->lengths[signature->symbols[i]]; ++j)
+        {
+          signature->fingerprint = (signature->fingerprint ^ (uint8_t)text[j]) * SIGNATURES_FNV_PRIME;
+        }
+      signature->fingerprint = (signature->fingerprint ^ (uint8_t)' ') * SIGNATURES_FNV_PRIME;
+    }
+
+  return result;
+}
+
+/**
+ * Compares two signatures, comparing their symbols only if the fingerprints are equal.
+ *
+ * @param signature The first signature.
+ * @param other The second signature.
+ * @return true if the signatures are equal, false otherwise.
+ */
+static bool
+signature_equals (const signature_t *signature, const signature_t *other)
+{
+  return (signature->fingerprint == other->fingerprint) && (signature->symbols_count == other->symbols_count)
+         && (memcmp (signature->symbols, other->symbols, signature->symbols_count * sizeof (uint32_t)) == 0);
+}
+
+/**
+ * Finds the recorded fingerprint of a function.
+ *
+ * @param inspection The inspection state of the library.
+ * @param function_name The name of the function.
+ * @return A pointer to the fingerprint, or NULL if none was recorded.
+ */
+static const fingerprint_t *
+fingerprints_find (const inspection_t *inspection, const char *function_name)
+{
+  const fingerprint_t *result = NULL;
+
+  for (uint32_t i = 0; i < inspection->fingerprints_count; ++i)
+    {
+      if (strcmp (inspection->fingerprints[i].function_name, function_name) == 0)
+        {
+          result = &inspection->fingerprints[i];
+          break;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Reads the fingerprints recorded by a previous run from the configured signatures
+ * file. A missing file records no fingerprints.
+ *
+ * @param inspection The inspection state of the library.
+ */
+static void
+fingerprints_load (inspection_t *inspection)
+{
+  inspection->fingerprints_count = 0U;
+
+  FILE *file = (inspection->config.signatures[0] != '\0') ? fopen (inspection->config.signatures, "r") : NULL;
+  if (file != NULL)
+    {
+      fingerprint_t *fingerprint = &inspection->fingerprints[0];
+      while ((inspection->fingerprints_count < MAX_PROTOTYPES)
+             && (fscanf (file, "%16" SCNx64 " %127s", &fingerprint->fingerprint, fingerprint->function_name) == 2))
+        {
+          fingerprint = &inspection->fingerprints[++inspection->fingerprints_count];
+        }
+
+      (void)fclose (file);
+    }
+}
+
+/**
+ * Marks the declarations executed according to the configured coverage file.
+ *
+ * The file holds the names of the executed API functions, one per line, as
+ * appended by every process using a library built with LIBRARY_COVERAGE. Names
+ * may repeat and names that match no declaration are ignored.
+ *
+ * @param inspection The inspection state of the library with its prototypes loaded.
+ */
+static void
+coverage_load (inspection_t *inspection)
+{
+  inspection->has_coverage = false;
+  for (uint32_t i = 0; i < inspection->decls_count; ++i)
+    {
+      inspection->decls[i].is_executed = false;
+    }
+
+  FILE *file = (inspection->config.coverage[0] != '\0') ? fopen (inspection->config.coverage, "r") : NULL;
+  if (file != NULL)
+    {
+      char function_name[LENGTH_FUNCTION_NAME];
+      while (fscanf (file, "%127s", function_name) == 1)
+        {
+          uint32_t symbol = symbol_lookup (&inspection->symbols, function_name, (uint32_t)strlen (function_name), false);
+          declaration_t *declaration = decls_find (inspection, symbol);
+          if (declaration != NULL)
+            {
+              declaration->is_executed = true;
+            }
+        }
+
+      inspection->has_coverage = true;
+      (void)fclose (file);
+    }
+  else if (inspection->config.coverage[0] != '\0')
+    {
+      (void)fprintf (stderr, "Error: Unable to open the coverage file at '%s'\n", inspection->config.coverage);
+    }
+}
+
+/**
+ * Collects the translation units of the configured compile commands file.
+ *
+ * The file is read in fixed-size chunks and parsed byte by byte, so that its size,
+ * which grows with the command lines of large trees, does not matter. Units are
+ * kept if they lie within a source directory and end with the source extension or
+ * within a test directory and end with the test extension. They are sorted by path
+ * and duplicates, such as sources compiled into several targets, are dropped.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the file was parsed or none is configured, false otherwise.
+ */
+static bool
+compile_commands_load (inspection_t *inspection)
+{
+  compile_commands_release (inspection);
+  inspection->has_compile_commands = (inspection->config.compile_commands[0] != '\0');
+  if (inspection->has_compile_commands == false)
+    {
+      return true;
+    }
+
+  bool result = false;
+  FILE *file = fopen (inspection->config.compile_commands, "r");
+  compile_commands_t *parser = calloc (1U, sizeof (compile_commands_t));
+  char *chunk = malloc (COMPILE_COMMANDS_CHUNK);
+
+  if ((file != NULL) && (parser != NULL) && (chunk != NULL))
+    {
+      for (uint32_t i = 0; i < inspection->config.sources_count; ++i)
+        {
+          (void)realpath (inspection->config.sources[i], parser->sources[i]);
+        }
+      for (uint32_t i = 0; i < inspection->config.tests_count; ++i)
+        {
+          (void)realpath (inspection->config.tests[i], parser->tests[i]);
+        }
+
+      size_t length = fread (chunk, 1U, COMPILE_COMMANDS_CHUNK, file);
+      while (length > 0U)
+        {
+          for (size_t i = 0; i < length; ++i)
+            {
+              compile_commands_parse (inspection, parser, chunk[i]);
+            }
+          length = fread (chunk, 1U, COMPILE_COMMANDS_CHUNK, file);
+        }
+
+      result = (ferror (file) == 0) && (parser->depth == 0U);
+      qsort (inspection->units, inspection->units_count, sizeof (unit_t), compile_commands_compare);
+
+      uint32_t count = 0;
+      for (uint32_t i = 0; i < inspection->units_count; ++i)
+        {
+          if ((count > 0U) && (strcmp (inspection->units[count - 1U].path, inspection->units[i].path) == 0))
+            {
+              free (inspection->units[i].path);
+            }
+          else
+            {
+              inspection->units[count++] = inspection->units[i];
+            }
+        }
+      inspection->units_count = count;
+    }
+
+  if (result == false)
+    {
+      (void)fprintf (stderr, "Error: Unable to read the compile commands at '%s'\n", inspection->config.compile_commands);
+    }
+
+  if (file != NULL)
+    {
+      (void)fclose (file);
+    }
+  free (parser);
+  free (chunk);
+
+  return result;
+}
+
+/**
+ * Advances the compile commands parser by one character of the file.
+ *
+ * Strings are unescaped into a fixed buffer; escaped code points are kept as the
+ * plain characters following the backslash, which suffices for the file paths
+ * that are extracted.
+ *
+ * @param inspection The inspection state of the library.
+ * @param parser The parser state.
+ * @param character The next character of the file.
+ */
+static void
+compile_commands_parse (inspection_t *inspection, compile_commands_t *parser, char character)
+{
+  if (parser->is_string)
+    {
+      if ((parser->is_escape == false) && (character == '"'))
+        {
+          parser->is_string = false;
+          parser->string[parser->string_length] = '\0';
+
+          /* Only the members of the objects in the top-level array are of interest */
+          if ((parser->depth == 2U) && parser->is_key)
+            {
+              /* Longer keys are none of the ones of interest */
+              size_t length = (parser->string_length < sizeof (parser->key)) ? parser->string_length : 0U;
+              memcpy (parser->key, parser->string, length);
+              parser->key[length] = '\0';
+            }
+          else if ((parser->depth == 2U) && (strcmp (parser->key, "file") == 0))
+            {
+              (void)strcpy (parser->file, parser->is_truncated ? "" : parser->string);
+            }
+          else if ((parser->depth == 2U) && (strcmp (parser->key, "directory") == 0))
+            {
+              (void)strcpy (parser->directory, parser->is_truncated ? "" : parser->string);
+            }
+        }
+      else if ((parser->is_escape == false) && (character == '\\'))
+        {
+          parser->is_escape = true;
+        }
+      else
+        {
+          parser->is_escape = false;
+          if (parser->string_length < (sizeof (parser->string) - 1U))
+            {
+              parser->string[parser->string_length++] = character;
+            }
+          else
+            {
+              parser->is_truncated = true;
+            }
+        }
+      return;
+    }
+
+  switch (character)
+    {
+    case '"':
+      parser->is_string = true;
+      parser->is_truncated = false;
+      parser->string_length = 0U;
+      break;
+    case '{':
+    case '[':
+      ++parser->depth;
+      if ((parser->depth == 2U) && (character == '{'))
+        {
+          parser->directory[0] = '\0';
+          parser->file[0] = '\0';
+          parser->key[0] = '\0';
+          parser->is_key = true;
+        }
+      break;
+    case '}':
+    case ']':
+      if ((parser->depth == 2U) && (character == '}'))
+        {
+          compile_commands_add (inspection, parser);
+        }
+      parser->depth -= (parser->depth > 0U) ? 1U : 0U;
+      break;
+    case ':':
+      parser->is_key = (parser->depth == 2U) ? false : parser->is_key;
+      break;
+    case ',':
+      parser->is_key = (parser->depth == 2U) ? true : parser->is_key;
+      break;
+    default:
+      break;
+    }
+}
+
+/**
+ * Adds the translation unit of a parsed compile command if it belongs to the library.
+ *
+ * @param inspection The inspection state of the library.
+ * @param parser The parser state holding the directory and file of the command.
+ */
+static void
+compile_commands_add (inspection_t *inspection, const compile_commands_t *parser)
+{
+  const inspection_config_t *config = &inspection->config;
+  char path[PATH_MAX * 2U] = { 0 };
+  char resolved[PATH_MAX] = { 0 };
+
+  bool is_valid = (parser->file[0] != '\0')
+                  && ((parser->file[0] == '/') ? (snprintf (path, sizeof (path), "%s", parser->file) < (int32_t)sizeof (path))
+                                               : path_join (path, sizeof (path), parser->directory, parser->file))
+                  && (realpath (path, resolved) != NULL);
+
+  bool is_test = is_valid && string_ends_with (resolved, config->test_extension) && compile_commands_contains (parser->tests, resolved);
+  bool is_source = is_valid && (is_test == false) && string_ends_with (resolved, config->source_extension)
+                   && compile_commands_contains (parser->sources, resolved);
+
+  if ((is_test || is_source) && (inspection->units_count == inspection->units_capacity))
+    {
+      uint32_t capacity = (inspection->units_capacity > 0U) ? (inspection->units_capacity * 2U) : 64U;
+      unit_t *units = realloc (inspection->units, capacity * sizeof (unit_t));
+      if (units == NULL)
+        {
+          return;
+        }
+      inspection->units = units;
+      inspection->units_capacity = capacity;
+    }
+
+  char *copy = (is_test || is_source) ? strdup (resolved) : NULL;
+  if (copy != NULL)
+    {
+      inspection->units[inspection->units_count].path = copy;
+      inspection->units[inspection->units_count++].is_test = is_test;
+    }
+}
+
+/**
+ * Checks if a resolved path lies within one of a list of resolved directories.
+ *
+ * @param directories The resolved directories; unresolvable ones are empty.
+ * @param path The resolved path.
+ * @return true if the path lies within a directory, false otherwise.
+ */
+static bool
+compile_commands_contains (const char (*directories)[PATH_MAX], const char *path)
+{
+  bool result = false;
+
+  for (uint32_t i = 0; (i < INSPECTION_MAX_PATHS) && (result == false); ++i)
+    {
+      size_t length = strlen (directories[i]);
+      result = (length > 0U) && (strncmp (path, directories[i], length) == 0) && (path[length] == '/');
+    }
+
+  return result;
+}
+
+/**
+ * Compares two translation units by their path.
+ */
+static int
+compile_commands_compare (const void *lhs, const void *rhs)
+{
+  return strcmp (((const unit_t *)lhs)->path, ((const unit_t *)rhs)->path);
+}
+
+/**
+ * Releases the translation units of the compile commands file.
+ *
+ * @param inspection The inspection state of the library.
+ */
+static void
+compile_commands_release (inspection_t *inspection)
+{
+  for (uint32_t i = 0; i < inspection->units_count; ++i)
+    {
+      free (inspection->units[i].path);
+    }
+  free (inspection->units);
+  inspection->units = NULL;
+  inspection->units_count = 0U;
+  inspection->units_capacity = 0U;
+}
+
+/**
+ * Records the fingerprints of the current prototypes, writing them to the
+ * configured signatures file if there is one. Later signature changes are reported
+ * against these fingerprints.
+ *
+ * @param inspection The loaded inspection state of the library.
+ */
+void
+inspection_fingerprints_update (inspection_t *inspection)
+{
+  for (uint32_t i = 0; i < inspection->decls_count; ++i)
+    {
+      (void)strcpy (inspection->fingerprints[i].function_name, inspection->decls[i].function_name);
+      inspection->fingerprints[i].fingerprint = inspection->decls[i].signature.fingerprint;
+    }
+  inspection->fingerprints_count = inspection->decls_count;
+  inspection->print_signature_changes = false;
+
+  FILE *file = (inspection->config.signatures[0] != '\0') ? fopen (inspection->config.signatures, "w") : NULL;
+  if (file != NULL)
+    {
+      for (uint32_t i = 0; i < inspection->fingerprints_count; ++i)
+        {
+          (void)fprintf (file, "%016" PRIx64 " %s\n", inspection->fingerprints[i].fingerprint, inspection->fingerprints[i].function_name);
+        }
+
+      (void)fclose (file);
+    }
+  else if (inspection->config.signatures[0] != '\0')
+    {
+      (void)fprintf (stderr, "Error: Unable to write the signatures to '%s'\n", inspection->config.signatures);
+    }
+}
+
+/**
+ * Adds a function prototype to the declarations if space is available.
+ *
+ * The tokens should follow the API prefix and form a C function prototype:
+ * \<return_type\> \<function_name\> (\<arguments\>)
+ *
+ * @param inspection The inspection state of the library.
+ * @param source The tokenized include file.
+ * @param include_index The index of the include file within the configuration.
+ * @param begin The index of the first token after the API prefix.
+ * @param end The index of the semicolon terminating the prototype.
+ * @param is_inline Whether the prototype begins an inline definition in the include file.
+ * @note If MAX_PROTOTYPES is reached, the prototype won't be added.
+ * @return true if the function prototype is successfully added, false otherwise.
+ */
+static bool
+decls_append (inspection_t *inspection, const source_t *source, uint32_t include_index, uint32_t begin, uint32_t end, bool is_inline)
+{
+  bool result = false;
+
+  if (inspection->decls_count < MAX_PROTOTYPES)
+    {
+      /* The name is the last identifier before the first parenthesis */
+      uint32_t name = SYMBOL_NONE;
+      uint32_t open = source_skip_comments (source, begin);
+      while ((open < end) && (source_is_punctuator (source, open, '(') == false))
+        {
+          name = (source->tokens[open].kind == TOKEN_IDENTIFIER) ? open : SYMBOL_NONE;
+          open = source_skip_comments (source, open + 1U);
+        }
+      uint32_t close = source_find_closing (source, open);
+
+      declaration_t *prototype = &inspection->decls[inspection->decls_count];
+      if ((name != SYMBOL_NONE) && (close < end))
+        {
+          const token_t *name_token = &source->tokens[name];
+          (void)snprintf (prototype->function_name, sizeof (prototype->function_name), "%.*s", (int)name_token->length,
+                          &source->text[name_token->offset]);
+          prototype->symbol = name_token->symbol;
+          prototype->declaration_line_number = name_token->line;
+
+          prototype->include_index = include_index;
+          prototype->is_inline = is_inline;
+          if (signature_build (inspection, source, begin, name, open, close, &prototype->signature))
+            {
+              ++inspection->decls_count;
+              result = true;
+            }
+          else
+            {
+              (void)fprintf (stderr, "Error: Maximum number of parameters or signature symbols reached for '%s'\n", prototype->function_name);
+            }
+        }
+      else
+        {
+          (void)fprintf (stderr, "Error: Invalid function declaration at line %u\n", source->tokens[begin - 1U].line);
+        }
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Maximum number of prototypes reached.\n");
+    }
+
+  return result;
+}
+
+/**
+ * Finds the declaration of a function.
+ *
+ * @param inspection The inspection state of the library.
+ * @param symbol The symbol of the function name.
+ * @return A pointer to the declaration, or NULL if the function is not declared.
+ */
+static declaration_t *
+decls_find (inspection_t *inspection, uint32_t symbol)
+{
+  declaration_t *result = NULL;
+
+  for (uint32_t i = 0; (i < inspection->decls_count) && (symbol != SYMBOL_NONE); ++i)
+    {
+      if (inspection->decls[i].symbol == symbol)
+        {
+          result = &inspection->decls[i];
+          break;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Updates test coverage information for function declarations.
+ *
+ * Tests are invocations of the test macro at file scope, and annotations are
+ * markers within comments. Tests that match no declaration
+ * are recorded as invalid.
+ *
+ * @param inspection The inspection state of the library.
+ * @param source The tokenized test file.
+ * @param test_path A pointer to the null-terminated string representing the path to the test.
+ * @return true if the test coverage information is successfully updated, false otherwise.
+ */
+static bool
+decls_update_tests (inspection_t *inspection, const source_t *source, const char *test_path)
+{
+  bool result = true;
+
+  const char *test_macro = inspection->config.test_macro;
+  uint32_t test_symbol = symbol_lookup (source->symbols, test_macro, (uint32_t)strlen (test_macro), false);
+  uint32_t depth = 0;
+
+  for (uint32_t i = 0; result && (i < source->tokens_count); ++i)
+    {
+      const token_t *token = &source->tokens[i];
+
+      if (token->kind == TOKEN_COMMENT)
+        {
+          result = decls_update_annotations (inspection, source, token, test_path);
+        }
+      else if (source_is_punctuator (source, i, '{') || source_is_punctuator (source, i, '}'))
+        {
+          depth = source_is_punctuator (source, i, '{') ? (depth + 1U) : ((depth > 0U) ? (depth - 1U) : 0U);
+        }
+      else if ((depth == 0U) && (token->symbol == test_symbol) && (test_symbol != SYMBOL_NONE))
+        {
+          uint32_t open = source_skip_comments (source, i + 1U);
+          uint32_t name = source_skip_comments (source, open + 1U);
+          uint32_t close = source_skip_comments (source, name + 1U);
+
+          if (source_is_punctuator (source, open, '(') && (name < source->tokens_count) && (source->tokens[name].kind == TOKEN_IDENTIFIER)
+              && source_is_punctuator (source, close, ')'))
+            {
+              result = decls_update_test (inspection, source, &source->tokens[name], token->line, test_path);
+              i = close;
+            }
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Adds the coverage annotations of a comment to their declarations.
+ *
+ * @param inspection The inspection state of the library.
+ * @param source The tokenized test file.
+ * @param comment The comment token to search.
+ * @param test_path A pointer to the null-terminated string representing the path to the test.
+ * @return true if the annotations were added, false if a declaration has too many coverages.
+ */
+static bool
+decls_update_annotations (inspection_t *inspection, const source_t *source, const token_t *comment, const char *test_path)
+{
+  bool result = true;
+
+  const char *text = &source->text[comment->offset];
+  const char *marker = inspection->config.test_annotation;
+  uint32_t marker_length = (uint32_t)strlen (marker);
+  uint32_t line_number = comment->line;
+
+  for (uint32_t i = 0; result && ((i + marker_length) <= comment->length); ++i)
+    {
+      line_number += (text[i] == '\n') ? 1U : 0U;
+      if (strncmp (&text[i], marker, marker_length) != 0)
+        {
+          continue;
+        }
+
+      uint32_t begin = i + marker_length;
+      while ((begin < comment->length) && ((text[begin] == ' ') || (text[begin] == '\t')))
+        {
+          ++begin;
+        }
+
+      uint32_t end = begin;
+      while ((end < comment->length) && ((isalnum ((uint8_t)text[end]) != 0) || (text[end] == '_')))
+        {
+          ++end;
+        }
+
+      declaration_t *declaration = decls_find (inspection, symbol_lookup (source->symbols, &text[begin], end - begin, false));
+      if (declaration != NULL)
+        {
+          result = declaration_add_coverage (declaration, test_path, line_number, true);
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Adds a test to the coverage of the declarations it is named after.
+ *
+ * A test covers the function of the same name, or, for variations, the function
+ * named by the part before a variation separator.
+ *
+ * @param inspection The inspection state of the library.
+ * @param source The tokenized test file.
+ * @param name The identifier token naming the test.
+ * @param line_number The line number of the test.
+ * @param test_path A pointer to the null-terminated string representing the path to the test.
+ * @return true if the test was recorded, false if a limit was reached.
+ */
+static bool
+decls_update_test (inspection_t *inspection, const source_t *source, const token_t *name, uint32_t line_number, const char *test_path)
+{
+  bool result = true;
+  bool is_defined = false;
+
+  const char *text = &source->text[name->offset];
+  const char *separator = inspection->config.test_variation;
+  uint32_t separator_length = (uint32_t)strlen (separator);
+
+  for (uint32_t length = name->length; result && (length > 0U); --length)
+    {
+      /* The full name, or a prefix followed by the variation separator */
+      if ((length == name->length)
+          || (((length + separator_length) <= name->length) && (strncmp (&text[length], separator, separator_length) == 0)))
+        {
+          declaration_t *declaration = decls_find (inspection, symbol_lookup (source->symbols, text, length, false));
+          if (declaration != NULL)
+            {
+              result = declaration_add_coverage (declaration, test_path, line_number, false);
+              is_defined = true;
+            }
+        }
+    }
+
+  if (result && (is_defined == false))
+    {
+      result = tests_append (inspection, test_path, line_number);
+    }
+
+  return result;
+}
+
+/**
+ * Maps prototype definitions from a source file to their implementations.
+ *
+ * A definition is a function at file scope whose parameter list is followed by a
+ * body, and its signature starts after the preceding declaration or definition.
+ * Calls and prototypes are never mistaken for definitions, and declarations
+ * already defined in another file are kept.
+ *
+ * @param inspection The inspection state of the library.
+ * @param source The tokenized source file.
+ * @param src_path A path to the source file.
+ */
+static void
+decls_update_definitions (inspection_t *inspection, const source_t *source, const char *src_path)
+{
+  uint32_t depth = 0;
+  uint32_t begin = source_skip_comments (source, 0U);
+
+  for (uint32_t i = begin; i < source->tokens_count; i = source_skip_comments (source, i + 1U))
+    {
+      if (source_is_punctuator (source, i, '{') || source_is_punctuator (source, i, '}'))
+        {
+          depth = source_is_punctuator (source, i, '{') ? (depth + 1U) : ((depth > 0U) ? (depth - 1U) : 0U);
+          begin = ((depth == 0U) && source_is_punctuator (source, i, '}')) ? source_skip_comments (source, i + 1U) : begin;
+        }
+      else if ((depth == 0U) && source_is_punctuator (source, i, ';'))
+        {
+          begin = source_skip_comments (source, i + 1U);
+        }
+      else if ((depth == 0U) && (source->tokens[i].kind == TOKEN_IDENTIFIER))
+        {
+          uint32_t open = source_skip_comments (source, i + 1U);
+          if (source_is_punctuator (source, open, '('))
+            {
+              uint32_t close = source_find_closing (source, open);
+              declaration_t *declaration = decls_find (inspection, source->tokens[i].symbol);
+
+              if ((declaration != NULL) && (declaration->definition_line_number == 0)
+                  && source_is_punctuator (source, source_skip_comments (source, close + 1U), '{'))
+                {
+                  declaration->definition_line_number = source->tokens[i].line;
+                  declaration_update_validation (inspection, declaration, source, begin, i, open, close);
+                  (void)snprintf (declaration->source_path, sizeof (declaration->source_path), "%s", src_path);
+                  declaration_update_test_file (inspection, declaration);
+                }
+
+              i = (close < source->tokens_count) ? close : i;
+            }
+        }
+    }
+}
+
+/**
+ * Appends a test to the list of defined tests.
+ *
+ * This function adds a test with the specified test path and line number to the
+ * list of defined tests, if the maximum limit has not been reached.
+ *
+ * @param inspection The inspection state of the library.
+ * @param test_path The path of the test.
+ * @param line_number The line number of the test.
+ * @return true if the test was successfully appended, false if the maximum limit
+ * has been reached.
+ */
+static bool
+tests_append (inspection_t *inspection, const char *test_path, uint32_t line_number)
+{
+  bool result = false;
+
+  if (inspection->tests_count < MAX_TESTS)
+    {
+      coverage_t *test = &inspection->tests[inspection->tests_count];
+      (void)strcpy (test->test_path, test_path);
+      test->line = line_number;
+      ++inspection->tests_count;
+
+      result = true;
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Maximum number of tests reached.");
+    }
+
+  return result;
+}
+
+/**
+ * Removes a test from the list of defined tests.
+ *
+ * This function removes the test at the specified index from the list of defined
+ * tests, adjusting the list accordingly.
+ *
+ * @param inspection The inspection state of the library.
+ * @param index The index of the test to be removed.
+ */
+static void
+tests_remove (inspection_t *inspection, uint32_t index)
+{
+  for (uint32_t i = index; i < (inspection->tests_count - 1U); ++i)
+    {
+      inspection->tests[i] = inspection->tests[i + 1U];
+    }
+
+  --inspection->tests_count;
+}
+
+/**
+ * Adds coverage information to a declaration if space is available.
+ *
+ * @param declaration Pointer to declaration_t structure.
+ * @param test_path Test path string.
+ * @param line_number Line number where the test was executed.
+ * @param is_annotation Marks the coverage as an annotation.
+ * @return true if coverage added successfully, false if array is full.
+ */
+static bool
+declaration_add_coverage (declaration_t *declaration, const char *test_path, uint32_t line_number, bool is_annotation)
+{
+  bool result = false;
+
+  if (declaration->coverages_count < MAX_TEST_BRANCHES)
+    {
+      coverage_t *coverage = &declaration->coverages[declaration->coverages_count];
+      (void)strcpy (coverage->test_path, test_path);
+      coverage->line = line_number;
+      coverage->is_annotation = is_annotation;
+      ++declaration->coverages_count;
+
+      if (is_annotation)
+        {
+          ++declaration->coverage_annotation_count;
+        }
+
+      result = true;
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Maximum number of coverage reached.");
+    }
+
+  return result;
+}
+
+/**
+ * Removes all coverage information of a test file from a declaration.
+ *
+ * @param declaration Pointer to declaration_t structure.
+ * @param test_path Test path string.
+ */
+static void
+declaration_remove_coverages (declaration_t *declaration, const char *test_path)
+{
+  uint32_t kept = 0;
+
+  for (uint32_t i = 0; i < declaration->coverages_count; ++i)
+    {
+      if (strcmp (declaration->coverages[i].test_path, test_path) != 0)
+        {
+          declaration->coverages[kept++] = declaration->coverages[i];
+        }
+      else if (declaration->coverages[i].is_annotation)
+        {
+          --declaration->coverage_annotation_count;
+        }
+    }
+
+  declaration->coverages_count = kept;
+}
+
+/**
+ * Forgets the definition of a declaration, so that it is searched again.
+ *
+ * @param declaration Pointer to declaration_t structure.
+ */
+static void
+declaration_remove_definition (declaration_t *declaration)
+{
+  declaration->definition_line_number = 0;
+  declaration->source_path[0] = '\0';
+  declaration->expected_test_path[0] = '\0';
+  declaration->is_prototype_match = false;
+  declaration->has_test_file = false;
+}
+
+/**
+ * Validates the signature of a function definition against its prototype.
+ *
+ * Both signatures are canonical, so whitespace, line breaks, comments and storage
+ * specifiers do not affect the result.
+ *
+ * @param inspection The inspection state of the library.
+ * @param declaration A pointer to the `declaration_t` structure to validate.
+ * @param source The tokenized source file containing the definition.
+ * @param begin The index of the first token of the definition.
+ * @param name The index of the function name of the definition.
+ * @param open The index of the opening parenthesis of the definition's parameters.
+ * @param close The index of the closing parenthesis of the definition's parameters.
+ */
+static void
+declaration_update_validation (const inspection_t *inspection, declaration_t *declaration, const source_t *source, uint32_t begin,
+                               uint32_t name, uint32_t open, uint32_t close)
+{
+  signature_t definition = { 0 };
+  declaration->is_prototype_match
+      = signature_build (inspection, source, begin, name, open, close, &definition) && signature_equals (&definition, &declaration->signature);
+}
+
+/**
+ * Determines the test file expected for the source file of a declaration.
+ *
+ * The test file carries the name of the source file with the test extension
+ * instead of the source extension, or instead of any extension for an include
+ * file defining inline functions. It is expected in the first test directory
+ * that contains it, or in the first test directory if none does. With a compile
+ * commands file, a compiled test of that name is preferred wherever it lies.
+ *
+ * @param inspection The inspection state of the library.
+ * @param declaration A pointer to a defined declaration.
+ */
+static void
+declaration_update_test_file (const inspection_t *inspection, declaration_t *declaration)
+{
+  const inspection_config_t *config = &inspection->config;
+  const char *file_name = strrchr (declaration->source_path, '/');
+  file_name = (file_name != NULL) ? (file_name + 1) : declaration->source_path;
+
+  const char *extension = strrchr (file_name, '.');
+  size_t stem_length = strlen (file_name);
+  if (string_ends_with (file_name, config->source_extension))
+    {
+      stem_length -= strlen (config->source_extension);
+    }
+  else if (extension != NULL)
+    {
+      stem_length = (size_t)(extension - file_name);
+    }
+
+  char test_name[INSPECTION_LENGTH_PATH] = { 0 };
+  (void)snprintf (test_name, sizeof (test_name), "%.*s%s", (int32_t)stem_length, file_name, config->test_extension);
+
+  declaration->expected_test_path[0] = '\0';
+  declaration->has_test_file = false;
+
+  for (uint32_t i = 0; (i < inspection->units_count) && (declaration->has_test_file == false); ++i)
+    {
+      const char *unit_name = strrchr (inspection->units[i].path, '/');
+      if (inspection->units[i].is_test && (unit_name != NULL) && (strcmp (&unit_name[1], test_name) == 0)
+          && (snprintf (declaration->expected_test_path, sizeof (declaration->expected_test_path), "%s", inspection->units[i].path)
+              < (int32_t)sizeof (declaration->expected_test_path)))
+        {
+          declaration->has_test_file = true;
+        }
+    }
+
+  for (uint32_t i = 0; (i < config->tests_count) && (declaration->has_test_file == false); ++i)
+    {
+      char path_buffer[INSPECTION_LENGTH_PATH] = { 0 };
+      if (path_join (path_buffer, sizeof (path_buffer), config->tests[i], test_name))
+        {
+          declaration->has_test_file = file_exists (path_buffer);
+          if ((i == 0U) || declaration->has_test_file)
+            {
+              (void)strcpy (declaration->expected_test_path, path_buffer);
+            }
+        }
+    }
+}
+
+/**
+ * Loads prototypes from the include files.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if the prototypes were loaded, false otherwise.
+ */
+static bool
+load_prototypes (inspection_t *inspection)
+{
+  bool result = true;
+
+  const char *api_prefix = inspection->config.api_prefix;
+  const char *inline_prefix = inspection->config.inline_prefix;
+  uint32_t api_symbol = symbol_lookup (&inspection->symbols, api_prefix, (uint32_t)strlen (api_prefix), true);
+  uint32_t inline_symbol = symbol_lookup (&inspection->symbols, inline_prefix, (uint32_t)strlen (inline_prefix), true);
+
+  for (uint32_t include = 0; result && (include < inspection->config.includes_count); ++include)
+    {
+      const char *include_path = inspection->config.includes[include];
+      source_t include_file = { 0 };
+
+      if ((source_load (&inspection->symbols, include_path, &include_file) == false)
+          || (source_expand (inspection, &include_file, include_path) == false))
+        {
+          (void)fprintf (stderr, "Error: Unable to open include file at '%s'\n", include_path);
+          continue;
+        }
+
+      for (uint32_t i = source_skip_comments (&include_file, 0U); result && (i < include_file.tokens_count);
+           i = source_skip_comments (&include_file, i + 1U))
+        {
+          if ((include_file.tokens[i].symbol == api_symbol) || (include_file.tokens[i].symbol == inline_symbol))
+            {
+              /* The prototype extends to the next semicolon, which lies within the body of an inline definition */
+              uint32_t end = source_skip_comments (&include_file, i + 1U);
+              while ((end < include_file.tokens_count) && (source_is_punctuator (&include_file, end, ';') == false))
+                {
+                  end = source_skip_comments (&include_file, end + 1U);
+                }
+
+              bool is_inline = (include_file.tokens[i].symbol == inline_symbol);
+              result = decls_append (inspection, &include_file, include, i + 1U, end, is_inline);
+              i = end;
+            }
+        }
+
+      source_release (&include_file);
+    }
+
+  return result;
+}
+
+/**
+ * Loads and processes function definitions from the files in the source directories.
+ *
+ * With a compile commands file, exactly the compiled sources within the source
+ * directories are processed, including those in nested directories. The include
+ * files are processed as well, for the functions defined inline.
+ *
+ * @param inspection The inspection state of the library.
+ * @return `true` if the loading and processing of function definitions were
+ * successful; otherwise, it returns `false`. In case of any errors,
+ * error messages are printed to stderr.
+ */
+static bool
+load_definitions (inspection_t *inspection)
+{
+  bool result = true;
+
+  for (uint32_t i = 0; i < inspection->config.includes_count; ++i)
+    {
+      load_source (inspection, inspection->config.includes[i]);
+    }
+
+  for (uint32_t i = 0; i < inspection->units_count; ++i)
+    {
+      if (inspection->units[i].is_test == false)
+        {
+          load_source (inspection, inspection->units[i].path);
+        }
+    }
+
+  for (uint32_t i = 0; (inspection->has_compile_commands == false) && (i < inspection->config.sources_count); ++i)
+    {
+      const char *directory = inspection->config.sources[i];
+      DIR *source_directory = opendir (directory);
+      if (source_directory == NULL)
+        {
+          (void)fprintf (stderr, "Error: Unable to open source directory at '%s'\n", directory);
+          result = false;
+          continue;
+        }
+
+      const struct dirent *entry = readdir (source_directory);
+      while (entry != NULL)
+        {
+          /* Only process files that end with the source extension */
+          char path_buffer[INSPECTION_LENGTH_PATH * 2U] = { 0 };
+          if (string_ends_with (entry->d_name, inspection->config.source_extension)
+              && path_join (path_buffer, sizeof (path_buffer), directory, entry->d_name))
+            {
+              load_source (inspection, path_buffer);
+            }
+
+          entry = readdir (source_directory);
+        }
+
+      (void)closedir (source_directory);
+    }
+
+  return result;
+}
+
+/**
+ * Maps the undefined prototypes to their implementations in a source file.
+ *
+ * @param inspection The inspection state of the library.
+ * @param path The path of the source file.
+ */
+static void
+load_source (inspection_t *inspection, const char *path)
+{
+  source_t src_file = { 0 };
+
+  if (source_load (&inspection->symbols, path, &src_file) && source_expand (inspection, &src_file, path))
+    {
+      decls_update_definitions (inspection, &src_file, path);
+      source_release (&src_file);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to open source file at '%s'\n", path);
+    }
+}
+
+/**
+ * Loads and processes the files in the test directories.
+ *
+ * This function attempts to open and process each file in the test directories
+ * whose name ends with the test extension. For each valid test file, it calls
+ * the decls_update_tests function to update the test declarations. With a compile
+ * commands file, exactly the compiled tests within the test directories are
+ * processed instead.
+ *
+ * @param inspection The inspection state of the library.
+ * @return true if all test files were successfully processed; false otherwise.
+ *
+ * @note The function prints error messages to stderr in case of failures, such as
+ * being unable to open a test directory or a specific test file.
+ */
+static bool
+load_tests (inspection_t *inspection)
+{
+  bool result = true;
+
+  for (uint32_t i = 0; result && (i < inspection->units_count); ++i)
+    {
+      if (inspection->units[i].is_test)
+        {
+          result = load_test (inspection, inspection->units[i].path);
+        }
+    }
+
+  for (uint32_t i = 0; result && (inspection->has_compile_commands == false) && (i < inspection->config.tests_count); ++i)
+    {
+      const char *directory = inspection->config.tests[i];
+      DIR *test_directory = opendir (directory);
+      if (test_directory == NULL)
+        {
+          (void)fprintf (stderr, "Error: Unable to open test directory at '%s'\n", directory);
+          result = false;
+          continue;
+        }
+
+      const struct dirent *entry = readdir (test_directory);
+      while (result && (entry != NULL))
+        {
+          /* Only process files that end with the test extension */
+          char path_buffer[INSPECTION_LENGTH_PATH * 2U] = { 0 };
+          if (string_ends_with (entry->d_name, inspection->config.test_extension)
+              && path_join (path_buffer, sizeof (path_buffer), directory, entry->d_name))
+            {
+              result = load_test (inspection, path_buffer);
+            }
+
+          entry = readdir (test_directory);
+        }
+
+      (void)closedir (test_directory);
+    }
+
+  return result;
+}
+
+/**
+ * Collects the tests and coverages of a test file.
+ *
+ * @param inspection The inspection state of the library.
+ * @param path The path of the test file.
+ * @return true if the file was processed or could not be opened, false if its
+ * tests exceed the limits.
+ */
+static bool
+load_test (inspection_t *inspection, const char *path)
+{
+  bool result = true;
+  source_t test_file = { 0 };
+
+  if (source_load (&inspection->symbols, path, &test_file) && source_expand (inspection, &test_file, path))
+    {
+      result = decls_update_tests (inspection, &test_file, path);
+      source_release (&test_file);
+    }
+  else
+    {
+      (void)fprintf (stderr, "Error: Unable to open test file at '%s'\n", path);
+    }
+
+  return result;
+}
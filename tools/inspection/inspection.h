@@ -0,0 +1,75 @@
+#ifndef _INSPECTION_H_
+#define _INSPECTION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Maximum number of include files, source directories and test directories of a library. */
+#define INSPECTION_MAX_PATHS 16U
+
+/* Maximum lengths of the configured paths and patterns, including the null terminator. */
+#define INSPECTION_LENGTH_PATH 256U
+#define INSPECTION_LENGTH_PATTERN 64U
+
+/**
+ * The layout and naming conventions of an inspected library.
+ *
+ * Relative paths are resolved against the working directory. inspection_config_init
+ * fills in the layout of this template: include/library.h, src and test below a root.
+ */
+typedef struct
+{
+  char name[INSPECTION_LENGTH_PATTERN];
+  char includes[INSPECTION_MAX_PATHS][INSPECTION_LENGTH_PATH];
+  uint32_t includes_count;
+  char sources[INSPECTION_MAX_PATHS][INSPECTION_LENGTH_PATH];
+  uint32_t sources_count;
+  char tests[INSPECTION_MAX_PATHS][INSPECTION_LENGTH_PATH];
+  uint32_t tests_count;
+  char signatures[INSPECTION_LENGTH_PATH];
+  char coverage[INSPECTION_LENGTH_PATH];
+  char compile_commands[INSPECTION_LENGTH_PATH];
+  char api_prefix[INSPECTION_LENGTH_PATTERN];
+  char inline_prefix[INSPECTION_LENGTH_PATTERN];
+  char test_macro[INSPECTION_LENGTH_PATTERN];
+  char test_annotation[INSPECTION_LENGTH_PATTERN];
+  char test_variation[INSPECTION_LENGTH_PATTERN];
+  char source_extension[INSPECTION_LENGTH_PATTERN];
+  char test_extension[INSPECTION_LENGTH_PATTERN];
+} inspection_config_t;
+
+/**
+ * The reports of an inspection. Every report but INSPECTION_REPORT_SIGNATURE_CHANGES
+ * describes an issue of the library.
+ */
+typedef enum
+{
+  INSPECTION_REPORT_UNDEFINED,
+  INSPECTION_REPORT_UNCOVERED,
+  INSPECTION_REPORT_MISSING_TEST_FILES,
+  INSPECTION_REPORT_TEST_MISMATCHES,
+  INSPECTION_REPORT_PROTOTYPE_MISMATCHES,
+  INSPECTION_REPORT_INVALID_TESTS,
+  INSPECTION_REPORT_UNEXECUTED,
+  INSPECTION_REPORT_SIGNATURE_CHANGES,
+  INSPECTION_REPORT_COUNT
+} inspection_report_t;
+
+/* The state of the inspection of one library. */
+typedef struct inspection inspection_t;
+
+/* Configuration */
+void inspection_config_init (inspection_config_t *config, const char *root);
+bool inspection_config_add_path (char (*paths)[INSPECTION_LENGTH_PATH], uint32_t *count, const char *root, const char *path);
+
+/* Inspection */
+inspection_t *inspection_create (const inspection_config_t *config);
+void inspection_destroy (inspection_t *inspection);
+bool inspection_load (inspection_t *inspection);
+bool inspection_prepare (inspection_t *inspection, inspection_report_t report);
+bool inspection_report (inspection_t *inspection, inspection_report_t report);
+uint32_t inspection_report_all (inspection_t *inspection);
+void inspection_fingerprints_update (inspection_t *inspection);
+void inspection_watch (inspection_t *const *inspections, uint32_t count);
+
+#endif
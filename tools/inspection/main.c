@@ -0,0 +1,260 @@
+#include "inspection.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Maximum number of libraries inspected by one invocation. */
+#define INSPECT_MAX_LIBRARIES 64U
+
+/**
+ * The configuration of a library given on the command line. The first --include,
+ * --src or --test option of a library replaces the default path list of its root.
+ */
+typedef struct
+{
+  inspection_config_t config;
+  const char *root;
+  bool is_custom_includes;
+  bool is_custom_sources;
+  bool is_custom_tests;
+} inspect_library_t;
+
+/**
+ * Prints the command line usage.
+ */
+static void
+inspect_usage (const char *program)
+{
+  (void)fprintf (stderr,
+                 "Usage: %s [--watch] [[--root] DIR [library options]]...\n"
+                 "Every DIR starts a library with the layout DIR/include/library.h, DIR/src and DIR/test, which the\n"
+                 "following options adjust. Without a DIR, the working directory is inspected.\n"
+                 "  --name TEXT        Name of the library in the reports.\n"
+                 "  --include PATH     Header declaring the API, relative to DIR (repeatable).\n"
+                 "  --src PATH         Source directory, relative to DIR (repeatable).\n"
+                 "  --test PATH        Test directory, relative to DIR (repeatable).\n"
+                 "  --api-prefix TEXT  Macro preceding API prototypes (default API).\n"
+                 "  --inline-prefix TEXT\n"
+                 "                     Macro preceding API functions defined inline in a header (default API_INLINE).\n"
+                 "  --test-macro TEXT  Macro defining tests (default CLOVE_TEST).\n"
+                 "  --annotation TEXT  Comment marker covering an API (default @covers).\n"
+                 "  --variation TEXT   Separator of test variations (default __).\n"
+                 "  --src-ext TEXT     Extension of source files (default .c).\n"
+                 "  --test-ext TEXT    Extension of test files (default .test.c).\n"
+                 "  --signatures FILE  Persist signature fingerprints and report changes since the last run.\n"
+                 "  --coverage FILE    Report the definitions missing from a runtime coverage file of LIBRARY_COVERAGE.\n"
+                 "  --compile-commands FILE\n"
+                 "                     Inspect the sources and tests compiled by a compile_commands.json instead of\n"
+                 "                     scanning the source and test directories.\n"
+                 "  --watch            Keep re-inspecting the libraries whenever their files change (Linux only).\n"
+                 "The exit status is 1 if an inspection issue was found and 2 if a library could not be inspected.\n",
+                 program);
+}
+
+/**
+ * Copies an option value into a fixed-size pattern of a configuration.
+ *
+ * @return true if the value fits, false otherwise.
+ */
+static bool
+inspect_set_pattern (char *pattern, const char *value)
+{
+  return snprintf (pattern, INSPECTION_LENGTH_PATTERN, "%s", value) < (int)INSPECTION_LENGTH_PATTERN;
+}
+
+/**
+ * Appends a path to a path list of a library, replacing the default list first.
+ *
+ * @return true if the path was appended, false otherwise.
+ */
+static bool
+inspect_add_path (const inspect_library_t *library, char (*paths)[INSPECTION_LENGTH_PATH], uint32_t *count, bool *is_custom, const char *path)
+{
+  if (*is_custom == false)
+    {
+      *count = 0U;
+      *is_custom = true;
+    }
+
+  return inspection_config_add_path (paths, count, library->root, path);
+}
+
+int
+main (int argc, char *argv[])
+{
+  int result = 0;
+  bool is_watch = false;
+  uint32_t libraries_count = 0U;
+  inspect_library_t *libraries = calloc (INSPECT_MAX_LIBRARIES, sizeof (inspect_library_t));
+  inspection_t **inspections = calloc (INSPECT_MAX_LIBRARIES, sizeof (inspection_t *));
+  if ((libraries == NULL) || (inspections == NULL))
+    {
+      free (libraries);
+      free (inspections);
+      return 2;
+    }
+
+  for (int i = 1; (i < argc) && (result == 0); ++i)
+    {
+      bool has_value = (i + 1) < argc;
+      bool is_root = (argv[i][0] != '-') || ((strcmp (argv[i], "--root") == 0) && has_value);
+
+      if (strcmp (argv[i], "--watch") == 0)
+        {
+          is_watch = true;
+          continue;
+        }
+
+      /* Library options without a preceding root apply to the working directory */
+      if (is_root || (libraries_count == 0U))
+        {
+          if (libraries_count == INSPECT_MAX_LIBRARIES)
+            {
+              (void)fprintf (stderr, "Error: At most %u libraries can be inspected at once.\n", INSPECT_MAX_LIBRARIES);
+              result = 2;
+              break;
+            }
+
+          inspect_library_t *library = &libraries[libraries_count++];
+          library->root = is_root ? ((argv[i][0] != '-') ? argv[i] : argv[++i]) : ".";
+          inspection_config_init (&library->config, library->root);
+          if (is_root)
+            {
+              continue;
+            }
+        }
+
+      inspect_library_t *library = &libraries[libraries_count - 1U];
+      inspection_config_t *config = &library->config;
+      const char *value = has_value ? argv[i + 1] : NULL;
+      bool is_valid = has_value;
+
+      if (strcmp (argv[i], "--name") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->name, value);
+        }
+      else if (strcmp (argv[i], "--include") == 0)
+        {
+          is_valid = is_valid && inspect_add_path (library, config->includes, &config->includes_count, &library->is_custom_includes, value);
+        }
+      else if (strcmp (argv[i], "--src") == 0)
+        {
+          is_valid = is_valid && inspect_add_path (library, config->sources, &config->sources_count, &library->is_custom_sources, value);
+        }
+      else if (strcmp (argv[i], "--test") == 0)
+        {
+          is_valid = is_valid && inspect_add_path (library, config->tests, &config->tests_count, &library->is_custom_tests, value);
+        }
+      else if (strcmp (argv[i], "--api-prefix") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->api_prefix, value);
+        }
+      else if (strcmp (argv[i], "--inline-prefix") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->inline_prefix, value);
+        }
+      else if (strcmp (argv[i], "--test-macro") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->test_macro, value);
+        }
+      else if (strcmp (argv[i], "--annotation") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->test_annotation, value);
+        }
+      else if (strcmp (argv[i], "--variation") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->test_variation, value);
+        }
+      else if (strcmp (argv[i], "--src-ext") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->source_extension, value);
+        }
+      else if (strcmp (argv[i], "--test-ext") == 0)
+        {
+          is_valid = is_valid && inspect_set_pattern (config->test_extension, value);
+        }
+      else if (strcmp (argv[i], "--signatures") == 0)
+        {
+          is_valid = is_valid && (snprintf (config->signatures, sizeof (config->signatures), "%s", value) < (int)sizeof (config->signatures));
+        }
+      else if (strcmp (argv[i], "--coverage") == 0)
+        {
+          is_valid = is_valid && (snprintf (config->coverage, sizeof (config->coverage), "%s", value) < (int)sizeof (config->coverage));
+        }
+      else if (strcmp (argv[i], "--compile-commands") == 0)
+        {
+          is_valid = is_valid
+                     && (snprintf (config->compile_commands, sizeof (config->compile_commands), "%s", value) < (int)sizeof (config->compile_commands));
+        }
+      else
+        {
+          is_valid = false;
+        }
+
+      result = is_valid ? 0 : 2;
+      ++i;
+    }
+
+  if ((result == 0) && (libraries_count == 0U))
+    {
+      libraries[0].root = ".";
+      inspection_config_init (&libraries[libraries_count++].config, ".");
+    }
+
+  if (result != 0)
+    {
+      inspect_usage (argv[0]);
+    }
+
+  for (uint32_t i = 0; (result == 0) && (i < libraries_count); ++i)
+    {
+      inspections[i] = inspection_create (&libraries[i].config);
+      bool is_loaded = (inspections[i] != NULL) && inspection_load (inspections[i]);
+
+      /* Every report is printed, so all data is loaded up front to tell load errors from issues */
+      for (uint32_t report = 0; is_loaded && (report < INSPECTION_REPORT_COUNT); ++report)
+        {
+          is_loaded = inspection_prepare (inspections[i], (inspection_report_t)report);
+        }
+
+      if (is_loaded == false)
+        {
+          (void)fprintf (stderr, "Error: Unable to inspect '%s'\n", libraries[i].config.name);
+          result = 2;
+        }
+    }
+
+  if ((result == 0) && is_watch)
+    {
+      inspection_watch (inspections, libraries_count);
+      result = 2;
+    }
+  else if (result == 0)
+    {
+      for (uint32_t i = 0; i < libraries_count; ++i)
+        {
+          if (libraries_count > 1U)
+            {
+              (void)printf ("%s== %s ==\n", (i > 0U) ? "\n" : "", libraries[i].config.name);
+            }
+
+          uint32_t issues = inspection_report_all (inspections[i]);
+          if (issues == 0U)
+            {
+              (void)printf ("No inspection issues found.\n");
+            }
+
+          inspection_fingerprints_update (inspections[i]);
+          result = (issues > 0U) ? 1 : result;
+        }
+    }
+
+  for (uint32_t i = 0; i < libraries_count; ++i)
+    {
+      inspection_destroy (inspections[i]);
+    }
+  free (inspections);
+  free (libraries);
+
+  return result;
+}
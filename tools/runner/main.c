@@ -0,0 +1,111 @@
+#include "runner.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Default name of the file keeping the job durations of previous runs, in the working directory. */
+#define RUNNER_DEFAULT_DURATIONS "LibraryTestRunner.durations"
+
+/* Default name of the file keeping the profile of the previous run, in the working directory. */
+#define RUNNER_DEFAULT_PROFILE "LibraryTestRunner.profile"
+
+/* Default number of entries of the slow-test report. */
+#define RUNNER_DEFAULT_TOP 10U
+
+/**
+ * Prints the command line usage.
+ */
+static void
+runner_usage (const char *program)
+{
+  (void)fprintf (stderr,
+                 "Usage: %s [--jobs N] [--split] [--durations FILE] [--profile] [--profile-file FILE] [--top N] EXECUTABLE\n"
+                 "Runs the suites of a CLove-Unit test executable on parallel worker processes.\n"
+                 "  --jobs          Number of worker processes (default: number of online processors).\n"
+                 "  --split         Run every test in its own process instead of one process per suite.\n"
+                 "  --durations     File keeping the job durations used for scheduling (default %s).\n"
+                 "  --profile       Measure the wall and CPU time of every test and suite setup and report the slowest;\n"
+                 "                  the jobs then run one at a time.\n"
+                 "  --profile-file  File keeping the profile of the previous run for comparison (default %s).\n"
+                 "  --top           Number of entries of the slow-test report (default %u).\n"
+                 "The exit status is 1 if a test failed and 2 if the tests could not be run.\n",
+                 program, RUNNER_DEFAULT_DURATIONS, RUNNER_DEFAULT_PROFILE, RUNNER_DEFAULT_TOP);
+}
+
+int
+main (int argc, char *argv[])
+{
+  int result = 0;
+  long processors = sysconf (_SC_NPROCESSORS_ONLN);
+  runner_t runner = {
+    .durations = RUNNER_DEFAULT_DURATIONS,
+    .profile = RUNNER_DEFAULT_PROFILE,
+    .top = RUNNER_DEFAULT_TOP,
+    .workers = (processors > 0) ? (uint32_t)processors : 1U,
+  };
+
+  for (int i = 1; (i < argc) && (result == 0); ++i)
+    {
+      bool has_value = (i + 1) < argc;
+      if ((strcmp (argv[i], "--jobs") == 0) && has_value)
+        {
+          runner.workers = (uint32_t)strtoul (argv[++i], NULL, 10);
+          result = (runner.workers > 0U) ? 0 : 2;
+        }
+      else if (strcmp (argv[i], "--split") == 0)
+        {
+          runner.is_split = true;
+        }
+      else if ((strcmp (argv[i], "--durations") == 0) && has_value)
+        {
+          runner.durations = argv[++i];
+        }
+      else if (strcmp (argv[i], "--profile") == 0)
+        {
+          runner.is_profile = true;
+        }
+      else if ((strcmp (argv[i], "--profile-file") == 0) && has_value)
+        {
+          runner.profile = argv[++i];
+        }
+      else if ((strcmp (argv[i], "--top") == 0) && has_value)
+        {
+          runner.top = (uint32_t)strtoul (argv[++i], NULL, 10);
+        }
+      else if ((argv[i][0] != '-') && (runner.executable == NULL))
+        {
+          runner.executable = argv[i];
+        }
+      else
+        {
+          result = 2;
+        }
+    }
+
+  if ((result == 0) && (runner.executable != NULL))
+    {
+      result = 2;
+      if (runner_discover (&runner))
+        {
+          runner_estimate (&runner);
+          bool is_complete = runner_execute (&runner);
+          uint32_t failures = runner_report (&runner, stdout);
+          if (runner.is_profile)
+            {
+              runner_profile_compute (&runner);
+              runner_profile_report (&runner, stdout);
+            }
+          runner_save_durations (&runner);
+          result = is_complete ? ((failures > 0U) ? 1 : 0) : 2;
+        }
+    }
+  else
+    {
+      runner_usage (argv[0]);
+      result = 2;
+    }
+
+  runner_destroy (&runner);
+
+  return result;
+}
@@ -0,0 +1,216 @@
+#include "runner.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The profiled time of a test body or of the setup of a suite, in milliseconds.
+ */
+typedef struct
+{
+  char name[(RUNNER_LENGTH_NAME * 2U) + 16U];
+  double wall;
+  double cpu;
+} runner_entry_t;
+
+/**
+ * Returns the larger of a value and zero, absorbing measurement noise that would
+ * otherwise attribute negative times.
+ */
+static double
+runner_positive (double value)
+{
+  return (value > 0.0) ? value : 0.0;
+}
+
+/**
+ * Returns whether a job runs a whole suite.
+ */
+static bool
+runner_is_suite_job (const runner_job_t *job)
+{
+  size_t length = strlen (job->pattern);
+  return (job->tests_count > 0U) && (length > 2U) && (strcmp (&job->pattern[length - 2U], ".*") == 0);
+}
+
+/**
+ * Attributes the measured process times to the suite setups and the CPU time to
+ * the test bodies.
+ *
+ * The wall time t_i of every test body is read from the reports of the workers. A
+ * suite of n tests ran once as a whole, taking S = o + s + t_1 + ... + t_n, where o
+ * is the cost of starting a worker, measured by a worker running no test, and s the
+ * cost of CLOVE_SUITE_SETUP_ONCE, which the reports do not give.
+ *
+ * The reports give no CPU time, so every test also ran in its own process, taking
+ * T_i = o + s + t_i of CPU time. Summing these single-test runs gives
+ * (n - 1) * (o + s) = T_1 + ... + T_n - S, which separates the shared CPU time from
+ * the test bodies. The CPU time of a suite of a single test cannot be separated
+ * and is attributed to its test.
+ */
+void
+runner_profile_compute (runner_t *runner)
+{
+  double overhead_wall = 0.0;
+  double overhead_cpu = 0.0;
+
+  for (uint32_t i = 0; i < runner->jobs_count; ++i)
+    {
+      const runner_job_t *job = &runner->jobs[i];
+      if (job->tests_count == 0U)
+        {
+          overhead_wall = job->duration;
+          overhead_cpu = job->cpu;
+        }
+      else if ((job->tests_count == 1U) && !runner_is_suite_job (job))
+        {
+          runner->tests[job->first_test].cpu = job->cpu;
+        }
+    }
+
+  for (uint32_t i = 0; i < runner->jobs_count; ++i)
+    {
+      runner_job_t *suite = &runner->jobs[i];
+      if (!runner_is_suite_job (suite))
+        {
+          continue;
+        }
+
+      runner_test_t *tests = &runner->tests[suite->first_test];
+      double total_wall = 0.0;
+      double shared_cpu = overhead_cpu;
+      if (suite->tests_count > 1U)
+        {
+          double total_cpu = 0.0;
+          for (uint32_t j = 0; j < suite->tests_count; ++j)
+            {
+              total_cpu += tests[j].cpu;
+            }
+
+          shared_cpu = runner_positive (total_cpu - suite->cpu) / (double)(suite->tests_count - 1U);
+        }
+
+      for (uint32_t j = 0; j < suite->tests_count; ++j)
+        {
+          total_wall += tests[j].wall;
+          tests[j].cpu = runner_positive (tests[j].cpu - shared_cpu);
+        }
+
+      suite->setup_wall = runner_positive (suite->duration - overhead_wall - total_wall);
+      suite->setup_cpu = runner_positive (shared_cpu - overhead_cpu);
+    }
+}
+
+/**
+ * Compares two profile entries by descending wall time, then by name.
+ */
+static int
+runner_compare_entries (const void *lhs, const void *rhs)
+{
+  const runner_entry_t *a = lhs;
+  const runner_entry_t *b = rhs;
+  int result = (a->wall < b->wall) - (a->wall > b->wall);
+  return (result != 0) ? result : strcmp (a->name, b->name);
+}
+
+/**
+ * Looks up the wall time of an entry in the profile of the previous run.
+ *
+ * @param history The contents of the profile file, or NULL.
+ * @return The previous wall time, or a negative value if the entry is new.
+ */
+static double
+runner_previous_wall (const char *history, const char *name)
+{
+  double result = -1.0;
+  size_t length = strlen (name);
+
+  for (const char *line = history; (line != NULL) && (*line != '\0') && (result < 0.0);)
+    {
+      char *end = NULL;
+      double wall = strtod (line, &end);
+      (void)strtod (end, &end);
+      size_t line_length = strcspn (end, "\n");
+      if ((line_length == (length + 1U)) && (end[0] == ' ') && (strncmp (&end[1], name, length) == 0))
+        {
+          result = wall;
+        }
+
+      line = (end[line_length] == '\n') ? &end[line_length + 1U] : &end[line_length];
+    }
+
+  return result;
+}
+
+/**
+ * Prints the slowest test bodies and suite setups and updates the profile file.
+ *
+ * The entries are ranked by wall time, and the change of every entry against the
+ * profile file of the previous run is printed next to it. The profile file is
+ * then replaced by the times of this run, one "<wall> <cpu> <name>" line per entry.
+ */
+void
+runner_profile_report (const runner_t *runner, FILE *stream)
+{
+  runner_entry_t *entries = calloc (runner->tests_count + runner->jobs_count + 1U, sizeof (runner_entry_t));
+  if (entries == NULL)
+    {
+      return;
+    }
+
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < runner->tests_count; ++i)
+    {
+      const runner_test_t *test = &runner->tests[i];
+      runner_entry_t *entry = &entries[count++];
+      (void)snprintf (entry->name, sizeof (entry->name), "%s.%s", test->suite, test->name);
+      entry->wall = test->wall;
+      entry->cpu = test->cpu;
+    }
+
+  for (uint32_t i = 0; i < runner->jobs_count; ++i)
+    {
+      const runner_job_t *job = &runner->jobs[i];
+      if (runner_is_suite_job (job))
+        {
+          runner_entry_t *entry = &entries[count++];
+          (void)snprintf (entry->name, sizeof (entry->name), "%s (setup once)", runner->tests[job->first_test].suite);
+          entry->wall = job->setup_wall;
+          entry->cpu = job->setup_cpu;
+        }
+    }
+
+  qsort (entries, count, sizeof (runner_entry_t), runner_compare_entries);
+  char *history = (runner->profile != NULL) ? runner_read_file (runner->profile) : NULL;
+
+  uint32_t shown = (runner->top < count) ? runner->top : count;
+  (void)fprintf (stream, "\nSlowest %u of %u tests and suite setups (milliseconds, change of the wall time against the previous run):\n", shown, count);
+  for (uint32_t i = 0; i < shown; ++i)
+    {
+      const runner_entry_t *entry = &entries[i];
+      double previous = runner_previous_wall (history, entry->name);
+      char delta[32];
+      if (previous > 0.0)
+        {
+          (void)snprintf (delta, sizeof (delta), "%+.1f%%", ((entry->wall - previous) * 100.0) / previous);
+        }
+      else
+        {
+          (void)snprintf (delta, sizeof (delta), "%s", (previous < 0.0) ? "new" : "-");
+        }
+
+      (void)fprintf (stream, "%3u. %10.3f wall %10.3f cpu %8s  %s\n", i + 1U, entry->wall, entry->cpu, delta, entry->name);
+    }
+
+  FILE *file = (runner->profile != NULL) ? fopen (runner->profile, "w") : NULL;
+  if (file != NULL)
+    {
+      for (uint32_t i = 0; i < count; ++i)
+        {
+          (void)fprintf (file, "%.3f %.3f %s\n", entries[i].wall, entries[i].cpu, entries[i].name);
+        }
+      (void)fclose (file);
+    }
+
+  free (history);
+  free (entries);
+}
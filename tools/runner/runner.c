@@ -0,0 +1,686 @@
+#include "runner.h"
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Maximum number of CSV columns read from a report of the test executable. */
+#define RUNNER_MAX_COLUMNS 16U
+
+/* Maximum length of a line of a report of the test executable. */
+#define RUNNER_LENGTH_LINE 4096U
+
+/* Test pattern matching no test, used to measure the cost of starting a worker. */
+#define RUNNER_PATTERN_NONE "LibraryTestRunner.none"
+
+/**
+ * The columns of a CSV report of the test executable, located by their header names.
+ */
+typedef struct
+{
+  int32_t suite;
+  int32_t test;
+  int32_t status;
+  int32_t duration;
+  int32_t file;
+  int32_t line;
+  int32_t assert;
+  int32_t expected;
+  int32_t actual;
+} runner_columns_t;
+
+/**
+ * Returns the current value of the monotonic clock in milliseconds.
+ */
+static double
+runner_now (void)
+{
+  struct timespec now;
+  (void)clock_gettime (CLOCK_MONOTONIC, &now);
+  return ((double)now.tv_sec * 1000.0) + ((double)now.tv_nsec / 1000000.0);
+}
+
+/**
+ * Converts a time value of the resource usage to milliseconds.
+ */
+static double
+runner_milliseconds (const struct timeval *time)
+{
+  return ((double)time->tv_sec * 1000.0) + ((double)time->tv_usec / 1000.0);
+}
+
+/**
+ * Builds the path of a file in the temporary directory of the run.
+ *
+ * @param buffer Receives the path, RUNNER_LENGTH_PATH bytes.
+ * @param name The name of the file.
+ * @param index A number distinguishing files of the same kind.
+ * @param extension The extension of the file.
+ */
+static void
+runner_path (const runner_t *runner, char *buffer, const char *name, uint32_t index, const char *extension)
+{
+  (void)snprintf (buffer, RUNNER_LENGTH_PATH, "%s/%s%u%s", runner->directory, name, index, extension);
+}
+
+/**
+ * Splits a CSV line into its columns in place. The last column holds the rest of
+ * the line, so that commas in assertion values do not shift the other columns.
+ *
+ * @param line The line, whose trailing newline is removed.
+ * @param columns Receives pointers to the columns.
+ * @param limit The maximum number of columns.
+ * @return The number of columns.
+ */
+static uint32_t
+runner_split (char *line, char **columns, uint32_t limit)
+{
+  uint32_t result = 0;
+  line[strcspn (line, "\r\n")] = '\0';
+
+  columns[result++] = line;
+  for (char *cursor = line; (*cursor != '\0') && (result < limit); ++cursor)
+    {
+      if (*cursor == ',')
+        {
+          *cursor = '\0';
+          columns[result++] = cursor + 1;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * Locates the known columns in the header of a CSV report.
+ *
+ * @return true if the suite and test columns were found, false otherwise.
+ */
+static bool
+runner_columns_parse (char *header, runner_columns_t *columns)
+{
+  char *names[RUNNER_MAX_COLUMNS];
+  uint32_t count = runner_split (header, names, RUNNER_MAX_COLUMNS);
+  *columns = (runner_columns_t){ -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      int32_t *column = NULL;
+      column = (strcmp (names[i], "Suite") == 0) ? &columns->suite : column;
+      column = (strcmp (names[i], "Test") == 0) ? &columns->test : column;
+      column = (strcmp (names[i], "Status") == 0) ? &columns->status : column;
+      column = (strcmp (names[i], "Duration") == 0) ? &columns->duration : column;
+      column = (strcmp (names[i], "File") == 0) ? &columns->file : column;
+      column = (strcmp (names[i], "Line") == 0) ? &columns->line : column;
+      column = (strcmp (names[i], "Assert") == 0) ? &columns->assert : column;
+      column = (strcmp (names[i], "Expected") == 0) ? &columns->expected : column;
+      column = (strcmp (names[i], "Actual") == 0) ? &columns->actual : column;
+      if (column != NULL)
+        {
+          *column = (int32_t)i;
+        }
+    }
+
+  return (columns->suite >= 0) && (columns->test >= 0);
+}
+
+/**
+ * Returns a column of a split CSV line, or an empty string if it is missing.
+ */
+static const char *
+runner_column (char *const *values, uint32_t count, int32_t column)
+{
+  return ((column >= 0) && ((uint32_t)column < count)) ? values[column] : "";
+}
+
+/**
+ * Starts the test executable with its output redirected to a log file.
+ *
+ * @param arguments The null-terminated arguments after the executable.
+ * @param log The path of the log file receiving stdout and stderr.
+ * @return The process id of the worker, or -1 if it could not be started.
+ */
+static pid_t
+runner_spawn (const runner_t *runner, const char *const *arguments, const char *log)
+{
+  pid_t result = fork ();
+  if (result == 0)
+    {
+      char *argv[16] = { (char *)runner->executable };
+      for (uint32_t i = 0; (arguments[i] != NULL) && (i < 14U); ++i)
+        {
+          argv[i + 1U] = (char *)arguments[i];
+        }
+
+      int descriptor = open (log, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+      if (descriptor >= 0)
+        {
+          (void)dup2 (descriptor, STDOUT_FILENO);
+          (void)dup2 (descriptor, STDERR_FILENO);
+          (void)close (descriptor);
+        }
+
+      (void)execv (runner->executable, argv);
+      _exit (127);
+    }
+
+  return result;
+}
+
+/**
+ * Appends a test to the discovered tests, growing the array as needed.
+ *
+ * @return true if the test was added, false on allocation failure.
+ */
+static bool
+runner_add_test (runner_t *runner, const char *suite, const char *name)
+{
+  if (runner->tests_count == runner->tests_capacity)
+    {
+      uint32_t capacity = (runner->tests_capacity > 0U) ? (runner->tests_capacity * 2U) : 64U;
+      runner_test_t *tests = realloc (runner->tests, capacity * sizeof (runner_test_t));
+      if (tests == NULL)
+        {
+          return false;
+        }
+      runner->tests = tests;
+      runner->tests_capacity = capacity;
+    }
+
+  runner_test_t *test = &runner->tests[runner->tests_count++];
+  *test = (runner_test_t){ .status = RUNNER_STATUS_MISSING };
+  (void)snprintf (test->suite, sizeof (test->suite), "%s", suite);
+  (void)snprintf (test->name, sizeof (test->name), "%s", name);
+
+  return true;
+}
+
+/**
+ * Appends the jobs of one granularity: one per suite, or one per test if is_split is set.
+ */
+static void
+runner_add_jobs (runner_t *runner, bool is_split, bool is_profile)
+{
+  for (uint32_t i = 0; i < runner->tests_count; ++i)
+    {
+      const runner_test_t *test = &runner->tests[i];
+      bool is_new_suite = (i == 0U) || (strcmp (test->suite, runner->tests[i - 1U].suite) != 0);
+      if (is_split || is_new_suite)
+        {
+          runner_job_t *job = &runner->jobs[runner->jobs_count];
+          job->id = runner->jobs_count++;
+          job->first_test = i;
+          job->is_profile = is_profile;
+          job->estimate = -1.0;
+          job->pid = -1;
+          (void)snprintf (job->pattern, sizeof (job->pattern), "%s.%s", test->suite, is_split ? test->name : "*");
+        }
+      ++runner->jobs[runner->jobs_count - 1U].tests_count;
+    }
+}
+
+/**
+ * Groups the discovered tests into jobs: one per suite, or one per test in split mode.
+ *
+ * In profile mode, every test additionally runs at the other granularity to estimate
+ * its CPU time, and one job runs no test at all to measure the cost of starting a
+ * worker process.
+ *
+ * @return true if the jobs were created, false on allocation failure.
+ */
+static bool
+runner_create_jobs (runner_t *runner)
+{
+  runner->jobs = calloc ((runner->tests_count * 2U) + 1U, sizeof (runner_job_t));
+  if (runner->jobs == NULL)
+    {
+      return false;
+    }
+
+  runner_add_jobs (runner, runner->is_split, false);
+  if (runner->is_profile)
+    {
+      runner_add_jobs (runner, !runner->is_split, true);
+
+      runner_job_t *job = &runner->jobs[runner->jobs_count];
+      job->id = runner->jobs_count++;
+      job->first_test = runner->tests_count;
+      job->is_profile = true;
+      job->estimate = -1.0;
+      job->pid = -1;
+      (void)snprintf (job->pattern, sizeof (job->pattern), "%s", RUNNER_PATTERN_NONE);
+    }
+
+  return true;
+}
+
+/**
+ * Lists the tests of the test executable and groups them into jobs.
+ *
+ * A temporary directory is created for the reports and logs of the workers, and
+ * the executable lists its tests into it as a CSV report. Suites are kept in the
+ * listing order, so that the merged report does not depend on the scheduling.
+ *
+ * @return true if the tests were discovered, false otherwise.
+ */
+bool
+runner_discover (runner_t *runner)
+{
+  bool result = false;
+  const char *temporary = getenv ("TMPDIR");
+  (void)snprintf (runner->directory, sizeof (runner->directory), "%s/LibraryTestRunner.XXXXXX", (temporary != NULL) ? temporary : "/tmp");
+  if (mkdtemp (runner->directory) == NULL)
+    {
+      (void)fprintf (stderr, "Error: Unable to create a temporary directory at '%s'\n", runner->directory);
+      runner->directory[0] = '\0';
+      return false;
+    }
+
+  char list[RUNNER_LENGTH_PATH];
+  char log[RUNNER_LENGTH_PATH];
+  runner_path (runner, list, "list", 0U, ".csv");
+  runner_path (runner, log, "list", 0U, ".log");
+
+  const char *arguments[] = { "-l", "-r", "csv", "-o", list, NULL };
+  int status = 0;
+  pid_t pid = runner_spawn (runner, arguments, log);
+  if ((pid < 0) || (waitpid (pid, &status, 0) != pid) || !WIFEXITED (status) || (WEXITSTATUS (status) != 0))
+    {
+      (void)fprintf (stderr, "Error: Unable to list the tests of '%s'\n", runner->executable);
+      return false;
+    }
+
+  FILE *file = fopen (list, "r");
+  if (file != NULL)
+    {
+      char line[RUNNER_LENGTH_LINE];
+      char *values[RUNNER_MAX_COLUMNS];
+      runner_columns_t columns;
+      result = (fgets (line, sizeof (line), file) != NULL) && runner_columns_parse (line, &columns);
+
+      while (result && (fgets (line, sizeof (line), file) != NULL))
+        {
+          uint32_t count = runner_split (line, values, RUNNER_MAX_COLUMNS);
+          const char *suite = runner_column (values, count, columns.suite);
+          const char *name = runner_column (values, count, columns.test);
+          if ((suite[0] != '\0') && (name[0] != '\0'))
+            {
+              result = runner_add_test (runner, suite, name);
+            }
+        }
+
+      (void)fclose (file);
+    }
+
+  if (!result)
+    {
+      (void)fprintf (stderr, "Error: Unable to read the test list of '%s'\n", runner->executable);
+    }
+
+  return result && runner_create_jobs (runner);
+}
+
+/**
+ * Reads a whole file into a null-terminated buffer.
+ *
+ * @return The contents, to be freed by the caller, or NULL if the file is missing or empty.
+ */
+char *
+runner_read_file (const char *path)
+{
+  char *result = NULL;
+  FILE *file = fopen (path, "r");
+  if (file != NULL)
+    {
+      if ((fseek (file, 0, SEEK_END) == 0) && (ftell (file) > 0))
+        {
+          size_t size = (size_t)ftell (file);
+          result = calloc (size + 1U, 1U);
+          rewind (file);
+          if ((result != NULL) && (fread (result, 1U, size, file) != size))
+            {
+              result[0] = '\0';
+            }
+        }
+      (void)fclose (file);
+    }
+
+  return result;
+}
+
+/**
+ * Compares two jobs by the position of their first test in the discovery order.
+ */
+static int
+runner_compare_first_tests (const void *lhs, const void *rhs)
+{
+  const runner_job_t *a = lhs;
+  const runner_job_t *b = rhs;
+  int result = (a->first_test > b->first_test) - (a->first_test < b->first_test);
+  return (result != 0) ? result : ((a->id > b->id) - (a->id < b->id));
+}
+
+/**
+ * Compares two jobs by descending estimated duration. Jobs without an estimate
+ * are treated as the longest and keep their discovery order among each other.
+ */
+static int
+runner_compare_jobs (const void *lhs, const void *rhs)
+{
+  const runner_job_t *a = lhs;
+  const runner_job_t *b = rhs;
+  double estimate_a = (a->estimate < 0.0) ? INFINITY : a->estimate;
+  double estimate_b = (b->estimate < 0.0) ? INFINITY : b->estimate;
+
+  int result = (estimate_a < estimate_b) - (estimate_a > estimate_b);
+  return (result != 0) ? result : runner_compare_first_tests (lhs, rhs);
+}
+
+/**
+ * Loads the durations measured by previous runs and orders the jobs by them.
+ *
+ * The durations file holds one "<milliseconds> <pattern>" line per job. Starting
+ * the longest jobs first and letting every idle worker take the next one keeps
+ * the workers busy until the end of the run, so a single slow suite does not
+ * start last and extend the run beyond the sum of the others.
+ */
+void
+runner_estimate (runner_t *runner)
+{
+  runner->history = (runner->durations != NULL) ? runner_read_file (runner->durations) : NULL;
+
+  for (const char *line = runner->history; (line != NULL) && (*line != '\0');)
+    {
+      char *end = NULL;
+      double duration = strtod (line, &end);
+      size_t length = strcspn (end, "\n");
+
+      for (uint32_t i = 0; (end != line) && (i < runner->jobs_count); ++i)
+        {
+          runner_job_t *job = &runner->jobs[i];
+          if ((length == (strlen (job->pattern) + 1U)) && (end[0] == ' ') && (strncmp (&end[1], job->pattern, length - 1U) == 0))
+            {
+              job->estimate = duration;
+            }
+        }
+
+      line = (end[length] == '\n') ? &end[length + 1U] : &end[length];
+    }
+
+  qsort (runner->jobs, runner->jobs_count, sizeof (runner_job_t), runner_compare_jobs);
+}
+
+/**
+ * Reads the report of a finished job into the results of its tests, including the
+ * wall time of every test body, which the report gives in nanoseconds.
+ */
+static void
+runner_collect (runner_t *runner, const runner_job_t *job)
+{
+  char path[RUNNER_LENGTH_PATH];
+  runner_path (runner, path, "job", job->id, ".csv");
+
+  FILE *file = fopen (path, "r");
+  if (file != NULL)
+    {
+      char line[RUNNER_LENGTH_LINE];
+      char *values[RUNNER_MAX_COLUMNS];
+      runner_columns_t columns;
+      bool is_valid = (fgets (line, sizeof (line), file) != NULL) && runner_columns_parse (line, &columns);
+
+      while (is_valid && (fgets (line, sizeof (line), file) != NULL))
+        {
+          uint32_t count = runner_split (line, values, RUNNER_MAX_COLUMNS);
+          const char *suite = runner_column (values, count, columns.suite);
+          const char *name = runner_column (values, count, columns.test);
+          const char *status = runner_column (values, count, columns.status);
+
+          for (uint32_t i = job->first_test; i < (job->first_test + job->tests_count); ++i)
+            {
+              runner_test_t *test = &runner->tests[i];
+              if ((strcmp (test->suite, suite) == 0) && (strcmp (test->name, name) == 0))
+                {
+                  test->status = (status[0] == 'P') ? RUNNER_STATUS_PASS : ((status[0] == 'S') ? RUNNER_STATUS_SKIP : RUNNER_STATUS_FAIL);
+                  test->wall = strtod (runner_column (values, count, columns.duration), NULL) / 1000000.0;
+                  if (test->status == RUNNER_STATUS_FAIL)
+                    {
+                      (void)snprintf (test->detail, sizeof (test->detail), "%s:%s: %s expected [%s] actual [%s]",
+                                      runner_column (values, count, columns.file), runner_column (values, count, columns.line),
+                                      runner_column (values, count, columns.assert), runner_column (values, count, columns.expected),
+                                      runner_column (values, count, columns.actual));
+                    }
+                }
+            }
+        }
+
+      (void)fclose (file);
+    }
+
+  for (uint32_t i = job->first_test; i < (job->first_test + job->tests_count); ++i)
+    {
+      runner_test_t *test = &runner->tests[i];
+      if ((test->status == RUNNER_STATUS_MISSING) && WIFSIGNALED (job->exit_status))
+        {
+          (void)snprintf (test->detail, sizeof (test->detail), "The worker was terminated by signal %d", WTERMSIG (job->exit_status));
+        }
+      else if (test->status == RUNNER_STATUS_MISSING)
+        {
+          (void)snprintf (test->detail, sizeof (test->detail), "The worker exited with status %d without a result",
+                          WIFEXITED (job->exit_status) ? WEXITSTATUS (job->exit_status) : -1);
+        }
+    }
+}
+
+/**
+ * Runs the jobs on the worker processes.
+ *
+ * The jobs form a single queue ordered by their estimated duration. Up to
+ * runner->workers processes run at a time, and whenever one finishes, the next job
+ * of the queue is started in its place, so that workers that finish early take
+ * over the remaining work instead of idling. In profile mode, the jobs run one at
+ * a time instead, so that concurrent workers do not inflate the measured times
+ * and the differences taken by runner_profile_compute stay meaningful.
+ *
+ * @return true if every job was started, false otherwise.
+ */
+bool
+runner_execute (runner_t *runner)
+{
+  bool result = true;
+  uint32_t next = 0;
+  uint32_t running = 0;
+  uint32_t workers = runner->is_profile ? 1U : runner->workers;
+
+  while ((next < runner->jobs_count) || (running > 0U))
+    {
+      while (result && (running < workers) && (next < runner->jobs_count))
+        {
+          runner_job_t *job = &runner->jobs[next];
+          char report[RUNNER_LENGTH_PATH];
+          char log[RUNNER_LENGTH_PATH];
+          runner_path (runner, report, "job", job->id, ".csv");
+          runner_path (runner, log, "job", job->id, ".log");
+
+          const char *arguments[] = { "-r", "csv", "-o", report, "-i", job->pattern, NULL };
+          job->duration = runner_now ();
+          job->pid = runner_spawn (runner, arguments, log);
+          result = job->pid > 0;
+          running += result ? 1U : 0U;
+          next += result ? 1U : 0U;
+        }
+
+      if (!result && (running == 0U))
+        {
+          (void)fprintf (stderr, "Error: Unable to start a worker for '%s'\n", runner->jobs[next].pattern);
+          break;
+        }
+
+      int status = 0;
+      struct rusage usage;
+      pid_t pid = wait4 (-1, &status, 0, &usage);
+      for (uint32_t i = 0; (pid > 0) && (i < next); ++i)
+        {
+          runner_job_t *job = &runner->jobs[i];
+          if (job->pid == pid)
+            {
+              job->duration = runner_now () - job->duration;
+              job->cpu = runner_milliseconds (&usage.ru_utime) + runner_milliseconds (&usage.ru_stime);
+              job->exit_status = status;
+              job->pid = -1;
+              --running;
+              if (!job->is_profile)
+                {
+                  runner_collect (runner, job);
+                }
+            }
+        }
+    }
+
+  /* Restore the discovery order for the report */
+  qsort (runner->jobs, runner->jobs_count, sizeof (runner_job_t), runner_compare_first_tests);
+
+  return result;
+}
+
+/**
+ * Appends the output of a worker to a stream.
+ */
+static void
+runner_print_log (const runner_t *runner, const runner_job_t *job, FILE *stream)
+{
+  char path[RUNNER_LENGTH_PATH];
+  runner_path (runner, path, "job", job->id, ".log");
+
+  FILE *file = fopen (path, "r");
+  if (file != NULL)
+    {
+      char buffer[RUNNER_LENGTH_LINE];
+      size_t size = 0;
+      while ((size = fread (buffer, 1U, sizeof (buffer), file)) > 0U)
+        {
+          (void)fwrite (buffer, 1U, size, stream);
+        }
+      (void)fclose (file);
+    }
+}
+
+/**
+ * Prints the merged report of the run.
+ *
+ * The tests are listed in discovery order with their outcome, followed by the
+ * output of the workers of failed jobs and a summary. runner_execute restores the
+ * discovery order of the jobs once they finished. Durations are left out, so
+ * that runs with different worker counts produce the same report.
+ *
+ * @return The number of failed tests, including tests without a result.
+ */
+uint32_t
+runner_report (const runner_t *runner, FILE *stream)
+{
+  static const char *const labels[] = { "[MISS]", "[PASS]", "[FAIL]", "[SKIP]" };
+  uint32_t counts[4] = { 0U, 0U, 0U, 0U };
+
+  for (uint32_t i = 0; i < runner->tests_count; ++i)
+    {
+      const runner_test_t *test = &runner->tests[i];
+      bool is_failed = (test->status == RUNNER_STATUS_FAIL) || (test->status == RUNNER_STATUS_MISSING);
+      (void)fprintf (stream, "%s %s.%s%s%s\n", labels[test->status], test->suite, test->name, is_failed ? " => " : "", is_failed ? test->detail : "");
+      ++counts[test->status];
+    }
+
+  for (uint32_t i = 0; i < runner->jobs_count; ++i)
+    {
+      const runner_job_t *job = &runner->jobs[i];
+      bool is_failed = false;
+      for (uint32_t j = job->first_test; !job->is_profile && (j < (job->first_test + job->tests_count)); ++j)
+        {
+          is_failed = is_failed || (runner->tests[j].status == RUNNER_STATUS_FAIL) || (runner->tests[j].status == RUNNER_STATUS_MISSING);
+        }
+
+      if (is_failed)
+        {
+          (void)fprintf (stream, "\n--- Output of %s ---\n", job->pattern);
+          runner_print_log (runner, job, stream);
+        }
+    }
+
+  (void)fprintf (stream, "\nTotal: %u, Passed: %u, Failed: %u, Skipped: %u\n", runner->tests_count, counts[RUNNER_STATUS_PASS],
+                 counts[RUNNER_STATUS_FAIL] + counts[RUNNER_STATUS_MISSING], counts[RUNNER_STATUS_SKIP]);
+
+  return counts[RUNNER_STATUS_FAIL] + counts[RUNNER_STATUS_MISSING];
+}
+
+/**
+ * Writes the measured job durations to the durations file. Entries of jobs that
+ * were not part of this run, e.g. single tests of a previous split run, are kept.
+ */
+void
+runner_save_durations (const runner_t *runner)
+{
+  FILE *file = (runner->durations != NULL) ? fopen (runner->durations, "w") : NULL;
+  if (file == NULL)
+    {
+      return;
+    }
+
+  for (uint32_t i = 0; i < runner->jobs_count; ++i)
+    {
+      (void)fprintf (file, "%.3f %s\n", runner->jobs[i].duration, runner->jobs[i].pattern);
+    }
+
+  for (const char *line = runner->history; (line != NULL) && (*line != '\0');)
+    {
+      size_t length = strcspn (line, "\n");
+      const char *pattern = memchr (line, ' ', length);
+      bool is_current = false;
+
+      for (uint32_t i = 0; (pattern != NULL) && (i < runner->jobs_count); ++i)
+        {
+          const char *job_pattern = runner->jobs[i].pattern;
+          is_current = is_current || ((strlen (job_pattern) == (size_t)(&line[length] - &pattern[1])) && (strncmp (&pattern[1], job_pattern, strlen (job_pattern)) == 0));
+        }
+
+      if ((pattern != NULL) && !is_current)
+        {
+          (void)fprintf (file, "%.*s\n", (int)length, line);
+        }
+
+      line = (line[length] == '\n') ? &line[length + 1U] : &line[length];
+    }
+
+  (void)fclose (file);
+}
+
+/**
+ * Removes the temporary files of the run and releases its memory.
+ */
+void
+runner_destroy (runner_t *runner)
+{
+  if (runner->directory[0] != '\0')
+    {
+      char path[RUNNER_LENGTH_PATH];
+      for (uint32_t i = 0; i < runner->jobs_count; ++i)
+        {
+          runner_path (runner, path, "job", runner->jobs[i].id, ".csv");
+          (void)unlink (path);
+          runner_path (runner, path, "job", runner->jobs[i].id, ".log");
+          (void)unlink (path);
+        }
+
+      runner_path (runner, path, "list", 0U, ".csv");
+      (void)unlink (path);
+      runner_path (runner, path, "list", 0U, ".log");
+      (void)unlink (path);
+      (void)rmdir (runner->directory);
+    }
+
+  free (runner->history);
+  free (runner->tests);
+  free (runner->jobs);
+}
@@ -0,0 +1,99 @@
+#ifndef _RUNNER_H_
+#define _RUNNER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+/* Maximum lengths of suite and test names, paths and failure details, including the null terminator. */
+#define RUNNER_LENGTH_NAME 128U
+#define RUNNER_LENGTH_PATH 512U
+#define RUNNER_LENGTH_DETAIL 512U
+
+/**
+ * The outcome of a test. RUNNER_STATUS_MISSING marks a test whose worker exited
+ * without reporting it, e.g. because an earlier test of the same job crashed.
+ */
+typedef enum
+{
+  RUNNER_STATUS_MISSING,
+  RUNNER_STATUS_PASS,
+  RUNNER_STATUS_FAIL,
+  RUNNER_STATUS_SKIP
+} runner_status_t;
+
+/**
+ * A test discovered in the test executable. The wall time of its body is read from
+ * the report of its worker, and its CPU time is only estimated in profile mode, both
+ * in milliseconds.
+ */
+typedef struct
+{
+  char suite[RUNNER_LENGTH_NAME];
+  char name[RUNNER_LENGTH_NAME];
+  runner_status_t status;
+  char detail[RUNNER_LENGTH_DETAIL];
+  double wall;
+  double cpu;
+} runner_test_t;
+
+/**
+ * A unit of work executed by one worker process: a whole suite, so that its
+ * CLOVE_SUITE_SETUP_ONCE runs once, or a single test in split mode. The tests of
+ * a job are a contiguous range of the discovered tests.
+ *
+ * Profile jobs run the tests at the other granularity, or no test at all, and
+ * only contribute their process times to the profile. Durations are in milliseconds,
+ * and the setup times of suite jobs are derived by runner_profile_compute.
+ */
+typedef struct
+{
+  char pattern[(RUNNER_LENGTH_NAME * 2U) + 2U];
+  uint32_t id;
+  uint32_t first_test;
+  uint32_t tests_count;
+  bool is_profile;
+  double estimate;
+  double duration;
+  double cpu;
+  double setup_wall;
+  double setup_cpu;
+  pid_t pid;
+  int exit_status;
+} runner_job_t;
+
+/**
+ * The state of a parallel test run. The temporary directory is shorter than
+ * RUNNER_LENGTH_PATH to leave room for the names of the files within it.
+ */
+typedef struct
+{
+  const char *executable;
+  const char *durations;
+  uint32_t workers;
+  bool is_split;
+  bool is_profile;
+  const char *profile;
+  uint32_t top;
+  char directory[RUNNER_LENGTH_PATH - 32U];
+  char *history;
+  runner_test_t *tests;
+  uint32_t tests_count;
+  uint32_t tests_capacity;
+  runner_job_t *jobs;
+  uint32_t jobs_count;
+} runner_t;
+
+char *runner_read_file (const char *path);
+bool runner_discover (runner_t *runner);
+void runner_estimate (runner_t *runner);
+bool runner_execute (runner_t *runner);
+uint32_t runner_report (const runner_t *runner, FILE *stream);
+void runner_save_durations (const runner_t *runner);
+void runner_destroy (runner_t *runner);
+
+void runner_profile_compute (runner_t *runner);
+void runner_profile_report (const runner_t *runner, FILE *stream);
+
+#endif